@@ -15,6 +15,7 @@ function(${PROJECT_NAME}_set_compiler_flags)
     elseif(CMAKE_C_COMPILER_ID STREQUAL "MSVC")
         add_compile_options(
             /wd5072
+            $<$<COMPILE_LANGUAGE:C>:/experimental:c11atomics>
         )
     else()
         message(FATAL_ERROR "Unknown C compiler: ${CMAKE_C_COMPILER_ID}")
@@ -0,0 +1,89 @@
+import argparse
+import json
+import utils
+
+BUILD_TYPES = ['release-nonsanitized', 'debug-nonsanitized']
+COMPARED_METRICS = ['real_time', 'p50_ns', 'p99_ns', 'p999_ns']
+
+def get_bench_executable(build_type):
+    executable = utils.BUILD_TOP_DIR/build_type/'test'/'logger_bench'/'logger_bench'
+    if utils.running_on_windows():
+        executable = executable.with_suffix('.exe')
+    return executable
+
+def run_benchmarks(build_type, output_path, benchmark_filter, repetitions):
+    command = f'{get_bench_executable(build_type)} --benchmark_out={output_path} --benchmark_out_format=json'
+    if benchmark_filter:
+        command += f' "--benchmark_filter={benchmark_filter}"'
+    if repetitions > 1:
+        command += f' --benchmark_repetitions={repetitions} --benchmark_report_aggregates_only=true'
+    # Run from the build directory, since some benchmarks write their files to the working directory
+    utils.run_command(command, shell=True, check=True, cwd=utils.BUILD_TOP_DIR/build_type)
+
+def load_results(path):
+    with open(path) as file:
+        results = json.load(file)
+
+    # With repetitions, only the medians are compared
+    benchmarks = {}
+    for benchmark in results.get('benchmarks', []):
+        if benchmark.get('run_type') == 'aggregate' and benchmark.get('aggregate_name') != 'median':
+            continue
+        benchmarks[benchmark['run_name']] = benchmark
+    return benchmarks
+
+def compare_results(baseline_path, current_path, threshold_percent):
+    baseline = load_results(baseline_path)
+    current = load_results(current_path)
+    regressions = []
+
+    for name, current_benchmark in current.items():
+        baseline_benchmark = baseline.get(name)
+        if baseline_benchmark is None:
+            continue
+        for metric in COMPARED_METRICS:
+            if metric not in current_benchmark or not baseline_benchmark.get(metric):
+                continue
+            change_percent = (current_benchmark[metric] / baseline_benchmark[metric] - 1) * 100
+            line = f'{name} {metric}: {baseline_benchmark[metric]:.1f} -> {current_benchmark[metric]:.1f} ({change_percent:+.1f}%)'
+            if change_percent > threshold_percent:
+                regressions.append(line)
+                utils.colored_print(line, color=utils.COLOR_RED)
+            else:
+                utils.colored_print(line)
+    return regressions
+
+def main():
+    parser = argparse.ArgumentParser(description='Build and run the benchmarks, optionally comparing them with a previous run')
+    parser.add_argument('-b', '--build-type', type=str, choices=BUILD_TYPES, help='Type of the build', default=BUILD_TYPES[0])
+    parser.add_argument('-f', '--filter', type=str, help='Regular expression of the benchmarks to run', default=None)
+    parser.add_argument('-r', '--repetitions', type=int, help='Repetitions of each benchmark, compared by their median', default=1)
+    parser.add_argument('-o', '--output', type=str, help='JSON results file, defaults to logger_bench.json in the build directory', default=None)
+    parser.add_argument('-c', '--compare', type=str, help='JSON results of a previous run to compare with', default=None)
+    parser.add_argument('-t', '--threshold', type=float, help='Slowdown in percent reported as a regression', default=10.0)
+    args = parser.parse_args()
+
+    output_path = args.output or str(utils.BUILD_TOP_DIR/args.build_type/'logger_bench.json')
+
+    command = f'cmake --preset config-{args.build_type}'
+    utils.run_command(command, shell=True, check=True)
+
+    command = f'cmake --build --preset build-{args.build_type} --target logger_bench'
+    utils.run_command(command, shell=True, check=True)
+
+    run_benchmarks(args.build_type, output_path, args.filter, args.repetitions)
+    utils.colored_print(f'Results written to {output_path}')
+
+    if args.compare:
+        regressions = compare_results(args.compare, output_path, args.threshold)
+        if regressions:
+            utils.colored_print(f'\n{len(regressions)} regression(s) above {args.threshold}%', color=utils.COLOR_RED)
+            exit(1)
+        utils.colored_print('\nNo regressions', color=utils.COLOR_GREEN)
+
+if __name__ == '__main__':
+    try:
+        main()
+    except Exception as e:
+        utils.colored_print('An error occurred:', color=utils.COLOR_RED)
+        raise e
@@ -0,0 +1,146 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "async_queue.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "mdn/mock_wrapper.h"
+
+#define ASYNC_QUEUE_MIN_CAPACITY 2
+
+typedef struct Logger_AsyncQueueAlloc_t_ {
+    Logger_AsyncQueue_t queue;
+    void               *selfAlloc;
+} Logger_AsyncQueueAlloc_t;
+
+static void *mdn_Logger_AsyncQueue_alignToCacheLine(void *ptr) {
+    uintptr_t address = (uintptr_t)ptr;
+
+    address = (address + (LOGGER_CACHE_LINE_SIZE - 1)) & ~(uintptr_t)(LOGGER_CACHE_LINE_SIZE - 1);
+    return (void *)address;
+}
+
+static size_t mdn_Logger_AsyncQueue_roundUpToPowerOfTwo(size_t value) {
+    size_t result = ASYNC_QUEUE_MIN_CAPACITY;
+
+    while ((result < value) && (result <= (SIZE_MAX / 2))) {
+        result *= 2;
+    }
+    return result;
+}
+
+static Logger_AsyncQueueSlot_t *mdn_Logger_AsyncQueue_slotAt(Logger_AsyncQueue_t *queue, size_t pos) {
+    return (Logger_AsyncQueueSlot_t *)(void *)(queue->slotsArr + ((pos & (queue->slotsArrLen - 1)) * queue->slotStride));
+}
+
+Logger_AsyncQueue_t *mdn_Logger_AsyncQueue_create(size_t capacity, size_t maxMessageLen) {
+    Logger_AsyncQueueAlloc_t *queueAlloc;
+    Logger_AsyncQueue_t      *queue;
+    void                     *selfAlloc;
+    size_t                    slotStride;
+
+    capacity   = mdn_Logger_AsyncQueue_roundUpToPowerOfTwo(capacity);
+    slotStride = sizeof(Logger_AsyncQueueSlot_t) + maxMessageLen + 1;
+    slotStride = (slotStride + (LOGGER_CACHE_LINE_SIZE - 1)) & ~(size_t)(LOGGER_CACHE_LINE_SIZE - 1);
+    if ((slotStride <= maxMessageLen) || (capacity > ((SIZE_MAX - LOGGER_CACHE_LINE_SIZE) / slotStride))) {
+        return NULL;
+    }
+
+    selfAlloc = MDN_MW_malloc(sizeof(*queueAlloc) + LOGGER_CACHE_LINE_SIZE - 1);
+    if (selfAlloc == NULL) {
+        return NULL;
+    }
+    queueAlloc            = mdn_Logger_AsyncQueue_alignToCacheLine(selfAlloc);
+    queueAlloc->selfAlloc = selfAlloc;
+    queue                 = &queueAlloc->queue;
+
+    queue->slotsAlloc = MDN_MW_malloc((capacity * slotStride) + LOGGER_CACHE_LINE_SIZE - 1);
+    if (queue->slotsAlloc == NULL) {
+        free(selfAlloc);
+        return NULL;
+    }
+    queue->slotsArr      = mdn_Logger_AsyncQueue_alignToCacheLine(queue->slotsAlloc);
+    queue->slotsArrLen   = capacity;
+    queue->slotStride    = slotStride;
+    queue->maxMessageLen = maxMessageLen;
+    atomic_init(&queue->enqueuePos, 0);
+    atomic_init(&queue->dequeuePos, 0);
+    for (size_t pos = 0; pos < capacity; ++pos) {
+        atomic_init(&mdn_Logger_AsyncQueue_slotAt(queue, pos)->sequence, pos);
+    }
+
+    return queue;
+}
+
+void mdn_Logger_AsyncQueue_destroy(Logger_AsyncQueue_t *queue) {
+    Logger_AsyncQueueAlloc_t *queueAlloc = (Logger_AsyncQueueAlloc_t *)(void *)queue;
+
+    free(queue->slotsAlloc);
+    free(queueAlloc->selfAlloc);
+}
+
+Logger_AsyncQueueSlot_t *mdn_Logger_AsyncQueue_claim(Logger_AsyncQueue_t *queue, size_t *pos) {
+    Logger_AsyncQueueSlot_t *slot;
+    size_t                   curPos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+    size_t                   sequence;
+
+    for (;;) {
+        slot     = mdn_Logger_AsyncQueue_slotAt(queue, curPos);
+        sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if (sequence == curPos) {
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueuePos, &curPos, curPos + 1, memory_order_seq_cst, memory_order_relaxed)) {
+                *pos = curPos;
+                return slot;
+            }
+        } else if ((ptrdiff_t)(sequence - curPos) < 0) {
+            return NULL;
+        } else {
+            curPos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+        }
+    }
+}
+
+void mdn_Logger_AsyncQueue_commit(Logger_AsyncQueue_t *queue, Logger_AsyncQueueSlot_t *slot, size_t pos) {
+    (void)queue;
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+}
+
+Logger_AsyncQueueSlot_t *mdn_Logger_AsyncQueue_acquire(Logger_AsyncQueue_t *queue, size_t *pos) {
+    Logger_AsyncQueueSlot_t *slot;
+    size_t                   curPos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+    size_t                   sequence;
+
+    for (;;) {
+        slot     = mdn_Logger_AsyncQueue_slotAt(queue, curPos);
+        sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if (sequence == (curPos + 1)) {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeuePos, &curPos, curPos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                *pos = curPos;
+                return slot;
+            }
+        } else if ((ptrdiff_t)(sequence - (curPos + 1)) < 0) {
+            return NULL;
+        } else {
+            curPos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+        }
+    }
+}
+
+void mdn_Logger_AsyncQueue_release(Logger_AsyncQueue_t *queue, Logger_AsyncQueueSlot_t *slot, size_t pos) {
+    atomic_store_explicit(&slot->sequence, pos + queue->slotsArrLen, memory_order_release);
+}
+
+bool mdn_Logger_AsyncQueue_isEmpty(Logger_AsyncQueue_t *queue) {
+    return atomic_load(&queue->dequeuePos) == atomic_load(&queue->enqueuePos);
+}
+
+size_t mdn_Logger_AsyncQueue_getDepth(Logger_AsyncQueue_t *queue) {
+    // In this order, as the reader never gets past the producers
+    size_t dequeuePos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+
+    return atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed) - dequeuePos;
+}
+
+char *mdn_Logger_AsyncQueue_slotMessage(Logger_AsyncQueueSlot_t *slot) {
+    return (char *)(slot + 1);
+}
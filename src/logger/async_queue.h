@@ -0,0 +1,52 @@
+#ifndef LOGGER_ASYNC_QUEUE_H
+#define LOGGER_ASYNC_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "logger_internal.h"
+
+// Bounded lock-free queue of fixed-size record slots (Vyukov's sequence-per-slot scheme).
+// Any number of threads may claim slots for writing. Reading is done by the logger's writer thread,
+// and also by producers discarding the oldest record when the queue is full.
+typedef struct Logger_AsyncQueue_t_ {
+    _Alignas(LOGGER_CACHE_LINE_SIZE) atomic_size_t enqueuePos;
+    _Alignas(LOGGER_CACHE_LINE_SIZE) atomic_size_t dequeuePos;
+    _Alignas(LOGGER_CACHE_LINE_SIZE) unsigned char *slotsArr;
+    void  *slotsAlloc;
+    size_t slotsArrLen;
+    size_t slotStride;
+    size_t maxMessageLen;
+} Logger_AsyncQueue_t;
+
+typedef struct Logger_AsyncQueueSlot_t_ {
+    atomic_size_t   sequence;
+    Logger_Record_t record;
+} Logger_AsyncQueueSlot_t;
+
+// 'capacity' is rounded up to a power of two
+Logger_AsyncQueue_t *mdn_Logger_AsyncQueue_create(size_t capacity, size_t maxMessageLen);
+
+void mdn_Logger_AsyncQueue_destroy(Logger_AsyncQueue_t *queue);
+
+// Returns NULL if the queue is full. On success, the slot must be handed back with mdn_Logger_AsyncQueue_commit().
+// Claiming is sequentially consistent with mdn_Logger_AsyncQueue_isEmpty(), so it can be used for sleep/wake-up handshakes.
+Logger_AsyncQueueSlot_t *mdn_Logger_AsyncQueue_claim(Logger_AsyncQueue_t *queue, size_t *pos);
+
+void mdn_Logger_AsyncQueue_commit(Logger_AsyncQueue_t *queue, Logger_AsyncQueueSlot_t *slot, size_t pos);
+
+// Returns NULL if there is no committed record. On success, the slot must be handed back with mdn_Logger_AsyncQueue_release()
+Logger_AsyncQueueSlot_t *mdn_Logger_AsyncQueue_acquire(Logger_AsyncQueue_t *queue, size_t *pos);
+
+void mdn_Logger_AsyncQueue_release(Logger_AsyncQueue_t *queue, Logger_AsyncQueueSlot_t *slot, size_t pos);
+
+bool mdn_Logger_AsyncQueue_isEmpty(Logger_AsyncQueue_t *queue);
+
+// Records claimed and not released yet, only a snapshot while producers and the reader are at work
+size_t mdn_Logger_AsyncQueue_getDepth(Logger_AsyncQueue_t *queue);
+
+// Buffer of (maxMessageLen + 1) bytes that follows the slot header
+char *mdn_Logger_AsyncQueue_slotMessage(Logger_AsyncQueueSlot_t *slot);
+
+#endif  // LOGGER_ASYNC_QUEUE_H
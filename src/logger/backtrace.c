@@ -0,0 +1,248 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "backtrace.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <pthread.h>
+#elif defined _WIN32
+# include <Windows.h>
+#endif  // OS
+
+#include "fast_printf.h"
+#include "line_buffer.h"
+#include "mdn/mock_wrapper.h"
+
+typedef struct Logger_BacktraceSlot_t_ {
+    Logger_Record_t record;
+    char            message[];  // maxMessageLen + 1 bytes
+} Logger_BacktraceSlot_t;
+
+// Ring of the records one thread holds back. Buffers outlive their thread and are taken over by the next new one, so there are
+// never more of them than threads were logging at once.
+typedef struct Logger_BacktraceBuffer_t_ {
+    atomic_bool                       inUse;
+    struct Logger_BacktraceBuffer_t_ *next;
+    size_t                            oldestIdx;
+    size_t                            len;
+    _Alignas(Logger_BacktraceSlot_t) unsigned char slots[];  // recordsCount slots of slotSize bytes
+} Logger_BacktraceBuffer_t;
+
+struct Logger_Backtrace_t_ {
+    size_t                              recordsCount;
+    size_t                              maxMessageLen;
+    size_t                              slotSize;
+    unsigned                            generation;   // Tells the buffers of this backtrace from those of a previous one
+    _Atomic(Logger_BacktraceBuffer_t *) buffersList;  // Only ever pushed onto, buffers are freed with the backtrace
+    // Hands the buffer of an exiting thread over to the next new one. Deleted before the buffers are freed, so that it no longer
+    // runs on threads that exit afterwards.
+#if (defined __APPLE__) || (defined __linux__)
+    pthread_key_t threadBufferKey;
+#elif defined _WIN32
+    DWORD threadBufferKey;
+#endif  // OS
+};
+
+// Changed only while no thread logs, see mdn_Logger_Backtrace_create()
+static unsigned g_Logger_backtraceGeneration;
+
+static _Thread_local Logger_BacktraceBuffer_t *g_Logger_threadBacktraceBuffer;
+static _Thread_local unsigned                  g_Logger_threadBacktraceGeneration;
+
+static void mdn_Logger_Backtrace_releaseBuffer(void *value) {
+    Logger_BacktraceBuffer_t *buffer = value;
+
+    g_Logger_threadBacktraceBuffer = NULL;
+    atomic_store_explicit(&buffer->inUse, false, memory_order_release);
+}
+
+#if (defined __APPLE__) || (defined __linux__)
+static void mdn_Logger_Backtrace_onThreadExit(void *value) {
+    mdn_Logger_Backtrace_releaseBuffer(value);
+}
+#elif defined _WIN32
+static void NTAPI mdn_Logger_Backtrace_onThreadExit(PVOID value) {
+    mdn_Logger_Backtrace_releaseBuffer(value);
+}
+#endif  // OS
+
+Logger_Backtrace_t *mdn_Logger_Backtrace_create(size_t recordsCount, size_t maxMessageLen) {
+    Logger_Backtrace_t *backtrace;
+    size_t              slotSize;
+
+    if ((recordsCount == 0) || (maxMessageLen > (SIZE_MAX / 2))) {
+        return NULL;
+    }
+    slotSize = sizeof(Logger_BacktraceSlot_t) + maxMessageLen + 1;
+    slotSize = (slotSize + _Alignof(Logger_BacktraceSlot_t) - 1) & ~(_Alignof(Logger_BacktraceSlot_t) - 1);
+    if (recordsCount > ((SIZE_MAX - sizeof(Logger_BacktraceBuffer_t)) / slotSize)) {
+        return NULL;
+    }
+
+    backtrace = MDN_MW_malloc(sizeof(*backtrace));
+    if (backtrace == NULL) {
+        return NULL;
+    }
+#if (defined __APPLE__) || (defined __linux__)
+    if (pthread_key_create(&backtrace->threadBufferKey, mdn_Logger_Backtrace_onThreadExit) != 0) {
+        free(backtrace);
+        return NULL;
+    }
+#elif defined _WIN32
+    backtrace->threadBufferKey = FlsAlloc(mdn_Logger_Backtrace_onThreadExit);
+    if (backtrace->threadBufferKey == FLS_OUT_OF_INDEXES) {
+        free(backtrace);
+        return NULL;
+    }
+#endif  // OS
+    backtrace->recordsCount  = recordsCount;
+    backtrace->maxMessageLen = maxMessageLen;
+    backtrace->slotSize      = slotSize;
+    // Starting from 1, as threads that never attached have a generation of 0
+    backtrace->generation = ++g_Logger_backtraceGeneration;
+    if (backtrace->generation == 0) {
+        backtrace->generation = ++g_Logger_backtraceGeneration;
+    }
+    atomic_init(&backtrace->buffersList, NULL);
+
+    return backtrace;
+}
+
+void mdn_Logger_Backtrace_destroy(Logger_Backtrace_t *backtrace) {
+    Logger_BacktraceBuffer_t *buffer;
+    Logger_BacktraceBuffer_t *nextBuffer;
+
+    if (backtrace == NULL) {
+        return;
+    }
+#if (defined __APPLE__) || (defined __linux__)
+    (void)pthread_key_delete(backtrace->threadBufferKey);
+#elif defined _WIN32
+    (void)FlsFree(backtrace->threadBufferKey);
+#endif  // OS
+    buffer = atomic_load_explicit(&backtrace->buffersList, memory_order_acquire);
+    while (buffer != NULL) {
+        nextBuffer = buffer->next;
+        free(buffer);
+        buffer = nextBuffer;
+    }
+    free(backtrace);
+}
+
+static Logger_BacktraceBuffer_t *mdn_Logger_Backtrace_attachThread(Logger_Backtrace_t *backtrace) {
+    Logger_BacktraceBuffer_t *buffer;
+    bool                      inUse;
+
+    for (buffer = atomic_load_explicit(&backtrace->buffersList, memory_order_acquire); buffer != NULL; buffer = buffer->next) {
+        inUse = false;
+        if (atomic_compare_exchange_strong_explicit(&buffer->inUse, &inUse, true, memory_order_acquire, memory_order_relaxed)) {
+            break;
+        }
+    }
+    if (buffer == NULL) {
+        buffer = MDN_MW_malloc(sizeof(*buffer) + (backtrace->recordsCount * backtrace->slotSize));
+        if (buffer == NULL) {
+            return NULL;
+        }
+        atomic_init(&buffer->inUse, true);
+        buffer->next = atomic_load_explicit(&backtrace->buffersList, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&backtrace->buffersList, &buffer->next, buffer, memory_order_release, memory_order_relaxed)) {
+        }
+    }
+    // What the previous thread held back isn't this one's history
+    buffer->oldestIdx = 0;
+    buffer->len       = 0;
+
+    // Should this fail, the buffer just stays with the thread after it exits
+#if (defined __APPLE__) || (defined __linux__)
+    (void)pthread_setspecific(backtrace->threadBufferKey, buffer);
+#elif defined _WIN32
+    (void)FlsSetValue(backtrace->threadBufferKey, buffer);
+#endif  // OS
+    g_Logger_threadBacktraceBuffer     = buffer;
+    g_Logger_threadBacktraceGeneration = backtrace->generation;
+
+    return buffer;
+}
+
+// NULL if the calling thread has yet to hold a record back
+static Logger_BacktraceBuffer_t *mdn_Logger_Backtrace_getThreadBuffer(const Logger_Backtrace_t *backtrace) {
+    return (g_Logger_threadBacktraceGeneration == backtrace->generation) ? g_Logger_threadBacktraceBuffer : NULL;
+}
+
+static Logger_BacktraceSlot_t *mdn_Logger_Backtrace_slot(const Logger_Backtrace_t *backtrace, Logger_BacktraceBuffer_t *buffer, size_t pos) {
+    return (Logger_BacktraceSlot_t *)(void *)&buffer->slots[((buffer->oldestIdx + pos) % backtrace->recordsCount) * backtrace->slotSize];
+}
+
+void mdn_Logger_Backtrace_hold(Logger_Backtrace_t *backtrace, const Logger_Record_t *record, const char *message, const char *format, va_list args) {
+    Logger_BacktraceBuffer_t *buffer;
+    Logger_BacktraceSlot_t   *slot;
+    Logger_LineBuffer_t       messageBuffer;
+    va_list                   argsCopy;
+
+    buffer = mdn_Logger_Backtrace_getThreadBuffer(backtrace);
+    if (buffer == NULL) {
+        buffer = mdn_Logger_Backtrace_attachThread(backtrace);
+        if (buffer == NULL) {
+            return;
+        }
+    }
+
+    if (buffer->len < backtrace->recordsCount) {
+        slot = mdn_Logger_Backtrace_slot(backtrace, buffer, buffer->len);
+        ++buffer->len;
+    } else {
+        slot              = mdn_Logger_Backtrace_slot(backtrace, buffer, 0);
+        buffer->oldestIdx = (buffer->oldestIdx + 1) % backtrace->recordsCount;
+    }
+
+    slot->record = *record;
+    if (message != NULL) {
+        slot->record.messageLen = (record->messageLen < backtrace->maxMessageLen) ? record->messageLen : backtrace->maxMessageLen;
+        memcpy(slot->message, message, slot->record.messageLen);
+    } else {
+        // Same as the async queue: formatted straight into the slot, a longer message goes through the heap before being cut
+        mdn_Logger_LineBuffer_init(&messageBuffer, slot->message, backtrace->maxMessageLen + 1);
+        va_copy(argsCopy, args);
+        mdn_Logger_FastPrintf_appendFormatV(&messageBuffer, format, argsCopy);
+        va_end(argsCopy);
+        slot->record.messageLen = (messageBuffer.len < backtrace->maxMessageLen) ? messageBuffer.len : backtrace->maxMessageLen;
+        if (messageBuffer.heapData != NULL) {
+            memcpy(slot->message, messageBuffer.heapData, slot->record.messageLen);
+            mdn_Logger_LineBuffer_release(&messageBuffer);
+        }
+    }
+    slot->message[slot->record.messageLen] = '\0';
+}
+
+mdn_Logger_loggingLevel_t mdn_Logger_Backtrace_minLevel(const Logger_Backtrace_t *backtrace) {
+    Logger_BacktraceBuffer_t *buffer   = mdn_Logger_Backtrace_getThreadBuffer(backtrace);
+    mdn_Logger_loggingLevel_t minLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
+
+    for (size_t pos = 0; (buffer != NULL) && (pos < buffer->len); ++pos) {
+        if (mdn_Logger_Backtrace_slot(backtrace, buffer, pos)->record.loggingLevel < minLevel) {
+            minLevel = mdn_Logger_Backtrace_slot(backtrace, buffer, pos)->record.loggingLevel;
+        }
+    }
+
+    return minLevel;
+}
+
+void mdn_Logger_Backtrace_flush(const Logger_Backtrace_t *backtrace, Logger_BacktraceFunc_t func, void *arg) {
+    Logger_BacktraceBuffer_t *buffer = mdn_Logger_Backtrace_getThreadBuffer(backtrace);
+    Logger_BacktraceSlot_t   *slot;
+
+    if (buffer == NULL) {
+        return;
+    }
+    for (size_t pos = 0; pos < buffer->len; ++pos) {
+        slot = mdn_Logger_Backtrace_slot(backtrace, buffer, pos);
+        func(&slot->record, slot->message, arg);
+    }
+    buffer->oldestIdx = 0;
+    buffer->len       = 0;
+}
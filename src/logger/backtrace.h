@@ -0,0 +1,30 @@
+#ifndef LOGGER_BACKTRACE_H
+#define LOGGER_BACKTRACE_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+#include "logger_internal.h"
+#include "mdn/logger.h"
+
+typedef struct Logger_Backtrace_t_ Logger_Backtrace_t;
+
+// Called on a record held back, with its message of record->messageLen bytes, null-terminated
+typedef void (*Logger_BacktraceFunc_t)(const Logger_Record_t *record, const char *message, void *arg);
+
+Logger_Backtrace_t *mdn_Logger_Backtrace_create(size_t recordsCount, size_t maxMessageLen);
+
+// Once no thread can be logging anymore. What threads held back is dropped.
+void mdn_Logger_Backtrace_destroy(Logger_Backtrace_t *backtrace);
+
+// Keeps a copy of the record, its message formatted (without consuming 'args'), in place of the oldest one the calling thread
+// holds back once it holds 'recordsCount'. Records of a thread whose buffer can't be allocated aren't held back.
+void mdn_Logger_Backtrace_hold(Logger_Backtrace_t *backtrace, const Logger_Record_t *record, const char *message, const char *format, va_list args);
+
+// Lowest level of the records the calling thread holds back, MDN_LOGGER_LOGGING_LEVEL_COUNT when there is none
+mdn_Logger_loggingLevel_t mdn_Logger_Backtrace_minLevel(const Logger_Backtrace_t *backtrace);
+
+// Calls 'func' on the records the calling thread holds back, oldest first, then forgets them
+void mdn_Logger_Backtrace_flush(const Logger_Backtrace_t *backtrace, Logger_BacktraceFunc_t func, void *arg);
+
+#endif  // LOGGER_BACKTRACE_H
@@ -0,0 +1,999 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "binary_format.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fast_printf.h"
+#include "mdn/mock_wrapper.h"
+#include "text_format.h"
+#include "thread.h"
+
+#ifdef MDN_LOGGER_SAFE_MODE
+# define IS_VALID_STREAM(stream) ((stream) != NULL)
+#endif  // MDN_LOGGER_SAFE_MODE
+
+#define SITE_STATE_EMPTY              0
+#define SITE_STATE_REGISTERING        1
+#define SITE_STATE_READY              2
+#define SITES_HASH_MULTIPLIER         UINT64_C(0x9E3779B97F4A7C15)
+#define SITES_HASH_SHIFT              32
+#define CONVERSION_MAX_LEN            32                          // Longer conversions (absurd widths) are not encoded
+#define CONVERSION_SPEC_BUFFER_LEN    (CONVERSION_MAX_LEN + 2 * 24)  // Room for both '*' replaced by their values
+#define NULL_STRING_LEN               UINT32_MAX
+#define LEVEL_BITS                    4
+#define LEVEL_MASK                    0x0FU
+#define BYTE_BITS                     8
+#define BYTE_MASK                     0xFFU
+#define DECIMAL_BASE                  10
+#define NSEC_PER_SEC                  1000000000U
+#define SITE_DESCRIPTION_STORAGE_SIZE 256
+#define DECODE_LINE_STORAGE_SIZE      1024
+
+typedef enum Logger_BinaryArgType_t_ {
+    BINARY_ARG_TYPE_NONE,  // "%%"
+    BINARY_ARG_TYPE_SIGNED,
+    BINARY_ARG_TYPE_UNSIGNED,
+    BINARY_ARG_TYPE_DOUBLE,
+    BINARY_ARG_TYPE_STRING,
+    BINARY_ARG_TYPE_POINTER,
+    BINARY_ARG_TYPE_UNSUPPORTED,
+} Logger_BinaryArgType_t;
+
+typedef enum Logger_BinaryLength_t_ {
+    BINARY_LENGTH_DEFAULT,
+    BINARY_LENGTH_HH,
+    BINARY_LENGTH_H,
+    BINARY_LENGTH_L,
+    BINARY_LENGTH_LL,
+    BINARY_LENGTH_J,
+    BINARY_LENGTH_Z,
+    BINARY_LENGTH_T,
+    BINARY_LENGTH_LONG_DOUBLE,
+} Logger_BinaryLength_t;
+
+typedef struct Logger_BinaryConversion_t_ {
+    const char            *begin;  // The '%'
+    const char            *end;    // Past the conversion specifier
+    bool                   widthFromArg;
+    bool                   precisionFromArg;
+    int                    precision;  // -1 unless given in the format itself
+    Logger_BinaryLength_t  length;
+    Logger_BinaryArgType_t argType;
+} Logger_BinaryConversion_t;
+
+static bool mdn_Logger_BinaryFormat_isDigit(char chr) {
+    return ('0' <= chr) && (chr <= '9');
+}
+
+static const char *mdn_Logger_BinaryFormat_parseLength(const char *pos, Logger_BinaryLength_t *length) {
+    switch (*pos) {
+        case 'h':
+            *length = (pos[1] == 'h') ? BINARY_LENGTH_HH : BINARY_LENGTH_H;
+            return pos + ((pos[1] == 'h') ? 2 : 1);
+        case 'l':
+            *length = (pos[1] == 'l') ? BINARY_LENGTH_LL : BINARY_LENGTH_L;
+            return pos + ((pos[1] == 'l') ? 2 : 1);
+        case 'j':
+            *length = BINARY_LENGTH_J;
+            return pos + 1;
+        case 'z':
+            *length = BINARY_LENGTH_Z;
+            return pos + 1;
+        case 't':
+            *length = BINARY_LENGTH_T;
+            return pos + 1;
+        case 'L':
+            *length = BINARY_LENGTH_LONG_DOUBLE;
+            return pos + 1;
+        default:
+            *length = BINARY_LENGTH_DEFAULT;
+            return pos;
+    }
+}
+
+static Logger_BinaryArgType_t mdn_Logger_BinaryFormat_argType(char specifier, Logger_BinaryLength_t length) {
+    switch (specifier) {
+        case 'd':
+        case 'i':
+            return (length == BINARY_LENGTH_LONG_DOUBLE) ? BINARY_ARG_TYPE_UNSUPPORTED : BINARY_ARG_TYPE_SIGNED;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            return (length == BINARY_LENGTH_LONG_DOUBLE) ? BINARY_ARG_TYPE_UNSUPPORTED : BINARY_ARG_TYPE_UNSIGNED;
+        case 'c':
+            return (length == BINARY_LENGTH_DEFAULT) ? BINARY_ARG_TYPE_SIGNED : BINARY_ARG_TYPE_UNSUPPORTED;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            return ((length == BINARY_LENGTH_DEFAULT) || (length == BINARY_LENGTH_L) || (length == BINARY_LENGTH_LONG_DOUBLE)) ? BINARY_ARG_TYPE_DOUBLE : BINARY_ARG_TYPE_UNSUPPORTED;
+        case 's':
+            return (length == BINARY_LENGTH_DEFAULT) ? BINARY_ARG_TYPE_STRING : BINARY_ARG_TYPE_UNSUPPORTED;
+        case 'p':
+            return (length == BINARY_LENGTH_DEFAULT) ? BINARY_ARG_TYPE_POINTER : BINARY_ARG_TYPE_UNSUPPORTED;
+        default:  // Including "%n", wide characters and strings, and positional arguments
+            return BINARY_ARG_TYPE_UNSUPPORTED;
+    }
+}
+
+// Finds the next conversion in 'format', returns false if there is none
+static bool mdn_Logger_BinaryFormat_nextConversion(const char *format, Logger_BinaryConversion_t *conversion) {
+    const char *pos = strchr(format, '%');
+
+    if (pos == NULL) {
+        return false;
+    }
+    *conversion = (Logger_BinaryConversion_t){
+        .begin            = pos,
+        .end              = NULL,
+        .widthFromArg     = false,
+        .precisionFromArg = false,
+        .precision        = -1,
+        .length           = BINARY_LENGTH_DEFAULT,
+        .argType          = BINARY_ARG_TYPE_UNSUPPORTED,
+    };
+    ++pos;
+    if (*pos == '%') {
+        conversion->end     = pos + 1;
+        conversion->argType = BINARY_ARG_TYPE_NONE;
+        return true;
+    }
+
+    while ((*pos != '\0') && (strchr("-+ #0", *pos) != NULL)) {
+        ++pos;
+    }
+    if (*pos == '*') {
+        conversion->widthFromArg = true;
+        ++pos;
+    } else {
+        while (mdn_Logger_BinaryFormat_isDigit(*pos)) {
+            ++pos;
+        }
+    }
+    if (*pos == '.') {
+        ++pos;
+        if (*pos == '*') {
+            conversion->precisionFromArg = true;
+            ++pos;
+        } else {
+            conversion->precision = 0;
+            while (mdn_Logger_BinaryFormat_isDigit(*pos)) {
+                if (conversion->precision < (INT_MAX / DECIMAL_BASE)) {
+                    conversion->precision = (conversion->precision * DECIMAL_BASE) + (*pos - '0');
+                }
+                ++pos;
+            }
+        }
+    }
+    pos                 = mdn_Logger_BinaryFormat_parseLength(pos, &conversion->length);
+    conversion->argType = mdn_Logger_BinaryFormat_argType(*pos, conversion->length);
+    conversion->end     = (*pos == '\0') ? pos : (pos + 1);
+    if ((size_t)(conversion->end - conversion->begin) > CONVERSION_MAX_LEN) {
+        conversion->argType = BINARY_ARG_TYPE_UNSUPPORTED;
+    }
+
+    return true;
+}
+
+static bool mdn_Logger_BinaryFormat_isEncodable(const char *format) {
+    Logger_BinaryConversion_t conversion;
+
+    while (mdn_Logger_BinaryFormat_nextConversion(format, &conversion)) {
+        if (conversion.argType == BINARY_ARG_TYPE_UNSUPPORTED) {
+            return false;
+        }
+        format = conversion.end;
+    }
+
+    return true;
+}
+
+static void mdn_Logger_BinaryFormat_appendU8(Logger_LineBuffer_t *lineBuffer, uint8_t value) {
+    char byte = (char)value;
+
+    mdn_Logger_LineBuffer_append(lineBuffer, &byte, 1);
+}
+
+static void mdn_Logger_BinaryFormat_storeU32(char *bytes, uint32_t value) {
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        bytes[idx] = (char)((value >> (idx * BYTE_BITS)) & BYTE_MASK);
+    }
+}
+
+static void mdn_Logger_BinaryFormat_appendU32(Logger_LineBuffer_t *lineBuffer, uint32_t value) {
+    char bytes[sizeof(value)];
+
+    mdn_Logger_BinaryFormat_storeU32(bytes, value);
+    mdn_Logger_LineBuffer_append(lineBuffer, bytes, sizeof(bytes));
+}
+
+static void mdn_Logger_BinaryFormat_appendU64(Logger_LineBuffer_t *lineBuffer, uint64_t value) {
+    char bytes[sizeof(value)];
+
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        bytes[idx] = (char)((value >> (idx * BYTE_BITS)) & BYTE_MASK);
+    }
+    mdn_Logger_LineBuffer_append(lineBuffer, bytes, sizeof(bytes));
+}
+
+static void mdn_Logger_BinaryFormat_appendString(Logger_LineBuffer_t *lineBuffer, const char *str, size_t strLen) {
+    if (strLen >= NULL_STRING_LEN) {
+        strLen = NULL_STRING_LEN - 1;
+    }
+    mdn_Logger_BinaryFormat_appendU32(lineBuffer, (uint32_t)strLen);
+    mdn_Logger_LineBuffer_append(lineBuffer, str, strLen);
+    mdn_Logger_BinaryFormat_appendU8(lineBuffer, '\0');
+}
+
+// Writes a u32 in place of the one reserved at 'offset'
+static void mdn_Logger_BinaryFormat_patchU32(Logger_LineBuffer_t *lineBuffer, size_t offset, uint32_t value) {
+    if (!lineBuffer->truncated) {
+        mdn_Logger_BinaryFormat_storeU32(lineBuffer->data + offset, value);
+    }
+}
+
+static uint8_t mdn_Logger_BinaryFormat_levelAndPrecision(mdn_Logger_loggingLevel_t loggingLevel, mdn_Logger_timestampPrecision_t timestampPrecision) {
+    return (uint8_t)((unsigned)loggingLevel | ((unsigned)timestampPrecision << LEVEL_BITS));
+}
+
+static void mdn_Logger_BinaryFormat_appendRecordHead(Logger_LineBuffer_t *lineBuffer, const Logger_Record_t *record, mdn_Logger_timestampPrecision_t timestampPrecision) {
+    mdn_Logger_BinaryFormat_appendU8(lineBuffer, mdn_Logger_BinaryFormat_levelAndPrecision(record->loggingLevel, timestampPrecision));
+    mdn_Logger_BinaryFormat_appendU64(lineBuffer, (uint64_t)record->timestamp.sec);
+    mdn_Logger_BinaryFormat_appendU32(lineBuffer, (uint32_t)record->timestamp.nsec);
+}
+
+static bool mdn_Logger_BinaryFormat_writeSite(const Logger_BinarySites_t *sites, size_t siteId, const Logger_BinarySite_t *site) {
+    char                storage[SITE_DESCRIPTION_STORAGE_SIZE];
+    Logger_LineBuffer_t lineBuffer;
+    bool                written = false;
+
+    mdn_Logger_LineBuffer_init(&lineBuffer, storage, sizeof(storage));
+    mdn_Logger_BinaryFormat_appendU8(&lineBuffer, LOGGER_BINARY_TAG_SITE);
+    mdn_Logger_BinaryFormat_appendU32(&lineBuffer, (uint32_t)siteId);
+    mdn_Logger_BinaryFormat_appendU32(&lineBuffer, (uint32_t)site->line);
+    mdn_Logger_BinaryFormat_appendString(&lineBuffer, site->file, strlen(site->file));
+    mdn_Logger_BinaryFormat_appendString(&lineBuffer, site->funcName, strlen(site->funcName));
+    mdn_Logger_BinaryFormat_appendString(&lineBuffer, site->format, strlen(site->format));
+    if (!lineBuffer.truncated) {
+        written = sites->siteSinkOps->write(sites->siteSinkContext, lineBuffer.data, lineBuffer.len);
+    }
+    mdn_Logger_LineBuffer_release(&lineBuffer);
+
+    return written;
+}
+
+Logger_BinarySites_t *mdn_Logger_BinarySites_create(const Logger_SinkOps_t *siteSinkOps, void *siteSinkContext) {
+    Logger_BinarySites_t *sites;
+
+    sites = MDN_MW_malloc(sizeof(*sites));
+    if (sites == NULL) {
+        return NULL;
+    }
+    sites->siteSinkOps     = siteSinkOps;
+    sites->siteSinkContext = siteSinkContext;
+    for (size_t idx = 0; idx < LOGGER_BINARY_SITES_CAPACITY; ++idx) {
+        atomic_init(&sites->sitesArr[idx].state, SITE_STATE_EMPTY);
+    }
+
+    return sites;
+}
+
+void mdn_Logger_BinarySites_destroy(Logger_BinarySites_t *sites) {
+    free(sites);
+}
+
+// The address of a call site defined by the logging macros stands for its file and line. The format and function name
+// still tell its records apart, since they are passed with each record (and records that went through the async queue
+// come preformatted).
+static size_t mdn_Logger_BinarySites_hash(const Logger_Record_t *record, const char *format) {
+    uint64_t hash;
+
+    if (record->callSite != NULL) {
+        hash = (uint64_t)(uintptr_t)record->callSite;
+    } else {
+        hash = (uint64_t)(uintptr_t)record->file;
+        hash = (hash * SITES_HASH_MULTIPLIER) ^ (uint64_t)(unsigned)record->line;
+    }
+    hash = (hash * SITES_HASH_MULTIPLIER) ^ (uint64_t)(uintptr_t)format;
+    hash = (hash * SITES_HASH_MULTIPLIER) ^ (uint64_t)(uintptr_t)record->funcName;
+    hash = hash * SITES_HASH_MULTIPLIER;
+
+    return (size_t)(hash >> SITES_HASH_SHIFT) & (LOGGER_BINARY_SITES_CAPACITY - 1);
+}
+
+static bool mdn_Logger_BinarySites_matches(const Logger_BinarySite_t *site, const Logger_Record_t *record, const char *format) {
+    if ((site->callSite != record->callSite) || (site->format != format) || (site->funcName != record->funcName)) {
+        return false;
+    }
+    return (record->callSite != NULL) || ((site->file == record->file) && (site->line == record->line));
+}
+
+// Returns NULL if the call site isn't in the table, and the table is full
+static Logger_BinarySite_t *mdn_Logger_BinarySites_lookup(Logger_BinarySites_t *sites, const Logger_Record_t *record, const char *format, size_t *siteId) {
+    Logger_BinarySite_t *site;
+    size_t               idx = mdn_Logger_BinarySites_hash(record, format);
+    int                  state;
+
+    for (size_t probe = 0; probe < LOGGER_BINARY_SITES_CAPACITY; ++probe, idx = (idx + 1) & (LOGGER_BINARY_SITES_CAPACITY - 1)) {
+        site  = &sites->sitesArr[idx];
+        state = atomic_load_explicit(&site->state, memory_order_acquire);
+        if ((state == SITE_STATE_EMPTY) &&
+            atomic_compare_exchange_strong_explicit(&site->state, &state, SITE_STATE_REGISTERING, memory_order_acquire, memory_order_acquire)) {
+            site->callSite  = record->callSite;
+            site->format    = format;
+            site->file      = record->file;
+            site->funcName  = record->funcName;
+            site->line      = record->line;
+            // Written before the site is published, so that no record of it can precede its description
+            site->encodable = mdn_Logger_BinaryFormat_isEncodable(format) && mdn_Logger_BinaryFormat_writeSite(sites, idx, site);
+            atomic_store_explicit(&site->state, SITE_STATE_READY, memory_order_release);
+            *siteId = idx;
+            return site;
+        }
+        while (state == SITE_STATE_REGISTERING) {
+            mdn_Logger_Thread_yield();
+            state = atomic_load_explicit(&site->state, memory_order_acquire);
+        }
+        if (mdn_Logger_BinarySites_matches(site, record, format)) {
+            *siteId = idx;
+            return site;
+        }
+    }
+
+    return NULL;
+}
+
+static int64_t mdn_Logger_BinaryFormat_readSigned(Logger_BinaryLength_t length, va_list *args) {
+    switch (length) {
+        case BINARY_LENGTH_L:
+            return (int64_t)va_arg(*args, long);
+        case BINARY_LENGTH_LL:
+            return (int64_t)va_arg(*args, long long);
+        case BINARY_LENGTH_J:
+            return (int64_t)va_arg(*args, intmax_t);
+        case BINARY_LENGTH_Z:
+            return (int64_t)va_arg(*args, size_t);  // Same size as its signed counterpart
+        case BINARY_LENGTH_T:
+            return (int64_t)va_arg(*args, ptrdiff_t);
+        default:  // char and short are promoted to int
+            return (int64_t)va_arg(*args, int);
+    }
+}
+
+static uint64_t mdn_Logger_BinaryFormat_readUnsigned(Logger_BinaryLength_t length, va_list *args) {
+    switch (length) {
+        case BINARY_LENGTH_L:
+            return (uint64_t)va_arg(*args, unsigned long);
+        case BINARY_LENGTH_LL:
+            return (uint64_t)va_arg(*args, unsigned long long);
+        case BINARY_LENGTH_J:
+            return (uint64_t)va_arg(*args, uintmax_t);
+        case BINARY_LENGTH_Z:
+            return (uint64_t)va_arg(*args, size_t);
+        case BINARY_LENGTH_T:
+            return (uint64_t)va_arg(*args, ptrdiff_t);
+        default:
+            return (uint64_t)va_arg(*args, unsigned int);
+    }
+}
+
+static void mdn_Logger_BinaryFormat_appendDouble(Logger_LineBuffer_t *lineBuffer, double value) {
+    uint64_t bits;
+
+    _Static_assert(sizeof(bits) == sizeof(value), "Error: double is expected to be 64 bits");
+    memcpy(&bits, &value, sizeof(bits));
+    mdn_Logger_BinaryFormat_appendU64(lineBuffer, bits);
+}
+
+static void mdn_Logger_BinaryFormat_appendArgString(Logger_LineBuffer_t *lineBuffer, const char *str, int precision) {
+    size_t strLen = 0;
+
+    if (str == NULL) {
+        mdn_Logger_BinaryFormat_appendU32(lineBuffer, NULL_STRING_LEN);
+        return;
+    }
+    // With a precision, the string doesn't have to be null-terminated
+    while (((precision < 0) || (strLen < (size_t)precision)) && (str[strLen] != '\0')) {
+        ++strLen;
+    }
+    mdn_Logger_BinaryFormat_appendString(lineBuffer, str, strLen);
+}
+
+static void mdn_Logger_BinaryFormat_appendArgs(Logger_LineBuffer_t *lineBuffer, const char *format, va_list *args) {
+    Logger_BinaryConversion_t conversion;
+    int                       precision;
+
+    while (mdn_Logger_BinaryFormat_nextConversion(format, &conversion)) {
+        format    = conversion.end;
+        precision = conversion.precision;
+        if (conversion.widthFromArg) {
+            mdn_Logger_BinaryFormat_appendU64(lineBuffer, (uint64_t)(int64_t)va_arg(*args, int));
+        }
+        if (conversion.precisionFromArg) {
+            precision = va_arg(*args, int);
+            mdn_Logger_BinaryFormat_appendU64(lineBuffer, (uint64_t)(int64_t)precision);
+        }
+        switch (conversion.argType) {
+            case BINARY_ARG_TYPE_SIGNED:
+                mdn_Logger_BinaryFormat_appendU64(lineBuffer, (uint64_t)mdn_Logger_BinaryFormat_readSigned(conversion.length, args));
+                break;
+            case BINARY_ARG_TYPE_UNSIGNED:
+                mdn_Logger_BinaryFormat_appendU64(lineBuffer, mdn_Logger_BinaryFormat_readUnsigned(conversion.length, args));
+                break;
+            case BINARY_ARG_TYPE_DOUBLE:
+                if (conversion.length == BINARY_LENGTH_LONG_DOUBLE) {
+                    mdn_Logger_BinaryFormat_appendDouble(lineBuffer, (double)va_arg(*args, long double));
+                } else {
+                    mdn_Logger_BinaryFormat_appendDouble(lineBuffer, va_arg(*args, double));
+                }
+                break;
+            case BINARY_ARG_TYPE_STRING:
+                mdn_Logger_BinaryFormat_appendArgString(lineBuffer, va_arg(*args, const char *), precision);
+                break;
+            case BINARY_ARG_TYPE_POINTER:
+                mdn_Logger_BinaryFormat_appendU64(lineBuffer, (uint64_t)(uintptr_t)va_arg(*args, void *));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static void mdn_Logger_BinaryFormat_renderRecord(Logger_LineBuffer_t *lineBuffer, size_t siteId, const Logger_Record_t *record,
+                                                 mdn_Logger_timestampPrecision_t timestampPrecision, const char *format, va_list args) {
+    va_list argsCopy;
+    size_t  argsLenOffset;
+
+    mdn_Logger_BinaryFormat_appendU8(lineBuffer, LOGGER_BINARY_TAG_RECORD);
+    mdn_Logger_BinaryFormat_appendU32(lineBuffer, (uint32_t)siteId);
+    mdn_Logger_BinaryFormat_appendRecordHead(lineBuffer, record, timestampPrecision);
+    argsLenOffset = lineBuffer->len;
+    mdn_Logger_BinaryFormat_appendU32(lineBuffer, 0);
+
+    va_copy(argsCopy, args);
+    mdn_Logger_BinaryFormat_appendArgs(lineBuffer, format, &argsCopy);
+    va_end(argsCopy);
+    mdn_Logger_BinaryFormat_patchU32(lineBuffer, argsLenOffset, (uint32_t)(lineBuffer->len - argsLenOffset - sizeof(uint32_t)));
+}
+
+static void mdn_Logger_BinaryFormat_renderText(Logger_LineBuffer_t *lineBuffer, const Logger_Record_t *record,
+                                               mdn_Logger_timestampPrecision_t timestampPrecision, const char *format, va_list args) {
+    size_t messageLenOffset;
+
+    mdn_Logger_BinaryFormat_appendU8(lineBuffer, LOGGER_BINARY_TAG_TEXT);
+    mdn_Logger_BinaryFormat_appendRecordHead(lineBuffer, record, timestampPrecision);
+    mdn_Logger_BinaryFormat_appendString(lineBuffer, record->file, strlen(record->file));
+    mdn_Logger_BinaryFormat_appendU32(lineBuffer, (uint32_t)record->line);
+    mdn_Logger_BinaryFormat_appendString(lineBuffer, record->funcName, strlen(record->funcName));
+    messageLenOffset = lineBuffer->len;
+    mdn_Logger_BinaryFormat_appendU32(lineBuffer, 0);
+    mdn_Logger_FastPrintf_appendFormatV(lineBuffer, format, args);
+    mdn_Logger_BinaryFormat_patchU32(lineBuffer, messageLenOffset, (uint32_t)(lineBuffer->len - messageLenOffset - sizeof(uint32_t)));
+    mdn_Logger_BinaryFormat_appendU8(lineBuffer, '\0');
+}
+
+void mdn_Logger_BinaryFormat_writeHeader(const Logger_SinkOps_t *sinkOps, void *sinkContext) {
+    static const char header[] = LOGGER_BINARY_FORMAT_MAGIC "\x01";
+
+    _Static_assert(LOGGER_BINARY_FORMAT_VERSION == 1, "Error: header is expected to carry the format version");
+    (void)sinkOps->write(sinkContext, header, LOGGER_BINARY_FORMAT_MAGIC_LEN + 1);
+}
+
+void mdn_Logger_BinaryFormat_render(Logger_LineBuffer_t *lineBuffer, Logger_BinarySites_t *sites, const Logger_Record_t *record,
+                                    mdn_Logger_timestampPrecision_t timestampPrecision, const char *format, va_list args) {
+    Logger_BinarySite_t *site;
+    size_t               siteId;
+
+    site = mdn_Logger_BinarySites_lookup(sites, record, format, &siteId);
+    if ((site != NULL) && site->encodable) {
+        mdn_Logger_BinaryFormat_renderRecord(lineBuffer, siteId, record, timestampPrecision, format, args);
+    } else {
+        mdn_Logger_BinaryFormat_renderText(lineBuffer, record, timestampPrecision, format, args);
+    }
+
+    // A partial record would make the rest of the stream unreadable
+    if (lineBuffer->truncated) {
+        lineBuffer->len = 0;
+    }
+}
+
+typedef struct Logger_BinaryDecodedSite_t_ {
+    char *file;
+    char *funcName;
+    char *format;
+    int   line;
+} Logger_BinaryDecodedSite_t;
+
+typedef struct Logger_BinaryDecoder_t_ {
+    FILE                       *binaryStream;
+    FILE                       *textStream;
+    Logger_BinaryDecodedSite_t *sitesArr;  // LOGGER_BINARY_SITES_CAPACITY entries, indexed by site ID
+    unsigned char              *argsBuf;
+    size_t                      argsBufCapacity;
+    char                        lineStorage[DECODE_LINE_STORAGE_SIZE];
+} Logger_BinaryDecoder_t;
+
+typedef struct Logger_BinaryArgsReader_t_ {
+    const unsigned char *data;
+    size_t               len;
+    size_t               pos;
+} Logger_BinaryArgsReader_t;
+
+static uint32_t mdn_Logger_BinaryFormat_loadU32(const unsigned char *bytes) {
+    uint32_t value = 0;
+
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        value |= (uint32_t)bytes[idx] << (idx * BYTE_BITS);
+    }
+
+    return value;
+}
+
+static uint64_t mdn_Logger_BinaryFormat_loadU64(const unsigned char *bytes) {
+    uint64_t value = 0;
+
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        value |= (uint64_t)bytes[idx] << (idx * BYTE_BITS);
+    }
+
+    return value;
+}
+
+static bool mdn_Logger_BinaryFormat_readU8(FILE *stream, uint8_t *value) {
+    return fread(value, 1, 1, stream) == 1;
+}
+
+static bool mdn_Logger_BinaryFormat_readU32(FILE *stream, uint32_t *value) {
+    unsigned char bytes[sizeof(*value)];
+
+    if (fread(bytes, 1, sizeof(bytes), stream) != sizeof(bytes)) {
+        return false;
+    }
+    *value = mdn_Logger_BinaryFormat_loadU32(bytes);
+
+    return true;
+}
+
+static bool mdn_Logger_BinaryFormat_readU64(FILE *stream, uint64_t *value) {
+    unsigned char bytes[sizeof(*value)];
+
+    if (fread(bytes, 1, sizeof(bytes), stream) != sizeof(bytes)) {
+        return false;
+    }
+    *value = mdn_Logger_BinaryFormat_loadU64(bytes);
+
+    return true;
+}
+
+// On success, '*str' is a heap allocation owned by the caller
+static mdn_Status_t mdn_Logger_BinaryFormat_readString(FILE *stream, char **str) {
+    uint32_t strLen;
+
+    if (!mdn_Logger_BinaryFormat_readU32(stream, &strLen) || (strLen == NULL_STRING_LEN)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    *str = MDN_MW_malloc((size_t)strLen + 1);
+    if (*str == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    if ((fread(*str, 1, (size_t)strLen + 1, stream) != ((size_t)strLen + 1)) || ((*str)[strLen] != '\0')) {
+        free(*str);
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+
+    return MDN_STATUS_SUCCESS;
+}
+
+static bool mdn_Logger_BinaryFormat_argsReadU64(Logger_BinaryArgsReader_t *reader, uint64_t *value) {
+    if ((reader->len - reader->pos) < sizeof(*value)) {
+        return false;
+    }
+    *value       = mdn_Logger_BinaryFormat_loadU64(reader->data + reader->pos);
+    reader->pos += sizeof(*value);
+
+    return true;
+}
+
+static bool mdn_Logger_BinaryFormat_argsReadString(Logger_BinaryArgsReader_t *reader, const char **str) {
+    uint32_t strLen;
+
+    if ((reader->len - reader->pos) < sizeof(strLen)) {
+        return false;
+    }
+    strLen       = mdn_Logger_BinaryFormat_loadU32(reader->data + reader->pos);
+    reader->pos += sizeof(strLen);
+    if (strLen == NULL_STRING_LEN) {
+        *str = NULL;
+        return true;
+    }
+    if (((reader->len - reader->pos) <= strLen) || (reader->data[reader->pos + strLen] != '\0')) {
+        return false;
+    }
+    *str         = (const char *)(reader->data + reader->pos);
+    reader->pos += (size_t)strLen + 1;
+
+    return true;
+}
+
+// Rebuilds the conversion with the width and precision that were given as arguments written in
+static bool mdn_Logger_BinaryFormat_buildSpec(const Logger_BinaryConversion_t *conversion, Logger_BinaryArgsReader_t *reader, char *spec) {
+    uint64_t width     = 0;
+    uint64_t precision = 0;
+    size_t   specLen   = 0;
+
+    if (conversion->widthFromArg && !mdn_Logger_BinaryFormat_argsReadU64(reader, &width)) {
+        return false;
+    }
+    if (conversion->precisionFromArg && !mdn_Logger_BinaryFormat_argsReadU64(reader, &precision)) {
+        return false;
+    }
+    for (const char *pos = conversion->begin; pos < conversion->end; ++pos) {
+        if ((pos[0] == '.') && (pos[1] == '*')) {
+            // A negative precision is taken as if it was omitted
+            if ((int)precision >= 0) {
+                specLen += (size_t)snprintf(spec + specLen, CONVERSION_SPEC_BUFFER_LEN - specLen, ".%d", (int)precision);
+            }
+            ++pos;
+        } else if (pos[0] == '*') {
+            specLen += (size_t)snprintf(spec + specLen, CONVERSION_SPEC_BUFFER_LEN - specLen, "%d", (int)width);
+        } else {
+            spec[specLen++] = pos[0];
+        }
+    }
+    spec[specLen] = '\0';
+
+    return true;
+}
+
+static bool mdn_Logger_BinaryFormat_decodeConversion(Logger_LineBuffer_t *lineBuffer, const Logger_BinaryConversion_t *conversion, Logger_BinaryArgsReader_t *reader) {
+    char        spec[CONVERSION_SPEC_BUFFER_LEN];
+    uint64_t    value = 0;
+    double      doubleValue;
+    const char *str;
+
+    if (!mdn_Logger_BinaryFormat_buildSpec(conversion, reader, spec)) {
+        return false;
+    }
+    if ((conversion->argType != BINARY_ARG_TYPE_STRING) && !mdn_Logger_BinaryFormat_argsReadU64(reader, &value)) {
+        return false;
+    }
+
+    switch (conversion->argType) {
+        case BINARY_ARG_TYPE_SIGNED:
+            switch (conversion->length) {
+                case BINARY_LENGTH_L:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (long)(int64_t)value);
+                    break;
+                case BINARY_LENGTH_LL:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (long long)(int64_t)value);
+                    break;
+                case BINARY_LENGTH_J:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (intmax_t)(int64_t)value);
+                    break;
+                case BINARY_LENGTH_Z:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (size_t)value);
+                    break;
+                case BINARY_LENGTH_T:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (ptrdiff_t)(int64_t)value);
+                    break;
+                default:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (int)(int64_t)value);
+                    break;
+            }
+            break;
+        case BINARY_ARG_TYPE_UNSIGNED:
+            switch (conversion->length) {
+                case BINARY_LENGTH_L:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (unsigned long)value);
+                    break;
+                case BINARY_LENGTH_LL:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (unsigned long long)value);
+                    break;
+                case BINARY_LENGTH_J:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (uintmax_t)value);
+                    break;
+                case BINARY_LENGTH_Z:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (size_t)value);
+                    break;
+                case BINARY_LENGTH_T:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (ptrdiff_t)value);
+                    break;
+                default:
+                    mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (unsigned int)value);
+                    break;
+            }
+            break;
+        case BINARY_ARG_TYPE_DOUBLE:
+            memcpy(&doubleValue, &value, sizeof(doubleValue));
+            if (conversion->length == BINARY_LENGTH_LONG_DOUBLE) {
+                mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (long double)doubleValue);
+            } else {
+                mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, doubleValue);
+            }
+            break;
+        case BINARY_ARG_TYPE_STRING:
+            if (!mdn_Logger_BinaryFormat_argsReadString(reader, &str)) {
+                return false;
+            }
+            mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, str);
+            break;
+        case BINARY_ARG_TYPE_POINTER:
+            mdn_Logger_LineBuffer_appendFormat(lineBuffer, spec, (void *)(uintptr_t)value);
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+static bool mdn_Logger_BinaryFormat_decodeMessage(Logger_LineBuffer_t *lineBuffer, const char *format, Logger_BinaryArgsReader_t *reader) {
+    Logger_BinaryConversion_t conversion;
+
+    while (mdn_Logger_BinaryFormat_nextConversion(format, &conversion)) {
+        mdn_Logger_LineBuffer_append(lineBuffer, format, (size_t)(conversion.begin - format));
+        format = conversion.end;
+        if (conversion.argType == BINARY_ARG_TYPE_NONE) {
+            mdn_Logger_LineBuffer_append(lineBuffer, "%", 1);
+        } else if (!mdn_Logger_BinaryFormat_decodeConversion(lineBuffer, &conversion, reader)) {
+            return false;
+        }
+    }
+    mdn_Logger_LineBuffer_appendStr(lineBuffer, format);
+
+    return reader->pos == reader->len;
+}
+
+static void mdn_Logger_BinaryFormat_freeSite(Logger_BinaryDecodedSite_t *site) {
+    free(site->file);
+    free(site->funcName);
+    free(site->format);
+    *site = (Logger_BinaryDecodedSite_t){
+        .file     = NULL,
+        .funcName = NULL,
+        .format   = NULL,
+        .line     = 0,
+    };
+}
+
+static void mdn_Logger_BinaryFormat_freeSites(Logger_BinaryDecoder_t *decoder) {
+    for (size_t idx = 0; idx < LOGGER_BINARY_SITES_CAPACITY; ++idx) {
+        mdn_Logger_BinaryFormat_freeSite(&decoder->sitesArr[idx]);
+    }
+}
+
+static mdn_Status_t mdn_Logger_BinaryFormat_decodeHeader(Logger_BinaryDecoder_t *decoder) {
+    char magic[LOGGER_BINARY_FORMAT_MAGIC_LEN];
+
+    // The tag is the first byte of the magic
+    magic[0] = LOGGER_BINARY_TAG_HEADER;
+    if ((fread(magic + 1, 1, sizeof(magic) - 1, decoder->binaryStream) != (sizeof(magic) - 1)) ||
+        (memcmp(magic, LOGGER_BINARY_FORMAT_MAGIC, sizeof(magic)) != 0) ||
+        (fgetc(decoder->binaryStream) != LOGGER_BINARY_FORMAT_VERSION)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    // Site IDs start over with every stream that was concatenated
+    mdn_Logger_BinaryFormat_freeSites(decoder);
+
+    return MDN_STATUS_SUCCESS;
+}
+
+static mdn_Status_t mdn_Logger_BinaryFormat_decodeSite(Logger_BinaryDecoder_t *decoder) {
+    Logger_BinaryDecodedSite_t site = {
+        .file     = NULL,
+        .funcName = NULL,
+        .format   = NULL,
+        .line     = 0,
+    };
+    uint32_t     siteId;
+    uint32_t     line;
+    mdn_Status_t status;
+
+    if (!mdn_Logger_BinaryFormat_readU32(decoder->binaryStream, &siteId) || (siteId >= LOGGER_BINARY_SITES_CAPACITY) ||
+        !mdn_Logger_BinaryFormat_readU32(decoder->binaryStream, &line) || (line > INT_MAX)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    site.line = (int)line;
+    status    = mdn_Logger_BinaryFormat_readString(decoder->binaryStream, &site.file);
+    if (status == MDN_STATUS_SUCCESS) {
+        status = mdn_Logger_BinaryFormat_readString(decoder->binaryStream, &site.funcName);
+        if (status == MDN_STATUS_SUCCESS) {
+            status = mdn_Logger_BinaryFormat_readString(decoder->binaryStream, &site.format);
+        }
+    }
+    if (status != MDN_STATUS_SUCCESS) {
+        mdn_Logger_BinaryFormat_freeSite(&site);
+        return status;
+    }
+    mdn_Logger_BinaryFormat_freeSite(&decoder->sitesArr[siteId]);
+    decoder->sitesArr[siteId] = site;
+
+    return MDN_STATUS_SUCCESS;
+}
+
+// Reads the level, precision and timestamp common to both kinds of records
+static bool mdn_Logger_BinaryFormat_decodeRecordHead(Logger_BinaryDecoder_t *decoder, Logger_Record_t *record, mdn_Logger_timestampPrecision_t *timestampPrecision) {
+    uint8_t  levelAndPrecision;
+    uint64_t sec;
+    uint32_t nsec;
+
+    if (!mdn_Logger_BinaryFormat_readU8(decoder->binaryStream, &levelAndPrecision) ||
+        !mdn_Logger_BinaryFormat_readU64(decoder->binaryStream, &sec) ||
+        !mdn_Logger_BinaryFormat_readU32(decoder->binaryStream, &nsec)) {
+        return false;
+    }
+    if (((levelAndPrecision & LEVEL_MASK) >= MDN_LOGGER_LOGGING_LEVEL_COUNT) ||
+        ((unsigned)(levelAndPrecision >> LEVEL_BITS) >= MDN_LOGGER_TIMESTAMP_PRECISION_COUNT) ||
+        (nsec >= NSEC_PER_SEC)) {
+        return false;
+    }
+    record->loggingLevel   = (mdn_Logger_loggingLevel_t)(levelAndPrecision & LEVEL_MASK);
+    record->timestamp.sec  = (int64_t)sec;
+    record->timestamp.nsec = (int32_t)nsec;
+    *timestampPrecision    = (mdn_Logger_timestampPrecision_t)(levelAndPrecision >> LEVEL_BITS);
+
+    return true;
+}
+
+static void mdn_Logger_BinaryFormat_writeLine(Logger_BinaryDecoder_t *decoder, Logger_LineBuffer_t *lineBuffer) {
+    mdn_Logger_TextFormat_renderSuffix(lineBuffer, MDN_LOGGER_LOGGING_FORMAT_FILE);
+    (void)fwrite(lineBuffer->data, 1, lineBuffer->len, decoder->textStream);
+    mdn_Logger_LineBuffer_release(lineBuffer);
+}
+
+static mdn_Status_t mdn_Logger_BinaryFormat_decodeRecord(Logger_BinaryDecoder_t *decoder) {
+    Logger_Record_t                 record;
+    mdn_Logger_timestampPrecision_t timestampPrecision;
+    Logger_BinaryDecodedSite_t     *site;
+    uint32_t                        siteId;
+    uint32_t                        argsLen;
+    unsigned char                  *argsBuf;
+    Logger_BinaryArgsReader_t       reader;
+    Logger_LineBuffer_t             lineBuffer;
+
+    if (!mdn_Logger_BinaryFormat_readU32(decoder->binaryStream, &siteId) || (siteId >= LOGGER_BINARY_SITES_CAPACITY) ||
+        !mdn_Logger_BinaryFormat_decodeRecordHead(decoder, &record, &timestampPrecision) ||
+        !mdn_Logger_BinaryFormat_readU32(decoder->binaryStream, &argsLen)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    site = &decoder->sitesArr[siteId];
+    if (site->format == NULL) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (argsLen > decoder->argsBufCapacity) {
+        argsBuf = MDN_MW_realloc(decoder->argsBuf, argsLen);
+        if (argsBuf == NULL) {
+            return MDN_STATUS_ERROR_MEM_ALLOC;
+        }
+        decoder->argsBuf         = argsBuf;
+        decoder->argsBufCapacity = argsLen;
+    }
+    if (fread(decoder->argsBuf, 1, argsLen, decoder->binaryStream) != argsLen) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+
+    record.file     = site->file;
+    record.line     = site->line;
+    record.funcName = site->funcName;
+    reader          = (Logger_BinaryArgsReader_t){
+        .data = decoder->argsBuf,
+        .len  = argsLen,
+        .pos  = 0,
+    };
+    mdn_Logger_LineBuffer_init(&lineBuffer, decoder->lineStorage, sizeof(decoder->lineStorage));
+    mdn_Logger_TextFormat_renderPrefix(&lineBuffer, MDN_LOGGER_LOGGING_FORMAT_FILE, &record, timestampPrecision);
+    if (!mdn_Logger_BinaryFormat_decodeMessage(&lineBuffer, site->format, &reader)) {
+        mdn_Logger_LineBuffer_release(&lineBuffer);
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    mdn_Logger_BinaryFormat_writeLine(decoder, &lineBuffer);
+
+    return MDN_STATUS_SUCCESS;
+}
+
+static mdn_Status_t mdn_Logger_BinaryFormat_decodeText(Logger_BinaryDecoder_t *decoder) {
+    Logger_Record_t                 record;
+    mdn_Logger_timestampPrecision_t timestampPrecision;
+    Logger_BinaryDecodedSite_t      site = {
+        .file     = NULL,
+        .funcName = NULL,
+        .format   = NULL,  // Holds the message
+        .line     = 0,
+    };
+    uint32_t            line;
+    Logger_LineBuffer_t lineBuffer;
+    mdn_Status_t        status;
+
+    if (!mdn_Logger_BinaryFormat_decodeRecordHead(decoder, &record, &timestampPrecision)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    status = mdn_Logger_BinaryFormat_readString(decoder->binaryStream, &site.file);
+    if (status == MDN_STATUS_SUCCESS) {
+        status = (mdn_Logger_BinaryFormat_readU32(decoder->binaryStream, &line) && (line <= INT_MAX)) ? MDN_STATUS_SUCCESS : MDN_STATUS_ERROR_BAD_ARGUMENT;
+        if (status == MDN_STATUS_SUCCESS) {
+            status = mdn_Logger_BinaryFormat_readString(decoder->binaryStream, &site.funcName);
+            if (status == MDN_STATUS_SUCCESS) {
+                status = mdn_Logger_BinaryFormat_readString(decoder->binaryStream, &site.format);
+            }
+        }
+    }
+    if (status == MDN_STATUS_SUCCESS) {
+        record.file     = site.file;
+        record.line     = (int)line;
+        record.funcName = site.funcName;
+        mdn_Logger_LineBuffer_init(&lineBuffer, decoder->lineStorage, sizeof(decoder->lineStorage));
+        mdn_Logger_TextFormat_renderPrefix(&lineBuffer, MDN_LOGGER_LOGGING_FORMAT_FILE, &record, timestampPrecision);
+        mdn_Logger_LineBuffer_appendStr(&lineBuffer, site.format);
+        mdn_Logger_BinaryFormat_writeLine(decoder, &lineBuffer);
+    }
+    mdn_Logger_BinaryFormat_freeSite(&site);
+
+    return status;
+}
+
+mdn_Status_t mdn_Logger_decodeBinary(FILE *binaryStream, FILE *textStream) {
+    Logger_BinaryDecoder_t *decoder;
+    mdn_Status_t            status = MDN_STATUS_SUCCESS;
+    int                     tag;
+    bool                    headerFound = false;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (!IS_VALID_STREAM(binaryStream) || !IS_VALID_STREAM(textStream)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    decoder = MDN_MW_malloc(sizeof(*decoder));
+    if (decoder == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    decoder->sitesArr = MDN_MW_malloc(LOGGER_BINARY_SITES_CAPACITY * sizeof(*(decoder->sitesArr)));
+    if (decoder->sitesArr == NULL) {
+        free(decoder);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    memset(decoder->sitesArr, 0, LOGGER_BINARY_SITES_CAPACITY * sizeof(*(decoder->sitesArr)));
+    decoder->binaryStream    = binaryStream;
+    decoder->textStream      = textStream;
+    decoder->argsBuf         = NULL;
+    decoder->argsBufCapacity = 0;
+
+    while ((status == MDN_STATUS_SUCCESS) && ((tag = fgetc(binaryStream)) != EOF)) {
+        if ((tag != LOGGER_BINARY_TAG_HEADER) && !headerFound) {
+            status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+            break;
+        }
+        switch (tag) {
+            case LOGGER_BINARY_TAG_HEADER:
+                status      = mdn_Logger_BinaryFormat_decodeHeader(decoder);
+                headerFound = true;
+                break;
+            case LOGGER_BINARY_TAG_SITE:
+                status = mdn_Logger_BinaryFormat_decodeSite(decoder);
+                break;
+            case LOGGER_BINARY_TAG_RECORD:
+                status = mdn_Logger_BinaryFormat_decodeRecord(decoder);
+                break;
+            case LOGGER_BINARY_TAG_TEXT:
+                status = mdn_Logger_BinaryFormat_decodeText(decoder);
+                break;
+            default:
+                status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+                break;
+        }
+    }
+
+    mdn_Logger_BinaryFormat_freeSites(decoder);
+    free(decoder->sitesArr);
+    free(decoder->argsBuf);
+    free(decoder);
+
+    return status;
+}
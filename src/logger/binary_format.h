@@ -0,0 +1,64 @@
+#ifndef LOGGER_BINARY_FORMAT_H
+#define LOGGER_BINARY_FORMAT_H
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "line_buffer.h"
+#include "logger_internal.h"
+#include "sink.h"
+
+// Stream layout (all integers little-endian):
+//   header: "MDNLOGB" + version byte, written when the stream is added (may appear again if streams are concatenated)
+//   site:   'S', u32 siteId, u32 line, then file, function and format strings, once per call site
+//   record: 'R', u32 siteId, u8 level | (precision << 4), i64 sec, u32 nsec, u32 argsLen, then the raw arguments
+//   text:   'T', u8 level | (precision << 4), i64 sec, u32 nsec, then file, u32 line, function and message strings,
+//           for call sites whose format can't be encoded, or once the sites table is full
+// Strings are a u32 length followed by the bytes and a null-terminator. Arguments are encoded in the order
+// they are consumed: integers (including '*' width and precision) as 8 bytes, floating point as an 8 bytes double,
+// pointers as 8 bytes, and strings like above (a length of UINT32_MAX stands for NULL).
+#define LOGGER_BINARY_FORMAT_MAGIC     "MDNLOGB"
+#define LOGGER_BINARY_FORMAT_MAGIC_LEN 7
+#define LOGGER_BINARY_FORMAT_VERSION   1
+#define LOGGER_BINARY_SITES_CAPACITY   1024  // Power of two
+
+typedef enum Logger_BinaryTag_t_ {
+    LOGGER_BINARY_TAG_HEADER = 'M',
+    LOGGER_BINARY_TAG_SITE   = 'S',
+    LOGGER_BINARY_TAG_RECORD = 'R',
+    LOGGER_BINARY_TAG_TEXT   = 'T',
+} Logger_BinaryTag_t;
+
+typedef struct Logger_BinarySite_t_ {
+    atomic_int                   state;
+    const mdn_Logger_CallSite_t *callSite;  // NULL for records logged through mdn_Logger_log()
+    const char                  *format;
+    const char                  *file;
+    const char                  *funcName;
+    int                          line;
+    bool                         encodable;  // Whether all of the format's conversions can be encoded
+} Logger_BinarySite_t;
+
+// Call sites already described in a stream, keyed by the addresses of their strings (of their descriptor for the file and line). Lock-free:
+// the first thread to log from a site writes its description, others wait for it to be written.
+typedef struct Logger_BinarySites_t_ {
+    const Logger_SinkOps_t *siteSinkOps;  // Where the descriptions are written, before any record of their site
+    void                   *siteSinkContext;
+    Logger_BinarySite_t     sitesArr[LOGGER_BINARY_SITES_CAPACITY];
+} Logger_BinarySites_t;
+
+Logger_BinarySites_t *mdn_Logger_BinarySites_create(const Logger_SinkOps_t *siteSinkOps, void *siteSinkContext);
+
+void mdn_Logger_BinarySites_destroy(Logger_BinarySites_t *sites);
+
+void mdn_Logger_BinaryFormat_writeHeader(const Logger_SinkOps_t *sinkOps, void *sinkContext);
+
+// Renders a record into 'lineBuffer'. When the call site is new to the stream, its description is written to the sites' sink first,
+// and if that fails its records are rendered as text. Leaves 'lineBuffer' empty if the record couldn't be rendered whole.
+void mdn_Logger_BinaryFormat_render(Logger_LineBuffer_t *lineBuffer, Logger_BinarySites_t *sites, const Logger_Record_t *record,
+                                    mdn_Logger_timestampPrecision_t timestampPrecision, const char *format, va_list args);
+
+#endif  // LOGGER_BINARY_FORMAT_H
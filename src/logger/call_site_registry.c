@@ -0,0 +1,220 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "call_site_registry.h"
+
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mdn/mock_wrapper.h"
+#include "thread.h"
+
+#define LINE_ANY -1
+
+typedef enum Logger_SiteOverride_t_ {
+    SITE_OVERRIDE_NONE,
+    SITE_OVERRIDE_ON,
+    SITE_OVERRIDE_OFF,
+} Logger_SiteOverride_t;
+
+typedef struct Logger_SiteRule_t_ {
+    struct Logger_SiteRule_t_ *next;
+    const char                *fileGlob;
+    const char                *funcGlob;
+    int                        line;  // LINE_ANY unless 'fileGlob' ended with ":<line>"
+    mdn_Logger_loggingLevel_t  loggingLevel;
+    char                       globsStorage[];
+} Logger_SiteRule_t;
+
+typedef struct Logger_CallSiteRegistry_t_ {
+    atomic_flag            lock;
+    mdn_Logger_CallSite_t *callSites;  // Most recently registered first
+    Logger_SiteRule_t     *rulesHead;  // Oldest first, so that later rules are applied last
+    Logger_SiteRule_t     *rulesTail;
+} Logger_CallSiteRegistry_t;
+
+// Statically initialized, since call sites may run before mdn_Logger_init() or after mdn_Logger_deinit()
+static Logger_CallSiteRegistry_t g_Logger_callSiteRegistry = {
+    .lock      = ATOMIC_FLAG_INIT,
+    .callSites = NULL,
+    .rulesHead = NULL,
+    .rulesTail = NULL,
+};
+
+_Static_assert(sizeof(atomic_uint_least32_t) == sizeof(uint32_t), "Error: call site flags can't be updated atomically in place");
+#define CALL_SITE_FLAGS(callSite) ((atomic_uint_least32_t *)&(callSite)->flags)
+
+static void mdn_Logger_CallSiteRegistry_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&g_Logger_callSiteRegistry.lock, memory_order_acquire)) {
+        mdn_Logger_Thread_yield();
+    }
+}
+
+static void mdn_Logger_CallSiteRegistry_unlock(void) {
+    atomic_flag_clear_explicit(&g_Logger_callSiteRegistry.lock, memory_order_release);
+}
+
+// '*' matches any run of characters, '?' any single one
+static bool mdn_Logger_CallSiteRegistry_globMatches(const char *glob, const char *str) {
+    const char *starGlob = NULL;
+    const char *starStr  = NULL;
+
+    while (*str != '\0') {
+        if (*glob == '*') {
+            starGlob = ++glob;
+            starStr  = str;
+        } else if ((*glob == '?') || (*glob == *str)) {
+            ++glob;
+            ++str;
+        } else if (starGlob != NULL) {
+            glob = starGlob;
+            str  = ++starStr;
+        } else {
+            return false;
+        }
+    }
+    while (*glob == '*') {
+        ++glob;
+    }
+    return *glob == '\0';
+}
+
+// Against the whole path, then against what follows each of its separators
+static bool mdn_Logger_CallSiteRegistry_pathMatches(const char *glob, const char *path) {
+    for (const char *suffix = path; *suffix != '\0'; ++suffix) {
+        if (((suffix == path) || (suffix[-1] == '/') || (suffix[-1] == '\\')) && mdn_Logger_CallSiteRegistry_globMatches(glob, suffix)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool mdn_Logger_CallSiteRegistry_ruleMatches(const Logger_SiteRule_t *rule, const mdn_Logger_CallSite_t *callSite) {
+    return ((rule->line == LINE_ANY) || (rule->line == callSite->line)) && mdn_Logger_CallSiteRegistry_pathMatches(rule->fileGlob, callSite->file) &&
+           mdn_Logger_CallSiteRegistry_globMatches(rule->funcGlob, callSite->funcName);
+}
+
+// Called with the registry locked
+static uint32_t mdn_Logger_CallSiteRegistry_computeFlags(const mdn_Logger_CallSite_t *callSite) {
+    Logger_SiteOverride_t siteOverride = SITE_OVERRIDE_NONE;
+
+    for (const Logger_SiteRule_t *rule = g_Logger_callSiteRegistry.rulesHead; rule != NULL; rule = rule->next) {
+        if (mdn_Logger_CallSiteRegistry_ruleMatches(rule, callSite)) {
+            siteOverride = (callSite->loggingLevel >= rule->loggingLevel) ? SITE_OVERRIDE_ON : SITE_OVERRIDE_OFF;
+        }
+    }
+
+    switch (siteOverride) {
+        case SITE_OVERRIDE_ON:
+            return MDN_LOGGER_CALL_SITE_FLAG_REGISTERED | MDN_LOGGER_CALL_SITE_FLAG_ENABLED | LOGGER_CALL_SITE_FLAG_FORCED;
+        case SITE_OVERRIDE_OFF:
+            return MDN_LOGGER_CALL_SITE_FLAG_REGISTERED;
+        default:
+            return MDN_LOGGER_CALL_SITE_FLAG_REGISTERED | (MDN_LOGGER_IS_LEVEL_ENABLED(callSite->loggingLevel) ? MDN_LOGGER_CALL_SITE_FLAG_ENABLED : 0);
+    }
+}
+
+bool mdn_Logger_registerCallSite(mdn_Logger_CallSite_t *callSite) {
+    uint32_t flags;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((callSite == NULL) || (callSite->file == NULL) || (callSite->funcName == NULL)) {
+        return false;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    mdn_Logger_CallSiteRegistry_lock();
+    // Several threads may reach a new call site at once
+    flags = atomic_load_explicit(CALL_SITE_FLAGS(callSite), memory_order_relaxed);
+    if ((flags & MDN_LOGGER_CALL_SITE_FLAG_REGISTERED) == 0) {
+        callSite->next                      = g_Logger_callSiteRegistry.callSites;
+        g_Logger_callSiteRegistry.callSites = callSite;
+        flags                               = mdn_Logger_CallSiteRegistry_computeFlags(callSite);
+        atomic_store_explicit(CALL_SITE_FLAGS(callSite), flags, memory_order_relaxed);
+    }
+    mdn_Logger_CallSiteRegistry_unlock();
+
+    return (flags & MDN_LOGGER_CALL_SITE_FLAG_ENABLED) != 0;
+}
+
+// Splits an optional ":<line>" suffix off 'fileGlob', returns the length of the glob itself
+static size_t mdn_Logger_CallSiteRegistry_parseLine(const char *fileGlob, int *line) {
+    const char *colon = strrchr(fileGlob, ':');
+    long        value = 0;
+
+    *line = LINE_ANY;
+    if ((colon == NULL) || (colon[1] == '\0')) {
+        return strlen(fileGlob);
+    }
+    for (const char *digit = colon + 1; *digit != '\0'; ++digit) {
+        if ((*digit < '0') || (*digit > '9') || (value > INT_MAX / 10)) {
+            return strlen(fileGlob);
+        }
+        value = (value * 10) + (*digit - '0');
+    }
+    *line = (int)value;
+    return (size_t)(colon - fileGlob);
+}
+
+mdn_Status_t mdn_Logger_CallSiteRegistry_addRule(const char *fileGlob, const char *funcGlob, mdn_Logger_loggingLevel_t loggingLevel) {
+    Logger_SiteRule_t *rule;
+    size_t             fileGlobLen, funcGlobLen;
+    int                line;
+
+    fileGlob    = (fileGlob == NULL) ? "*" : fileGlob;
+    funcGlob    = (funcGlob == NULL) ? "*" : funcGlob;
+    fileGlobLen = mdn_Logger_CallSiteRegistry_parseLine(fileGlob, &line);
+    funcGlobLen = strlen(funcGlob);
+
+    rule = MDN_MW_malloc(sizeof(*rule) + fileGlobLen + 1 + funcGlobLen + 1);
+    if (rule == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    memcpy(rule->globsStorage, fileGlob, fileGlobLen);
+    rule->globsStorage[fileGlobLen] = '\0';
+    memcpy(rule->globsStorage + fileGlobLen + 1, funcGlob, funcGlobLen + 1);
+    rule->next         = NULL;
+    rule->fileGlob     = rule->globsStorage;
+    rule->funcGlob     = rule->globsStorage + fileGlobLen + 1;
+    rule->line         = line;
+    rule->loggingLevel = loggingLevel;
+
+    mdn_Logger_CallSiteRegistry_lock();
+    if (g_Logger_callSiteRegistry.rulesTail == NULL) {
+        g_Logger_callSiteRegistry.rulesHead = rule;
+    } else {
+        g_Logger_callSiteRegistry.rulesTail->next = rule;
+    }
+    g_Logger_callSiteRegistry.rulesTail = rule;
+    mdn_Logger_CallSiteRegistry_unlock();
+
+    return MDN_STATUS_SUCCESS;
+}
+
+void mdn_Logger_CallSiteRegistry_clearRules(void) {
+    Logger_SiteRule_t *rule;
+    Logger_SiteRule_t *nextRule;
+
+    mdn_Logger_CallSiteRegistry_lock();
+    rule                                = g_Logger_callSiteRegistry.rulesHead;
+    g_Logger_callSiteRegistry.rulesHead = NULL;
+    g_Logger_callSiteRegistry.rulesTail = NULL;
+    mdn_Logger_CallSiteRegistry_unlock();
+
+    for (; rule != NULL; rule = nextRule) {
+        nextRule = rule->next;
+        free(rule);
+    }
+}
+
+void mdn_Logger_CallSiteRegistry_refresh(void) {
+    mdn_Logger_CallSiteRegistry_lock();
+    for (mdn_Logger_CallSite_t *callSite = g_Logger_callSiteRegistry.callSites; callSite != NULL; callSite = callSite->next) {
+        atomic_store_explicit(CALL_SITE_FLAGS(callSite), mdn_Logger_CallSiteRegistry_computeFlags(callSite), memory_order_relaxed);
+    }
+    mdn_Logger_CallSiteRegistry_unlock();
+}
+
+bool mdn_Logger_CallSiteRegistry_isForced(const mdn_Logger_CallSite_t *callSite) {
+    return (atomic_load_explicit(CALL_SITE_FLAGS(callSite), memory_order_relaxed) & LOGGER_CALL_SITE_FLAG_FORCED) != 0;
+}
@@ -0,0 +1,23 @@
+#ifndef LOGGER_CALL_SITE_REGISTRY_H
+#define LOGGER_CALL_SITE_REGISTRY_H
+
+#include <stdbool.h>
+
+#include "logger_internal.h"
+
+#define LOGGER_CALL_SITE_FLAG_FORCED 0x4U  // Enabled by mdn_Logger_setSiteLevel(), written whatever the streams' levels
+
+// Every call site that ran at least once, and the mdn_Logger_setSiteLevel() rules applied to them.
+// Sites register themselves through mdn_Logger_registerCallSite(); registering and updating take a spinlock,
+// while logging only ever reads the flags of its own call site.
+
+mdn_Status_t mdn_Logger_CallSiteRegistry_addRule(const char *fileGlob, const char *funcGlob, mdn_Logger_loggingLevel_t loggingLevel);
+
+void mdn_Logger_CallSiteRegistry_clearRules(void);
+
+// Recomputes the flags of every registered call site, after the rules or the minimum enabled level changed
+void mdn_Logger_CallSiteRegistry_refresh(void);
+
+bool mdn_Logger_CallSiteRegistry_isForced(const mdn_Logger_CallSite_t *callSite);
+
+#endif  // LOGGER_CALL_SITE_REGISTRY_H
@@ -0,0 +1,49 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "mdn/logger.h"
+#include "mdn/mock_wrapper.h"
+#include "sink.h"
+
+typedef struct Logger_CallbackSink_t_ {
+    mdn_Logger_SinkCallback_t callback;
+    void                     *userData;
+} Logger_CallbackSink_t;
+
+static bool mdn_Logger_CallbackSink_write(void *context, const char *data, size_t len) {
+    const Logger_CallbackSink_t *sink = context;
+
+    return sink->callback(data, len, sink->userData);
+}
+
+static void mdn_Logger_CallbackSink_close(void *context) {
+    free(context);
+}
+
+static const Logger_SinkOps_t g_Logger_CallbackSink_ops = {
+    .write = mdn_Logger_CallbackSink_write,
+    .close = mdn_Logger_CallbackSink_close,
+};
+
+mdn_Status_t mdn_Logger_createCallbackSink(mdn_Logger_Sink_t *sink, mdn_Logger_SinkCallback_t callback, void *userData) {
+    Logger_CallbackSink_t *sinkContext;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((sink == NULL) || (callback == NULL)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    sinkContext = MDN_MW_malloc(sizeof(*sinkContext));
+    if (sinkContext == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    sinkContext->callback = callback;
+    sinkContext->userData = userData;
+    *sink                 = (mdn_Logger_Sink_t){
+        .ops     = &g_Logger_CallbackSink_ops,
+        .context = sinkContext,
+    };
+
+    return MDN_STATUS_SUCCESS;
+}
@@ -0,0 +1,167 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "compressed_format.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mdn/logger.h"
+#include "mdn/mock_wrapper.h"
+
+#ifdef MDN_LOGGER_SAFE_MODE
+# define IS_VALID_STREAM(stream) ((stream) != NULL)
+#endif  // MDN_LOGGER_SAFE_MODE
+
+#define BYTE_BITS 8
+#define BYTE_MASK 0xFFU
+
+static void mdn_Logger_CompressedFormat_storeU32(uint8_t *bytes, uint32_t value) {
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        bytes[idx] = (uint8_t)((value >> (idx * BYTE_BITS)) & BYTE_MASK);
+    }
+}
+
+static uint32_t mdn_Logger_CompressedFormat_loadU32(const uint8_t *bytes) {
+    uint32_t value = 0;
+
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        value |= (uint32_t)bytes[idx] << (idx * BYTE_BITS);
+    }
+
+    return value;
+}
+
+void mdn_Logger_CompressedFormat_writeHeader(FILE *stream) {
+    char header[LOGGER_COMPRESSED_FORMAT_MAGIC_LEN + 1] = LOGGER_COMPRESSED_FORMAT_MAGIC;
+
+    header[LOGGER_COMPRESSED_FORMAT_MAGIC_LEN] = LOGGER_COMPRESSED_FORMAT_VERSION;
+    (void)fwrite(header, 1, sizeof(header), stream);
+}
+
+bool mdn_Logger_CompressedFormat_writeBlock(FILE *stream, const char *data, size_t len, uint8_t *scratch) {
+    uint8_t *payload = scratch + LOGGER_COMPRESSED_FORMAT_BLOCK_HEAD;
+    size_t   compressedLen;
+
+    compressedLen = mdn_Logger_Lz_compress((const uint8_t *)data, len, payload);
+    if (compressedLen >= len) {
+        memcpy(payload, data, len);
+        compressedLen = 0;
+    }
+    mdn_Logger_CompressedFormat_storeU32(scratch, (uint32_t)len);
+    mdn_Logger_CompressedFormat_storeU32(scratch + sizeof(uint32_t), (uint32_t)compressedLen);
+
+    len = LOGGER_COMPRESSED_FORMAT_BLOCK_HEAD + ((compressedLen == 0) ? len : compressedLen);
+    return fwrite(scratch, 1, len, stream) == len;
+}
+
+mdn_Status_t mdn_Logger_CompressedFormat_compress(FILE *rawStream, FILE *compressedStream) {
+    char        *raw;
+    uint8_t     *scratch;
+    size_t       rawLen;
+    mdn_Status_t status = MDN_STATUS_SUCCESS;
+
+    raw = MDN_MW_malloc(LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE);
+    if (raw == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    scratch = MDN_MW_malloc(LOGGER_COMPRESSED_FORMAT_SCRATCH_SIZE);
+    if (scratch == NULL) {
+        free(raw);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+
+    mdn_Logger_CompressedFormat_writeHeader(compressedStream);
+    while ((rawLen = fread(raw, 1, LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE, rawStream)) > 0) {
+        if (!mdn_Logger_CompressedFormat_writeBlock(compressedStream, raw, rawLen, scratch)) {
+            status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+            break;
+        }
+    }
+    if (ferror(rawStream) || (fflush(compressedStream) != 0)) {
+        status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+
+    free(scratch);
+    free(raw);
+
+    return status;
+}
+
+// Returns false at the end of the stream, including when it ends in the middle of a block (cut short by a crash)
+static bool mdn_Logger_CompressedFormat_readBlock(FILE *compressedStream, uint8_t *scratch, char *raw, size_t *rawLen, mdn_Status_t *status) {
+    uint8_t *blockHead = scratch;
+    size_t   compressedLen;
+
+    if (fread(blockHead, 1, LOGGER_COMPRESSED_FORMAT_BLOCK_HEAD, compressedStream) != LOGGER_COMPRESSED_FORMAT_BLOCK_HEAD) {
+        return false;
+    }
+    // A header, from concatenated streams
+    if (memcmp(blockHead, LOGGER_COMPRESSED_FORMAT_MAGIC, LOGGER_COMPRESSED_FORMAT_MAGIC_LEN) == 0) {
+        if (blockHead[LOGGER_COMPRESSED_FORMAT_MAGIC_LEN] != LOGGER_COMPRESSED_FORMAT_VERSION) {
+            *status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+            return false;
+        }
+        *rawLen = 0;
+        return true;
+    }
+
+    *rawLen       = mdn_Logger_CompressedFormat_loadU32(blockHead);
+    compressedLen = mdn_Logger_CompressedFormat_loadU32(blockHead + sizeof(uint32_t));
+    if ((*rawLen > LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE) || (compressedLen > LOGGER_LZ_COMPRESS_BOUND(*rawLen))) {
+        *status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+        return false;
+    }
+    if (compressedLen == 0) {
+        return fread(raw, 1, *rawLen, compressedStream) == *rawLen;
+    }
+    if (fread(scratch, 1, compressedLen, compressedStream) != compressedLen) {
+        return false;
+    }
+    if (!mdn_Logger_Lz_decompress(scratch, compressedLen, (uint8_t *)raw, *rawLen)) {
+        *status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+        return false;
+    }
+
+    return true;
+}
+
+mdn_Status_t mdn_Logger_decompress(FILE *compressedStream, FILE *rawStream) {
+    char        *raw;
+    uint8_t     *scratch;
+    size_t       rawLen;
+    mdn_Status_t status = MDN_STATUS_SUCCESS;
+    char         header[LOGGER_COMPRESSED_FORMAT_MAGIC_LEN + 1];
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (!IS_VALID_STREAM(compressedStream) || !IS_VALID_STREAM(rawStream)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    if ((fread(header, 1, sizeof(header), compressedStream) != sizeof(header)) ||
+        (memcmp(header, LOGGER_COMPRESSED_FORMAT_MAGIC, LOGGER_COMPRESSED_FORMAT_MAGIC_LEN) != 0) ||
+        (header[LOGGER_COMPRESSED_FORMAT_MAGIC_LEN] != LOGGER_COMPRESSED_FORMAT_VERSION)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+
+    raw = MDN_MW_malloc(LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE);
+    if (raw == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    scratch = MDN_MW_malloc(LOGGER_COMPRESSED_FORMAT_SCRATCH_SIZE);
+    if (scratch == NULL) {
+        free(raw);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+
+    while (mdn_Logger_CompressedFormat_readBlock(compressedStream, scratch, raw, &rawLen, &status)) {
+        if (fwrite(raw, 1, rawLen, rawStream) != rawLen) {
+            status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+            break;
+        }
+    }
+
+    free(scratch);
+    free(raw);
+
+    return status;
+}
@@ -0,0 +1,32 @@
+#ifndef LOGGER_COMPRESSED_FORMAT_H
+#define LOGGER_COMPRESSED_FORMAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lz_codec.h"
+#include "mdn/status.h"
+
+// Stream layout (all integers little-endian):
+//   header: "MDNLOGZ" + version byte (may appear again if streams are concatenated)
+//   block:  u32 rawLen, u32 compressedLen, then compressedLen bytes of lz_codec output,
+//           or rawLen bytes as is when compressedLen is 0 (incompressible data)
+// Blocks are independent of each other, so a stream cut in the middle of a block only loses that block.
+#define LOGGER_COMPRESSED_FORMAT_MAGIC        "MDNLOGZ"
+#define LOGGER_COMPRESSED_FORMAT_MAGIC_LEN    7
+#define LOGGER_COMPRESSED_FORMAT_VERSION      1
+#define LOGGER_COMPRESSED_FORMAT_BLOCK_HEAD   8
+#define LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE   (64 * 1024)  // Raw bytes per block, at most
+#define LOGGER_COMPRESSED_FORMAT_SCRATCH_SIZE (LOGGER_COMPRESSED_FORMAT_BLOCK_HEAD + LOGGER_LZ_COMPRESS_BOUND(LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE))
+
+void mdn_Logger_CompressedFormat_writeHeader(FILE *stream);
+
+// Compresses up to LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE bytes into a block, written with a single fwrite().
+// 'scratch' must hold LOGGER_COMPRESSED_FORMAT_SCRATCH_SIZE bytes.
+bool mdn_Logger_CompressedFormat_writeBlock(FILE *stream, const char *data, size_t len, uint8_t *scratch);
+
+// Writes the whole content of 'rawStream' to 'compressedStream', header included
+mdn_Status_t mdn_Logger_CompressedFormat_compress(FILE *rawStream, FILE *compressedStream);
+
+#endif  // LOGGER_COMPRESSED_FORMAT_H
@@ -0,0 +1,79 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "compressed_sink.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "compressed_format.h"
+#include "mdn/mock_wrapper.h"
+#include "thread.h"
+
+// Records are gathered into a block, which is compressed and written once full. The block is compressed while holding
+// the mutex, which keeps blocks in order; that cost is paid once per LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE bytes.
+struct Logger_CompressedSink_t_ {
+    Logger_Mutex_t mutex;
+    FILE          *stream;
+    size_t         blockLen;
+    char           block[LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE];
+    uint8_t        scratch[LOGGER_COMPRESSED_FORMAT_SCRATCH_SIZE];
+};
+
+static bool mdn_Logger_CompressedSink_write(void *context, const char *data, size_t len) {
+    Logger_CompressedSink_t *sink    = context;
+    bool                     written = true;
+    size_t                   copyLen;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    while (len > 0) {
+        copyLen = LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE - sink->blockLen;
+        if (copyLen > len) {
+            copyLen = len;
+        }
+        memcpy(sink->block + sink->blockLen, data, copyLen);
+        sink->blockLen += copyLen;
+        data           += copyLen;
+        len            -= copyLen;
+        if (sink->blockLen == LOGGER_COMPRESSED_FORMAT_BLOCK_SIZE) {
+            // Reported by whichever record fills the block, though it holds the end of earlier ones as well
+            written        = mdn_Logger_CompressedFormat_writeBlock(sink->stream, sink->block, sink->blockLen, sink->scratch) && written;
+            sink->blockLen = 0;
+        }
+    }
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return written;
+}
+
+static void mdn_Logger_CompressedSink_close(void *context) {
+    Logger_CompressedSink_t *sink = context;
+
+    if (sink->blockLen > 0) {
+        (void)mdn_Logger_CompressedFormat_writeBlock(sink->stream, sink->block, sink->blockLen, sink->scratch);
+    }
+    (void)fflush(sink->stream);
+    mdn_Logger_Mutex_destroy(&sink->mutex);
+    free(sink);
+}
+
+Logger_CompressedSink_t *mdn_Logger_CompressedSink_create(FILE *stream) {
+    Logger_CompressedSink_t *sink;
+
+    sink = MDN_MW_malloc(sizeof(*sink));
+    if (sink == NULL) {
+        return NULL;
+    }
+    if (!mdn_Logger_Mutex_init(&sink->mutex)) {
+        free(sink);
+        return NULL;
+    }
+    sink->stream   = stream;
+    sink->blockLen = 0;
+    mdn_Logger_CompressedFormat_writeHeader(stream);
+
+    return sink;
+}
+
+const Logger_SinkOps_t g_Logger_CompressedSink_ops = {
+    .write = mdn_Logger_CompressedSink_write,
+    .close = mdn_Logger_CompressedSink_close,
+};
@@ -0,0 +1,15 @@
+#ifndef LOGGER_COMPRESSED_SINK_H
+#define LOGGER_COMPRESSED_SINK_H
+
+#include <stdio.h>
+
+#include "sink.h"
+
+typedef struct Logger_CompressedSink_t_ Logger_CompressedSink_t;
+
+extern const Logger_SinkOps_t g_Logger_CompressedSink_ops;
+
+// Writes the compressed format header to 'stream'. Closing the sink writes the last block, but leaves 'stream' open.
+Logger_CompressedSink_t *mdn_Logger_CompressedSink_create(FILE *stream);
+
+#endif  // LOGGER_COMPRESSED_SINK_H
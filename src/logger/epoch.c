@@ -0,0 +1,29 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "epoch.h"
+
+#include "thread.h"
+
+unsigned mdn_Logger_Epoch_enter(Logger_Epoch_t *epoch) {
+    unsigned token = atomic_load(&epoch->current) % LOGGER_EPOCH_PHASES_COUNT;
+
+    // Sequentially consistent with the writer's pointer swap and phase flips: once counted, the reader is either
+    // waited for, or it loads the pointer after it was replaced
+    atomic_fetch_add(&epoch->readersArr[token].count, 1);
+    return token;
+}
+
+void mdn_Logger_Epoch_exit(Logger_Epoch_t *epoch, unsigned token) {
+    atomic_fetch_sub_explicit(&epoch->readersArr[token].count, 1, memory_order_release);
+}
+
+void mdn_Logger_Epoch_synchronize(Logger_Epoch_t *epoch) {
+    unsigned phase;
+
+    // A reader may have read the phase before a flip and registered after it, so both phases are drained
+    for (unsigned flipIdx = 0; flipIdx < LOGGER_EPOCH_PHASES_COUNT; ++flipIdx) {
+        phase = atomic_fetch_add(&epoch->current, 1) % LOGGER_EPOCH_PHASES_COUNT;
+        while (atomic_load(&epoch->readersArr[phase].count) != 0) {
+            mdn_Logger_Thread_yield();
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef LOGGER_EPOCH_H
+#define LOGGER_EPOCH_H
+
+#include <stdatomic.h>
+
+#include "logger_internal.h"
+
+#define LOGGER_EPOCH_PHASES_COUNT 2
+
+// Grace periods for data published through an atomic pointer (RCU-like, two reader counters).
+// Readers announce themselves with mdn_Logger_Epoch_enter() before loading the pointer, without ever blocking.
+// After replacing the pointer, a writer calls mdn_Logger_Epoch_synchronize(), after which no reader can still hold the old value.
+// Readers arriving meanwhile are counted on the other phase, so a steady stream of them can't starve the writer.
+typedef struct Logger_Epoch_t_ {
+    _Alignas(LOGGER_CACHE_LINE_SIZE) atomic_uint current;
+    struct {
+        _Alignas(LOGGER_CACHE_LINE_SIZE) atomic_size_t count;
+    } readersArr[LOGGER_EPOCH_PHASES_COUNT];
+} Logger_Epoch_t;
+
+// Returns the token to pass to mdn_Logger_Epoch_exit()
+unsigned mdn_Logger_Epoch_enter(Logger_Epoch_t *epoch);
+
+void mdn_Logger_Epoch_exit(Logger_Epoch_t *epoch, unsigned token);
+
+// Waits for every reader that entered before the call to exit. Calls must not overlap (writers are expected to be serialized).
+void mdn_Logger_Epoch_synchronize(Logger_Epoch_t *epoch);
+
+#endif  // LOGGER_EPOCH_H
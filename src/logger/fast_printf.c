@@ -0,0 +1,528 @@
+#include "fast_printf.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define FAST_PRINTF_DEFAULT_FLOAT_PRECISION 6
+#define FAST_PRINTF_MAX_FLOAT_PRECISION     17
+#define FAST_PRINTF_MAX_WIDTH               4096                // Wider fields are rare enough to be left to vsnprintf()
+#define FAST_PRINTF_MAX_EXACT_SCALED        4503599627370496.0  // 2^52, below which a double has its halves exactly
+#define FAST_PRINTF_SPLITTER                134217729.0         // 2^27 + 1, splits a double into two halves of 26 bits
+#define FAST_PRINTF_DIGITS_LEN              24                  // Decimal or hexadecimal digits of any 64 bit value
+#define FAST_PRINTF_FLOAT_LEN               48                  // Digits, decimal point and leading zeros of a fast path %f
+
+typedef enum Logger_FastPrintfLength_t_ {
+    LOGGER_FAST_PRINTF_LENGTH_NONE = 0,
+    LOGGER_FAST_PRINTF_LENGTH_HH,
+    LOGGER_FAST_PRINTF_LENGTH_H,
+    LOGGER_FAST_PRINTF_LENGTH_L,
+    LOGGER_FAST_PRINTF_LENGTH_LL,
+    LOGGER_FAST_PRINTF_LENGTH_Z,
+    LOGGER_FAST_PRINTF_LENGTH_J,
+    LOGGER_FAST_PRINTF_LENGTH_T,
+} Logger_FastPrintfLength_t;
+
+typedef struct Logger_FastPrintfSpec_t_ {
+    bool                      leftAlign;
+    bool                      zeroPad;
+    bool                      plusSign;
+    bool                      spaceSign;
+    size_t                    width;      // 0 if none
+    int                       precision;  // Negative if none
+    Logger_FastPrintfLength_t length;
+    char                      conversion;
+} Logger_FastPrintfSpec_t;
+
+// The two digits of every value below 100, so that integers are converted two digits per division
+static const char g_Logger_FastPrintf_digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char g_Logger_FastPrintf_lowerHexDigits[] = "0123456789abcdef";
+static const char g_Logger_FastPrintf_upperHexDigits[] = "0123456789ABCDEF";
+
+static const double g_Logger_FastPrintf_powersOf10[FAST_PRINTF_MAX_FLOAT_PRECISION + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+};
+
+// Writes 'value' in decimal right before 'end', returns how many digits were written
+static size_t mdn_Logger_FastPrintf_formatDecimal(uint64_t value, char *end) {
+    char  *digits = end;
+    size_t pairIdx;
+
+    while (value >= 100) {
+        pairIdx     = (size_t)(value % 100) * 2;
+        value      /= 100;
+        *--digits   = g_Logger_FastPrintf_digitPairs[pairIdx + 1];
+        *--digits   = g_Logger_FastPrintf_digitPairs[pairIdx];
+    }
+    if (value >= 10) {
+        pairIdx   = (size_t)value * 2;
+        *--digits = g_Logger_FastPrintf_digitPairs[pairIdx + 1];
+        *--digits = g_Logger_FastPrintf_digitPairs[pairIdx];
+    } else {
+        *--digits = (char)('0' + value);
+    }
+
+    return (size_t)(end - digits);
+}
+
+// Writes 'value' in hexadecimal right before 'end', returns how many digits were written
+static size_t mdn_Logger_FastPrintf_formatHex(uint64_t value, char *end, bool upperCase) {
+    const char *hexDigits = upperCase ? g_Logger_FastPrintf_upperHexDigits : g_Logger_FastPrintf_lowerHexDigits;
+    char       *digits    = end;
+
+    do {
+        *--digits   = hexDigits[value & 0xF];
+        value     >>= 4;
+    } while (value != 0);
+
+    return (size_t)(end - digits);
+}
+
+// Appends a whole field: spaces up to the width on the side it is aligned to, then 'prefix', 'zerosLen' zeros and 'body'.
+// Most fields are neither padded nor prefixed, so each part is only copied if there is one, rather than with zero-length calls.
+static void mdn_Logger_FastPrintf_appendField(Logger_LineBuffer_t *lineBuffer, const Logger_FastPrintfSpec_t *spec, const char *prefix,
+                                              size_t prefixLen, size_t zerosLen, const char *body, size_t bodyLen) {
+    size_t fieldLen = prefixLen + zerosLen + bodyLen;
+    size_t padLen   = (spec->width > fieldLen) ? (spec->width - fieldLen) : 0;
+    char  *dst;
+
+    if (spec->zeroPad && !spec->leftAlign) {
+        zerosLen += padLen;
+        padLen    = 0;
+    }
+    if (!mdn_Logger_LineBuffer_reserve(lineBuffer, prefixLen + zerosLen + bodyLen + padLen)) {
+        lineBuffer->truncated = true;
+        return;
+    }
+
+    dst = lineBuffer->data + lineBuffer->len;
+    if ((padLen != 0) && !spec->leftAlign) {
+        memset(dst, ' ', padLen);
+        dst += padLen;
+    }
+    for (size_t idx = 0; idx < prefixLen; ++idx) {
+        *dst++ = prefix[idx];
+    }
+    if (zerosLen != 0) {
+        memset(dst, '0', zerosLen);
+        dst += zerosLen;
+    }
+    memcpy(dst, body, bodyLen);
+    dst += bodyLen;
+    if ((padLen != 0) && spec->leftAlign) {
+        memset(dst, ' ', padLen);
+        dst += padLen;
+    }
+    lineBuffer->len = (size_t)(dst - lineBuffer->data);
+}
+
+// Parses what follows a '%' up to and including the conversion, returns false if the conversion isn't supported
+static bool mdn_Logger_FastPrintf_parseSpec(const char **format, va_list *args, Logger_FastPrintfSpec_t *spec) {
+    const char *pos = *format;
+    int         starValue;
+
+    *spec = (Logger_FastPrintfSpec_t){.precision = -1};
+
+    for (;; ++pos) {
+        if (*pos == '-') {
+            spec->leftAlign = true;
+        } else if (*pos == '0') {
+            spec->zeroPad = true;
+        } else if (*pos == '+') {
+            spec->plusSign = true;
+        } else if (*pos == ' ') {
+            spec->spaceSign = true;
+        } else {
+            break;
+        }
+    }
+
+    if (*pos == '*') {
+        starValue = va_arg(*args, int);
+        if (starValue < 0) {
+            spec->leftAlign = true;
+            // Negating INT_MIN would overflow, and such a width isn't taken by the fast path anyway
+            spec->width = (starValue < -FAST_PRINTF_MAX_WIDTH) ? (FAST_PRINTF_MAX_WIDTH + 1) : (size_t)-starValue;
+        } else {
+            spec->width = (size_t)starValue;
+        }
+        ++pos;
+    } else {
+        while ((*pos >= '0') && (*pos <= '9') && (spec->width <= FAST_PRINTF_MAX_WIDTH)) {
+            spec->width = (spec->width * 10) + (size_t)(*pos - '0');
+            ++pos;
+        }
+    }
+    if (spec->width > FAST_PRINTF_MAX_WIDTH) {
+        return false;
+    }
+
+    if (*pos == '.') {
+        ++pos;
+        if (*pos == '*') {
+            starValue       = va_arg(*args, int);
+            spec->precision = (starValue < 0) ? -1 : starValue;
+            ++pos;
+        } else {
+            spec->precision = 0;
+            while ((*pos >= '0') && (*pos <= '9') && (spec->precision <= FAST_PRINTF_MAX_WIDTH)) {
+                spec->precision = (spec->precision * 10) + (*pos - '0');
+                ++pos;
+            }
+        }
+        if (spec->precision > FAST_PRINTF_MAX_WIDTH) {
+            return false;
+        }
+    }
+
+    switch (*pos) {
+        case 'h':
+            ++pos;
+            spec->length = (*pos == 'h') ? LOGGER_FAST_PRINTF_LENGTH_HH : LOGGER_FAST_PRINTF_LENGTH_H;
+            pos         += (*pos == 'h') ? 1 : 0;
+            break;
+        case 'l':
+            ++pos;
+            spec->length = (*pos == 'l') ? LOGGER_FAST_PRINTF_LENGTH_LL : LOGGER_FAST_PRINTF_LENGTH_L;
+            pos         += (*pos == 'l') ? 1 : 0;
+            break;
+        case 'z':
+            ++pos;
+            spec->length = LOGGER_FAST_PRINTF_LENGTH_Z;
+            break;
+        case 'j':
+            ++pos;
+            spec->length = LOGGER_FAST_PRINTF_LENGTH_J;
+            break;
+        case 't':
+            ++pos;
+            spec->length = LOGGER_FAST_PRINTF_LENGTH_T;
+            break;
+        default:
+            break;
+    }
+
+    spec->conversion = *pos;
+    switch (spec->conversion) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+            break;
+        case 'f':
+        case 'F':
+            // %lf is the same as %f, the other modifiers either mean long double or nothing at all
+            if ((spec->length != LOGGER_FAST_PRINTF_LENGTH_NONE) && (spec->length != LOGGER_FAST_PRINTF_LENGTH_L)) {
+                return false;
+            }
+            break;
+        case 'c':
+        case 's':
+        case 'p':
+            // Wide characters, and flags whose effect on these conversions is undefined or implementation specific
+            if ((spec->length != LOGGER_FAST_PRINTF_LENGTH_NONE) || spec->zeroPad || spec->plusSign || spec->spaceSign) {
+                return false;
+            }
+            if ((spec->conversion != 's') && (spec->precision >= 0)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    *format = pos + 1;
+
+    return true;
+}
+
+static int64_t mdn_Logger_FastPrintf_readSigned(Logger_FastPrintfLength_t length, va_list *args) {
+    switch (length) {
+        case LOGGER_FAST_PRINTF_LENGTH_HH:
+            return (signed char)va_arg(*args, int);
+        case LOGGER_FAST_PRINTF_LENGTH_H:
+            return (short)va_arg(*args, int);
+        case LOGGER_FAST_PRINTF_LENGTH_L:
+            return va_arg(*args, long);
+        case LOGGER_FAST_PRINTF_LENGTH_LL:
+            return va_arg(*args, long long);
+        case LOGGER_FAST_PRINTF_LENGTH_Z:
+            return (int64_t)va_arg(*args, size_t);  // The signed type of the same size
+        case LOGGER_FAST_PRINTF_LENGTH_J:
+            return va_arg(*args, intmax_t);
+        case LOGGER_FAST_PRINTF_LENGTH_T:
+            return va_arg(*args, ptrdiff_t);
+        default:
+            return va_arg(*args, int);
+    }
+}
+
+static uint64_t mdn_Logger_FastPrintf_readUnsigned(Logger_FastPrintfLength_t length, va_list *args) {
+    switch (length) {
+        case LOGGER_FAST_PRINTF_LENGTH_HH:
+            return (unsigned char)va_arg(*args, unsigned int);
+        case LOGGER_FAST_PRINTF_LENGTH_H:
+            return (unsigned short)va_arg(*args, unsigned int);
+        case LOGGER_FAST_PRINTF_LENGTH_L:
+            return va_arg(*args, unsigned long);
+        case LOGGER_FAST_PRINTF_LENGTH_LL:
+            return va_arg(*args, unsigned long long);
+        case LOGGER_FAST_PRINTF_LENGTH_Z:
+            return va_arg(*args, size_t);
+        case LOGGER_FAST_PRINTF_LENGTH_J:
+            return va_arg(*args, uintmax_t);
+        case LOGGER_FAST_PRINTF_LENGTH_T:
+            return (uint64_t)va_arg(*args, ptrdiff_t);  // The unsigned type of the same size
+        default:
+            return va_arg(*args, unsigned int);
+    }
+}
+
+static void mdn_Logger_FastPrintf_appendInteger(Logger_LineBuffer_t *lineBuffer, Logger_FastPrintfSpec_t *spec, va_list *args) {
+    char     digits[FAST_PRINTF_DIGITS_LEN];
+    char    *digitsEnd = digits + sizeof(digits);
+    char     sign      = '\0';
+    int64_t  signedValue;
+    uint64_t magnitude;
+    size_t   digitsLen;
+    size_t   zerosLen;
+
+    if ((spec->conversion == 'd') || (spec->conversion == 'i')) {
+        signedValue = mdn_Logger_FastPrintf_readSigned(spec->length, args);
+        magnitude   = (signedValue < 0) ? (0 - (uint64_t)signedValue) : (uint64_t)signedValue;
+        if (signedValue < 0) {
+            sign = '-';
+        } else if (spec->plusSign) {
+            sign = '+';
+        } else if (spec->spaceSign) {
+            sign = ' ';
+        }
+    } else {
+        magnitude = mdn_Logger_FastPrintf_readUnsigned(spec->length, args);
+    }
+
+    // An explicit precision is the minimum number of digits, none at all for a zero, and disables zero padding
+    if ((spec->precision == 0) && (magnitude == 0)) {
+        digitsLen = 0;
+    } else if (spec->conversion == 'x') {
+        digitsLen = mdn_Logger_FastPrintf_formatHex(magnitude, digitsEnd, false);
+    } else if (spec->conversion == 'X') {
+        digitsLen = mdn_Logger_FastPrintf_formatHex(magnitude, digitsEnd, true);
+    } else {
+        digitsLen = mdn_Logger_FastPrintf_formatDecimal(magnitude, digitsEnd);
+    }
+    zerosLen = 0;
+    if (spec->precision >= 0) {
+        spec->zeroPad = false;
+        if ((size_t)spec->precision > digitsLen) {
+            zerosLen = (size_t)spec->precision - digitsLen;
+        }
+    }
+
+    mdn_Logger_FastPrintf_appendField(lineBuffer, spec, &sign, (sign != '\0') ? 1 : 0, zerosLen, digitsEnd - digitsLen, digitsLen);
+}
+
+// Rounds 'magnitude' * 10^'precision' to the nearest integer, ties to even, as if the product was exact (which is how printf()
+// rounds). Returns false if the product is too large for the fast path.
+static bool mdn_Logger_FastPrintf_scaleFloat(double magnitude, int precision, uint64_t *scaled) {
+#if (FLT_EVAL_METHOD == 0)
+    double scale = g_Logger_FastPrintf_powersOf10[precision];
+    double product;
+    double productError;
+    double fraction;
+# if !(defined __FMA__) && !(defined __FP_FAST_FMA)
+    double magnitudeHigh;
+    double magnitudeLow;
+    double scaleHigh;
+    double scaleLow;
+    double split;
+# endif
+
+    product = magnitude * scale;
+    if (!(product < FAST_PRINTF_MAX_EXACT_SCALED)) {
+        return false;
+    }
+
+    // Rounding error of the product, so that 'product' + 'productError' is exactly 'magnitude' * 'scale' (Dekker's product)
+# if (defined __FMA__) || (defined __FP_FAST_FMA)
+    productError = __builtin_fma(magnitude, scale, -product);
+# else
+    split         = FAST_PRINTF_SPLITTER * magnitude;
+    magnitudeHigh = split - (split - magnitude);
+    magnitudeLow  = magnitude - magnitudeHigh;
+    split         = FAST_PRINTF_SPLITTER * scale;
+    scaleHigh     = split - (split - scale);
+    scaleLow      = scale - scaleHigh;
+    productError  = (((magnitudeHigh * scaleHigh) - product) + (magnitudeHigh * scaleLow) + (magnitudeLow * scaleHigh)) + (magnitudeLow * scaleLow);
+# endif
+
+    // Below 2^52 the fraction is exact, and the error is smaller than the distance to the next half, so it only matters for ties
+    *scaled  = (uint64_t)product;
+    fraction = product - (double)*scaled;
+    if ((fraction > 0.5) || ((fraction == 0.5) && ((productError > 0.0) || ((productError == 0.0) && ((*scaled & 1) != 0))))) {
+        ++*scaled;
+    }
+
+    return true;
+#else
+    (void)magnitude;
+    (void)precision;
+    (void)scaled;
+
+    return false;
+#endif  // FLT_EVAL_METHOD
+}
+
+static bool mdn_Logger_FastPrintf_appendFloat(Logger_LineBuffer_t *lineBuffer, const Logger_FastPrintfSpec_t *spec, double value) {
+    char     body[FAST_PRINTF_FLOAT_LEN];
+    char    *bodyEnd   = body + sizeof(body);
+    char     sign      = '\0';
+    int      precision = (spec->precision < 0) ? FAST_PRINTF_DEFAULT_FLOAT_PRECISION : spec->precision;
+    uint64_t scaled;
+    size_t   digitsLen;
+    size_t   intLen;
+
+    if (!isfinite(value) || (precision > FAST_PRINTF_MAX_FLOAT_PRECISION)) {
+        return false;
+    }
+    if (!mdn_Logger_FastPrintf_scaleFloat(signbit(value) ? -value : value, precision, &scaled)) {
+        return false;
+    }
+
+    // Digits of the scaled value, with enough leading zeros for the integer part to have at least one
+    digitsLen = mdn_Logger_FastPrintf_formatDecimal(scaled, bodyEnd);
+    while (digitsLen <= (size_t)precision) {
+        *(bodyEnd - ++digitsLen) = '0';
+    }
+    intLen = digitsLen - (size_t)precision;
+    if (precision > 0) {
+        memmove(bodyEnd - digitsLen - 1, bodyEnd - digitsLen, intLen);
+        *(bodyEnd - precision - 1) = '.';
+        ++digitsLen;
+    }
+
+    // Negative zero and negative values rounded to zero keep their sign, as with printf()
+    if (signbit(value)) {
+        sign = '-';
+    } else if (spec->plusSign) {
+        sign = '+';
+    } else if (spec->spaceSign) {
+        sign = ' ';
+    }
+    mdn_Logger_FastPrintf_appendField(lineBuffer, spec, &sign, (sign != '\0') ? 1 : 0, 0, bodyEnd - digitsLen, digitsLen);
+
+    return true;
+}
+
+// Appends one parsed conversion, returns false if its value has to be left to vsnprintf()
+static bool mdn_Logger_FastPrintf_appendConversion(Logger_LineBuffer_t *lineBuffer, Logger_FastPrintfSpec_t *spec, va_list *args) {
+    char        digits[FAST_PRINTF_DIGITS_LEN];
+    char       *digitsEnd = digits + sizeof(digits);
+    const char *str;
+    const char *strEnd;
+    const void *ptr;
+    size_t      digitsLen;
+    char        character;
+
+    switch (spec->conversion) {
+        case 'f':
+        case 'F':
+            return mdn_Logger_FastPrintf_appendFloat(lineBuffer, spec, va_arg(*args, double));
+        case 'c':
+            character = (char)va_arg(*args, int);
+            mdn_Logger_FastPrintf_appendField(lineBuffer, spec, "", 0, 0, &character, 1);
+            return true;
+        case 's':
+            // How a null string is printed isn't standard
+            str = va_arg(*args, const char *);
+            if (str == NULL) {
+                return false;
+            }
+            strEnd = (spec->precision < 0) ? (str + strlen(str)) : memchr(str, '\0', (size_t)spec->precision);
+            if (strEnd == NULL) {
+                strEnd = str + spec->precision;
+            }
+            mdn_Logger_FastPrintf_appendField(lineBuffer, spec, "", 0, 0, str, (size_t)(strEnd - str));
+            return true;
+        case 'p':
+            // Same as "%#lx", except for null pointers which aren't printed the same everywhere
+            ptr = va_arg(*args, const void *);
+            if (ptr == NULL) {
+                return false;
+            }
+            digitsLen = mdn_Logger_FastPrintf_formatHex((uint64_t)(uintptr_t)ptr, digitsEnd, false);
+            mdn_Logger_FastPrintf_appendField(lineBuffer, spec, "0x", 2, 0, digitsEnd - digitsLen, digitsLen);
+            return true;
+        default:
+            mdn_Logger_FastPrintf_appendInteger(lineBuffer, spec, args);
+            return true;
+    }
+}
+
+static bool mdn_Logger_FastPrintf_tryAppendFormat(Logger_LineBuffer_t *lineBuffer, const char *format, va_list *args) {
+    Logger_FastPrintfSpec_t spec;
+    const char             *percent;
+
+    for (;;) {
+        percent = strchr(format, '%');
+        if (percent == NULL) {
+            if (*format != '\0') {
+                mdn_Logger_LineBuffer_appendStr(lineBuffer, format);
+            }
+            return true;
+        }
+        if (percent != format) {
+            mdn_Logger_LineBuffer_append(lineBuffer, format, (size_t)(percent - format));
+        }
+        format = percent + 1;
+
+        if (*format == '%') {
+            mdn_Logger_LineBuffer_append(lineBuffer, "%", 1);
+            ++format;
+            continue;
+        }
+        if (!mdn_Logger_FastPrintf_parseSpec(&format, args, &spec) || !mdn_Logger_FastPrintf_appendConversion(lineBuffer, &spec, args)) {
+            return false;
+        }
+    }
+}
+
+void mdn_Logger_FastPrintf_appendFormatV(Logger_LineBuffer_t *lineBuffer, const char *format, va_list args) {
+    va_list argsCopy;
+    size_t  startLen  = lineBuffer->len;
+    bool    truncated = lineBuffer->truncated;
+    bool    appended;
+
+    va_copy(argsCopy, args);
+    appended = mdn_Logger_FastPrintf_tryAppendFormat(lineBuffer, format, &argsCopy);
+    va_end(argsCopy);
+
+    // Arguments can't be handed over to vsnprintf() one at a time, so the whole message is formatted again
+    if (!appended) {
+        lineBuffer->len       = startLen;
+        lineBuffer->truncated = truncated;
+        mdn_Logger_LineBuffer_appendFormatV(lineBuffer, format, args);
+    }
+}
+
+void mdn_Logger_FastPrintf_appendFormat(Logger_LineBuffer_t *lineBuffer, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    mdn_Logger_FastPrintf_appendFormatV(lineBuffer, format, args);
+    va_end(args);
+}
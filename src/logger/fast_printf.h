@@ -0,0 +1,16 @@
+#ifndef LOGGER_FAST_PRINTF_H
+#define LOGGER_FAST_PRINTF_H
+
+#include <stdarg.h>
+
+#include "line_buffer.h"
+
+// Same output as mdn_Logger_LineBuffer_appendFormatV(), without going through vsnprintf() for the conversions logging
+// formats are mostly made of: %d %i %u %x %X %c %s %p %f %F and %%, with the '-', '0', '+' and ' ' flags, width, precision
+// (both possibly '*') and the hh, h, l, ll, z, j and t length modifiers. Anything else, as well as null strings and pointers,
+// NaN, infinities and floating values too large for the fast path, has the whole message formatted by vsnprintf() instead.
+void mdn_Logger_FastPrintf_appendFormatV(Logger_LineBuffer_t *lineBuffer, const char *format, va_list args);
+
+void mdn_Logger_FastPrintf_appendFormat(Logger_LineBuffer_t *lineBuffer, const char *format, ...);
+
+#endif  // LOGGER_FAST_PRINTF_H
@@ -0,0 +1,422 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "fd_sink.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mdn/mock_wrapper.h"
+#include "thread.h"
+#include "timestamp.h"
+#include "uring.h"
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <errno.h>
+# include <sys/uio.h>
+#endif  // OS
+
+#if (defined __APPLE__) || (defined __linux__)
+# define FLUSH_IDLE_WAIT_MS     1000
+# define NSEC_PER_MSEC          1000000ULL
+# define WRITEV_BUFFERS_COUNT   2
+# define IO_URING_BUFFERS_COUNT 4  // One being filled, up to three in flight
+# define MAX_BUFFERS_COUNT      IO_URING_BUFFERS_COUNT
+# define RAW_FD_SINK_IOV_COUNT  64  // Per writev(), well under IOV_MAX
+
+// Records are appended to 'buffer' under 'mutex'. A flush swaps it with a free buffer and writes the former without holding
+// 'mutex', so other threads keep appending meanwhile; 'flushMutex' keeps flushes in the order their buffers were filled.
+// With writev(), the buffer is free again once written, and a record that doesn't fit the buffer at all is written by the same
+// writev() as what was buffered before it.
+// With io_uring, the flush only submits the buffer, which is free again once its write completes; completions are reaped by
+// the next flushes, which wait for one only when all buffers are in flight. A record that doesn't fit is written with
+// writev() once all submitted writes completed.
+struct Logger_FdSink_t_ {
+    Logger_Mutex_t  mutex;
+    Logger_Mutex_t  flushMutex;
+    Logger_Cond_t   cond;  // Wakes the flush thread once 'buffer' gets its first record
+    Logger_Thread_t thread;
+    bool            stopRequested;
+    int             fd;
+    char           *buffer;
+    size_t          bufferLen;
+    size_t          recordsCount;    // In 'buffer'
+    uint64_t        oldestRecordNs;  // When the first record of 'buffer' was appended
+    size_t          flushSize;
+    size_t          flushRecordsCount;
+    uint64_t        flushIntervalNs;
+    // Under 'flushMutex'
+    char           *freeBuffersArr[MAX_BUFFERS_COUNT];
+    unsigned        freeBuffersCount;
+    Logger_Uring_t *ring;  // NULL when writing with writev()
+    size_t          inFlightLensArr[IO_URING_BUFFERS_COUNT];  // Bytes submitted from each buffer, 0 when it isn't in flight
+    unsigned        inFlightCount;
+    bool            inFlightFailed;  // A completed write failed, or was short, since the last flush reported it
+    char            buffersArr[];    // 'buffer' and the free buffers, of 'flushSize' bytes each
+};
+
+// Writes the buffers whole, unless the fd fails
+static bool mdn_Logger_FdSink_writeAll(int fd, struct iovec *iovArr, int iovArrLen) {
+    ssize_t writtenLen;
+    size_t  remainingLen;
+
+    while (iovArrLen > 0) {
+        if (iovArr->iov_len == 0) {
+            ++iovArr;
+            --iovArrLen;
+            continue;
+        }
+        writtenLen = writev(fd, iovArr, iovArrLen);
+        if (writtenLen < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        remainingLen = (size_t)writtenLen;
+        while ((iovArrLen > 0) && (remainingLen >= iovArr->iov_len)) {
+            remainingLen -= iovArr->iov_len;
+            ++iovArr;
+            --iovArrLen;
+        }
+        if (iovArrLen > 0) {
+            iovArr->iov_base  = (char *)iovArr->iov_base + remainingLen;
+            iovArr->iov_len  -= remainingLen;
+        }
+    }
+
+    return true;
+}
+
+// Frees the buffer of a completed io_uring write
+static void mdn_Logger_FdSink_completeWrite(Logger_FdSink_t *sink, unsigned bufferIdx, int32_t result) {
+    if ((result < 0) || ((size_t)result != sink->inFlightLensArr[bufferIdx])) {
+        sink->inFlightFailed = true;
+    }
+    sink->inFlightLensArr[bufferIdx]               = 0;
+    sink->freeBuffersArr[sink->freeBuffersCount++] = sink->buffersArr + (bufferIdx * sink->flushSize);
+    --sink->inFlightCount;
+}
+
+// Reaps the io_uring writes that completed, and waits for more until 'maxInFlightCount' at most are in flight
+static void mdn_Logger_FdSink_reapWrites(Logger_FdSink_t *sink, unsigned maxInFlightCount) {
+    unsigned bufferIdx;
+    int32_t  result;
+
+    while ((sink->inFlightCount > 0) && mdn_Logger_Uring_reap(sink->ring, sink->inFlightCount > maxInFlightCount, &bufferIdx, &result)) {
+        mdn_Logger_FdSink_completeWrite(sink, bufferIdx, result);
+    }
+}
+
+// Submits the buffer to io_uring, or writes it with writev() if that fails. Frees it right away when not in flight.
+static bool mdn_Logger_FdSink_submitBuffer(Logger_FdSink_t *sink, char *buffer, size_t len) {
+    unsigned     bufferIdx = (unsigned)((size_t)(buffer - sink->buffersArr) / sink->flushSize);
+    struct iovec iov       = {.iov_base = buffer, .iov_len = len};
+    bool         written   = true;
+
+    if ((len > 0) && mdn_Logger_Uring_submitWrite(sink->ring, bufferIdx, len)) {
+        sink->inFlightLensArr[bufferIdx] = len;
+        ++sink->inFlightCount;
+        return true;
+    }
+    if (len > 0) {
+        // After the writes already submitted
+        mdn_Logger_FdSink_reapWrites(sink, 0);
+        written = mdn_Logger_FdSink_writeAll(sink->fd, &iov, 1);
+    }
+    sink->freeBuffersArr[sink->freeBuffersCount++] = buffer;
+
+    return written;
+}
+
+// Writes what is buffered, followed by 'data' (which may be NULL)
+static bool mdn_Logger_FdSink_flushWith(Logger_FdSink_t *sink, const char *data, size_t len) {
+    struct iovec iovArr[2];
+    char        *flushBuffer;
+    size_t       flushLen;
+    bool         written = true;
+
+    mdn_Logger_Mutex_lock(&sink->flushMutex);
+    if (sink->ring != NULL) {
+        // Waits only if all buffers but the one being filled are in flight
+        mdn_Logger_FdSink_reapWrites(sink, IO_URING_BUFFERS_COUNT - 2);
+    }
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    flushBuffer        = sink->buffer;
+    flushLen           = sink->bufferLen;
+    sink->buffer       = sink->freeBuffersArr[--sink->freeBuffersCount];
+    sink->bufferLen    = 0;
+    sink->recordsCount = 0;
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    if (sink->ring != NULL) {
+        written = mdn_Logger_FdSink_submitBuffer(sink, flushBuffer, flushLen);
+        if (data != NULL) {
+            mdn_Logger_FdSink_reapWrites(sink, 0);
+            iovArr[0] = (struct iovec){.iov_base = (void *)(uintptr_t)data, .iov_len = len};
+            written   = mdn_Logger_FdSink_writeAll(sink->fd, iovArr, 1) && written;
+        }
+        if (sink->inFlightFailed) {
+            sink->inFlightFailed = false;
+            written              = false;
+        }
+    } else {
+        iovArr[0] = (struct iovec){.iov_base = flushBuffer, .iov_len = flushLen};
+        iovArr[1] = (struct iovec){.iov_base = (void *)(uintptr_t)data, .iov_len = len};
+        written   = mdn_Logger_FdSink_writeAll(sink->fd, iovArr, 2);
+        sink->freeBuffersArr[sink->freeBuffersCount++] = flushBuffer;
+    }
+    mdn_Logger_Mutex_unlock(&sink->flushMutex);
+
+    return written;
+}
+
+static void mdn_Logger_FdSink_thread(void *arg) {
+    Logger_FdSink_t *sink = arg;
+    uint64_t         nowNs;
+    uint64_t         dueNs;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    while (!sink->stopRequested) {
+        if (sink->bufferLen == 0) {
+            mdn_Logger_Cond_timedWait(&sink->cond, &sink->mutex, FLUSH_IDLE_WAIT_MS);
+            continue;
+        }
+        nowNs = mdn_Logger_Timestamp_getMonotonicNs();
+        dueNs = sink->oldestRecordNs + sink->flushIntervalNs;
+        if (nowNs < dueNs) {
+            mdn_Logger_Cond_timedWait(&sink->cond, &sink->mutex, (unsigned)(((dueNs - nowNs) / NSEC_PER_MSEC) + 1));
+            continue;
+        }
+        mdn_Logger_Mutex_unlock(&sink->mutex);
+        (void)mdn_Logger_FdSink_flushWith(sink, NULL, 0);
+        mdn_Logger_Mutex_lock(&sink->mutex);
+    }
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+}
+
+static bool mdn_Logger_FdSink_write(void *context, const char *data, size_t len) {
+    Logger_FdSink_t *sink    = context;
+    bool             written = true;
+    bool             isFlushDue;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    while ((sink->bufferLen + len) > sink->flushSize) {
+        mdn_Logger_Mutex_unlock(&sink->mutex);
+        if (len >= sink->flushSize) {
+            return mdn_Logger_FdSink_flushWith(sink, data, len) && written;
+        }
+        written = mdn_Logger_FdSink_flushWith(sink, NULL, 0) && written;
+        mdn_Logger_Mutex_lock(&sink->mutex);
+    }
+    if (sink->bufferLen == 0) {
+        sink->oldestRecordNs = mdn_Logger_Timestamp_getMonotonicNs();
+        mdn_Logger_Cond_signal(&sink->cond);
+    }
+    memcpy(sink->buffer + sink->bufferLen, data, len);
+    sink->bufferLen += len;
+    ++sink->recordsCount;
+    isFlushDue = (sink->bufferLen >= sink->flushSize) || ((sink->flushRecordsCount != 0) && (sink->recordsCount >= sink->flushRecordsCount));
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    if (isFlushDue) {
+        written = mdn_Logger_FdSink_flushWith(sink, NULL, 0) && written;
+    }
+
+    return written;
+}
+
+static bool mdn_Logger_FdSink_flush(void *context) {
+    return mdn_Logger_FdSink_flushWith(context, NULL, 0);
+}
+
+// Flushes what is left and waits for it to be written, the fd stays open
+static void mdn_Logger_FdSink_close(void *context) {
+    Logger_FdSink_t *sink = context;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    sink->stopRequested = true;
+    mdn_Logger_Cond_signal(&sink->cond);
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+    mdn_Logger_Thread_join(&sink->thread);
+
+    (void)mdn_Logger_FdSink_flushWith(sink, NULL, 0);
+    if (sink->ring != NULL) {
+        mdn_Logger_FdSink_reapWrites(sink, 0);
+        mdn_Logger_Uring_destroy(sink->ring);
+    }
+    mdn_Logger_Cond_destroy(&sink->cond);
+    mdn_Logger_Mutex_destroy(&sink->flushMutex);
+    mdn_Logger_Mutex_destroy(&sink->mutex);
+    free(sink);
+}
+
+mdn_Status_t mdn_Logger_FdSink_create(Logger_FdSink_t **sink, const mdn_Logger_FdConfig_t *config) {
+    Logger_FdSink_t *sinkTemp;
+    size_t           flushSize    = (config->flushSize == 0) ? LOGGER_FD_SINK_DEFAULT_FLUSH_SIZE : config->flushSize;
+    unsigned         buffersCount = config->ioUring ? IO_URING_BUFFERS_COUNT : WRITEV_BUFFERS_COUNT;
+
+    // io_uring writes at most 4 GiB at once
+    if ((flushSize > ((SIZE_MAX - sizeof(*sinkTemp)) / buffersCount)) || (config->ioUring && (flushSize > UINT32_MAX))) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    sinkTemp = MDN_MW_malloc(sizeof(*sinkTemp) + (buffersCount * flushSize));
+    if (sinkTemp == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    sinkTemp->stopRequested     = false;
+    sinkTemp->fd                = config->fd;
+    sinkTemp->buffer            = sinkTemp->buffersArr;
+    sinkTemp->bufferLen         = 0;
+    sinkTemp->recordsCount      = 0;
+    sinkTemp->oldestRecordNs    = 0;
+    sinkTemp->flushSize         = flushSize;
+    sinkTemp->flushRecordsCount = config->flushRecordsCount;
+    sinkTemp->flushIntervalNs   = ((config->flushIntervalMs == 0) ? LOGGER_FD_SINK_DEFAULT_FLUSH_INTERVAL_MS : config->flushIntervalMs) * NSEC_PER_MSEC;
+    sinkTemp->freeBuffersCount  = 0;
+    for (unsigned idx = 1; idx < buffersCount; ++idx) {
+        sinkTemp->freeBuffersArr[sinkTemp->freeBuffersCount++] = sinkTemp->buffersArr + (idx * flushSize);
+    }
+    memset(sinkTemp->inFlightLensArr, 0, sizeof(sinkTemp->inFlightLensArr));
+    sinkTemp->inFlightCount  = 0;
+    sinkTemp->inFlightFailed = false;
+    // Falls back to writev() when io_uring is unavailable
+    sinkTemp->ring = config->ioUring ? mdn_Logger_Uring_create(config->fd, sinkTemp->buffersArr, flushSize, buffersCount) : NULL;
+
+    // Thread primitives only fail on resources exhaustion, hence reported as memory allocation failures
+    if (mdn_Logger_Mutex_init(&sinkTemp->mutex)) {
+        if (mdn_Logger_Mutex_init(&sinkTemp->flushMutex)) {
+            if (mdn_Logger_Cond_init(&sinkTemp->cond)) {
+                if (mdn_Logger_Thread_create(&sinkTemp->thread, mdn_Logger_FdSink_thread, sinkTemp)) {
+                    *sink = sinkTemp;
+                    return MDN_STATUS_SUCCESS;
+                }
+                mdn_Logger_Cond_destroy(&sinkTemp->cond);
+            }
+            mdn_Logger_Mutex_destroy(&sinkTemp->flushMutex);
+        }
+        mdn_Logger_Mutex_destroy(&sinkTemp->mutex);
+    }
+    if (sinkTemp->ring != NULL) {
+        mdn_Logger_Uring_destroy(sinkTemp->ring);
+    }
+    free(sinkTemp);
+
+    return MDN_STATUS_ERROR_MEM_ALLOC;
+}
+
+// Unbuffered: each record is written right away, a batch by as few writev() as IOV_MAX allows. 'mutex' keeps the records of
+// concurrent writes from interleaving when the fd writes them partially.
+typedef struct Logger_RawFdSink_t_ {
+    Logger_Mutex_t mutex;
+    int            fd;
+} Logger_RawFdSink_t;
+
+static bool mdn_Logger_RawFdSink_write(void *context, const char *data, size_t len) {
+    Logger_RawFdSink_t *sink = context;
+    struct iovec        iov  = {.iov_base = (void *)(uintptr_t)data, .iov_len = len};
+    bool                written;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    written = mdn_Logger_FdSink_writeAll(sink->fd, &iov, 1);
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return written;
+}
+
+static bool mdn_Logger_RawFdSink_writeBatch(void *context, const mdn_Logger_SinkBuffer_t *buffersArr, size_t buffersArrLen) {
+    Logger_RawFdSink_t *sink    = context;
+    struct iovec        iovArr[RAW_FD_SINK_IOV_COUNT];
+    int                 iovArrLen;
+    bool                written = true;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    while (buffersArrLen > 0) {
+        iovArrLen = 0;
+        while ((iovArrLen < RAW_FD_SINK_IOV_COUNT) && (buffersArrLen > 0)) {
+            iovArr[iovArrLen++] = (struct iovec){.iov_base = (void *)(uintptr_t)buffersArr->data, .iov_len = buffersArr->len};
+            ++buffersArr;
+            --buffersArrLen;
+        }
+        written = mdn_Logger_FdSink_writeAll(sink->fd, iovArr, iovArrLen) && written;
+    }
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return written;
+}
+
+// The fd stays open
+static void mdn_Logger_RawFdSink_close(void *context) {
+    Logger_RawFdSink_t *sink = context;
+
+    mdn_Logger_Mutex_destroy(&sink->mutex);
+    free(sink);
+}
+
+static const Logger_SinkOps_t g_Logger_RawFdSink_ops = {
+    .write      = mdn_Logger_RawFdSink_write,
+    .writeBatch = mdn_Logger_RawFdSink_writeBatch,
+    .close      = mdn_Logger_RawFdSink_close,
+};
+
+mdn_Status_t mdn_Logger_createRawFdSink(mdn_Logger_Sink_t *sink, int fd) {
+    Logger_RawFdSink_t *sinkContext;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((sink == NULL) || (fd < 0)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    sinkContext = MDN_MW_malloc(sizeof(*sinkContext));
+    if (sinkContext == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    if (!mdn_Logger_Mutex_init(&sinkContext->mutex)) {
+        free(sinkContext);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    sinkContext->fd = fd;
+    *sink           = (mdn_Logger_Sink_t){
+        .ops     = &g_Logger_RawFdSink_ops,
+        .context = sinkContext,
+    };
+
+    return MDN_STATUS_SUCCESS;
+}
+#elif defined _WIN32
+static bool mdn_Logger_FdSink_write(void *context, const char *data, size_t len) {
+    (void)context;
+    (void)data;
+    (void)len;
+    return false;
+}
+
+static bool mdn_Logger_FdSink_flush(void *context) {
+    (void)context;
+    return false;
+}
+
+static void mdn_Logger_FdSink_close(void *context) {
+    (void)context;
+}
+
+// No writev() on Windows
+mdn_Status_t mdn_Logger_FdSink_create(Logger_FdSink_t **sink, const mdn_Logger_FdConfig_t *config) {
+    (void)sink;
+    (void)config;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+
+// No writev() on Windows
+mdn_Status_t mdn_Logger_createRawFdSink(mdn_Logger_Sink_t *sink, int fd) {
+    (void)sink;
+    (void)fd;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+#endif  // OS
+
+const Logger_SinkOps_t g_Logger_FdSink_ops = {
+    .write = mdn_Logger_FdSink_write,
+    .close = mdn_Logger_FdSink_close,
+    .flush = mdn_Logger_FdSink_flush,
+};
@@ -0,0 +1,18 @@
+#ifndef LOGGER_FD_SINK_H
+#define LOGGER_FD_SINK_H
+
+#include "mdn/logger.h"
+#include "sink.h"
+
+#define LOGGER_FD_SINK_DEFAULT_FLUSH_SIZE        (64 * 1024)
+#define LOGGER_FD_SINK_DEFAULT_FLUSH_INTERVAL_MS 100
+
+typedef struct Logger_FdSink_t_ Logger_FdSink_t;
+
+extern const Logger_SinkOps_t g_Logger_FdSink_ops;
+
+// Starts the thread that flushes what waited 'config->flushIntervalMs'. The fd stays the caller's.
+// Returns MDN_STATUS_ERROR_BAD_ARGUMENT on Windows.
+mdn_Status_t mdn_Logger_FdSink_create(Logger_FdSink_t **sink, const mdn_Logger_FdConfig_t *config);
+
+#endif  // LOGGER_FD_SINK_H
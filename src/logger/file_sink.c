@@ -0,0 +1,21 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "file_sink.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+static bool mdn_Logger_FileSink_write(void *context, const char *data, size_t len) {
+    return fwrite(data, 1, len, context) == len;
+}
+
+const Logger_SinkOps_t g_Logger_FileSink_ops = {
+    .write = mdn_Logger_FileSink_write,
+    .close = NULL,  // The FILE belongs to the caller
+};
+
+mdn_Logger_Sink_t mdn_Logger_fileSink(FILE *stream) {
+    return (mdn_Logger_Sink_t){
+        .ops     = &g_Logger_FileSink_ops,
+        .context = stream,
+    };
+}
@@ -0,0 +1,9 @@
+#ifndef LOGGER_FILE_SINK_H
+#define LOGGER_FILE_SINK_H
+
+#include "sink.h"
+
+// The context is the FILE itself, which the sink never closes
+extern const Logger_SinkOps_t g_Logger_FileSink_ops;
+
+#endif  // LOGGER_FILE_SINK_H
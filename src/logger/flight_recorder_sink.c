@@ -0,0 +1,370 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "flight_recorder_sink.h"
+
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "binary_format.h"
+#include "file_sink.h"
+#include "mdn/mock_wrapper.h"
+#include "thread.h"
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif  // OS
+
+#ifdef MDN_LOGGER_SAFE_MODE
+# define IS_VALID_STREAM(stream) ((stream) != NULL)
+#endif  // MDN_LOGGER_SAFE_MODE
+
+#define FRAME_HEAD_SIZE              sizeof(uint32_t)
+#define HEADER_BLOCK_SIZE_OFFSET     8
+#define HEADER_BLOCKS_COUNT_OFFSET   16
+#define HEADER_SITES_CAPACITY_OFFSET 24
+#define HEADER_SITES_LEN_OFFSET      32
+#define HEADER_WRITE_POS_OFFSET      40
+#define HEADER_FIELDS_LEN            48
+#define MIN_BLOCKS_COUNT             2
+#define BYTE_BITS                    8
+
+static uint32_t mdn_Logger_FlightRecorderSink_loadU32(const unsigned char *bytes) {
+    uint32_t value = 0;
+
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        value |= (uint32_t)bytes[idx] << (idx * BYTE_BITS);
+    }
+
+    return value;
+}
+
+static uint64_t mdn_Logger_FlightRecorderSink_loadU64(const unsigned char *bytes) {
+    uint64_t value = 0;
+
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        value |= (uint64_t)bytes[idx] << (idx * BYTE_BITS);
+    }
+
+    return value;
+}
+
+#if (defined __APPLE__) || (defined __linux__)
+# define FLIGHT_RECORDER_FILE_MODE (S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)
+
+// The whole file is mapped once. Frames are copied into the ring under a mutex, then published by storing the new
+// 'writePos' into the header, which is all the reader of a crashed process' file relies on.
+struct Logger_FlightRecorderSink_t_ {
+    Logger_Mutex_t    mutex;
+    int               fd;
+    unsigned char    *mapping;
+    size_t            mappingSize;
+    _Atomic uint64_t *sitesLenField;  // In the mapped header, little-endian
+    _Atomic uint64_t *writePosField;
+    unsigned char    *sites;
+    size_t            sitesLen;
+    unsigned char    *ring;
+    size_t            ringSize;
+    uint64_t          writePos;
+};
+
+static void mdn_Logger_FlightRecorderSink_storeU32(unsigned char *bytes, uint32_t value) {
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        bytes[idx] = (unsigned char)(value >> (idx * BYTE_BITS));
+    }
+}
+
+// Returns the value whose bytes in memory are those of 'value' in little-endian order
+static uint64_t mdn_Logger_FlightRecorderSink_toLittleEndian(uint64_t value) {
+    unsigned char bytes[sizeof(value)];
+    uint64_t      littleEndianValue;
+
+    for (size_t idx = 0; idx < sizeof(value); ++idx) {
+        bytes[idx] = (unsigned char)(value >> (idx * BYTE_BITS));
+    }
+    memcpy(&littleEndianValue, bytes, sizeof(littleEndianValue));
+
+    return littleEndianValue;
+}
+
+// Ordered after the writes of what the new value covers, should the process stop right after
+static void mdn_Logger_FlightRecorderSink_publish(_Atomic uint64_t *field, uint64_t value) {
+    atomic_store_explicit(field, mdn_Logger_FlightRecorderSink_toLittleEndian(value), memory_order_release);
+}
+
+static bool mdn_Logger_FlightRecorderSink_write(void *context, const char *data, size_t len) {
+    Logger_FlightRecorderSink_t *sink     = context;
+    size_t                       frameLen = FRAME_HEAD_SIZE + len;
+    size_t                       blockLeft;
+    unsigned char               *frame;
+
+    if (len == 0) {
+        return true;
+    }
+    if (frameLen > LOGGER_FLIGHT_RECORDER_BLOCK_SIZE) {
+        return false;
+    }
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    blockLeft = LOGGER_FLIGHT_RECORDER_BLOCK_SIZE - (size_t)(sink->writePos % LOGGER_FLIGHT_RECORDER_BLOCK_SIZE);
+    if (frameLen > blockLeft) {
+        if (blockLeft >= FRAME_HEAD_SIZE) {
+            mdn_Logger_FlightRecorderSink_storeU32(sink->ring + (sink->writePos % sink->ringSize), 0);
+        }
+        // Published before the next block is overwritten, so that it is no longer read as the oldest whole one
+        sink->writePos += blockLeft;
+        mdn_Logger_FlightRecorderSink_publish(sink->writePosField, sink->writePos);
+    }
+    frame = sink->ring + (sink->writePos % sink->ringSize);
+    mdn_Logger_FlightRecorderSink_storeU32(frame, (uint32_t)len);
+    memcpy(frame + FRAME_HEAD_SIZE, data, len);
+    sink->writePos += frameLen;
+    mdn_Logger_FlightRecorderSink_publish(sink->writePosField, sink->writePos);
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return true;
+}
+
+static bool mdn_Logger_FlightRecorderSink_writeSite(void *context, const char *data, size_t len) {
+    Logger_FlightRecorderSink_t *sink    = context;
+    bool                         written = false;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    if (len <= (LOGGER_FLIGHT_RECORDER_SITES_CAPACITY - sink->sitesLen)) {
+        memcpy(sink->sites + sink->sitesLen, data, len);
+        sink->sitesLen += len;
+        mdn_Logger_FlightRecorderSink_publish(sink->sitesLenField, sink->sitesLen);
+        written = true;
+    }
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return written;
+}
+
+// The file keeps its full size, what matters is in the header
+static void mdn_Logger_FlightRecorderSink_close(void *context) {
+    Logger_FlightRecorderSink_t *sink = context;
+
+    (void)munmap(sink->mapping, sink->mappingSize);
+    (void)close(sink->fd);
+    mdn_Logger_Mutex_destroy(&sink->mutex);
+    free(sink);
+}
+
+static bool mdn_Logger_FlightRecorderSink_preallocate(int fd, size_t len) {
+# if defined __linux__
+    // Reserves the blocks up front, so writing to the mapping doesn't fault on a full disk
+    return posix_fallocate(fd, 0, (off_t)len) == 0;
+# else
+    return ftruncate(fd, (off_t)len) == 0;
+# endif  // OS
+}
+
+static bool mdn_Logger_FlightRecorderSink_map(Logger_FlightRecorderSink_t *sink) {
+    void    *mapping;
+    uint64_t headerFieldsArr[] = {LOGGER_FLIGHT_RECORDER_BLOCK_SIZE, sink->ringSize / LOGGER_FLIGHT_RECORDER_BLOCK_SIZE, LOGGER_FLIGHT_RECORDER_SITES_CAPACITY};
+
+    if (!mdn_Logger_FlightRecorderSink_preallocate(sink->fd, sink->mappingSize)) {
+        return false;
+    }
+    mapping = mmap(NULL, sink->mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, sink->fd, 0);
+    if (mapping == MAP_FAILED) {  // NOLINT(performance-no-int-to-ptr)
+        return false;
+    }
+    sink->mapping       = mapping;
+    sink->sitesLenField = (_Atomic uint64_t *)(void *)(sink->mapping + HEADER_SITES_LEN_OFFSET);
+    sink->writePosField = (_Atomic uint64_t *)(void *)(sink->mapping + HEADER_WRITE_POS_OFFSET);
+    sink->sites         = sink->mapping + LOGGER_FLIGHT_RECORDER_HEADER_SIZE;
+    sink->ring          = sink->sites + LOGGER_FLIGHT_RECORDER_SITES_CAPACITY;
+
+    // The file was just preallocated with zeros, which 'sitesLen' and 'writePos' start at
+    memcpy(sink->mapping, LOGGER_FLIGHT_RECORDER_MAGIC, LOGGER_FLIGHT_RECORDER_MAGIC_LEN);
+    sink->mapping[LOGGER_FLIGHT_RECORDER_MAGIC_LEN] = LOGGER_FLIGHT_RECORDER_VERSION;
+    for (size_t idx = 0; idx < (sizeof(headerFieldsArr) / sizeof(*headerFieldsArr)); ++idx) {
+        headerFieldsArr[idx] = mdn_Logger_FlightRecorderSink_toLittleEndian(headerFieldsArr[idx]);
+    }
+    memcpy(sink->mapping + HEADER_BLOCK_SIZE_OFFSET, headerFieldsArr, sizeof(headerFieldsArr));
+
+    return true;
+}
+
+mdn_Status_t mdn_Logger_FlightRecorderSink_create(Logger_FlightRecorderSink_t **sink, const char *path, size_t ringSize) {
+    Logger_FlightRecorderSink_t *sinkTemp;
+    size_t                       blocksCount;
+
+    if (ringSize == 0) {
+        ringSize = LOGGER_FLIGHT_RECORDER_DEFAULT_RING_SIZE;
+    }
+    blocksCount = (ringSize / LOGGER_FLIGHT_RECORDER_BLOCK_SIZE) + ((ringSize % LOGGER_FLIGHT_RECORDER_BLOCK_SIZE) != 0);
+    if (blocksCount < MIN_BLOCKS_COUNT) {
+        blocksCount = MIN_BLOCKS_COUNT;
+    }
+    if (blocksCount > ((SIZE_MAX - LOGGER_FLIGHT_RECORDER_HEADER_SIZE - LOGGER_FLIGHT_RECORDER_SITES_CAPACITY) / LOGGER_FLIGHT_RECORDER_BLOCK_SIZE)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+
+    sinkTemp = MDN_MW_malloc(sizeof(*sinkTemp));
+    if (sinkTemp == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    sinkTemp->ringSize    = blocksCount * LOGGER_FLIGHT_RECORDER_BLOCK_SIZE;
+    sinkTemp->mappingSize = LOGGER_FLIGHT_RECORDER_HEADER_SIZE + LOGGER_FLIGHT_RECORDER_SITES_CAPACITY + sinkTemp->ringSize;
+    sinkTemp->sitesLen    = 0;
+    sinkTemp->writePos    = 0;
+    sinkTemp->fd          = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, FLIGHT_RECORDER_FILE_MODE);  // NOLINT(hicpp-vararg)
+    if (sinkTemp->fd < 0) {
+        free(sinkTemp);
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    // Thread primitives only fail on resources exhaustion, as do preallocation and mapping, hence reported as memory allocation failures
+    if (!mdn_Logger_Mutex_init(&sinkTemp->mutex)) {
+        (void)close(sinkTemp->fd);
+        free(sinkTemp);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    if (!mdn_Logger_FlightRecorderSink_map(sinkTemp)) {
+        mdn_Logger_Mutex_destroy(&sinkTemp->mutex);
+        (void)close(sinkTemp->fd);
+        free(sinkTemp);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    *sink = sinkTemp;
+
+    return MDN_STATUS_SUCCESS;
+}
+#elif defined _WIN32
+static bool mdn_Logger_FlightRecorderSink_write(void *context, const char *data, size_t len) {
+    (void)context;
+    (void)data;
+    (void)len;
+    return false;
+}
+
+static bool mdn_Logger_FlightRecorderSink_writeSite(void *context, const char *data, size_t len) {
+    (void)context;
+    (void)data;
+    (void)len;
+    return false;
+}
+
+static void mdn_Logger_FlightRecorderSink_close(void *context) {
+    (void)context;
+}
+
+mdn_Status_t mdn_Logger_FlightRecorderSink_create(Logger_FlightRecorderSink_t **sink, const char *path, size_t ringSize) {
+    (void)sink;
+    (void)path;
+    (void)ringSize;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+#endif  // OS
+
+const Logger_SinkOps_t g_Logger_FlightRecorderSink_ops = {
+    .write = mdn_Logger_FlightRecorderSink_write,
+    .close = mdn_Logger_FlightRecorderSink_close,
+};
+
+const Logger_SinkOps_t g_Logger_FlightRecorderSink_sitesOps = {
+    .write = mdn_Logger_FlightRecorderSink_writeSite,
+    .close = NULL,  // Closed along with the records
+};
+
+static bool mdn_Logger_FlightRecorderSink_copy(FILE *inStream, long offset, size_t len, FILE *outStream, unsigned char *buffer) {
+    size_t chunkLen;
+
+    if (fseek(inStream, offset, SEEK_SET) != 0) {
+        return false;
+    }
+    while (len > 0) {
+        chunkLen = (len < LOGGER_FLIGHT_RECORDER_BLOCK_SIZE) ? len : LOGGER_FLIGHT_RECORDER_BLOCK_SIZE;
+        if ((fread(buffer, 1, chunkLen, inStream) != chunkLen) || (fwrite(buffer, 1, chunkLen, outStream) != chunkLen)) {
+            return false;
+        }
+        len -= chunkLen;
+    }
+
+    return true;
+}
+
+// Writes the records of the first 'blockLen' bytes of a block. A frame that doesn't fit ends it, as the writer would have.
+static bool mdn_Logger_FlightRecorderSink_extractBlock(FILE *inStream, long offset, size_t blockLen, FILE *outStream, unsigned char *buffer) {
+    size_t pos = 0;
+    size_t frameLen;
+
+    if ((fseek(inStream, offset, SEEK_SET) != 0) || (fread(buffer, 1, blockLen, inStream) != blockLen)) {
+        return false;
+    }
+    while ((blockLen - pos) >= FRAME_HEAD_SIZE) {
+        frameLen = mdn_Logger_FlightRecorderSink_loadU32(buffer + pos);
+        if ((frameLen == 0) || (frameLen > (blockLen - pos - FRAME_HEAD_SIZE))) {
+            break;
+        }
+        if (fwrite(buffer + pos + FRAME_HEAD_SIZE, 1, frameLen, outStream) != frameLen) {
+            return false;
+        }
+        pos += FRAME_HEAD_SIZE + frameLen;
+    }
+
+    return true;
+}
+
+mdn_Status_t mdn_Logger_extractFlightRecorder(FILE *flightRecorderStream, FILE *binaryStream) {
+    unsigned char  header[HEADER_FIELDS_LEN];
+    uint64_t       blocksCount;
+    uint64_t       sitesCapacity;
+    uint64_t       sitesLen;
+    uint64_t       writePos;
+    uint64_t       lastBlock;
+    uint64_t       firstBlock;
+    size_t         blockLen;
+    long           ringOffset;
+    unsigned char *buffer;
+    bool           extracted;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (!IS_VALID_STREAM(flightRecorderStream) || !IS_VALID_STREAM(binaryStream)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    if ((fread(header, 1, sizeof(header), flightRecorderStream) != sizeof(header)) ||
+        (memcmp(header, LOGGER_FLIGHT_RECORDER_MAGIC, LOGGER_FLIGHT_RECORDER_MAGIC_LEN) != 0) ||
+        (header[LOGGER_FLIGHT_RECORDER_MAGIC_LEN] != LOGGER_FLIGHT_RECORDER_VERSION) ||
+        (mdn_Logger_FlightRecorderSink_loadU64(header + HEADER_BLOCK_SIZE_OFFSET) != LOGGER_FLIGHT_RECORDER_BLOCK_SIZE)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    blocksCount   = mdn_Logger_FlightRecorderSink_loadU64(header + HEADER_BLOCKS_COUNT_OFFSET);
+    sitesCapacity = mdn_Logger_FlightRecorderSink_loadU64(header + HEADER_SITES_CAPACITY_OFFSET);
+    sitesLen      = mdn_Logger_FlightRecorderSink_loadU64(header + HEADER_SITES_LEN_OFFSET);
+    writePos      = mdn_Logger_FlightRecorderSink_loadU64(header + HEADER_WRITE_POS_OFFSET);
+    // Offsets are given to fseek(), so the whole file has to be addressable by a long
+    if ((blocksCount == 0) || (sitesLen > sitesCapacity) || (sitesCapacity > (uint64_t)(LONG_MAX - LOGGER_FLIGHT_RECORDER_HEADER_SIZE)) ||
+        (blocksCount > (((uint64_t)LONG_MAX - LOGGER_FLIGHT_RECORDER_HEADER_SIZE - sitesCapacity) / LOGGER_FLIGHT_RECORDER_BLOCK_SIZE))) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+
+    buffer = MDN_MW_malloc(LOGGER_FLIGHT_RECORDER_BLOCK_SIZE);
+    if (buffer == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+
+    // Site descriptions all come first, the decoder only needs them before the records of their site
+    mdn_Logger_BinaryFormat_writeHeader(&g_Logger_FileSink_ops, binaryStream);
+    extracted  = mdn_Logger_FlightRecorderSink_copy(flightRecorderStream, LOGGER_FLIGHT_RECORDER_HEADER_SIZE, (size_t)sitesLen, binaryStream, buffer);
+    ringOffset = (long)(LOGGER_FLIGHT_RECORDER_HEADER_SIZE + sitesCapacity);
+    lastBlock  = writePos / LOGGER_FLIGHT_RECORDER_BLOCK_SIZE;
+    firstBlock = (lastBlock >= blocksCount) ? (lastBlock - blocksCount + 1) : 0;
+    for (uint64_t block = firstBlock; extracted && (block <= lastBlock); ++block) {
+        blockLen  = (block == lastBlock) ? (size_t)(writePos % LOGGER_FLIGHT_RECORDER_BLOCK_SIZE) : LOGGER_FLIGHT_RECORDER_BLOCK_SIZE;
+        extracted = mdn_Logger_FlightRecorderSink_extractBlock(flightRecorderStream, ringOffset + (long)((block % blocksCount) * LOGGER_FLIGHT_RECORDER_BLOCK_SIZE),
+                                                               blockLen, binaryStream, buffer);
+    }
+    free(buffer);
+
+    return extracted ? MDN_STATUS_SUCCESS : MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
@@ -0,0 +1,34 @@
+#ifndef LOGGER_FLIGHT_RECORDER_SINK_H
+#define LOGGER_FLIGHT_RECORDER_SINK_H
+
+#include "mdn/logger.h"
+#include "sink.h"
+
+// File layout (all integers little-endian):
+//   header: "MDNLOGF" + version byte, u64 blockSize, u64 blocksCount, u64 sitesCapacity, u64 sitesLen, u64 writePos,
+//           padded to LOGGER_FLIGHT_RECORDER_HEADER_SIZE
+//   sites:  sitesCapacity bytes, the first sitesLen of them being binary format site descriptions (see binary_format.h)
+//   ring:   blocksCount blocks of blockSize bytes, each holding frames (u32 len, then a binary format record of len bytes).
+//           Frames don't cross blocks: a len of 0, or less room than a len, ends a block.
+// 'writePos' counts the bytes of every block ever started, as if the ring never wrapped: records are read in the blocksCount - 1
+// blocks before the one it falls in, then in that one up to it. Lengths are only updated once what they cover is written,
+// so the file can be read at any point the process may stop at.
+#define LOGGER_FLIGHT_RECORDER_MAGIC             "MDNLOGF"
+#define LOGGER_FLIGHT_RECORDER_MAGIC_LEN         7
+#define LOGGER_FLIGHT_RECORDER_VERSION           1
+#define LOGGER_FLIGHT_RECORDER_HEADER_SIZE       4096
+#define LOGGER_FLIGHT_RECORDER_BLOCK_SIZE        (64 * 1024)
+#define LOGGER_FLIGHT_RECORDER_DEFAULT_RING_SIZE (16 * 1024 * 1024)
+#define LOGGER_FLIGHT_RECORDER_SITES_CAPACITY    (256 * 1024)  // Once full, records of new call sites are kept as text
+
+typedef struct Logger_FlightRecorderSink_t_ Logger_FlightRecorderSink_t;
+
+// Records go to 'g_Logger_FlightRecorderSink_ops', and call site descriptions to 'g_Logger_FlightRecorderSink_sitesOps', with the same context
+extern const Logger_SinkOps_t g_Logger_FlightRecorderSink_ops;
+extern const Logger_SinkOps_t g_Logger_FlightRecorderSink_sitesOps;
+
+// Creates (or truncates) the file at 'path', and maps it whole. Returns MDN_STATUS_ERROR_BAD_ARGUMENT when it can't be opened,
+// and on platforms without memory-mapped files
+mdn_Status_t mdn_Logger_FlightRecorderSink_create(Logger_FlightRecorderSink_t **sink, const char *path, size_t ringSize);
+
+#endif  // LOGGER_FLIGHT_RECORDER_SINK_H
@@ -7,6 +7,8 @@ extern "C" {
 #endif  // __cplusplus
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include "mdn/status.h"
@@ -23,6 +25,9 @@ typedef enum mdn_Logger_loggingLevel_t_ {
 typedef enum mdn_Logger_loggingFormat_t_ {
     MDN_LOGGER_LOGGING_FORMAT_SCREEN,
     MDN_LOGGER_LOGGING_FORMAT_FILE,
+    MDN_LOGGER_LOGGING_FORMAT_BINARY,  // Unformatted arguments, turned into FILE format text by mdn_Logger_decodeBinary()
+    MDN_LOGGER_LOGGING_FORMAT_JSON,    // JSON Lines: one object per record with time, level, file, line, func, thread and msg
+    MDN_LOGGER_LOGGING_FORMAT_LOGFMT,  // Same fields as JSON, as space-separated key=value pairs
     MDN_LOGGER_LOGGING_FORMAT_COUNT,
 } mdn_Logger_loggingFormat_t;
 
@@ -30,53 +35,484 @@ typedef struct mdn_Logger_StreamConfig_t_ {
     FILE                      *stream;
     mdn_Logger_loggingLevel_t  loggingLevel;
     mdn_Logger_loggingFormat_t loggingFormat;
+    bool                       compressed;  // Only with MDN_LOGGER_LOGGING_FORMAT_FILE, see mdn_Logger_decompress()
+    bool                       ioUring;     // Written through io_uring where available, see mdn_Logger_addOutputStream()
 } mdn_Logger_StreamConfig_t;
 
+typedef struct mdn_Logger_FdConfig_t_ {
+    int                        fd;  // Stays the caller's, and mustn't be closed before mdn_Logger_deinit()
+    mdn_Logger_loggingLevel_t  loggingLevel;
+    mdn_Logger_loggingFormat_t loggingFormat;      // Any but MDN_LOGGER_LOGGING_FORMAT_BINARY
+    size_t                     flushSize;          // Bytes buffered before they are written (0 for 64 KiB)
+    size_t                     flushRecordsCount;  // Records buffered before they are written (0 for no limit)
+    unsigned                   flushIntervalMs;    // Longest a record stays buffered (0 for 100 ms)
+    bool                       ioUring;            // Submits batches through io_uring where available, see mdn_Logger_addFd()
+} mdn_Logger_FdConfig_t;
+
+typedef struct mdn_Logger_MmapFileConfig_t_ {
+    const char               *path;       // Created, or truncated if it exists
+    mdn_Logger_loggingLevel_t loggingLevel;
+    size_t                    chunkSize;  // Bytes preallocated and mapped at a time, rounded up to whole pages (0 for 16 MiB)
+} mdn_Logger_MmapFileConfig_t;
+
+typedef struct mdn_Logger_RotatingFileConfig_t_ {
+    const char               *path;  // Created, or appended to if it exists (and rotated first if already too big)
+    mdn_Logger_loggingLevel_t loggingLevel;
+    size_t                    maxFileSize;          // Rotates once the file reaches this size (0 for no limit)
+    unsigned                  rotationIntervalSec;  // Rotates on wall-clock multiples of this interval, e.g. 3600 on the hour (0 for none)
+    unsigned                  retainedCount;        // Rotated files kept as "<path>.1" (newest) to "<path>.<retainedCount>"
+    bool                      compress;             // Compresses rotated files into "<path>.<n>.mdnz", see mdn_Logger_decompress()
+} mdn_Logger_RotatingFileConfig_t;
+
+typedef struct mdn_Logger_FlightRecorderConfig_t_ {
+    const char               *path;          // Created, or truncated if it exists
+    mdn_Logger_loggingLevel_t loggingLevel;  // Usually MDN_LOGGER_LOGGING_LEVEL_DEBUG, whatever the levels of the other streams
+    size_t                    ringSize;      // Bytes of records kept, rounded up to whole 64 KiB blocks (0 for 16 MiB)
+} mdn_Logger_FlightRecorderConfig_t;
+
+typedef struct mdn_Logger_SinkBuffer_t_ {
+    const char *data;
+    size_t      len;
+} mdn_Logger_SinkBuffer_t;
+
+// Where the rendered records of a stream end up, see mdn_Logger_addSink(). 'write' gets one whole record at a time, and may be
+// called by several threads at once: it must write each record whole, without interleaving it with others. Functions return
+// false if any of the data was lost, which counts as a write error in mdn_Logger_getStats().
+typedef struct mdn_Logger_SinkOps_t_ {
+    bool (*write)(void *context, const char *data, size_t len);
+    // May be NULL. Several records at once, in order, handed over by the writer thread of mdn_Logger_initAsync() for the
+    // records it dequeued in a row. Never called concurrently with itself, but may be with 'write'.
+    bool (*writeBatch)(void *context, const mdn_Logger_SinkBuffer_t *buffersArr, size_t buffersArrLen);
+    bool (*flush)(void *context);  // May be NULL. Hands what was buffered over, after each CRITICAL record.
+    void (*close)(void *context);  // May be NULL. Called once no thread can be writing anymore.
+} mdn_Logger_SinkOps_t;
+
+typedef struct mdn_Logger_Sink_t_ {
+    const mdn_Logger_SinkOps_t *ops;      // Must stay valid until the sink is closed
+    void                       *context;  // Passed to the ops
+} mdn_Logger_Sink_t;
+
+typedef struct mdn_Logger_SinkConfig_t_ {
+    mdn_Logger_Sink_t          sink;
+    mdn_Logger_loggingLevel_t  loggingLevel;
+    mdn_Logger_loggingFormat_t loggingFormat;
+} mdn_Logger_SinkConfig_t;
+
+typedef struct mdn_Logger_UnixSocketConfig_t_ {
+    const char *path;          // Where the collector's socket is bound
+    bool        seqPacket;     // SOCK_SEQPACKET, for a collector that accepts connections, rather than SOCK_DGRAM
+    size_t      datagramSize;  // Records are packed whole into datagrams of up to that many bytes (0 for 16 KiB)
+    size_t      spillSize;     // Bytes of records held while the collector can't take them (0 for 1 MiB)
+} mdn_Logger_UnixSocketConfig_t;
+
+#define MDN_LOGGER_SHM_RING_MAX_PRODUCERS 128  // Sinks open on a ring at once, across all processes
+
+typedef struct mdn_Logger_ShmRingConfig_t_ {
+    const char *name;      // Of the shared memory object, "/<name>" as for shm_open()
+    size_t      ringSize;  // Bytes of records, rounded up to a multiple of 4 KiB (0 for 4 MiB). Ignored when the object already exists.
+} mdn_Logger_ShmRingConfig_t;
+
+typedef struct mdn_Logger_ShmRingProducerStats_t_ {
+    int      pid;
+    bool     open;           // Whether its sink is still open, or may be and its process is gone
+    uint64_t recordsCount;   // Written into the ring
+    uint64_t overrunsCount;  // Dropped because the ring was full, or didn't fit in a quarter of it
+} mdn_Logger_ShmRingProducerStats_t;
+
+typedef struct mdn_Logger_ShmRingStats_t_ {
+    mdn_Logger_ShmRingProducerStats_t producersArr[MDN_LOGGER_SHM_RING_MAX_PRODUCERS];
+    size_t                            producersArrLen;
+    uint64_t                          skippedLen;  // Bytes given up on by the drain, see mdn_Logger_drainShmRing()
+} mdn_Logger_ShmRingStats_t;
+
+typedef struct mdn_Logger_ShmRingDrain_t_ mdn_Logger_ShmRingDrain_t;
+
+// Called by mdn_Logger_drainShmRing() with each record, along with the pid of the process that wrote it.
+// Returns false to stop draining, the record is then handed over again by the next call.
+typedef bool (*mdn_Logger_ShmRingCallback_t)(int pid, const char *data, size_t len, void *userData);
+
+// Called by the sink of mdn_Logger_createCallbackSink() with each record, from as many threads at once as are logging.
+// Returns false if the record was lost.
+typedef bool (*mdn_Logger_SinkCallback_t)(const char *data, size_t len, void *userData);
+
+typedef enum mdn_Logger_timestampPrecision_t_ {
+    MDN_LOGGER_TIMESTAMP_PRECISION_MSEC,  // HH:MM:SS.mmm (default)
+    MDN_LOGGER_TIMESTAMP_PRECISION_USEC,  // HH:MM:SS.uuuuuu
+    MDN_LOGGER_TIMESTAMP_PRECISION_NSEC,  // HH:MM:SS.nnnnnnnnn
+    MDN_LOGGER_TIMESTAMP_PRECISION_COUNT,
+} mdn_Logger_timestampPrecision_t;
+
+typedef enum mdn_Logger_asyncFullPolicy_t_ {
+    MDN_LOGGER_ASYNC_FULL_POLICY_BLOCK,             // Wait for the writer thread to free a slot
+    MDN_LOGGER_ASYNC_FULL_POLICY_DROP_NEWEST,       // Discard the record being logged
+    MDN_LOGGER_ASYNC_FULL_POLICY_OVERWRITE_OLDEST,  // Discard the oldest queued record
+    MDN_LOGGER_ASYNC_FULL_POLICY_COUNT,
+} mdn_Logger_asyncFullPolicy_t;
+
+typedef struct mdn_Logger_AsyncConfig_t_ {
+    size_t                       queueCapacity;  // Number of records, rounded up to a power of two
+    size_t                       maxMessageLen;  // Longer messages are truncated
+    mdn_Logger_asyncFullPolicy_t fullPolicy;
+} mdn_Logger_AsyncConfig_t;
+
+typedef struct mdn_Logger_AsyncStats_t_ {
+    uint64_t droppedCount;      // Records discarded by MDN_LOGGER_ASYNC_FULL_POLICY_DROP_NEWEST
+    uint64_t overwrittenCount;  // Records discarded by MDN_LOGGER_ASYNC_FULL_POLICY_OVERWRITE_OLDEST
+} mdn_Logger_AsyncStats_t;
+
+#define MDN_LOGGER_STATS_MAX_STREAMS_COUNT     16  // Streams added while this many others are there aren't counted
+#define MDN_LOGGER_STATS_LATENCY_BUCKETS_COUNT 32
+
+typedef struct mdn_Logger_StreamStats_t_ {
+    FILE                      *stream;  // NULL unless added with mdn_Logger_addOutputStream()
+    mdn_Logger_loggingFormat_t loggingFormat;
+    uint64_t                   recordsCount;
+    uint64_t                   bytesCount;        // As rendered, before any compression
+    uint64_t                   writeErrorsCount;  // Records the stream failed to write whole
+} mdn_Logger_StreamStats_t;
+
+// Counts since mdn_Logger_init(), see mdn_Logger_getStats().
+// latencyBucketsArr[i] counts the durations below 2^i ns and of at least 2^(i-1) ns, the last bucket all longer ones as well.
+typedef struct mdn_Logger_Stats_t_ {
+    uint64_t                 recordsCountArr[MDN_LOGGER_LOGGING_LEVEL_COUNT];  // Records logged, whether or not a stream wanted them
+    uint64_t                 filteredCount;                                    // Records dropped by rate limits and sampling
+    uint64_t                 latencySampledCount;                              // Logging calls whose duration was measured
+    uint64_t                 latencyTotalNs;
+    uint64_t                 latencyBucketsArr[MDN_LOGGER_STATS_LATENCY_BUCKETS_COUNT];
+    size_t                   asyncQueueCapacity;     // 0 unless initialized with mdn_Logger_initAsync()
+    size_t                   asyncQueueDepth;        // Records waiting for the writer thread
+    uint64_t                 asyncDroppedCount;      // Same as mdn_Logger_AsyncStats_t
+    uint64_t                 asyncOverwrittenCount;
+    size_t                   streamsArrLen;
+    mdn_Logger_StreamStats_t streamsArr[MDN_LOGGER_STATS_MAX_STREAMS_COUNT];  // In the order of the streams
+} mdn_Logger_Stats_t;
+
+typedef struct mdn_Logger_StatsDumpConfig_t_ {
+    const char *path;  // Replaced as a whole by each dump, e.g. a "*.prom" file in the directory of node_exporter's textfile collector
+    unsigned    intervalMs;
+} mdn_Logger_StatsDumpConfig_t;
+
+typedef struct mdn_Logger_BacktraceConfig_t_ {
+    size_t                    recordsCount;   // Latest records held back per thread
+    size_t                    maxMessageLen;  // Longer messages are truncated
+    mdn_Logger_loggingLevel_t loggingLevel;   // Lowest level held back, usually MDN_LOGGER_LOGGING_LEVEL_DEBUG
+    mdn_Logger_loggingLevel_t flushLevel;     // Usually MDN_LOGGER_LOGGING_LEVEL_ERROR, above 'loggingLevel'
+} mdn_Logger_BacktraceConfig_t;
+
+// Describes one logging call site. Every expansion of the logging macros defines its own as a static, so its address
+// identifies the call site for as long as the program runs. Only holds constants, so that it needs no run-time initialization:
+// the format and MDN_LOGGER_FUNC_NAME are passed along with each record instead. Its 'flags', like the fields of the rate limit
+// and sample states below, are plain integers the library only accesses atomically, so that this header stays usable from C++.
+typedef struct mdn_Logger_CallSite_t_ {
+    const mdn_Logger_loggingLevel_t loggingLevel;
+    const int                       line;
+    const char *const               file;
+    const char *const               funcName;  // __func__, which the function globs of mdn_Logger_setSiteLevel() match
+    uint32_t                        flags;  // MDN_LOGGER_CALL_SITE_FLAG_*, owned by the library and only updated with atomic operations
+    struct mdn_Logger_CallSite_t_  *next;   // Owned by the library, links the registered call sites
+} mdn_Logger_CallSite_t;
+
+#define MDN_LOGGER_CALL_SITE_FLAG_REGISTERED 0x1U  // Known to the library, which keeps the other flags up to date
+#define MDN_LOGGER_CALL_SITE_FLAG_ENABLED    0x2U  // Records are wanted, by a stream's level or mdn_Logger_setSiteLevel()
+
+// State of one rate-limited call site, a zero-initialized static declared by the MDN_LOGGER_LOG_*_RATE_LIMITED() macros.
+// Only updated by the library, with atomic operations.
+typedef struct mdn_Logger_RateLimit_t_ {
+    uint64_t nextAllowedNs;    // When the bucket is full again, on the library's monotonic clock
+    uint64_t suppressedCount;  // Records dropped since the last one let through
+} mdn_Logger_RateLimit_t;
+
+// State of one sampled call site, a zero-initialized static declared by the MDN_LOGGER_LOG_*_SAMPLED() macros
+typedef struct mdn_Logger_Sample_t_ {
+    uint64_t callsCount;
+} mdn_Logger_Sample_t;
+
 #if (!defined MDN_LOGGER_SET_LEVEL_DEBUG) && (!defined MDN_LOGGER_SET_LEVEL_INFO) && (!defined MDN_LOGGER_SET_LEVEL_WARNING) && (!defined MDN_LOGGER_SET_LEVEL_ERROR) && (!defined MDN_LOGGER_SET_LEVEL_CRITICAL) && (!defined MDN_LOGGER_SET_LEVEL_NONE)
 # error Requested minimal logging level must be defined
 #endif
 
-#define MDN_LOGGER_FUNC_NAME                 __func__
-#define MDN_LOGGER_LOG_COMMON(logLevel, ...) mdn_Logger_log(logLevel, __FILE__, __LINE__, MDN_LOGGER_FUNC_NAME, __VA_ARGS__)
+// Lowest logging level wanted by any output stream (MDN_LOGGER_LOGGING_LEVEL_COUNT while there is none), maintained by the library.
+// Read by the logging macros before evaluating their arguments, so that disabled levels cost a single branch.
+extern int g_mdn_Logger_minEnabledLevel;
+
+#if (defined __GNUC__) || (defined __clang__)
+# define MDN_LOGGER_MIN_ENABLED_LEVEL() __atomic_load_n(&g_mdn_Logger_minEnabledLevel, __ATOMIC_RELAXED)
+#else
+# define MDN_LOGGER_MIN_ENABLED_LEVEL() (*(volatile int *)&g_mdn_Logger_minEnabledLevel)
+#endif
+
+#define MDN_LOGGER_IS_LEVEL_ENABLED(logLevel) ((int)(logLevel) >= MDN_LOGGER_MIN_ENABLED_LEVEL())
+
+#if (defined __GNUC__) || (defined __clang__)
+# define MDN_LOGGER_CALL_SITE_FLAGS(callSite) __atomic_load_n(&(callSite).flags, __ATOMIC_RELAXED)
+#else
+# define MDN_LOGGER_CALL_SITE_FLAGS(callSite) (*(volatile uint32_t *)&(callSite).flags)
+#endif
+
+// A single load once the call site is registered. The first time through, registers it to learn whether it is enabled.
+#define MDN_LOGGER_IS_CALL_SITE_ENABLED(callSite, flagsVar)                                                                  \
+    ((((flagsVar) = MDN_LOGGER_CALL_SITE_FLAGS(callSite)) & MDN_LOGGER_CALL_SITE_FLAG_ENABLED) ||                            \
+     ((((flagsVar) & MDN_LOGGER_CALL_SITE_FLAG_REGISTERED) == 0) && mdn_Logger_registerCallSite(&(callSite))))
+
+#define MDN_LOGGER_FUNC_NAME __func__
+
+// Every logging statement defines its call site, and passes its address along with the function name and the arguments.
+// Being a modifiable static, it can't be defined in a C inline function with external linkage (C11 6.7.4p3, "static but
+// declared in inline function"): the logging macros can be used in static inline functions, or mdn_Logger_log() instead.
+#define MDN_LOGGER_CALL_SITE_DEFINE(name, logLevel) \
+    static mdn_Logger_CallSite_t name = {logLevel, __LINE__, __FILE__, __func__, 0, NULL}
+
+#define MDN_LOGGER_LOG_COMMON(logLevel, ...)                                                                                                        \
+    do {                                                                                                                                            \
+        MDN_LOGGER_CALL_SITE_DEFINE(mdn_Logger_callSite_, logLevel);                                                                                \
+        uint32_t mdn_Logger_callSiteFlags_;                                                                                                         \
+        if (MDN_LOGGER_IS_CALL_SITE_ENABLED(mdn_Logger_callSite_, mdn_Logger_callSiteFlags_)) {                                                     \
+            mdn_Logger_logSite(&mdn_Logger_callSite_, MDN_LOGGER_FUNC_NAME, __VA_ARGS__);                                                           \
+        }                                                                                                                                           \
+    } while (0)
+
+// Token bucket of 'burst' records refilled at 'ratePerSec', per call site. Once records were dropped, the next one let through
+// is preceded by a record of the same level saying how many.
+#define MDN_LOGGER_LOG_RATE_LIMITED_COMMON(logLevel, ratePerSec, burst, ...)                                                                        \
+    do {                                                                                                                                            \
+        MDN_LOGGER_CALL_SITE_DEFINE(mdn_Logger_callSite_, logLevel);                                                                                \
+        static mdn_Logger_RateLimit_t mdn_Logger_rateLimit_;                                                                                        \
+        uint32_t                      mdn_Logger_callSiteFlags_;                                                                                    \
+        if (MDN_LOGGER_IS_CALL_SITE_ENABLED(mdn_Logger_callSite_, mdn_Logger_callSiteFlags_) &&                                                     \
+            mdn_Logger_allowRateLimited(&mdn_Logger_rateLimit_, (ratePerSec), (burst), &mdn_Logger_callSite_, MDN_LOGGER_FUNC_NAME)) {              \
+            mdn_Logger_logSite(&mdn_Logger_callSite_, MDN_LOGGER_FUNC_NAME, __VA_ARGS__);                                                           \
+        }                                                                                                                                           \
+    } while (0)
+
+// Logs the first and then every 'sampleEvery'-th call of the call site, arguments of the others aren't evaluated
+#define MDN_LOGGER_LOG_SAMPLED_COMMON(logLevel, sampleEvery, ...)                                                                                   \
+    do {                                                                                                                                            \
+        MDN_LOGGER_CALL_SITE_DEFINE(mdn_Logger_callSite_, logLevel);                                                                                \
+        static mdn_Logger_Sample_t mdn_Logger_sample_;                                                                                              \
+        uint32_t                   mdn_Logger_callSiteFlags_;                                                                                       \
+        if (MDN_LOGGER_IS_CALL_SITE_ENABLED(mdn_Logger_callSite_, mdn_Logger_callSiteFlags_) &&                                                     \
+            mdn_Logger_allowSampled(&mdn_Logger_sample_, (sampleEvery))) {                                                                          \
+            mdn_Logger_logSite(&mdn_Logger_callSite_, MDN_LOGGER_FUNC_NAME, __VA_ARGS__);                                                           \
+        }                                                                                                                                           \
+    } while (0)
 
 #if (defined MDN_LOGGER_SET_LEVEL_DEBUG)
-# define MDN_LOGGER_LOG_DEBUG(...) MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_DEBUG, __VA_ARGS__)
+# define MDN_LOGGER_LOG_DEBUG(...)                                 MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_DEBUG, __VA_ARGS__)
+# define MDN_LOGGER_LOG_DEBUG_RATE_LIMITED(ratePerSec, burst, ...) MDN_LOGGER_LOG_RATE_LIMITED_COMMON(MDN_LOGGER_LOGGING_LEVEL_DEBUG, ratePerSec, burst, __VA_ARGS__)
+# define MDN_LOGGER_LOG_DEBUG_SAMPLED(sampleEvery, ...)            MDN_LOGGER_LOG_SAMPLED_COMMON(MDN_LOGGER_LOGGING_LEVEL_DEBUG, sampleEvery, __VA_ARGS__)
 #else
 # define MDN_LOGGER_LOG_DEBUG(...)
+# define MDN_LOGGER_LOG_DEBUG_RATE_LIMITED(ratePerSec, burst, ...)
+# define MDN_LOGGER_LOG_DEBUG_SAMPLED(sampleEvery, ...)
 #endif
 
 #if (defined MDN_LOGGER_SET_LEVEL_DEBUG) || (defined MDN_LOGGER_SET_LEVEL_INFO)
-# define MDN_LOGGER_LOG_INFO(...) MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_INFO, __VA_ARGS__)
+# define MDN_LOGGER_LOG_INFO(...)                                 MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_INFO, __VA_ARGS__)
+# define MDN_LOGGER_LOG_INFO_RATE_LIMITED(ratePerSec, burst, ...) MDN_LOGGER_LOG_RATE_LIMITED_COMMON(MDN_LOGGER_LOGGING_LEVEL_INFO, ratePerSec, burst, __VA_ARGS__)
+# define MDN_LOGGER_LOG_INFO_SAMPLED(sampleEvery, ...)            MDN_LOGGER_LOG_SAMPLED_COMMON(MDN_LOGGER_LOGGING_LEVEL_INFO, sampleEvery, __VA_ARGS__)
 #else
 # define MDN_LOGGER_LOG_INFO(...)
+# define MDN_LOGGER_LOG_INFO_RATE_LIMITED(ratePerSec, burst, ...)
+# define MDN_LOGGER_LOG_INFO_SAMPLED(sampleEvery, ...)
 #endif
 
 #if (defined MDN_LOGGER_SET_LEVEL_DEBUG) || (defined MDN_LOGGER_SET_LEVEL_INFO) || (defined MDN_LOGGER_SET_LEVEL_WARNING)
-# define MDN_LOGGER_LOG_WARNING(...) MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_WARNING, __VA_ARGS__)
+# define MDN_LOGGER_LOG_WARNING(...)                                 MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_WARNING, __VA_ARGS__)
+# define MDN_LOGGER_LOG_WARNING_RATE_LIMITED(ratePerSec, burst, ...) MDN_LOGGER_LOG_RATE_LIMITED_COMMON(MDN_LOGGER_LOGGING_LEVEL_WARNING, ratePerSec, burst, __VA_ARGS__)
+# define MDN_LOGGER_LOG_WARNING_SAMPLED(sampleEvery, ...)            MDN_LOGGER_LOG_SAMPLED_COMMON(MDN_LOGGER_LOGGING_LEVEL_WARNING, sampleEvery, __VA_ARGS__)
 #else
 # define MDN_LOGGER_LOG_WARNING(...)
+# define MDN_LOGGER_LOG_WARNING_RATE_LIMITED(ratePerSec, burst, ...)
+# define MDN_LOGGER_LOG_WARNING_SAMPLED(sampleEvery, ...)
 #endif
 
 #if (defined MDN_LOGGER_SET_LEVEL_DEBUG) || (defined MDN_LOGGER_SET_LEVEL_INFO) || (defined MDN_LOGGER_SET_LEVEL_WARNING) || (defined MDN_LOGGER_SET_LEVEL_ERROR)
-# define MDN_LOGGER_LOG_ERROR(...) MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_ERROR, __VA_ARGS__)
+# define MDN_LOGGER_LOG_ERROR(...)                                 MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_ERROR, __VA_ARGS__)
+# define MDN_LOGGER_LOG_ERROR_RATE_LIMITED(ratePerSec, burst, ...) MDN_LOGGER_LOG_RATE_LIMITED_COMMON(MDN_LOGGER_LOGGING_LEVEL_ERROR, ratePerSec, burst, __VA_ARGS__)
+# define MDN_LOGGER_LOG_ERROR_SAMPLED(sampleEvery, ...)            MDN_LOGGER_LOG_SAMPLED_COMMON(MDN_LOGGER_LOGGING_LEVEL_ERROR, sampleEvery, __VA_ARGS__)
 #else
 # define MDN_LOGGER_LOG_ERROR(...)
+# define MDN_LOGGER_LOG_ERROR_RATE_LIMITED(ratePerSec, burst, ...)
+# define MDN_LOGGER_LOG_ERROR_SAMPLED(sampleEvery, ...)
 #endif
 
 #if (defined MDN_LOGGER_SET_LEVEL_DEBUG) || (defined MDN_LOGGER_SET_LEVEL_INFO) || (defined MDN_LOGGER_SET_LEVEL_WARNING) || (defined MDN_LOGGER_SET_LEVEL_ERROR) || (defined MDN_LOGGER_SET_LEVEL_CRITICAL)
-# define MDN_LOGGER_LOG_CRITICAL(...) MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_CRITICAL, __VA_ARGS__)
+# define MDN_LOGGER_LOG_CRITICAL(...)                                 MDN_LOGGER_LOG_COMMON(MDN_LOGGER_LOGGING_LEVEL_CRITICAL, __VA_ARGS__)
+# define MDN_LOGGER_LOG_CRITICAL_RATE_LIMITED(ratePerSec, burst, ...) MDN_LOGGER_LOG_RATE_LIMITED_COMMON(MDN_LOGGER_LOGGING_LEVEL_CRITICAL, ratePerSec, burst, __VA_ARGS__)
+# define MDN_LOGGER_LOG_CRITICAL_SAMPLED(sampleEvery, ...)            MDN_LOGGER_LOG_SAMPLED_COMMON(MDN_LOGGER_LOGGING_LEVEL_CRITICAL, sampleEvery, __VA_ARGS__)
 #else
 # define MDN_LOGGER_LOG_CRITICAL(...)
+# define MDN_LOGGER_LOG_CRITICAL_RATE_LIMITED(ratePerSec, burst, ...)
+# define MDN_LOGGER_LOG_CRITICAL_SAMPLED(sampleEvery, ...)
 #endif
 
 mdn_Status_t mdn_Logger_init(void);
 
+// Records are copied into a preallocated queue and written to the output streams by a background thread.
+// mdn_Logger_deinit() writes all queued records before returning.
+mdn_Status_t mdn_Logger_initAsync(mdn_Logger_AsyncConfig_t asyncConfig);
+
 mdn_Status_t mdn_Logger_deinit(void);
 
+// Streams can be added and removed while other threads are logging.
+// With 'ioUring', the stream is flushed, then written to through its file descriptor, as by mdn_Logger_addFd() with 'ioUring'
+// and the default thresholds; the caller mustn't write to it until it is removed. Any format but MDN_LOGGER_LOGGING_FORMAT_BINARY,
+// not compressed. Not supported on Windows (MDN_STATUS_ERROR_BAD_ARGUMENT).
 mdn_Status_t mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t streamConfig);
 
+// Once it returns, the logger no longer uses 'stream', which may then be closed. Records still queued in async mode aren't written to it.
+mdn_Status_t mdn_Logger_removeOutputStream(FILE *stream);
+
+// Writes to any destination through its sink, which is taken over: it is closed once removed, by mdn_Logger_deinit(), or right
+// away if it can't be added. Built-in sinks are those of mdn_Logger_fileSink() and mdn_Logger_create*Sink().
+mdn_Status_t mdn_Logger_addSink(mdn_Logger_SinkConfig_t sinkConfig);
+
+// Removes and closes the sink of the same ops and context, see mdn_Logger_removeOutputStream()
+mdn_Status_t mdn_Logger_removeSink(mdn_Logger_Sink_t sink);
+
+// Writes each record to 'stream' with fwrite(), which is what mdn_Logger_addOutputStream() does. Closing it leaves the FILE open.
+mdn_Logger_Sink_t mdn_Logger_fileSink(FILE *stream);
+
+// Writes each record straight to 'fd' with write(), and each batch with a single writev(), without the buffering and locking of a
+// FILE. Closing it leaves the fd open. Not supported on Windows (MDN_STATUS_ERROR_BAD_ARGUMENT).
+mdn_Status_t mdn_Logger_createRawFdSink(mdn_Logger_Sink_t *sink, int fd);
+
+// Keeps records in memory, up to 'capacity' bytes: records that don't fit whole are dropped (and counted as write errors)
+// until mdn_Logger_readMemorySink() makes room.
+mdn_Status_t mdn_Logger_createMemorySink(mdn_Logger_Sink_t *sink, size_t capacity);
+
+// Moves up to 'size' of the oldest bytes a memory sink holds into 'buffer', and returns how many. A record may be split
+// between two reads. Not to be called once the sink is closed.
+size_t mdn_Logger_readMemorySink(mdn_Logger_Sink_t sink, char *buffer, size_t size);
+
+// Hands each record over to 'callback', along with 'userData'
+mdn_Status_t mdn_Logger_createCallbackSink(mdn_Logger_Sink_t *sink, mdn_Logger_SinkCallback_t callback, void *userData);
+
+// Sends records to a local collector over a Unix socket, as many per datagram as fit, and the datagrams of a batch with a
+// single sendmmsg(). The socket never blocks: records the collector can't take yet, or sent while it is unreachable, are held
+// in a spill buffer and sent first next time, and records that don't fit there are dropped. Reconnects, at most every 100 ms,
+// when the collector went away or isn't there yet. Closing it waits up to 1 s for the collector to take what is held.
+// Not supported on Windows (MDN_STATUS_ERROR_BAD_ARGUMENT), nor with a path too long for a socket address.
+mdn_Status_t mdn_Logger_createUnixSocketSink(mdn_Logger_Sink_t *sink, mdn_Logger_UnixSocketConfig_t unixSocketConfig);
+
+// Writes records into a ring in a POSIX shared memory object, which any number of processes write to at once, and a single
+// drain process empties (see mdn_Logger_openShmRingDrain(), or mdn_logger_drain for MDN_LOGGER_LOGGING_FORMAT_FILE records).
+// The object is created by whichever of them comes first, and stays until shm_unlink(). Producers only ever copy a record
+// in and never wait, neither for each other nor for the drain: records that find the ring full are dropped, and counted as
+// overruns of their process. Fails with MDN_STATUS_ERROR_MEM_ALLOC once MDN_LOGGER_SHM_RING_MAX_PRODUCERS sinks are open.
+// Not supported on Windows (MDN_STATUS_ERROR_BAD_ARGUMENT).
+mdn_Status_t mdn_Logger_createShmRingSink(mdn_Logger_Sink_t *sink, mdn_Logger_ShmRingConfig_t shmRingConfig);
+
+// Writes to a file descriptor, in batches: records are buffered, and written together with a single writev() once
+// 'flushSize' bytes or 'flushRecordsCount' records are buffered, once the oldest waited 'flushIntervalMs', and after each
+// CRITICAL record. Unlike a FILE such as stderr, costs one syscall per batch rather than per record.
+// With 'ioUring' on Linux, batches are instead submitted through io_uring from a pool of 4 registered buffers, to the fd
+// registered as a fixed file: the thread that flushes doesn't wait for the write, unless 3 batches are already in flight.
+// Falls back to writev() where io_uring is unavailable (kernel older than 5.6, io_uring disabled, locked memory limit...).
+// Not supported on Windows (MDN_STATUS_ERROR_BAD_ARGUMENT).
+mdn_Status_t mdn_Logger_addFd(mdn_Logger_FdConfig_t fdConfig);
+
+// Writes MDN_LOGGER_LOGGING_FORMAT_FILE records straight into a memory-mapped, preallocated file, without a syscall per record.
+// The file is truncated to what was written by mdn_Logger_deinit(). Not supported on Windows (MDN_STATUS_ERROR_BAD_ARGUMENT).
+mdn_Status_t mdn_Logger_addMmapFile(mdn_Logger_MmapFileConfig_t mmapFileConfig);
+
+// Writes MDN_LOGGER_LOGGING_FORMAT_FILE records to a file the logger owns, and rotates by size and/or time.
+// Rotation and compression happen on a background thread; loggers only wait for the new file to be swapped in.
+// Not supported on Windows (MDN_STATUS_ERROR_BAD_ARGUMENT).
+mdn_Status_t mdn_Logger_addRotatingFile(mdn_Logger_RotatingFileConfig_t rotatingFileConfig);
+
+// Keeps the latest records in a fixed-size ring, in a memory-mapped file: records are copied into it in the binary format,
+// without formatting their messages or making a syscall. The pages belong to the kernel, so the ring outlives the process
+// crashing or being killed; read it with mdn_Logger_extractFlightRecorder() (or mdn_logger_flight) before the process
+// is started again, as that truncates the file. Not supported on Windows (MDN_STATUS_ERROR_BAD_ARGUMENT).
+mdn_Status_t mdn_Logger_addFlightRecorder(mdn_Logger_FlightRecorderConfig_t flightRecorderConfig);
+
+// Overrides the levels of the call sites in files matching 'fileGlob' and functions matching 'funcGlob' (NULL for any):
+// those of at least 'loggingLevel' are written to every stream whatever its level, the others aren't written at all.
+// Globs support '*' and '?', and match a whole path or any of its trailing components, e.g. "net/*.c" matches "src/net/parse.c".
+// A ":<line>" suffix to 'fileGlob' selects a single line. Later calls take precedence over earlier ones for the sites they both match.
+// Applies to call sites that haven't run yet as well. Disabled call sites cost the same single load as ones disabled by stream levels.
+mdn_Status_t mdn_Logger_setSiteLevel(const char *fileGlob, const char *funcGlob, mdn_Logger_loggingLevel_t loggingLevel);
+
+// Drops all mdn_Logger_setSiteLevel() overrides, also done by mdn_Logger_deinit()
+mdn_Status_t mdn_Logger_resetSiteLevels(void);
+
+// Applies to all output streams, expected to be set before logging starts
+mdn_Status_t mdn_Logger_setTimestampPrecision(mdn_Logger_timestampPrecision_t timestampPrecision);
+
+// Holds back, in memory and per thread, the latest records of at least 'loggingLevel' that the level of some stream keeps out.
+// When a thread logs a record of at least 'flushLevel', what it held back is written first, oldest first and between
+// "Backtrace start" and "Backtrace end" records, to the streams that didn't take it. Otherwise held back records are dropped
+// without ever being written. Replaces any previous backtrace, dropping what it held; mdn_Logger_deinit() drops it too.
+// Not to be called while other threads are logging.
+mdn_Status_t mdn_Logger_enableBacktrace(mdn_Logger_BacktraceConfig_t backtraceConfig);
+
+mdn_Status_t mdn_Logger_disableBacktrace(void);
+
+mdn_Status_t mdn_Logger_getAsyncStats(mdn_Logger_AsyncStats_t *asyncStats);
+
+// Adds up the counters logging threads keep for themselves. Logging only pays for plain increments of its own thread's counters
+// and for reading the clock around one call in 64, whether or not the stats are ever read. Records below the levels
+// of all streams never reach the library, so they aren't counted.
+mdn_Status_t mdn_Logger_getStats(mdn_Logger_Stats_t *stats);
+
+// Writes the stats in the Prometheus text exposition format
+mdn_Status_t mdn_Logger_writeStats(FILE *stream);
+
+// Writes the stats to 'path' every 'intervalMs' from a background thread, in place of any previous dump.
+// mdn_Logger_deinit() writes a last one before stopping it.
+mdn_Status_t mdn_Logger_startStatsDump(mdn_Logger_StatsDumpConfig_t statsDumpConfig);
+
+// For callers that can't define a call site, e.g. C inline functions with external linkage
 void mdn_Logger_log(mdn_Logger_loggingLevel_t loggingLevel, const char *file, int line, const char *func, const char *format, ...);
 
+// For callers that format messages themselves, such as the C++ front end in "mdn/logger.hpp". 'message' needs no null-terminator.
+void mdn_Logger_logMessage(mdn_Logger_loggingLevel_t loggingLevel, const char *file, int line, const char *funcName, const char *message, size_t messageLen);
+
+// Adds a call site to the registry mdn_Logger_setSiteLevel() works on, and returns whether it is enabled.
+// Called by the logging macros the first time through each call site.
+bool mdn_Logger_registerCallSite(mdn_Logger_CallSite_t *callSite);
+
+// What the logging macros call, with MDN_LOGGER_FUNC_NAME as 'funcName'
+void mdn_Logger_logSite(mdn_Logger_CallSite_t *callSite, const char *funcName, const char *format, ...);
+
+// Whether a record of a rate-limited call site may be logged, see MDN_LOGGER_LOG_RATE_LIMITED_COMMON(). Lock-free.
+// Logs the record of dropped ones itself, with 'funcName' like the call site's records.
+bool mdn_Logger_allowRateLimited(mdn_Logger_RateLimit_t *rateLimit, unsigned ratePerSec, unsigned burst, const mdn_Logger_CallSite_t *callSite, const char *funcName);
+
+// Whether a record of a sampled call site may be logged, see MDN_LOGGER_LOG_SAMPLED_COMMON(). Lock-free.
+bool mdn_Logger_allowSampled(mdn_Logger_Sample_t *sample, unsigned sampleEvery);
+
+// Writes the text MDN_LOGGER_LOGGING_FORMAT_FILE would have written for the records of a MDN_LOGGER_LOGGING_FORMAT_BINARY stream.
+// Both streams should be opened in binary mode. Timestamps are rendered in the local time of the decoding machine.
+// Doesn't require the library to be initialized.
+mdn_Status_t mdn_Logger_decodeBinary(FILE *binaryStream, FILE *textStream);
+
+// Writes the records left in the file of a flight recorder, oldest first, as a MDN_LOGGER_LOGGING_FORMAT_BINARY stream
+// for mdn_Logger_decodeBinary(). Meant for the file of a process that is no longer running. Both streams should be opened
+// in binary mode. Doesn't require the library to be initialized.
+mdn_Status_t mdn_Logger_extractFlightRecorder(FILE *flightRecorderStream, FILE *binaryStream);
+
+// Writes the original content of a compressed log to 'rawStream'. Compressed logs are made of independently compressed blocks
+// of up to 64 KiB, written once full (or when the stream is removed), so a crash loses at most the block being filled.
+// Both streams should be opened in binary mode. A log cut short is restored up to its last whole block.
+// Doesn't require the library to be initialized.
+mdn_Status_t mdn_Logger_decompress(FILE *compressedStream, FILE *rawStream);
+
+// Opens the ring of mdn_Logger_createShmRingSink() for draining, creating it if no producer did yet. A ring has a single drain
+// at a time. Doesn't require the library to be initialized. Not supported on Windows (MDN_STATUS_ERROR_BAD_ARGUMENT).
+mdn_Status_t mdn_Logger_openShmRingDrain(mdn_Logger_ShmRingDrain_t **drain, mdn_Logger_ShmRingConfig_t shmRingConfig);
+
+// Hands the records written since the last call over to 'callback', in the order they were reserved in, and frees their room.
+// Returns as soon as it reaches a record still being written. A record left unfinished for over 1 s, once no live producer has
+// one pending, was left by a producer that died while writing it: it is skipped along with every record reserved before the
+// drain got stuck on it. 'recordsCount' may be NULL.
+mdn_Status_t mdn_Logger_drainShmRing(mdn_Logger_ShmRingDrain_t *drain, mdn_Logger_ShmRingCallback_t callback, void *userData, size_t *recordsCount);
+
+mdn_Status_t mdn_Logger_getShmRingStats(const mdn_Logger_ShmRingDrain_t *drain, mdn_Logger_ShmRingStats_t *stats);
+
+void mdn_Logger_closeShmRingDrain(mdn_Logger_ShmRingDrain_t *drain);
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
@@ -0,0 +1,118 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+// Type-safe C++20 front end, e.g. mdn::log::info("Served {} in {} us", path, elapsedUs).
+// Format strings are checked against the arguments at compile time, messages are formatted with std::format_to_n()
+// on the caller's stack and handed over to mdn_Logger_logMessage(), without a printf-style parse at run time.
+// Levels are compiled out like the C macros, by defining one of the MDN_LOGGER_SET_LEVEL_* macros before including this header.
+// Records have no call site descriptor, so mdn_Logger_setSiteLevel() doesn't apply to them.
+
+#include <array>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "mdn/logger.h"
+
+namespace mdn::log {
+
+#if (defined MDN_LOGGER_SET_LEVEL_DEBUG)
+inline constexpr mdn_Logger_loggingLevel_t compiledMinLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG;
+#elif (defined MDN_LOGGER_SET_LEVEL_INFO)
+inline constexpr mdn_Logger_loggingLevel_t compiledMinLevel = MDN_LOGGER_LOGGING_LEVEL_INFO;
+#elif (defined MDN_LOGGER_SET_LEVEL_WARNING)
+inline constexpr mdn_Logger_loggingLevel_t compiledMinLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING;
+#elif (defined MDN_LOGGER_SET_LEVEL_ERROR)
+inline constexpr mdn_Logger_loggingLevel_t compiledMinLevel = MDN_LOGGER_LOGGING_LEVEL_ERROR;
+#elif (defined MDN_LOGGER_SET_LEVEL_CRITICAL)
+inline constexpr mdn_Logger_loggingLevel_t compiledMinLevel = MDN_LOGGER_LOGGING_LEVEL_CRITICAL;
+#else
+inline constexpr mdn_Logger_loggingLevel_t compiledMinLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
+#endif
+
+// Messages up to this size are formatted on the stack, longer ones are formatted again into a heap buffer
+inline constexpr std::size_t stackMessageSize = 512;
+
+// A std::format_string that also captures where it was written, since a default argument can't follow the format's arguments
+template <typename... Args>
+struct FormatString {
+    template <typename String>
+        requires std::convertible_to<const String &, std::string_view>
+    consteval FormatString(const String &formatStr, std::source_location sourceLocation = std::source_location::current())  // NOLINT(hicpp-explicit-conversions)
+        : format(formatStr), str(formatStr), location(sourceLocation) {}
+
+    std::format_string<Args...> format;
+    std::string_view            str;  // Same string, for std::vformat_to(), since not every standard library has format_string::get() yet
+    std::source_location        location;
+};
+
+namespace detail {
+
+template <typename... Args>
+void log(mdn_Logger_loggingLevel_t loggingLevel, const FormatString<std::type_identity_t<Args>...> &format, Args &&...args) {
+    std::array<char, stackMessageSize> stackMessage;  // NOLINT(cppcoreguidelines-pro-type-member-init)
+    std::string                        heapMessage;
+
+    // Same single branch as the C macros, before anything is formatted
+    if (!MDN_LOGGER_IS_LEVEL_ENABLED(loggingLevel)) {
+        return;
+    }
+
+    // Forwarded as they came, since std::format_string<Args...> is only checked against these exact types
+    const auto result = std::format_to_n(stackMessage.data(), static_cast<std::ptrdiff_t>(stackMessage.size()), format.format, std::forward<Args>(args)...);
+    if (static_cast<std::size_t>(result.size) <= stackMessage.size()) {
+        mdn_Logger_logMessage(loggingLevel, format.location.file_name(), static_cast<int>(format.location.line()), format.location.function_name(),
+                              stackMessage.data(), static_cast<std::size_t>(result.size));
+        return;
+    }
+    heapMessage.reserve(static_cast<std::size_t>(result.size));
+    std::vformat_to(std::back_inserter(heapMessage), format.str, std::make_format_args(args...));
+    mdn_Logger_logMessage(loggingLevel, format.location.file_name(), static_cast<int>(format.location.line()), format.location.function_name(),
+                          heapMessage.data(), heapMessage.size());
+}
+
+}  // namespace detail
+
+template <typename... Args>
+void debug(FormatString<std::type_identity_t<Args>...> format, Args &&...args) {
+    if constexpr (compiledMinLevel <= MDN_LOGGER_LOGGING_LEVEL_DEBUG) {
+        detail::log(MDN_LOGGER_LOGGING_LEVEL_DEBUG, format, std::forward<Args>(args)...);
+    }
+}
+
+template <typename... Args>
+void info(FormatString<std::type_identity_t<Args>...> format, Args &&...args) {
+    if constexpr (compiledMinLevel <= MDN_LOGGER_LOGGING_LEVEL_INFO) {
+        detail::log(MDN_LOGGER_LOGGING_LEVEL_INFO, format, std::forward<Args>(args)...);
+    }
+}
+
+template <typename... Args>
+void warning(FormatString<std::type_identity_t<Args>...> format, Args &&...args) {
+    if constexpr (compiledMinLevel <= MDN_LOGGER_LOGGING_LEVEL_WARNING) {
+        detail::log(MDN_LOGGER_LOGGING_LEVEL_WARNING, format, std::forward<Args>(args)...);
+    }
+}
+
+template <typename... Args>
+void error(FormatString<std::type_identity_t<Args>...> format, Args &&...args) {
+    if constexpr (compiledMinLevel <= MDN_LOGGER_LOGGING_LEVEL_ERROR) {
+        detail::log(MDN_LOGGER_LOGGING_LEVEL_ERROR, format, std::forward<Args>(args)...);
+    }
+}
+
+template <typename... Args>
+void critical(FormatString<std::type_identity_t<Args>...> format, Args &&...args) {
+    if constexpr (compiledMinLevel <= MDN_LOGGER_LOGGING_LEVEL_CRITICAL) {
+        detail::log(MDN_LOGGER_LOGGING_LEVEL_CRITICAL, format, std::forward<Args>(args)...);
+    }
+}
+
+}  // namespace mdn::log
+
+#endif  // LOGGER_HPP
@@ -0,0 +1,122 @@
+#include "line_buffer.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mdn/mock_wrapper.h"
+
+#define LINE_BUFFER_GROWTH_FACTOR 2
+
+void mdn_Logger_LineBuffer_init(Logger_LineBuffer_t *lineBuffer, char *storage, size_t storageLen) {
+    *lineBuffer = (Logger_LineBuffer_t){
+        .data      = storage,
+        .len       = 0,
+        .capacity  = storageLen,
+        .heapData  = NULL,
+        .truncated = false,
+    };
+}
+
+void mdn_Logger_LineBuffer_release(Logger_LineBuffer_t *lineBuffer) {
+    free(lineBuffer->heapData);
+    lineBuffer->heapData = NULL;
+}
+
+bool mdn_Logger_LineBuffer_reserve(Logger_LineBuffer_t *lineBuffer, size_t extraLen) {
+    size_t requiredCapacity;
+    size_t newCapacity;
+    char  *newData;
+
+    if (extraLen >= (SIZE_MAX - lineBuffer->len)) {
+        return false;
+    }
+    requiredCapacity = lineBuffer->len + extraLen + 1;
+    if (requiredCapacity <= lineBuffer->capacity) {
+        return true;
+    }
+
+    newCapacity = lineBuffer->capacity * LINE_BUFFER_GROWTH_FACTOR;
+    if (newCapacity < requiredCapacity) {
+        newCapacity = requiredCapacity;
+    }
+    if (lineBuffer->heapData == NULL) {
+        newData = MDN_MW_malloc(newCapacity);
+        if (newData == NULL) {
+            return false;
+        }
+        memcpy(newData, lineBuffer->data, lineBuffer->len);
+    } else {
+        newData = MDN_MW_realloc(lineBuffer->heapData, newCapacity);
+        if (newData == NULL) {
+            return false;
+        }
+    }
+    lineBuffer->heapData = newData;
+    lineBuffer->data     = newData;
+    lineBuffer->capacity = newCapacity;
+
+    return true;
+}
+
+void mdn_Logger_LineBuffer_append(Logger_LineBuffer_t *lineBuffer, const char *str, size_t strLen) {
+    if (!mdn_Logger_LineBuffer_reserve(lineBuffer, strLen)) {
+        lineBuffer->truncated = true;
+        strLen                = lineBuffer->capacity - lineBuffer->len - 1;
+    }
+    memcpy(lineBuffer->data + lineBuffer->len, str, strLen);
+    lineBuffer->len += strLen;
+}
+
+void mdn_Logger_LineBuffer_appendStr(Logger_LineBuffer_t *lineBuffer, const char *str) {
+    mdn_Logger_LineBuffer_append(lineBuffer, str, strlen(str));
+}
+
+void mdn_Logger_LineBuffer_appendPadded(Logger_LineBuffer_t *lineBuffer, const char *str, size_t width) {
+    size_t strLen = strlen(str);
+
+    mdn_Logger_LineBuffer_append(lineBuffer, str, strLen);
+    if (strLen >= width) {
+        return;
+    }
+    if (!mdn_Logger_LineBuffer_reserve(lineBuffer, width - strLen)) {
+        lineBuffer->truncated = true;
+        return;
+    }
+    memset(lineBuffer->data + lineBuffer->len, ' ', width - strLen);
+    lineBuffer->len += width - strLen;
+}
+
+void mdn_Logger_LineBuffer_appendFormatV(Logger_LineBuffer_t *lineBuffer, const char *format, va_list args) {
+    va_list argsCopy;
+    size_t  availableLen = lineBuffer->capacity - lineBuffer->len;
+    int     formattedLen;
+
+    // First pass formats straight into the free space, which is enough for the vast majority of records
+    va_copy(argsCopy, args);
+    formattedLen = vsnprintf(lineBuffer->data + lineBuffer->len, availableLen, format, argsCopy);  // NOLINT(clang-diagnostic-format-nonliteral)
+    va_end(argsCopy);
+    if (formattedLen < 0) {
+        return;
+    }
+
+    // Second pass, only when the first one was cut short, now that the exact length is known
+    if ((size_t)formattedLen >= availableLen) {
+        if (!mdn_Logger_LineBuffer_reserve(lineBuffer, (size_t)formattedLen)) {
+            lineBuffer->truncated  = true;
+            lineBuffer->len       += availableLen - 1;
+            return;
+        }
+        (void)vsnprintf(lineBuffer->data + lineBuffer->len, (size_t)formattedLen + 1, format, args);  // NOLINT(clang-diagnostic-format-nonliteral)
+    }
+    lineBuffer->len += (size_t)formattedLen;
+}
+
+void mdn_Logger_LineBuffer_appendFormat(Logger_LineBuffer_t *lineBuffer, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    mdn_Logger_LineBuffer_appendFormatV(lineBuffer, format, args);
+    va_end(args);
+}
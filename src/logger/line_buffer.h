@@ -0,0 +1,36 @@
+#ifndef LOGGER_LINE_BUFFER_H
+#define LOGGER_LINE_BUFFER_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Buffer a record is rendered into before being written with a single call.
+// Starts on caller-provided storage (typically thread-local), and moves to the heap only if a record doesn't fit.
+typedef struct Logger_LineBuffer_t_ {
+    char  *data;
+    size_t len;
+    size_t capacity;
+    char  *heapData;   // Owned allocation, NULL while 'data' is the caller's storage
+    bool   truncated;  // Set if growing failed, in which case the content is cut short
+} Logger_LineBuffer_t;
+
+void mdn_Logger_LineBuffer_init(Logger_LineBuffer_t *lineBuffer, char *storage, size_t storageLen);
+
+void mdn_Logger_LineBuffer_release(Logger_LineBuffer_t *lineBuffer);
+
+// Makes room for 'extraLen' more bytes (plus a null-terminator), returns false if it fails
+bool mdn_Logger_LineBuffer_reserve(Logger_LineBuffer_t *lineBuffer, size_t extraLen);
+
+void mdn_Logger_LineBuffer_append(Logger_LineBuffer_t *lineBuffer, const char *str, size_t strLen);
+
+void mdn_Logger_LineBuffer_appendStr(Logger_LineBuffer_t *lineBuffer, const char *str);
+
+// Appends 'str' left-aligned in a 'width' wide column (same as "%-*s")
+void mdn_Logger_LineBuffer_appendPadded(Logger_LineBuffer_t *lineBuffer, const char *str, size_t width);
+
+void mdn_Logger_LineBuffer_appendFormatV(Logger_LineBuffer_t *lineBuffer, const char *format, va_list args);
+
+void mdn_Logger_LineBuffer_appendFormat(Logger_LineBuffer_t *lineBuffer, const char *format, ...);
+
+#endif  // LOGGER_LINE_BUFFER_H
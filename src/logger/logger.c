@@ -1,88 +1,137 @@
 #define MDN_LOGGER_SET_LEVEL_NONE
 #include "mdn/logger.h"
 
+#include <limits.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
-
-#if (defined __APPLE__) || (defined __linux__)
-# include <sys/time.h>
-#elif defined _WIN32
-# include <Windows.h>
-#endif  // OS
+#include <string.h>
 
+#include "async_queue.h"
+#include "backtrace.h"
+#include "binary_format.h"
+#include "call_site_registry.h"
+#include "compressed_sink.h"
+#include "epoch.h"
+#include "fast_printf.h"
+#include "fd_sink.h"
+#include "file_sink.h"
+#include "flight_recorder_sink.h"
+#include "line_buffer.h"
+#include "logger_internal.h"
 #include "mdn/mock_wrapper.h"
+#include "mmap_sink.h"
+#include "rotating_sink.h"
+#include "stats.h"
+#include "structured_format.h"
+#include "text_format.h"
+#include "thread.h"
+#include "timestamp.h"
 
 #ifdef MDN_LOGGER_SAFE_MODE
-# define IS_VALID_LOGGING_LEVEL(loggingLevel)   ((0 <= (loggingLevel)) && ((loggingLevel) < MDN_LOGGER_LOGGING_LEVEL_COUNT))
-# define IS_VALID_LOGGING_FORMAT(loggingFormat) ((0 <= (loggingFormat)) && ((loggingFormat) < MDN_LOGGER_LOGGING_FORMAT_COUNT))
+# define IS_VALID_LOGGING_LEVEL(loggingLevel)        ((0 <= (loggingLevel)) && ((loggingLevel) < MDN_LOGGER_LOGGING_LEVEL_COUNT))
+# define IS_VALID_LOGGING_FORMAT(loggingFormat)      ((0 <= (loggingFormat)) && ((loggingFormat) < MDN_LOGGER_LOGGING_FORMAT_COUNT))
+# define IS_VALID_ASYNC_FULL_POLICY(asyncFullPolicy) ((0 <= (asyncFullPolicy)) && ((asyncFullPolicy) < MDN_LOGGER_ASYNC_FULL_POLICY_COUNT))
+# define IS_VALID_TIMESTAMP_PRECISION(precision)     ((0 <= (precision)) && ((precision) < MDN_LOGGER_TIMESTAMP_PRECISION_COUNT))
 #endif  // MDN_LOGGER_SAFE_MODE
 
+#define ASYNC_WRITER_IDLE_WAIT_MS 100
+#define LINE_BUFFER_STORAGE_SIZE  1024
+
+#define LOGGER_BATCH_RECORDS_COUNT 64  // Dequeued in a row by the async writer before its batch is written
+#define LOGGER_BATCH_ENTRIES_COUNT 256
+#define LOGGER_BATCH_DATA_SIZE     (16 * 1024)
+#define LOGGER_BATCH_NO_OFFSET     SIZE_MAX
+
+#define LOGGER_FORMATTED_MESSAGE_FORMAT "%.*s"  // How binary streams store messages that were formatted by the caller
+
+#define LOGGER_BACKTRACE_START_MESSAGE "Backtrace start"
+#define LOGGER_BACKTRACE_END_MESSAGE   "Backtrace end"
+
+typedef struct Logger_Stream_t_ {
+    mdn_Logger_StreamConfig_t config;       // 'config.stream' is NULL unless added with mdn_Logger_addOutputStream()
+    Logger_BinarySites_t     *binarySites;  // Only for MDN_LOGGER_LOGGING_FORMAT_BINARY
+    const Logger_SinkOps_t   *sinkOps;
+    void                     *sinkContext;
+    size_t                    statsSlot;    // LOGGER_STATS_NO_STREAM_SLOT when the stream isn't counted
+} Logger_Stream_t;
+
+// Immutable once published, replaced as a whole when streams are added or removed
+typedef struct Logger_Streams_t_ {
+    size_t          streamsArrLen;
+    Logger_Stream_t streamsArr[];
+} Logger_Streams_t;
+
+typedef struct Logger_BatchEntry_t_ {
+    const Logger_Stream_t *stream;
+    size_t                 offset;  // In 'data'
+    size_t                 len;
+} Logger_BatchEntry_t;
+
+// Records the async writer rendered for the streams whose sink has a 'writeBatch' op, written with a single call per stream
+// once LOGGER_BATCH_RECORDS_COUNT records were dequeued, the queue is empty, or the batch is full. The streams snapshot is
+// held for the whole batch, so its entries can point to its streams.
+typedef struct Logger_Batch_t_ {
+    const Logger_Streams_t *streams;
+    unsigned                epochToken;
+    size_t                  lastOffset;  // Of the last record copied to 'data', LOGGER_BATCH_NO_OFFSET if there is none to share
+    size_t                  entriesArrLen;
+    Logger_BatchEntry_t     entriesArr[LOGGER_BATCH_ENTRIES_COUNT];
+    size_t                  dataLen;
+    char                    data[LOGGER_BATCH_DATA_SIZE];
+} Logger_Batch_t;
+
+typedef struct Logger_AsyncState_t_ {
+    Logger_AsyncQueue_t         *queue;
+    mdn_Logger_asyncFullPolicy_t fullPolicy;
+    Logger_Thread_t              writerThread;
+    Logger_Mutex_t               writerMutex;  // Held by the writer thread while it goes to sleep
+    Logger_Cond_t                writerCond;
+    atomic_bool                  writerSleeping;
+    atomic_bool                  stopRequested;
+    _Atomic uint64_t             droppedCount;
+    _Atomic uint64_t             overwrittenCount;
+    Logger_Batch_t               batch;  // Only used by the writer thread
+} Logger_AsyncState_t;
+
 typedef struct Logger_InternalState_t_ {
-    mdn_Logger_StreamConfig_t *streamsArr;
-    size_t                     streamsArrLen;
+    _Atomic(Logger_Streams_t *)     streams;       // NULL while there are no streams
+    Logger_Mutex_t                  streamsMutex;  // Serializes the replacements of 'streams'
+    Logger_AsyncState_t            *asyncState;    // NULL unless initialized with mdn_Logger_initAsync()
+    Logger_StatsDump_t             *statsDump;     // NULL unless started with mdn_Logger_startStatsDump()
+    Logger_Backtrace_t             *backtrace;     // NULL unless enabled with mdn_Logger_enableBacktrace()
+    mdn_Logger_BacktraceConfig_t    backtraceConfig;
+    atomic_int                      minStreamLevel;  // Lowest and highest levels of the streams, MDN_LOGGER_LOGGING_LEVEL_COUNT
+    atomic_int                      maxStreamLevel;  // while there is none
+    mdn_Logger_timestampPrecision_t timestampPrecision;
+    bool                            useCoarseClock;
 } Logger_InternalState_t;
 
 static Logger_InternalState_t *g_Logger_internalState;
 
-typedef struct mdn_Logger_logToStreamArguments_t_ {
-    size_t                    streamIndex;
-    mdn_Logger_loggingLevel_t loggingLevel;
-    const char               *file;
-    int                       line;
-    const char               *funcName;
-    const char               *format;
-    va_list                   args;
-} mdn_Logger_logToStreamArguments_t;
+// Lets logging threads read 'streams' without locking, and stream changes know when the previous snapshot can be freed
+static Logger_Epoch_t g_Logger_streamsEpoch;
 
-static const char *g_mdn_Logger_logLevelToStrMap[] = {
-    [MDN_LOGGER_LOGGING_LEVEL_DEBUG]    = "DEBUG",
-    [MDN_LOGGER_LOGGING_LEVEL_INFO]     = "INFO",
-    [MDN_LOGGER_LOGGING_LEVEL_WARNING]  = "WARNING",
-    [MDN_LOGGER_LOGGING_LEVEL_ERROR]    = "ERROR",
-    [MDN_LOGGER_LOGGING_LEVEL_CRITICAL] = "CRITICAL",
-};
-#define ARRAY_LEN(array) (sizeof(array) / sizeof(*(array)))
-_Static_assert(ARRAY_LEN(g_mdn_Logger_logLevelToStrMap) == MDN_LOGGER_LOGGING_LEVEL_COUNT,
-               "Error: seems like a description string for a log level is missing");
-
-#define ANSI_ESC                      "\033"
-#define ANSI_PARAM_BEGIN              "["
-#define ANSI_PARAM_END                "m"
-#define COLOR_PREFIX                  ANSI_ESC ANSI_PARAM_BEGIN
-#define COLOR_SUFFIX                  ANSI_PARAM_END
-#define COLOR(color)                  COLOR_PREFIX color COLOR_SUFFIX
-#define LOGGER_TERMINAL_COLOR_GRAY    COLOR("90")
-#define LOGGER_TERMINAL_COLOR_RESET   COLOR("0")
-#define LOGGER_TERMINAL_COLOR_YELLOW  COLOR("33")
-#define LOGGER_TERMINAL_COLOR_RED     COLOR("31")
-#define LOGGER_TERMINAL_COLOR_MAGENTA COLOR("35")
-
-typedef enum mdn_Logger_loggingColor_t_ {
-    LOGGING_COLOR_GRAY,
-    LOGGING_COLOR_RESET,
-    LOGGING_COLOR_YELLOW,
-    LOGGING_COLOR_RED,
-    LOGGING_COLOR_MAGENTA,
-    LOGGING_COLOR_COUNT,
-} mdn_Logger_loggingColor_t;
-
-static mdn_Logger_loggingColor_t g_mdn_Logger_loggingLevelToColorMap[] = {
-    [MDN_LOGGER_LOGGING_LEVEL_DEBUG]    = LOGGING_COLOR_GRAY,
-    [MDN_LOGGER_LOGGING_LEVEL_INFO]     = LOGGING_COLOR_RESET,
-    [MDN_LOGGER_LOGGING_LEVEL_WARNING]  = LOGGING_COLOR_YELLOW,
-    [MDN_LOGGER_LOGGING_LEVEL_ERROR]    = LOGGING_COLOR_RED,
-    [MDN_LOGGER_LOGGING_LEVEL_CRITICAL] = LOGGING_COLOR_MAGENTA,
-};
+int g_mdn_Logger_minEnabledLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
 
-static const char *g_Logger_colorToTerminalColorMap[] = {
-    [LOGGING_COLOR_GRAY]    = LOGGER_TERMINAL_COLOR_GRAY,
-    [LOGGING_COLOR_RESET]   = LOGGER_TERMINAL_COLOR_RESET,
-    [LOGGING_COLOR_YELLOW]  = LOGGER_TERMINAL_COLOR_YELLOW,
-    [LOGGING_COLOR_RED]     = LOGGER_TERMINAL_COLOR_RED,
-    [LOGGING_COLOR_MAGENTA] = LOGGER_TERMINAL_COLOR_MAGENTA,
-};
+#if (defined __GNUC__) || (defined __clang__)
+# define LOGGER_SET_MIN_ENABLED_LEVEL(loggingLevel) __atomic_store_n(&g_mdn_Logger_minEnabledLevel, (int)(loggingLevel), __ATOMIC_RELAXED)
+#else
+# define LOGGER_SET_MIN_ENABLED_LEVEL(loggingLevel) (*(volatile int *)&g_mdn_Logger_minEnabledLevel = (int)(loggingLevel))
+#endif
+
+// Records that don't fit are rendered into a heap buffer that is freed right after the write
+static _Thread_local char g_Logger_lineBufferStorage[LINE_BUFFER_STORAGE_SIZE];
+
+typedef struct mdn_Logger_logToStreamArguments_t_ {
+    const Logger_Stream_t *stream;
+    const Logger_Record_t *record;
+    const char            *message;  // Already formatted, of record->messageLen bytes. NULL when 'format' and 'args' are to be formatted.
+    const char            *format;
+    va_list                args;
+    Logger_Batch_t        *batch;  // NULL unless called by the async writer
+} mdn_Logger_logToStreamArguments_t;
 
 mdn_Status_t mdn_Logger_init(void) {
 #ifdef MDN_LOGGER_SAFE_MODE
@@ -91,35 +140,215 @@ mdn_Status_t mdn_Logger_init(void) {
     }
 #endif  // MDN_LOGGER_SAFE_MODE
 
+    if (!mdn_Logger_Stats_init()) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
     g_Logger_internalState = MDN_MW_malloc(sizeof(*g_Logger_internalState));
     if (g_Logger_internalState == NULL) {
         return MDN_STATUS_ERROR_MEM_ALLOC;
     }
 
     *g_Logger_internalState = (Logger_InternalState_t){
-        .streamsArr    = NULL,
-        .streamsArrLen = 0,
+        .asyncState         = NULL,
+        .statsDump          = NULL,
+        .backtrace          = NULL,
+        .timestampPrecision = MDN_LOGGER_TIMESTAMP_PRECISION_MSEC,
+        .useCoarseClock     = mdn_Logger_Timestamp_isCoarseClockEnough(MDN_LOGGER_TIMESTAMP_PRECISION_MSEC),
     };
+    atomic_init(&g_Logger_internalState->streams, NULL);
+    atomic_init(&g_Logger_internalState->minStreamLevel, MDN_LOGGER_LOGGING_LEVEL_COUNT);
+    atomic_init(&g_Logger_internalState->maxStreamLevel, MDN_LOGGER_LOGGING_LEVEL_COUNT);
+    // Thread primitives only fail on resources exhaustion, hence reported as memory allocation failures
+    if (!mdn_Logger_Mutex_init(&g_Logger_internalState->streamsMutex)) {
+        free(g_Logger_internalState);
+        g_Logger_internalState = NULL;
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
 
     return MDN_STATUS_SUCCESS;
 }
 
+static void mdn_Logger_asyncWriterThread(void *arg);
+
+mdn_Status_t mdn_Logger_initAsync(mdn_Logger_AsyncConfig_t asyncConfig) {
+    Logger_AsyncState_t *asyncState;
+    mdn_Status_t         status;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((asyncConfig.queueCapacity == 0) || (asyncConfig.maxMessageLen == 0)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (!IS_VALID_ASYNC_FULL_POLICY(asyncConfig.fullPolicy)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    status = mdn_Logger_init();
+    if (status != MDN_STATUS_SUCCESS) {
+        return status;
+    }
+
+    asyncState = MDN_MW_malloc(sizeof(*asyncState));
+    if (asyncState == NULL) {
+        (void)mdn_Logger_deinit();
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    asyncState->fullPolicy = asyncConfig.fullPolicy;
+    atomic_init(&asyncState->writerSleeping, false);
+    atomic_init(&asyncState->stopRequested, false);
+    atomic_init(&asyncState->droppedCount, 0);
+    atomic_init(&asyncState->overwrittenCount, 0);
+
+    asyncState->queue = mdn_Logger_AsyncQueue_create(asyncConfig.queueCapacity, asyncConfig.maxMessageLen);
+    if (asyncState->queue == NULL) {
+        free(asyncState);
+        (void)mdn_Logger_deinit();
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+
+    status = MDN_STATUS_ERROR_MEM_ALLOC;
+    if (mdn_Logger_Mutex_init(&asyncState->writerMutex)) {
+        if (mdn_Logger_Cond_init(&asyncState->writerCond)) {
+            if (mdn_Logger_Thread_create(&asyncState->writerThread, mdn_Logger_asyncWriterThread, asyncState)) {
+                g_Logger_internalState->asyncState = asyncState;
+                return MDN_STATUS_SUCCESS;
+            }
+            mdn_Logger_Cond_destroy(&asyncState->writerCond);
+        }
+        mdn_Logger_Mutex_destroy(&asyncState->writerMutex);
+    }
+    mdn_Logger_AsyncQueue_destroy(asyncState->queue);
+    free(asyncState);
+    (void)mdn_Logger_deinit();
+
+    return status;
+}
+
+static void mdn_Logger_asyncStop(Logger_AsyncState_t *asyncState) {
+    atomic_store(&asyncState->stopRequested, true);
+    mdn_Logger_Mutex_lock(&asyncState->writerMutex);
+    mdn_Logger_Cond_signal(&asyncState->writerCond);
+    mdn_Logger_Mutex_unlock(&asyncState->writerMutex);
+    mdn_Logger_Thread_join(&asyncState->writerThread);
+
+    mdn_Logger_Cond_destroy(&asyncState->writerCond);
+    mdn_Logger_Mutex_destroy(&asyncState->writerMutex);
+    mdn_Logger_AsyncQueue_destroy(asyncState->queue);
+    free(asyncState);
+}
+
+// Once no thread can be logging to 'stream' anymore
+static void mdn_Logger_closeStream(const Logger_Stream_t *stream) {
+    mdn_Logger_BinarySites_destroy(stream->binarySites);
+    if (stream->sinkOps->close != NULL) {
+        stream->sinkOps->close(stream->sinkContext);
+    }
+    mdn_Logger_Stats_releaseStreamSlot(stream->statsSlot);
+}
+
+// Call sites cache whether they are enabled, so they are refreshed whenever the level changes
+static void mdn_Logger_setMinEnabledLevel(mdn_Logger_loggingLevel_t minEnabledLevel) {
+    LOGGER_SET_MIN_ENABLED_LEVEL(minEnabledLevel);
+    mdn_Logger_CallSiteRegistry_refresh();
+}
+
 mdn_Status_t mdn_Logger_deinit(void) {
+    Logger_Streams_t *streams;
+
 #ifdef MDN_LOGGER_SAFE_MODE
     if (g_Logger_internalState == NULL) {
         return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
     }
 #endif  // MDN_LOGGER_SAFE_MODE
 
-    free(g_Logger_internalState->streamsArr);
+    if (g_Logger_internalState->asyncState != NULL) {
+        mdn_Logger_asyncStop(g_Logger_internalState->asyncState);
+    }
+    // Once the queued records are written, so that the last dump counts them
+    if (g_Logger_internalState->statsDump != NULL) {
+        mdn_Logger_StatsDump_stop(g_Logger_internalState->statsDump);
+    }
+    streams = atomic_load(&g_Logger_internalState->streams);
+    if (streams != NULL) {
+        for (size_t idx = 0; idx < streams->streamsArrLen; ++idx) {
+            mdn_Logger_closeStream(&streams->streamsArr[idx]);
+        }
+        free(streams);
+    }
+    mdn_Logger_Backtrace_destroy(g_Logger_internalState->backtrace);
+    mdn_Logger_Mutex_destroy(&g_Logger_internalState->streamsMutex);
     free(g_Logger_internalState);
     g_Logger_internalState = NULL;
+    mdn_Logger_CallSiteRegistry_clearRules();
+    mdn_Logger_setMinEnabledLevel(MDN_LOGGER_LOGGING_LEVEL_COUNT);
+
+    return MDN_STATUS_SUCCESS;
+}
+
+// Called with 'streamsMutex' locked
+static void mdn_Logger_updateLevels(const Logger_Streams_t *streams) {
+    mdn_Logger_loggingLevel_t minStreamLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
+    mdn_Logger_loggingLevel_t maxStreamLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
+    mdn_Logger_loggingLevel_t minEnabledLevel;
+
+    for (size_t idx = 0; (streams != NULL) && (idx < streams->streamsArrLen); ++idx) {
+        if (streams->streamsArr[idx].config.loggingLevel < minStreamLevel) {
+            minStreamLevel = streams->streamsArr[idx].config.loggingLevel;
+        }
+        if ((idx == 0) || (streams->streamsArr[idx].config.loggingLevel > maxStreamLevel)) {
+            maxStreamLevel = streams->streamsArr[idx].config.loggingLevel;
+        }
+    }
+    atomic_store_explicit(&g_Logger_internalState->minStreamLevel, (int)minStreamLevel, memory_order_relaxed);
+    atomic_store_explicit(&g_Logger_internalState->maxStreamLevel, (int)maxStreamLevel, memory_order_relaxed);
+
+    // Records the backtrace holds back have to reach the library even when no stream wants them
+    minEnabledLevel = minStreamLevel;
+    if ((g_Logger_internalState->backtrace != NULL) && (g_Logger_internalState->backtraceConfig.loggingLevel < minEnabledLevel)) {
+        minEnabledLevel = g_Logger_internalState->backtraceConfig.loggingLevel;
+    }
+    mdn_Logger_setMinEnabledLevel(minEnabledLevel);
+}
+
+// Publishes 'newStreams' in place of 'oldStreams', and frees the latter once no logging thread can still be using it.
+// Called with 'streamsMutex' locked.
+static void mdn_Logger_replaceStreams(Logger_Streams_t *oldStreams, Logger_Streams_t *newStreams) {
+    atomic_store(&g_Logger_internalState->streams, newStreams);
+    mdn_Logger_updateLevels(newStreams);
+    mdn_Logger_Epoch_synchronize(&g_Logger_streamsEpoch);
+    free(oldStreams);
+}
+
+static mdn_Status_t mdn_Logger_appendStream(const Logger_Stream_t *stream) {
+    Logger_Streams_t *oldStreams;
+    Logger_Streams_t *newStreams;
+    size_t            oldStreamsArrLen;
+
+    mdn_Logger_Mutex_lock(&g_Logger_internalState->streamsMutex);
+    oldStreams       = atomic_load(&g_Logger_internalState->streams);
+    oldStreamsArrLen = (oldStreams == NULL) ? 0 : oldStreams->streamsArrLen;
+    newStreams       = MDN_MW_malloc(sizeof(*newStreams) + ((oldStreamsArrLen + 1) * sizeof(*(newStreams->streamsArr))));
+    if (newStreams == NULL) {
+        mdn_Logger_Mutex_unlock(&g_Logger_internalState->streamsMutex);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    for (size_t idx = 0; idx < oldStreamsArrLen; ++idx) {
+        newStreams->streamsArr[idx] = oldStreams->streamsArr[idx];
+    }
+    newStreams->streamsArr[oldStreamsArrLen] = *stream;
+    newStreams->streamsArrLen                = oldStreamsArrLen + 1;
+    mdn_Logger_replaceStreams(oldStreams, newStreams);
+    mdn_Logger_Mutex_unlock(&g_Logger_internalState->streamsMutex);
 
     return MDN_STATUS_SUCCESS;
 }
 
 mdn_Status_t mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t streamConfig) {
-    mdn_Logger_StreamConfig_t *streamsArrTemp;
+    Logger_Stream_t       stream;
+    mdn_Logger_Sink_t     fileSink;
+    Logger_FdSink_t      *fdSink;
+    mdn_Logger_FdConfig_t fdConfig;
+    mdn_Status_t          status;
 #ifdef MDN_LOGGER_SAFE_MODE
     if (g_Logger_internalState == NULL) {
         return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
@@ -133,104 +362,1028 @@ mdn_Status_t mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t streamConfig)
     if (!IS_VALID_LOGGING_FORMAT(streamConfig.loggingFormat)) {
         return MDN_STATUS_ERROR_BAD_ARGUMENT;
     }
+    if (streamConfig.compressed && (streamConfig.loggingFormat != MDN_LOGGER_LOGGING_FORMAT_FILE)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (streamConfig.ioUring && (streamConfig.compressed || (streamConfig.loggingFormat == MDN_LOGGER_LOGGING_FORMAT_BINARY))) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
 #endif  // MDN_LOGGER_SAFE_MODE
 
-    streamsArrTemp                     = g_Logger_internalState->streamsArr;
-    g_Logger_internalState->streamsArr = MDN_MW_realloc(g_Logger_internalState->streamsArr, (g_Logger_internalState->streamsArrLen + 1) * sizeof(*(g_Logger_internalState->streamsArr)));
-    if (g_Logger_internalState->streamsArr == NULL) {
-        g_Logger_internalState->streamsArr = streamsArrTemp;
+    fileSink = mdn_Logger_fileSink(streamConfig.stream);
+    stream   = (Logger_Stream_t){
+        .config      = streamConfig,
+        .binarySites = NULL,
+        .sinkOps     = fileSink.ops,
+        .sinkContext = fileSink.context,
+        .statsSlot   = LOGGER_STATS_NO_STREAM_SLOT,
+    };
+    if (streamConfig.loggingFormat == MDN_LOGGER_LOGGING_FORMAT_BINARY) {
+        stream.binarySites = mdn_Logger_BinarySites_create(fileSink.ops, fileSink.context);
+        if (stream.binarySites == NULL) {
+            return MDN_STATUS_ERROR_MEM_ALLOC;
+        }
+        mdn_Logger_BinaryFormat_writeHeader(fileSink.ops, fileSink.context);
+    }
+    if (streamConfig.compressed) {
+        stream.sinkContext = mdn_Logger_CompressedSink_create(streamConfig.stream);
+        if (stream.sinkContext == NULL) {
+            mdn_Logger_closeStream(&stream);
+            return MDN_STATUS_ERROR_MEM_ALLOC;
+        }
+        stream.sinkOps = &g_Logger_CompressedSink_ops;
+    }
+    if (streamConfig.ioUring) {
+        // What the FILE buffered goes first, the sink then bypasses it
+        (void)fflush(streamConfig.stream);
+        fdConfig = (mdn_Logger_FdConfig_t){
+            .fd            = fileno(streamConfig.stream),
+            .loggingLevel  = streamConfig.loggingLevel,
+            .loggingFormat = streamConfig.loggingFormat,
+            .ioUring       = true,
+        };
+        status = mdn_Logger_FdSink_create(&fdSink, &fdConfig);
+        if (status != MDN_STATUS_SUCCESS) {
+            mdn_Logger_closeStream(&stream);
+            return status;
+        }
+        stream.sinkOps     = &g_Logger_FdSink_ops;
+        stream.sinkContext = fdSink;
+    }
+
+    stream.statsSlot = mdn_Logger_Stats_acquireStreamSlot();
+    status           = mdn_Logger_appendStream(&stream);
+    if (status != MDN_STATUS_SUCCESS) {
+        mdn_Logger_closeStream(&stream);
+    }
+
+    return status;
+}
+
+static void mdn_Logger_closeSink(mdn_Logger_Sink_t sink) {
+    if (sink.ops->close != NULL) {
+        sink.ops->close(sink.context);
+    }
+}
+
+mdn_Status_t mdn_Logger_addSink(mdn_Logger_SinkConfig_t sinkConfig) {
+    Logger_Stream_t stream;
+    mdn_Status_t    status;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((sinkConfig.sink.ops == NULL) || (sinkConfig.sink.ops->write == NULL)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (g_Logger_internalState == NULL) {
+        mdn_Logger_closeSink(sinkConfig.sink);
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (!IS_VALID_LOGGING_LEVEL(sinkConfig.loggingLevel) || !IS_VALID_LOGGING_FORMAT(sinkConfig.loggingFormat)) {
+        mdn_Logger_closeSink(sinkConfig.sink);
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    stream = (Logger_Stream_t){
+        .config = {
+            .stream        = NULL,
+            .loggingLevel  = sinkConfig.loggingLevel,
+            .loggingFormat = sinkConfig.loggingFormat,
+        },
+        .binarySites = NULL,
+        .sinkOps     = sinkConfig.sink.ops,
+        .sinkContext = sinkConfig.sink.context,
+        .statsSlot   = LOGGER_STATS_NO_STREAM_SLOT,
+    };
+    if (sinkConfig.loggingFormat == MDN_LOGGER_LOGGING_FORMAT_BINARY) {
+        stream.binarySites = mdn_Logger_BinarySites_create(sinkConfig.sink.ops, sinkConfig.sink.context);
+        if (stream.binarySites == NULL) {
+            mdn_Logger_closeSink(sinkConfig.sink);
+            return MDN_STATUS_ERROR_MEM_ALLOC;
+        }
+        mdn_Logger_BinaryFormat_writeHeader(sinkConfig.sink.ops, sinkConfig.sink.context);
+    }
+
+    stream.statsSlot = mdn_Logger_Stats_acquireStreamSlot();
+    status           = mdn_Logger_appendStream(&stream);
+    if (status != MDN_STATUS_SUCCESS) {
+        mdn_Logger_closeStream(&stream);
+    }
+
+    return status;
+}
+
+mdn_Status_t mdn_Logger_addFd(mdn_Logger_FdConfig_t fdConfig) {
+    Logger_Stream_t  stream;
+    Logger_FdSink_t *sink;
+    mdn_Status_t     status;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (fdConfig.fd < 0) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (!IS_VALID_LOGGING_LEVEL(fdConfig.loggingLevel)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (!IS_VALID_LOGGING_FORMAT(fdConfig.loggingFormat) || (fdConfig.loggingFormat == MDN_LOGGER_LOGGING_FORMAT_BINARY)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    status = mdn_Logger_FdSink_create(&sink, &fdConfig);
+    if (status != MDN_STATUS_SUCCESS) {
+        return status;
+    }
+    stream = (Logger_Stream_t){
+        .config = {
+            .stream        = NULL,
+            .loggingLevel  = fdConfig.loggingLevel,
+            .loggingFormat = fdConfig.loggingFormat,
+        },
+        .binarySites = NULL,
+        .sinkOps     = &g_Logger_FdSink_ops,
+        .sinkContext = sink,
+        .statsSlot   = LOGGER_STATS_NO_STREAM_SLOT,
+    };
+
+    stream.statsSlot = mdn_Logger_Stats_acquireStreamSlot();
+    status           = mdn_Logger_appendStream(&stream);
+    if (status != MDN_STATUS_SUCCESS) {
+        mdn_Logger_closeStream(&stream);
+    }
+
+    return status;
+}
+
+mdn_Status_t mdn_Logger_addMmapFile(mdn_Logger_MmapFileConfig_t mmapFileConfig) {
+    Logger_Stream_t    stream;
+    Logger_MmapSink_t *sink;
+    mdn_Status_t       status;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (mmapFileConfig.path == NULL) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (!IS_VALID_LOGGING_LEVEL(mmapFileConfig.loggingLevel)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    status = mdn_Logger_MmapSink_create(&sink, mmapFileConfig.path, mmapFileConfig.chunkSize);
+    if (status != MDN_STATUS_SUCCESS) {
+        return status;
+    }
+    stream = (Logger_Stream_t){
+        .config = {
+            .stream        = NULL,
+            .loggingLevel  = mmapFileConfig.loggingLevel,
+            .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE,
+        },
+        .binarySites = NULL,
+        .sinkOps     = &g_Logger_MmapSink_ops,
+        .sinkContext = sink,
+        .statsSlot   = LOGGER_STATS_NO_STREAM_SLOT,
+    };
+
+    stream.statsSlot = mdn_Logger_Stats_acquireStreamSlot();
+    status           = mdn_Logger_appendStream(&stream);
+    if (status != MDN_STATUS_SUCCESS) {
+        mdn_Logger_closeStream(&stream);
+    }
+
+    return status;
+}
+
+mdn_Status_t mdn_Logger_addRotatingFile(mdn_Logger_RotatingFileConfig_t rotatingFileConfig) {
+    Logger_Stream_t        stream;
+    Logger_RotatingSink_t *sink;
+    mdn_Status_t           status;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (rotatingFileConfig.path == NULL) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (!IS_VALID_LOGGING_LEVEL(rotatingFileConfig.loggingLevel)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    status = mdn_Logger_RotatingSink_create(&sink, &rotatingFileConfig);
+    if (status != MDN_STATUS_SUCCESS) {
+        return status;
+    }
+    stream = (Logger_Stream_t){
+        .config = {
+            .stream        = NULL,
+            .loggingLevel  = rotatingFileConfig.loggingLevel,
+            .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE,
+        },
+        .binarySites = NULL,
+        .sinkOps     = &g_Logger_RotatingSink_ops,
+        .sinkContext = sink,
+        .statsSlot   = LOGGER_STATS_NO_STREAM_SLOT,
+    };
+
+    stream.statsSlot = mdn_Logger_Stats_acquireStreamSlot();
+    status           = mdn_Logger_appendStream(&stream);
+    if (status != MDN_STATUS_SUCCESS) {
+        mdn_Logger_closeStream(&stream);
+    }
+
+    return status;
+}
+
+mdn_Status_t mdn_Logger_addFlightRecorder(mdn_Logger_FlightRecorderConfig_t flightRecorderConfig) {
+    Logger_Stream_t              stream;
+    Logger_FlightRecorderSink_t *sink;
+    mdn_Status_t                 status;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (flightRecorderConfig.path == NULL) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (!IS_VALID_LOGGING_LEVEL(flightRecorderConfig.loggingLevel)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    status = mdn_Logger_FlightRecorderSink_create(&sink, flightRecorderConfig.path, flightRecorderConfig.ringSize);
+    if (status != MDN_STATUS_SUCCESS) {
+        return status;
+    }
+    stream = (Logger_Stream_t){
+        .config = {
+            .stream        = NULL,
+            .loggingLevel  = flightRecorderConfig.loggingLevel,
+            .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_BINARY,
+        },
+        .binarySites = mdn_Logger_BinarySites_create(&g_Logger_FlightRecorderSink_sitesOps, sink),
+        .sinkOps     = &g_Logger_FlightRecorderSink_ops,
+        .sinkContext = sink,
+        .statsSlot   = LOGGER_STATS_NO_STREAM_SLOT,
+    };
+    if (stream.binarySites == NULL) {
+        mdn_Logger_closeStream(&stream);
         return MDN_STATUS_ERROR_MEM_ALLOC;
     }
-    (g_Logger_internalState->streamsArr)[g_Logger_internalState->streamsArrLen] = streamConfig;
-    ++(g_Logger_internalState->streamsArrLen);
+
+    stream.statsSlot = mdn_Logger_Stats_acquireStreamSlot();
+    status           = mdn_Logger_appendStream(&stream);
+    if (status != MDN_STATUS_SUCCESS) {
+        mdn_Logger_closeStream(&stream);
+    }
+
+    return status;
+}
+
+// Streams added with mdn_Logger_addOutputStream() are found by their FILE, others by their sink (no stream has NULL ops)
+static bool mdn_Logger_isStreamOf(const Logger_Stream_t *stream, FILE *file, mdn_Logger_Sink_t sink) {
+    if (file != NULL) {
+        return stream->config.stream == file;
+    }
+    return (stream->sinkOps == sink.ops) && (stream->sinkContext == sink.context);
+}
+
+static mdn_Status_t mdn_Logger_removeStream(FILE *file, mdn_Logger_Sink_t sink) {
+    Logger_Streams_t *oldStreams;
+    Logger_Streams_t *newStreams = NULL;
+    size_t            removedIdx;
+    Logger_Stream_t   removedStream;
+
+    mdn_Logger_Mutex_lock(&g_Logger_internalState->streamsMutex);
+    oldStreams = atomic_load(&g_Logger_internalState->streams);
+    for (removedIdx = 0; (oldStreams != NULL) && (removedIdx < oldStreams->streamsArrLen); ++removedIdx) {
+        if (mdn_Logger_isStreamOf(&oldStreams->streamsArr[removedIdx], file, sink)) {
+            break;
+        }
+    }
+    if ((oldStreams == NULL) || (removedIdx == oldStreams->streamsArrLen)) {
+        mdn_Logger_Mutex_unlock(&g_Logger_internalState->streamsMutex);
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if (oldStreams->streamsArrLen > 1) {
+        newStreams = MDN_MW_malloc(sizeof(*newStreams) + ((oldStreams->streamsArrLen - 1) * sizeof(*(newStreams->streamsArr))));
+        if (newStreams == NULL) {
+            mdn_Logger_Mutex_unlock(&g_Logger_internalState->streamsMutex);
+            return MDN_STATUS_ERROR_MEM_ALLOC;
+        }
+        newStreams->streamsArrLen = 0;
+        for (size_t idx = 0; idx < oldStreams->streamsArrLen; ++idx) {
+            if (idx != removedIdx) {
+                newStreams->streamsArr[newStreams->streamsArrLen++] = oldStreams->streamsArr[idx];
+            }
+        }
+    }
+    removedStream = oldStreams->streamsArr[removedIdx];
+    mdn_Logger_replaceStreams(oldStreams, newStreams);
+    mdn_Logger_closeStream(&removedStream);
+    mdn_Logger_Mutex_unlock(&g_Logger_internalState->streamsMutex);
 
     return MDN_STATUS_SUCCESS;
 }
 
-static void mdn_Logger_setColor(FILE *stream, mdn_Logger_loggingColor_t color) {
-    (void)fprintf(stream, "%s", g_Logger_colorToTerminalColorMap[color]);
+mdn_Status_t mdn_Logger_removeOutputStream(FILE *stream) {
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (stream == NULL) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    return mdn_Logger_removeStream(stream, (mdn_Logger_Sink_t){.ops = NULL, .context = NULL});
+}
+
+mdn_Status_t mdn_Logger_removeSink(mdn_Logger_Sink_t sink) {
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (sink.ops == NULL) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    return mdn_Logger_removeStream(NULL, sink);
 }
 
-static void mdn_Logger_printTimestamp(FILE *stream, bool includeDate) {
-#if (defined __APPLE__) || (defined __linux__)
-    struct timeval timeValue;
-    struct tm     *tm_info;
-    char           timestampBuf[10 + 1 + 8 + 1];  // 10(date: YYYY-MM-DD) + 1(space) + 8(time: HH:MM:SS) + 1(null-terminator)
-    const char    *timestampStart  = includeDate ? timestampBuf : timestampBuf + 11;
-    int            usecToMsecDenom = 1000;
+mdn_Status_t mdn_Logger_setSiteLevel(const char *fileGlob, const char *funcGlob, mdn_Logger_loggingLevel_t loggingLevel) {
+    mdn_Status_t status;
 
-    if (gettimeofday(&timeValue, NULL) != 0) {
-        timeValue.tv_sec  = 0;
-        timeValue.tv_usec = 0;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (!IS_VALID_LOGGING_LEVEL(loggingLevel)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
     }
-    tm_info = localtime(&timeValue.tv_sec);
-    strftime(timestampBuf, sizeof(timestampBuf), "%Y-%m-%d %H:%M:%S", tm_info);
+#endif  // MDN_LOGGER_SAFE_MODE
 
-    // Safe cast: microseconds/1000 gives milliseconds (0-999), fits in int
-    (void)fprintf(stream, "%s.%03d ", timestampStart, (int)(timeValue.tv_usec / usecToMsecDenom));
-#elif defined _WIN32
-    SYSTEMTIME systemTime;
+    status = mdn_Logger_CallSiteRegistry_addRule(fileGlob, funcGlob, loggingLevel);
+    if (status != MDN_STATUS_SUCCESS) {
+        return status;
+    }
+    mdn_Logger_CallSiteRegistry_refresh();
 
-    GetLocalTime(&systemTime);
+    return MDN_STATUS_SUCCESS;
+}
 
-    if (includeDate) {
-        (void)fprintf(stream, "%04d-%02d-%02d ", systemTime.wYear, systemTime.wMonth, systemTime.wDay);
+mdn_Status_t mdn_Logger_resetSiteLevels(void) {
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
     }
-    (void)fprintf(stream, "%02d:%02d:%02d.%03d ", systemTime.wHour, systemTime.wMinute, systemTime.wSecond, systemTime.wMilliseconds);
-#endif  // OS
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    mdn_Logger_CallSiteRegistry_clearRules();
+    mdn_Logger_CallSiteRegistry_refresh();
+
+    return MDN_STATUS_SUCCESS;
 }
 
-static void mdn_Logger_printLoggingLevel(FILE *stream, mdn_Logger_loggingLevel_t loggingLevel) {
-    (void)fprintf(stream, "%-8s ", g_mdn_Logger_logLevelToStrMap[loggingLevel]);
+mdn_Status_t mdn_Logger_setTimestampPrecision(mdn_Logger_timestampPrecision_t timestampPrecision) {
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (!IS_VALID_TIMESTAMP_PRECISION(timestampPrecision)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    g_Logger_internalState->timestampPrecision = timestampPrecision;
+    g_Logger_internalState->useCoarseClock     = mdn_Logger_Timestamp_isCoarseClockEnough(timestampPrecision);
+
+    return MDN_STATUS_SUCCESS;
 }
 
-static void mdn_Logger_printFuncName(FILE *stream, const char *funcName) {
-    (void)fprintf(stream, "%-20s ", funcName);
+// Replaces the backtrace with 'backtrace' (possibly NULL), which is expected to happen while no thread logs
+static void mdn_Logger_replaceBacktrace(Logger_Backtrace_t *backtrace, mdn_Logger_BacktraceConfig_t backtraceConfig) {
+    Logger_Backtrace_t *oldBacktrace;
+
+    mdn_Logger_Mutex_lock(&g_Logger_internalState->streamsMutex);
+    oldBacktrace                            = g_Logger_internalState->backtrace;
+    g_Logger_internalState->backtrace       = backtrace;
+    g_Logger_internalState->backtraceConfig = backtraceConfig;
+    mdn_Logger_updateLevels(atomic_load(&g_Logger_internalState->streams));
+    mdn_Logger_Mutex_unlock(&g_Logger_internalState->streamsMutex);
+    mdn_Logger_Backtrace_destroy(oldBacktrace);
 }
 
-static void mdn_Logger_printSeparator(FILE *stream) {
-    (void)fprintf(stream, "| ");
+mdn_Status_t mdn_Logger_enableBacktrace(mdn_Logger_BacktraceConfig_t backtraceConfig) {
+    Logger_Backtrace_t *backtrace;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if ((backtraceConfig.recordsCount == 0) || (backtraceConfig.maxMessageLen == 0) || !IS_VALID_LOGGING_LEVEL(backtraceConfig.loggingLevel) ||
+        !IS_VALID_LOGGING_LEVEL(backtraceConfig.flushLevel) || (backtraceConfig.flushLevel <= backtraceConfig.loggingLevel)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    backtrace = mdn_Logger_Backtrace_create(backtraceConfig.recordsCount, backtraceConfig.maxMessageLen);
+    if (backtrace == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    mdn_Logger_replaceBacktrace(backtrace, backtraceConfig);
+
+    return MDN_STATUS_SUCCESS;
 }
 
-static void mdn_Logger_logToScreen(mdn_Logger_logToStreamArguments_t *logToStreamArguments) {
-    FILE *stream = g_Logger_internalState->streamsArr[logToStreamArguments->streamIndex].stream;
+mdn_Status_t mdn_Logger_disableBacktrace(void) {
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    mdn_Logger_replaceBacktrace(NULL, (mdn_Logger_BacktraceConfig_t){0});
 
-    mdn_Logger_setColor(stream, g_mdn_Logger_loggingLevelToColorMap[logToStreamArguments->loggingLevel]);
-    mdn_Logger_printTimestamp(stream, false);
-    mdn_Logger_printFuncName(stream, logToStreamArguments->funcName);
-    mdn_Logger_printSeparator(stream);
-    (void)vfprintf(stream, logToStreamArguments->format, logToStreamArguments->args);  // NOLINT(clang-diagnostic-format-nonliteral)
-    mdn_Logger_setColor(stream, LOGGING_COLOR_RESET);
-    (void)fprintf(stream, "\n");
+    return MDN_STATUS_SUCCESS;
 }
 
-static void mdn_Logger_logToFile(mdn_Logger_logToStreamArguments_t *logToStreamArguments) {
-    FILE *stream = g_Logger_internalState->streamsArr[logToStreamArguments->streamIndex].stream;
+mdn_Status_t mdn_Logger_getAsyncStats(mdn_Logger_AsyncStats_t *asyncStats) {
+    Logger_AsyncState_t *asyncState;
 
-    mdn_Logger_printTimestamp(stream, true);
-    mdn_Logger_printLoggingLevel(stream, logToStreamArguments->loggingLevel);
-    mdn_Logger_printFuncName(stream, logToStreamArguments->funcName);
-    mdn_Logger_printSeparator(stream);
-    (void)vfprintf(stream, logToStreamArguments->format, logToStreamArguments->args);  // NOLINT(clang-diagnostic-format-nonliteral)
-    (void)fprintf(stream, "\n");
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (asyncStats == NULL) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    asyncState = g_Logger_internalState->asyncState;
+    if (asyncState == NULL) {
+        *asyncStats = (mdn_Logger_AsyncStats_t){
+            .droppedCount     = 0,
+            .overwrittenCount = 0,
+        };
+    } else {
+        *asyncStats = (mdn_Logger_AsyncStats_t){
+            .droppedCount     = atomic_load_explicit(&asyncState->droppedCount, memory_order_relaxed),
+            .overwrittenCount = atomic_load_explicit(&asyncState->overwrittenCount, memory_order_relaxed),
+        };
+    }
+
+    return MDN_STATUS_SUCCESS;
 }
 
-typedef void (*mdn_Logger_logPrintFunc)(mdn_Logger_logToStreamArguments_t *);
+mdn_Status_t mdn_Logger_getStats(mdn_Logger_Stats_t *stats) {
+    Logger_AsyncState_t      *asyncState;
+    const Logger_Streams_t   *streams;
+    const Logger_Stream_t    *stream;
+    mdn_Logger_StreamStats_t *streamStats;
+    unsigned                  epochToken;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (stats == NULL) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    mdn_Logger_Stats_sum(stats);
+
+    asyncState = g_Logger_internalState->asyncState;
+    if (asyncState != NULL) {
+        stats->asyncQueueCapacity    = asyncState->queue->slotsArrLen;
+        stats->asyncQueueDepth       = mdn_Logger_AsyncQueue_getDepth(asyncState->queue);
+        stats->asyncDroppedCount     = atomic_load_explicit(&asyncState->droppedCount, memory_order_relaxed);
+        stats->asyncOverwrittenCount = atomic_load_explicit(&asyncState->overwrittenCount, memory_order_relaxed);
+    }
+
+    // As a logging thread would, so that streams can keep changing meanwhile
+    epochToken = mdn_Logger_Epoch_enter(&g_Logger_streamsEpoch);
+    streams    = atomic_load(&g_Logger_internalState->streams);
+    for (size_t idx = 0; (streams != NULL) && (idx < streams->streamsArrLen); ++idx) {
+        stream = &streams->streamsArr[idx];
+        if (stream->statsSlot == LOGGER_STATS_NO_STREAM_SLOT) {
+            continue;
+        }
+        streamStats                = &stats->streamsArr[stats->streamsArrLen++];
+        streamStats->stream        = stream->config.stream;
+        streamStats->loggingFormat = stream->config.loggingFormat;
+        mdn_Logger_Stats_sumStream(stream->statsSlot, streamStats);
+    }
+    mdn_Logger_Epoch_exit(&g_Logger_streamsEpoch, epochToken);
+
+    return MDN_STATUS_SUCCESS;
+}
+
+mdn_Status_t mdn_Logger_writeStats(FILE *stream) {
+    mdn_Logger_Stats_t stats;
+    mdn_Status_t       status;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if (stream == NULL) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    status = mdn_Logger_getStats(&stats);
+    if (status != MDN_STATUS_SUCCESS) {
+        return status;
+    }
+    mdn_Logger_Stats_writePrometheus(stream, &stats);
+
+    return MDN_STATUS_SUCCESS;
+}
+
+mdn_Status_t mdn_Logger_startStatsDump(mdn_Logger_StatsDumpConfig_t statsDumpConfig) {
+    Logger_StatsDump_t *statsDump;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED;
+    }
+    if ((statsDumpConfig.path == NULL) || (statsDumpConfig.intervalMs == 0)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    statsDump = mdn_Logger_StatsDump_start(statsDumpConfig.path, statsDumpConfig.intervalMs);
+    if (statsDump == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    if (g_Logger_internalState->statsDump != NULL) {
+        mdn_Logger_StatsDump_stop(g_Logger_internalState->statsDump);
+    }
+    g_Logger_internalState->statsDump = statsDump;
+
+    return MDN_STATUS_SUCCESS;
+}
+
+static void mdn_Logger_appendMessage(Logger_LineBuffer_t *lineBuffer, mdn_Logger_logToStreamArguments_t *logToStreamArguments) {
+    if (logToStreamArguments->message != NULL) {
+        mdn_Logger_LineBuffer_append(lineBuffer, logToStreamArguments->message, logToStreamArguments->record->messageLen);
+    } else {
+        mdn_Logger_FastPrintf_appendFormatV(lineBuffer, logToStreamArguments->format, logToStreamArguments->args);
+    }
+}
+
+static void mdn_Logger_logAsText(Logger_LineBuffer_t *lineBuffer, mdn_Logger_logToStreamArguments_t *logToStreamArguments) {
+    mdn_Logger_loggingFormat_t loggingFormat = logToStreamArguments->stream->config.loggingFormat;
+
+    mdn_Logger_TextFormat_renderPrefix(lineBuffer, loggingFormat, logToStreamArguments->record, g_Logger_internalState->timestampPrecision);
+    mdn_Logger_appendMessage(lineBuffer, logToStreamArguments);
+    mdn_Logger_TextFormat_renderSuffix(lineBuffer, loggingFormat);
+}
+
+static void mdn_Logger_renderBinaryFormatted(Logger_LineBuffer_t *lineBuffer, const Logger_Stream_t *stream, const Logger_Record_t *record, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    mdn_Logger_BinaryFormat_render(lineBuffer, stream->binarySites, record, g_Logger_internalState->timestampPrecision, format, args);
+    va_end(args);
+}
+
+static void mdn_Logger_logAsBinary(Logger_LineBuffer_t *lineBuffer, mdn_Logger_logToStreamArguments_t *logToStreamArguments) {
+    const Logger_Stream_t *stream = logToStreamArguments->stream;
+
+    if (logToStreamArguments->message != NULL) {
+        // Messages aren't null-terminated, and may be longer than INT_MAX only in theory
+        mdn_Logger_renderBinaryFormatted(lineBuffer, stream, logToStreamArguments->record, LOGGER_FORMATTED_MESSAGE_FORMAT,
+                                         (int)((logToStreamArguments->record->messageLen < INT_MAX) ? logToStreamArguments->record->messageLen : INT_MAX),
+                                         logToStreamArguments->message);
+        return;
+    }
+    mdn_Logger_BinaryFormat_render(lineBuffer, stream->binarySites, logToStreamArguments->record, g_Logger_internalState->timestampPrecision,
+                                   logToStreamArguments->format, logToStreamArguments->args);
+}
+
+static void mdn_Logger_logAsStructured(Logger_LineBuffer_t *lineBuffer, mdn_Logger_logToStreamArguments_t *logToStreamArguments) {
+    mdn_Logger_loggingFormat_t loggingFormat = logToStreamArguments->stream->config.loggingFormat;
+    size_t                     messageStart;
+
+    mdn_Logger_StructuredFormat_renderPrefix(lineBuffer, loggingFormat, logToStreamArguments->record, g_Logger_internalState->timestampPrecision);
+    messageStart = lineBuffer->len;
+    mdn_Logger_appendMessage(lineBuffer, logToStreamArguments);
+    mdn_Logger_StructuredFormat_renderSuffix(lineBuffer, loggingFormat, messageStart);
+}
+
+typedef void (*mdn_Logger_logPrintFunc)(Logger_LineBuffer_t *, mdn_Logger_logToStreamArguments_t *);
 static mdn_Logger_logPrintFunc g_mdn_Logger_logFormatToFuncMap[] = {
-    [MDN_LOGGER_LOGGING_FORMAT_SCREEN] = mdn_Logger_logToScreen,
-    [MDN_LOGGER_LOGGING_FORMAT_FILE]   = mdn_Logger_logToFile,
+    [MDN_LOGGER_LOGGING_FORMAT_SCREEN] = mdn_Logger_logAsText,
+    [MDN_LOGGER_LOGGING_FORMAT_FILE]   = mdn_Logger_logAsText,
+    [MDN_LOGGER_LOGGING_FORMAT_BINARY] = mdn_Logger_logAsBinary,
+    [MDN_LOGGER_LOGGING_FORMAT_JSON]   = mdn_Logger_logAsStructured,
+    [MDN_LOGGER_LOGGING_FORMAT_LOGFMT] = mdn_Logger_logAsStructured,
 };
 
-void mdn_Logger_log(mdn_Logger_loggingLevel_t loggingLevel, const char *file, int line, const char *funcName, const char *format, ...) {
+static bool mdn_Logger_isRecordForStream(const Logger_Record_t *record, bool forced, const Logger_Stream_t *stream) {
+    if (record->backtrace) {
+        return record->loggingLevel < stream->config.loggingLevel;  // Was already written when logged otherwise
+    }
+    return forced || (record->loggingLevel >= stream->config.loggingLevel);
+}
+
+static void mdn_Logger_renderRecord(Logger_LineBuffer_t *lineBuffer, mdn_Logger_logToStreamArguments_t *logToStreamArguments, const Logger_Stream_t *stream,
+                                    va_list args) {
+    mdn_Logger_LineBuffer_init(lineBuffer, g_Logger_lineBufferStorage, sizeof(g_Logger_lineBufferStorage));
+    va_copy(logToStreamArguments->args, args);
+    logToStreamArguments->stream = stream;
+    g_mdn_Logger_logFormatToFuncMap[stream->config.loggingFormat](lineBuffer, logToStreamArguments);
+    va_end(logToStreamArguments->args);
+}
+
+// Hands the batched records over to their streams, with one 'writeBatch' call per stream
+static void mdn_Logger_Batch_write(Logger_Batch_t *batch) {
+    mdn_Logger_SinkBuffer_t buffersArr[LOGGER_BATCH_ENTRIES_COUNT];
+    size_t                  buffersArrLen;
+    const Logger_Stream_t  *stream;
+    bool                    written;
+
+    for (size_t idx = 0; (batch->entriesArrLen > 0) && (idx < batch->streams->streamsArrLen); ++idx) {
+        stream        = &batch->streams->streamsArr[idx];
+        buffersArrLen = 0;
+        for (size_t entryIdx = 0; entryIdx < batch->entriesArrLen; ++entryIdx) {
+            if (batch->entriesArr[entryIdx].stream == stream) {
+                buffersArr[buffersArrLen++] = (mdn_Logger_SinkBuffer_t){
+                    .data = batch->data + batch->entriesArr[entryIdx].offset,
+                    .len  = batch->entriesArr[entryIdx].len,
+                };
+            }
+        }
+        if (buffersArrLen == 0) {
+            continue;
+        }
+        written = stream->sinkOps->writeBatch(stream->sinkContext, buffersArr, buffersArrLen);
+        for (size_t bufferIdx = 0; bufferIdx < buffersArrLen; ++bufferIdx) {
+            mdn_Logger_Stats_countWrite(stream->statsSlot, buffersArr[bufferIdx].len, written);
+        }
+    }
+    batch->entriesArrLen = 0;
+    batch->dataLen       = 0;
+    batch->lastOffset    = LOGGER_BATCH_NO_OFFSET;
+}
+
+// Adds the record to the batch, unless it is CRITICAL or too big for the batch, in which case what was batched is written
+// first, for the record to be written right away after it. The copy of 'lineBuffer' made for the first stream to batch it
+// is shared by the others, until mdn_Logger_Batch_startRecord().
+static bool mdn_Logger_Batch_add(Logger_Batch_t *batch, const Logger_Stream_t *stream, const Logger_Record_t *record, const Logger_LineBuffer_t *lineBuffer) {
+    if ((record->loggingLevel == MDN_LOGGER_LOGGING_LEVEL_CRITICAL) || (lineBuffer->len > LOGGER_BATCH_DATA_SIZE)) {
+        mdn_Logger_Batch_write(batch);
+        return false;
+    }
+    if ((batch->entriesArrLen == LOGGER_BATCH_ENTRIES_COUNT)
+        || ((batch->lastOffset == LOGGER_BATCH_NO_OFFSET) && (lineBuffer->len > (LOGGER_BATCH_DATA_SIZE - batch->dataLen)))) {
+        mdn_Logger_Batch_write(batch);
+    }
+    if (batch->lastOffset == LOGGER_BATCH_NO_OFFSET) {
+        batch->lastOffset = batch->dataLen;
+        memcpy(batch->data + batch->dataLen, lineBuffer->data, lineBuffer->len);
+        batch->dataLen += lineBuffer->len;
+    }
+    batch->entriesArr[batch->entriesArrLen++] = (Logger_BatchEntry_t){
+        .stream = stream,
+        .offset = batch->lastOffset,
+        .len    = lineBuffer->len,
+    };
+
+    return true;
+}
+
+// Holds the streams snapshot until the batch is written by mdn_Logger_Batch_close()
+static void mdn_Logger_Batch_open(Logger_Batch_t *batch) {
+    batch->epochToken    = mdn_Logger_Epoch_enter(&g_Logger_streamsEpoch);
+    batch->streams       = atomic_load(&g_Logger_internalState->streams);
+    batch->entriesArrLen = 0;
+    batch->dataLen       = 0;
+    batch->lastOffset    = LOGGER_BATCH_NO_OFFSET;
+}
+
+// Called on each new render, whether or not the stream it is for batches it, so it never shares the copy of a previous one
+static void mdn_Logger_Batch_startRecord(Logger_Batch_t *batch) {
+    batch->lastOffset = LOGGER_BATCH_NO_OFFSET;
+}
+
+static void mdn_Logger_Batch_close(Logger_Batch_t *batch) {
+    mdn_Logger_Batch_write(batch);
+    mdn_Logger_Epoch_exit(&g_Logger_streamsEpoch, batch->epochToken);
+}
+
+static void mdn_Logger_writeRecord(Logger_Batch_t *batch, const Logger_Stream_t *stream, const Logger_Record_t *record, const Logger_LineBuffer_t *lineBuffer) {
+    bool written;
+
+    if ((batch != NULL) && (stream->sinkOps->writeBatch != NULL) && mdn_Logger_Batch_add(batch, stream, record, lineBuffer)) {
+        return;
+    }
+    // A single write per record keeps lines whole when several threads share a stream
+    written = stream->sinkOps->write(stream->sinkContext, lineBuffer->data, lineBuffer->len);
+    // Critical records are likely the last before a crash, so they don't wait in a buffer
+    if ((record->loggingLevel == MDN_LOGGER_LOGGING_LEVEL_CRITICAL) && (stream->sinkOps->flush != NULL)) {
+        written = stream->sinkOps->flush(stream->sinkContext) && written;
+    }
+    mdn_Logger_Stats_countWrite(stream->statsSlot, lineBuffer->len, written);
+}
+
+// Renders the record once per format, for the first stream of that format, and writes the same bytes to the streams after it
+// with that format. Binary streams each render their own, as call sites are numbered per stream.
+static void mdn_Logger_logToStreams(mdn_Logger_logToStreamArguments_t *logToStreamArguments, va_list args) {
+    const Logger_Record_t  *record = logToStreamArguments->record;
+    Logger_Batch_t         *batch  = logToStreamArguments->batch;
+    Logger_LineBuffer_t     lineBuffer;
+    const Logger_Streams_t *streams;
+    const Logger_Stream_t  *stream;
+    unsigned                epochToken          = 0;
+    unsigned                renderedFormatsMask = 0;
+    bool                    forced;
+
+    forced = (record->callSite != NULL) && mdn_Logger_CallSiteRegistry_isForced(record->callSite);
+    if (batch != NULL) {
+        streams = batch->streams;
+    } else {
+        epochToken = mdn_Logger_Epoch_enter(&g_Logger_streamsEpoch);
+        streams    = atomic_load(&g_Logger_internalState->streams);
+    }
+    for (size_t idx = 0; (streams != NULL) && (idx < streams->streamsArrLen); ++idx) {
+        stream = &streams->streamsArr[idx];
+        if (((renderedFormatsMask & (1U << stream->config.loggingFormat)) != 0) || !mdn_Logger_isRecordForStream(record, forced, stream)) {
+            continue;
+        }
+        mdn_Logger_renderRecord(&lineBuffer, logToStreamArguments, stream, args);
+        if (batch != NULL) {
+            mdn_Logger_Batch_startRecord(batch);
+        }
+        mdn_Logger_writeRecord(batch, stream, record, &lineBuffer);
+        if (stream->config.loggingFormat != MDN_LOGGER_LOGGING_FORMAT_BINARY) {
+            renderedFormatsMask |= 1U << stream->config.loggingFormat;
+            for (size_t nextIdx = idx + 1; nextIdx < streams->streamsArrLen; ++nextIdx) {
+                if ((streams->streamsArr[nextIdx].config.loggingFormat == stream->config.loggingFormat)
+                    && mdn_Logger_isRecordForStream(record, forced, &streams->streamsArr[nextIdx])) {
+                    mdn_Logger_writeRecord(batch, &streams->streamsArr[nextIdx], record, &lineBuffer);
+                }
+            }
+        }
+        mdn_Logger_LineBuffer_release(&lineBuffer);
+    }
+    if (batch == NULL) {
+        mdn_Logger_Epoch_exit(&g_Logger_streamsEpoch, epochToken);
+    }
+}
+
+// With 'message' set, called without arguments only to get a valid va_list
+static void mdn_Logger_logFormattedToStreams(mdn_Logger_logToStreamArguments_t *logToStreamArguments, ...) {
+    va_list args;
+
+    va_start(args, logToStreamArguments);
+    mdn_Logger_logToStreams(logToStreamArguments, args);
+    va_end(args);
+}
+
+static void mdn_Logger_asyncWakeWriter(Logger_AsyncState_t *asyncState) {
+    // The slot was claimed with a sequentially consistent operation, and mdn_Logger_asyncWriterWait() marks sleeping before
+    // checking for records the same way, so either the writer sees the new record, or we see it sleeping
+    if (atomic_load(&asyncState->writerSleeping)) {
+        mdn_Logger_Mutex_lock(&asyncState->writerMutex);
+        mdn_Logger_Cond_signal(&asyncState->writerCond);
+        mdn_Logger_Mutex_unlock(&asyncState->writerMutex);
+    }
+}
+
+static void mdn_Logger_asyncWriterWait(Logger_AsyncState_t *asyncState) {
+    mdn_Logger_Mutex_lock(&asyncState->writerMutex);
+    atomic_store(&asyncState->writerSleeping, true);
+    if (mdn_Logger_AsyncQueue_isEmpty(asyncState->queue) && !atomic_load(&asyncState->stopRequested)) {
+        mdn_Logger_Cond_timedWait(&asyncState->writerCond, &asyncState->writerMutex, ASYNC_WRITER_IDLE_WAIT_MS);
+    }
+    atomic_store(&asyncState->writerSleeping, false);
+    mdn_Logger_Mutex_unlock(&asyncState->writerMutex);
+}
+
+// Records dequeued in a row are written as a batch to the sinks that take batches
+static void mdn_Logger_asyncWriterThread(void *arg) {
+    Logger_AsyncState_t              *asyncState = arg;
+    Logger_AsyncQueueSlot_t          *slot;
+    size_t                            pos;
+    size_t                            recordsCount;
+    mdn_Logger_logToStreamArguments_t logToStreamArguments;
+
+    for (;;) {
+        slot = mdn_Logger_AsyncQueue_acquire(asyncState->queue, &pos);
+        if (slot != NULL) {
+            mdn_Logger_Batch_open(&asyncState->batch);
+            recordsCount = 0;
+            do {
+                logToStreamArguments = (mdn_Logger_logToStreamArguments_t){
+                    .record  = &slot->record,
+                    .message = mdn_Logger_AsyncQueue_slotMessage(slot),
+                    .format  = NULL,
+                    .batch   = &asyncState->batch,
+                };
+                mdn_Logger_logFormattedToStreams(&logToStreamArguments);
+                mdn_Logger_AsyncQueue_release(asyncState->queue, slot, pos);
+                ++recordsCount;
+            } while ((recordsCount < LOGGER_BATCH_RECORDS_COUNT) && ((slot = mdn_Logger_AsyncQueue_acquire(asyncState->queue, &pos)) != NULL));
+            mdn_Logger_Batch_close(&asyncState->batch);
+            continue;
+        }
+        if (atomic_load(&asyncState->stopRequested) && mdn_Logger_AsyncQueue_isEmpty(asyncState->queue)) {
+            break;
+        }
+        mdn_Logger_asyncWriterWait(asyncState);
+    }
+}
+
+static Logger_AsyncQueueSlot_t *mdn_Logger_asyncClaimWhenFull(Logger_AsyncState_t *asyncState, size_t *pos) {
+    Logger_AsyncQueueSlot_t *slot = NULL;
+    Logger_AsyncQueueSlot_t *oldestSlot;
+    size_t                   oldestPos;
+
+    switch (asyncState->fullPolicy) {
+        case MDN_LOGGER_ASYNC_FULL_POLICY_BLOCK:
+            while (slot == NULL) {
+                mdn_Logger_asyncWakeWriter(asyncState);
+                mdn_Logger_Thread_yield();
+                slot = mdn_Logger_AsyncQueue_claim(asyncState->queue, pos);
+            }
+            break;
+        case MDN_LOGGER_ASYNC_FULL_POLICY_DROP_NEWEST:
+            atomic_fetch_add_explicit(&asyncState->droppedCount, 1, memory_order_relaxed);
+            break;
+        case MDN_LOGGER_ASYNC_FULL_POLICY_OVERWRITE_OLDEST:
+            while (slot == NULL) {
+                oldestSlot = mdn_Logger_AsyncQueue_acquire(asyncState->queue, &oldestPos);
+                if (oldestSlot != NULL) {
+                    mdn_Logger_AsyncQueue_release(asyncState->queue, oldestSlot, oldestPos);
+                    atomic_fetch_add_explicit(&asyncState->overwrittenCount, 1, memory_order_relaxed);
+                } else {
+                    mdn_Logger_Thread_yield();
+                }
+                slot = mdn_Logger_AsyncQueue_claim(asyncState->queue, pos);
+            }
+            break;
+    }
+
+    return slot;
+}
+
+static void mdn_Logger_logAsync(Logger_AsyncState_t *asyncState, const Logger_Record_t *record, const char *message, const char *format, va_list args) {
+    Logger_AsyncQueueSlot_t *slot;
+    size_t                   pos;
+    Logger_LineBuffer_t      messageBuffer;
+    char                    *slotMessage;
+
+    slot = mdn_Logger_AsyncQueue_claim(asyncState->queue, &pos);
+    if (slot == NULL) {
+        slot = mdn_Logger_asyncClaimWhenFull(asyncState, &pos);
+        if (slot == NULL) {
+            return;
+        }
+    }
+
+    slot->record = *record;
+    slotMessage  = mdn_Logger_AsyncQueue_slotMessage(slot);
+    if (message != NULL) {
+        slot->record.messageLen = (record->messageLen < asyncState->queue->maxMessageLen) ? record->messageLen : asyncState->queue->maxMessageLen;
+        memcpy(slotMessage, message, slot->record.messageLen);
+        slotMessage[slot->record.messageLen] = '\0';
+    } else {
+        // Formatted straight into the slot, only a message longer than the slot can take goes through the heap before being cut
+        mdn_Logger_LineBuffer_init(&messageBuffer, slotMessage, asyncState->queue->maxMessageLen + 1);
+        mdn_Logger_FastPrintf_appendFormatV(&messageBuffer, format, args);
+        slot->record.messageLen = (messageBuffer.len < asyncState->queue->maxMessageLen) ? messageBuffer.len : asyncState->queue->maxMessageLen;
+        if (messageBuffer.heapData != NULL) {
+            memcpy(slotMessage, messageBuffer.heapData, slot->record.messageLen);
+            mdn_Logger_LineBuffer_release(&messageBuffer);
+        }
+        slotMessage[slot->record.messageLen] = '\0';
+    }
+    mdn_Logger_AsyncQueue_commit(asyncState->queue, slot, pos);
+
+    mdn_Logger_asyncWakeWriter(asyncState);
+}
+
+// Either 'message' is already formatted, or 'format' and 'args' are
+static void mdn_Logger_dispatchRecord(const Logger_Record_t *record, const char *message, const char *format, va_list args) {
     mdn_Logger_logToStreamArguments_t logToStreamArguments = (mdn_Logger_logToStreamArguments_t){
+        .record  = record,
+        .message = message,
+        .format  = format,
+        .batch   = NULL,
+    };
+
+    if (g_Logger_internalState->asyncState != NULL) {
+        mdn_Logger_logAsync(g_Logger_internalState->asyncState, record, message, format, args);
+    } else {
+        mdn_Logger_logToStreams(&logToStreamArguments, args);
+    }
+}
+
+// Only there to get a valid va_list for mdn_Logger_dispatchRecord()
+static void mdn_Logger_dispatchMessage(const Logger_Record_t *record, const char *message, ...) {
+    va_list args;
+
+    va_start(args, message);
+    mdn_Logger_dispatchRecord(record, message, NULL, args);
+    va_end(args);
+}
+
+static void mdn_Logger_dispatchHeldBack(const Logger_Record_t *record, const char *message, void *arg) {
+    Logger_Record_t heldBackRecord = *record;
+
+    (void)arg;
+    heldBackRecord.backtrace = true;
+    mdn_Logger_dispatchMessage(&heldBackRecord, message);
+}
+
+// Writes what the calling thread held back before 'record', between markers of the lowest level held back, so that they
+// reach the same streams
+static void mdn_Logger_flushBacktrace(Logger_Backtrace_t *backtrace, const Logger_Record_t *record) {
+    Logger_Record_t marker;
+
+    marker = (Logger_Record_t){
+        .loggingLevel = mdn_Logger_Backtrace_minLevel(backtrace),
+        .file         = record->file,
+        .line         = record->line,
+        .funcName     = record->funcName,
+        .callSite     = NULL,
+        .timestamp    = record->timestamp,
+        .threadId     = record->threadId,
+        .messageLen   = sizeof(LOGGER_BACKTRACE_START_MESSAGE) - 1,
+        .backtrace    = true,
+    };
+    if (marker.loggingLevel == MDN_LOGGER_LOGGING_LEVEL_COUNT) {
+        return;
+    }
+    mdn_Logger_dispatchMessage(&marker, LOGGER_BACKTRACE_START_MESSAGE);
+    mdn_Logger_Backtrace_flush(backtrace, mdn_Logger_dispatchHeldBack, NULL);
+    marker.messageLen = sizeof(LOGGER_BACKTRACE_END_MESSAGE) - 1;
+    mdn_Logger_dispatchMessage(&marker, LOGGER_BACKTRACE_END_MESSAGE);
+}
+
+// Holds 'record' back if some stream keeps it out, or flushes what the thread held back before it.
+// Returns whether the record is to be written, which it isn't when it is only enabled for the backtrace.
+static bool mdn_Logger_applyBacktrace(Logger_Backtrace_t *backtrace, const Logger_Record_t *record, const char *message, const char *format,
+                                      va_list args) {
+    const mdn_Logger_BacktraceConfig_t *backtraceConfig = &g_Logger_internalState->backtraceConfig;
+
+    if (record->loggingLevel >= backtraceConfig->flushLevel) {
+        mdn_Logger_flushBacktrace(backtrace, record);
+        return true;
+    }
+    // Written to every stream already
+    if ((record->callSite != NULL) && mdn_Logger_CallSiteRegistry_isForced(record->callSite)) {
+        return true;
+    }
+    if ((record->loggingLevel >= backtraceConfig->loggingLevel) &&
+        ((int)record->loggingLevel < atomic_load_explicit(&g_Logger_internalState->maxStreamLevel, memory_order_relaxed))) {
+        mdn_Logger_Backtrace_hold(backtrace, record, message, format, args);
+    }
+
+    return (int)record->loggingLevel >= atomic_load_explicit(&g_Logger_internalState->minStreamLevel, memory_order_relaxed);
+}
+
+// Either 'message' is already formatted, or 'format' and 'args' are
+static void mdn_Logger_logRecord(Logger_Record_t *record, const char *message, const char *format, va_list args) {
+    Logger_Backtrace_t *backtrace = g_Logger_internalState->backtrace;
+    bool                timed;
+    uint64_t            startNs = 0;
+
+    timed = mdn_Logger_Stats_countRecord(record->loggingLevel);
+    if (timed) {
+        startNs = mdn_Logger_Timestamp_getPreciseMonotonicNs();
+    }
+
+    mdn_Logger_Timestamp_get(&record->timestamp, g_Logger_internalState->useCoarseClock);
+    record->threadId = mdn_Logger_Thread_getId();
+
+    if ((backtrace == NULL) || mdn_Logger_applyBacktrace(backtrace, record, message, format, args)) {
+        mdn_Logger_dispatchRecord(record, message, format, args);
+    }
+
+    if (timed) {
+        mdn_Logger_Stats_countLatency(mdn_Logger_Timestamp_getPreciseMonotonicNs() - startNs);
+    }
+}
+
+void mdn_Logger_log(mdn_Logger_loggingLevel_t loggingLevel, const char *file, int line, const char *funcName, const char *format, ...) {
+    Logger_Record_t record = (Logger_Record_t){
         .loggingLevel = loggingLevel,
         .file         = file,
         .line         = line,
         .funcName     = funcName,
-        .format       = format,
+        .callSite     = NULL,
+        .messageLen   = 0,
     };
-    va_list                 args;
-    mdn_Logger_logPrintFunc logPrintFunc;
+    va_list args;
 
 #ifdef MDN_LOGGER_SAFE_MODE
     if (g_Logger_internalState == NULL) {
@@ -241,16 +1394,82 @@ void mdn_Logger_log(mdn_Logger_loggingLevel_t loggingLevel, const char *file, in
     }
 #endif  // MDN_LOGGER_SAFE_MODE
 
-    for (size_t idx = 0; idx < g_Logger_internalState->streamsArrLen; ++idx) {
-        if (loggingLevel < g_Logger_internalState->streamsArr[idx].loggingLevel) {
-            continue;
-        }
-        va_start(args, format);
-        va_copy(logToStreamArguments.args, args);
-        logToStreamArguments.streamIndex = idx;
-        logPrintFunc                     = g_mdn_Logger_logFormatToFuncMap[g_Logger_internalState->streamsArr[idx].loggingFormat];
-        logPrintFunc(&logToStreamArguments);
-        va_end(logToStreamArguments.args);
-        va_end(args);
+    // Already checked by the logging macros, but the function may be called directly
+    if (!MDN_LOGGER_IS_LEVEL_ENABLED(loggingLevel)) {
+        return;
+    }
+
+    va_start(args, format);
+    mdn_Logger_logRecord(&record, NULL, format, args);
+    va_end(args);
+}
+
+// Only there to get a valid va_list for mdn_Logger_logRecord()
+static void mdn_Logger_logRecordMessage(Logger_Record_t *record, const char *message, ...) {
+    va_list args;
+
+    va_start(args, message);
+    mdn_Logger_logRecord(record, message, NULL, args);
+    va_end(args);
+}
+
+void mdn_Logger_logMessage(mdn_Logger_loggingLevel_t loggingLevel, const char *file, int line, const char *funcName, const char *message, size_t messageLen) {
+    Logger_Record_t record = (Logger_Record_t){
+        .loggingLevel = loggingLevel,
+        .file         = file,
+        .line         = line,
+        .funcName     = funcName,
+        .callSite     = NULL,
+        .messageLen   = messageLen,
+    };
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return;
+    }
+    if (!IS_VALID_LOGGING_LEVEL(loggingLevel) || (file == NULL) || (line < 0) || (funcName == NULL) || (message == NULL)) {
+        return;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    // Checked by the C++ front end before formatting, but the function may be called directly
+    if (!MDN_LOGGER_IS_LEVEL_ENABLED(loggingLevel)) {
+        return;
+    }
+
+    mdn_Logger_logRecordMessage(&record, message);
+}
+
+void mdn_Logger_logSite(mdn_Logger_CallSite_t *callSite, const char *funcName, const char *format, ...) {
+    Logger_Record_t record;
+    uint32_t        flags;
+    va_list         args;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if (g_Logger_internalState == NULL) {
+        return;
+    }
+    if ((callSite == NULL) || !IS_VALID_LOGGING_LEVEL(callSite->loggingLevel) || (callSite->file == NULL) || (callSite->line < 0) ||
+        (callSite->funcName == NULL) || (funcName == NULL) || (format == NULL)) {
+        return;
     }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    // Already checked by the logging macros, but the function may be called directly
+    flags = atomic_load_explicit((atomic_uint_least32_t *)&callSite->flags, memory_order_relaxed);
+    if (((flags & MDN_LOGGER_CALL_SITE_FLAG_ENABLED) == 0) && (((flags & MDN_LOGGER_CALL_SITE_FLAG_REGISTERED) != 0) || !mdn_Logger_registerCallSite(callSite))) {
+        return;
+    }
+    record = (Logger_Record_t){
+        .loggingLevel = callSite->loggingLevel,
+        .file         = callSite->file,
+        .line         = callSite->line,
+        .funcName     = funcName,
+        .callSite     = callSite,
+        .messageLen   = 0,
+    };
+
+    va_start(args, format);
+    mdn_Logger_logRecord(&record, NULL, format, args);
+    va_end(args);
 }
@@ -0,0 +1,31 @@
+#ifndef LOGGER_INTERNAL_H
+#define LOGGER_INTERNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mdn/logger.h"
+
+#define LOGGER_CACHE_LINE_SIZE 64
+
+// Wall-clock time since the Unix epoch (UTC), converted to local time only when rendered
+typedef struct Logger_Timestamp_t_ {
+    int64_t sec;
+    int32_t nsec;
+} Logger_Timestamp_t;
+
+// Everything needed to render a record, once its message is already formatted
+typedef struct Logger_Record_t_ {
+    mdn_Logger_loggingLevel_t    loggingLevel;
+    const char                  *file;
+    int                          line;
+    const char                  *funcName;
+    const mdn_Logger_CallSite_t *callSite;  // NULL when logged through mdn_Logger_log()
+    Logger_Timestamp_t           timestamp;
+    uint64_t                     threadId;
+    size_t                       messageLen;
+    bool                         backtrace;  // Held back then flushed, only written to the streams whose level kept it out
+} Logger_Record_t;
+
+#endif  // LOGGER_INTERNAL_H
@@ -0,0 +1,176 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "lz_codec.h"
+
+#include <string.h>
+
+#define MIN_MATCH_LEN       4
+#define LAST_LITERALS_LEN   5   // The format requires a block to end with literals
+#define MATCH_FIND_LIMIT    12  // No match starts closer than this to the end of a block
+#define MAX_OFFSET          65535
+#define HASH_BITS           12
+#define HASH_MULTIPLIER     2654435761U
+#define SKIP_TRIGGER_SHIFT  6  // Steps grow while nothing matches, so incompressible data is skipped quickly
+#define TOKEN_LEN_BITS      4
+#define TOKEN_LEN_MASK      0x0FU
+#define LEN_BYTE_MAX        255U
+#define BYTE_BITS           8
+#define BYTE_MASK           0xFFU
+#define OFFSET_LEN          2
+
+static uint32_t mdn_Logger_Lz_load32(const uint8_t *bytes) {
+    uint32_t value;
+
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static size_t mdn_Logger_Lz_hash(uint32_t sequence) {
+    return (size_t)((sequence * HASH_MULTIPLIER) >> ((sizeof(sequence) * BYTE_BITS) - HASH_BITS));
+}
+
+// Writes the part of a length that doesn't fit in its token nibble
+static uint8_t *mdn_Logger_Lz_writeLength(uint8_t *out, size_t len) {
+    while (len >= LEN_BYTE_MAX) {
+        *out++  = (uint8_t)LEN_BYTE_MAX;
+        len    -= LEN_BYTE_MAX;
+    }
+    *out++ = (uint8_t)len;
+
+    return out;
+}
+
+static uint8_t *mdn_Logger_Lz_writeLiterals(uint8_t *out, uint8_t *token, const uint8_t *literals, size_t literalsLen) {
+    if (literalsLen >= TOKEN_LEN_MASK) {
+        *token |= (uint8_t)(TOKEN_LEN_MASK << TOKEN_LEN_BITS);
+        out     = mdn_Logger_Lz_writeLength(out, literalsLen - TOKEN_LEN_MASK);
+    } else {
+        *token |= (uint8_t)(literalsLen << TOKEN_LEN_BITS);
+    }
+    memcpy(out, literals, literalsLen);
+
+    return out + literalsLen;
+}
+
+static uint8_t *mdn_Logger_Lz_writeSequence(uint8_t *out, const uint8_t *literals, size_t literalsLen, size_t offset, size_t matchLen) {
+    uint8_t *token = out++;
+
+    *token  = 0;
+    out     = mdn_Logger_Lz_writeLiterals(out, token, literals, literalsLen);
+    *out++  = (uint8_t)(offset & BYTE_MASK);
+    *out++  = (uint8_t)(offset >> BYTE_BITS);
+    matchLen -= MIN_MATCH_LEN;
+    if (matchLen >= TOKEN_LEN_MASK) {
+        *token |= (uint8_t)TOKEN_LEN_MASK;
+        out     = mdn_Logger_Lz_writeLength(out, matchLen - TOKEN_LEN_MASK);
+    } else {
+        *token |= (uint8_t)matchLen;
+    }
+
+    return out;
+}
+
+size_t mdn_Logger_Lz_compress(const uint8_t *src, size_t srcLen, uint8_t *dst) {
+    uint32_t hashTable[(size_t)1 << HASH_BITS];  // Last position of each hashed 4 bytes sequence
+    uint8_t *out    = dst;
+    size_t   anchor = 0;  // Start of the literals not written yet
+    size_t   pos    = 0;
+    size_t   matchPos;
+    size_t   matchLen;
+    uint32_t sequence;
+    size_t   hash;
+
+    if (srcLen >= MATCH_FIND_LIMIT) {
+        memset(hashTable, 0, sizeof(hashTable));
+        while (pos <= srcLen - MATCH_FIND_LIMIT) {
+            sequence        = mdn_Logger_Lz_load32(src + pos);
+            hash            = mdn_Logger_Lz_hash(sequence);
+            matchPos        = hashTable[hash];
+            hashTable[hash] = (uint32_t)pos;
+            if ((matchPos >= pos) || ((pos - matchPos) > MAX_OFFSET) || (mdn_Logger_Lz_load32(src + matchPos) != sequence)) {
+                pos += 1 + ((pos - anchor) >> SKIP_TRIGGER_SHIFT);
+                continue;
+            }
+            matchLen = MIN_MATCH_LEN;
+            while (((pos + matchLen) < (srcLen - LAST_LITERALS_LEN)) && (src[matchPos + matchLen] == src[pos + matchLen])) {
+                ++matchLen;
+            }
+            out     = mdn_Logger_Lz_writeSequence(out, src + anchor, pos - anchor, pos - matchPos, matchLen);
+            pos    += matchLen;
+            anchor  = pos;
+        }
+    }
+
+    // The last sequence only has literals
+    *out = 0;
+    out  = mdn_Logger_Lz_writeLiterals(out + 1, out, src + anchor, srcLen - anchor);
+
+    return (size_t)(out - dst);
+}
+
+static bool mdn_Logger_Lz_readLength(const uint8_t **in, const uint8_t *inEnd, size_t *len) {
+    uint8_t byte;
+
+    do {
+        if (*in == inEnd) {
+            return false;
+        }
+        byte  = *(*in)++;
+        *len += byte;
+    } while (byte == LEN_BYTE_MAX);
+
+    return true;
+}
+
+bool mdn_Logger_Lz_decompress(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstLen) {
+    const uint8_t *in     = src;
+    const uint8_t *inEnd  = src + srcLen;
+    uint8_t       *out    = dst;
+    uint8_t       *outEnd = dst + dstLen;
+    const uint8_t *match;
+    uint8_t        token;
+    size_t         literalsLen;
+    size_t         matchLen;
+    size_t         offset;
+
+    while (in < inEnd) {
+        token       = *in++;
+        literalsLen = token >> TOKEN_LEN_BITS;
+        if ((literalsLen == TOKEN_LEN_MASK) && !mdn_Logger_Lz_readLength(&in, inEnd, &literalsLen)) {
+            return false;
+        }
+        if ((literalsLen > (size_t)(inEnd - in)) || (literalsLen > (size_t)(outEnd - out))) {
+            return false;
+        }
+        memcpy(out, in, literalsLen);
+        in  += literalsLen;
+        out += literalsLen;
+        if (in == inEnd) {
+            break;
+        }
+
+        if ((size_t)(inEnd - in) < OFFSET_LEN) {
+            return false;
+        }
+        offset  = (size_t)in[0] | ((size_t)in[1] << BYTE_BITS);
+        in     += OFFSET_LEN;
+        if ((offset == 0) || (offset > (size_t)(out - dst))) {
+            return false;
+        }
+        matchLen = token & TOKEN_LEN_MASK;
+        if ((matchLen == TOKEN_LEN_MASK) && !mdn_Logger_Lz_readLength(&in, inEnd, &matchLen)) {
+            return false;
+        }
+        matchLen += MIN_MATCH_LEN;
+        if (matchLen > (size_t)(outEnd - out)) {
+            return false;
+        }
+        // Byte by byte, as the match may overlap the bytes it produces
+        match = out - offset;
+        for (size_t idx = 0; idx < matchLen; ++idx) {
+            out[idx] = match[idx];
+        }
+        out += matchLen;
+    }
+
+    return out == outEnd;
+}
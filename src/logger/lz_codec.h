@@ -0,0 +1,20 @@
+#ifndef LOGGER_LZ_CODEC_H
+#define LOGGER_LZ_CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// LZ77 block codec, in the LZ4 block format: sequences of literals followed by a match (2 bytes offset in a 64 KiB window).
+// Fast rather than tight, it targets repetitive text such as log lines. Each block is self-contained.
+
+// Largest compressed size of 'srcLen' bytes (incompressible input grows slightly)
+#define LOGGER_LZ_COMPRESS_BOUND(srcLen) ((srcLen) + ((srcLen) / 255) + 16)
+
+// 'dst' must hold LOGGER_LZ_COMPRESS_BOUND(srcLen) bytes. Returns the compressed size.
+size_t mdn_Logger_Lz_compress(const uint8_t *src, size_t srcLen, uint8_t *dst);
+
+// Returns false unless 'src' decompresses to exactly 'dstLen' bytes. Safe on corrupted input.
+bool mdn_Logger_Lz_decompress(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstLen);
+
+#endif  // LOGGER_LZ_CODEC_H
@@ -0,0 +1,116 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mdn/logger.h"
+#include "mdn/mock_wrapper.h"
+#include "sink.h"
+#include "thread.h"
+
+// Records are appended after those held, reads take the oldest bytes and move the rest to the front
+typedef struct Logger_MemorySink_t_ {
+    Logger_Mutex_t mutex;
+    size_t         capacity;
+    size_t         len;
+    char           buffer[];  // 'capacity' bytes
+} Logger_MemorySink_t;
+
+// Called with 'mutex' locked
+static bool mdn_Logger_MemorySink_append(Logger_MemorySink_t *sink, const char *data, size_t len) {
+    if (len > (sink->capacity - sink->len)) {
+        return false;
+    }
+    memcpy(sink->buffer + sink->len, data, len);
+    sink->len += len;
+
+    return true;
+}
+
+static bool mdn_Logger_MemorySink_write(void *context, const char *data, size_t len) {
+    Logger_MemorySink_t *sink = context;
+    bool                 written;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    written = mdn_Logger_MemorySink_append(sink, data, len);
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return written;
+}
+
+static bool mdn_Logger_MemorySink_writeBatch(void *context, const mdn_Logger_SinkBuffer_t *buffersArr, size_t buffersArrLen) {
+    Logger_MemorySink_t *sink    = context;
+    bool                 written = true;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    for (size_t idx = 0; idx < buffersArrLen; ++idx) {
+        written = mdn_Logger_MemorySink_append(sink, buffersArr[idx].data, buffersArr[idx].len) && written;
+    }
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return written;
+}
+
+static void mdn_Logger_MemorySink_close(void *context) {
+    Logger_MemorySink_t *sink = context;
+
+    mdn_Logger_Mutex_destroy(&sink->mutex);
+    free(sink);
+}
+
+static const Logger_SinkOps_t g_Logger_MemorySink_ops = {
+    .write      = mdn_Logger_MemorySink_write,
+    .writeBatch = mdn_Logger_MemorySink_writeBatch,
+    .close      = mdn_Logger_MemorySink_close,
+};
+
+mdn_Status_t mdn_Logger_createMemorySink(mdn_Logger_Sink_t *sink, size_t capacity) {
+    Logger_MemorySink_t *sinkContext;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((sink == NULL) || (capacity == 0)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    if (capacity > (SIZE_MAX - sizeof(*sinkContext))) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    sinkContext = MDN_MW_malloc(sizeof(*sinkContext) + capacity);
+    if (sinkContext == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    // Thread primitives only fail on resources exhaustion, hence reported as memory allocation failures
+    if (!mdn_Logger_Mutex_init(&sinkContext->mutex)) {
+        free(sinkContext);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    sinkContext->capacity = capacity;
+    sinkContext->len      = 0;
+    *sink                 = (mdn_Logger_Sink_t){
+        .ops     = &g_Logger_MemorySink_ops,
+        .context = sinkContext,
+    };
+
+    return MDN_STATUS_SUCCESS;
+}
+
+size_t mdn_Logger_readMemorySink(mdn_Logger_Sink_t sink, char *buffer, size_t size) {
+    Logger_MemorySink_t *sinkContext = sink.context;
+    size_t               readLen;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((sink.ops != &g_Logger_MemorySink_ops) || (sinkContext == NULL) || ((buffer == NULL) && (size != 0))) {
+        return 0;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    mdn_Logger_Mutex_lock(&sinkContext->mutex);
+    readLen = (size < sinkContext->len) ? size : sinkContext->len;
+    if (readLen > 0) {
+        memcpy(buffer, sinkContext->buffer, readLen);
+        memmove(sinkContext->buffer, sinkContext->buffer + readLen, sinkContext->len - readLen);
+        sinkContext->len -= readLen;
+    }
+    mdn_Logger_Mutex_unlock(&sinkContext->mutex);
+
+    return readLen;
+}
@@ -0,0 +1,154 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "mmap_sink.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mdn/mock_wrapper.h"
+#include "thread.h"
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif  // OS
+
+#if (defined __APPLE__) || (defined __linux__)
+# define MMAP_SINK_FILE_MODE (S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)
+
+// The file is preallocated and mapped one chunk (window) at a time. Records are copied into the window
+// under a mutex, which is only held for a memcpy() unless the window is full and the next one is mapped.
+struct Logger_MmapSink_t_ {
+    Logger_Mutex_t mutex;
+    int            fd;
+    char          *window;  // NULL once a chunk couldn't be mapped, following records are then dropped
+    size_t         windowSize;
+    off_t          windowOffset;  // In the file, a multiple of 'windowSize'
+    size_t         windowPos;     // Bytes already written in the window
+};
+
+static bool mdn_Logger_MmapSink_preallocate(int fd, off_t offset, size_t len) {
+# if defined __linux__
+    // Reserves the blocks up front, so writing to the mapping doesn't fault on a full disk
+    return posix_fallocate(fd, offset, (off_t)len) == 0;
+# else
+    return ftruncate(fd, offset + (off_t)len) == 0;
+# endif  // OS
+}
+
+static bool mdn_Logger_MmapSink_mapWindow(Logger_MmapSink_t *sink, off_t windowOffset) {
+    void *window;
+
+    if (!mdn_Logger_MmapSink_preallocate(sink->fd, windowOffset, sink->windowSize)) {
+        return false;
+    }
+    window = mmap(NULL, sink->windowSize, PROT_READ | PROT_WRITE, MAP_SHARED, sink->fd, windowOffset);
+    if (window == MAP_FAILED) {  // NOLINT(performance-no-int-to-ptr)
+        return false;
+    }
+    sink->window       = window;
+    sink->windowOffset = windowOffset;
+    sink->windowPos    = 0;
+
+    return true;
+}
+
+static bool mdn_Logger_MmapSink_write(void *context, const char *data, size_t len) {
+    Logger_MmapSink_t *sink = context;
+    size_t             copyLen;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    while ((len > 0) && (sink->window != NULL)) {
+        if (sink->windowPos == sink->windowSize) {
+            (void)munmap(sink->window, sink->windowSize);
+            sink->window = NULL;
+            (void)mdn_Logger_MmapSink_mapWindow(sink, sink->windowOffset + (off_t)sink->windowSize);
+            continue;
+        }
+        copyLen = sink->windowSize - sink->windowPos;
+        if (copyLen > len) {
+            copyLen = len;
+        }
+        memcpy(sink->window + sink->windowPos, data, copyLen);
+        sink->windowPos += copyLen;
+        data            += copyLen;
+        len             -= copyLen;
+    }
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return len == 0;  // Whatever is left couldn't be mapped
+}
+
+// Truncates the preallocated file to what was actually written
+static void mdn_Logger_MmapSink_close(void *context) {
+    Logger_MmapSink_t *sink = context;
+
+    if (sink->window != NULL) {
+        (void)munmap(sink->window, sink->windowSize);
+    }
+    (void)ftruncate(sink->fd, sink->windowOffset + (off_t)sink->windowPos);
+    (void)close(sink->fd);
+    mdn_Logger_Mutex_destroy(&sink->mutex);
+    free(sink);
+}
+
+mdn_Status_t mdn_Logger_MmapSink_create(Logger_MmapSink_t **sink, const char *path, size_t chunkSize) {
+    Logger_MmapSink_t *sinkTemp;
+    size_t             pageSize = (size_t)sysconf(_SC_PAGESIZE);
+
+    if (chunkSize == 0) {
+        chunkSize = LOGGER_MMAP_SINK_DEFAULT_CHUNK_SIZE;
+    }
+
+    sinkTemp = MDN_MW_malloc(sizeof(*sinkTemp));
+    if (sinkTemp == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    sinkTemp->windowSize = ((chunkSize + pageSize - 1) / pageSize) * pageSize;  // Mappings start on page boundaries
+    sinkTemp->fd         = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, MMAP_SINK_FILE_MODE);  // NOLINT(hicpp-vararg)
+    if (sinkTemp->fd < 0) {
+        free(sinkTemp);
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    // Thread primitives only fail on resources exhaustion, as do preallocation and mapping, hence reported as memory allocation failures
+    if (!mdn_Logger_Mutex_init(&sinkTemp->mutex)) {
+        (void)close(sinkTemp->fd);
+        free(sinkTemp);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    if (!mdn_Logger_MmapSink_mapWindow(sinkTemp, 0)) {
+        mdn_Logger_Mutex_destroy(&sinkTemp->mutex);
+        (void)close(sinkTemp->fd);
+        free(sinkTemp);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    *sink = sinkTemp;
+
+    return MDN_STATUS_SUCCESS;
+}
+#elif defined _WIN32
+static bool mdn_Logger_MmapSink_write(void *context, const char *data, size_t len) {
+    (void)context;
+    (void)data;
+    (void)len;
+    return false;
+}
+
+static void mdn_Logger_MmapSink_close(void *context) {
+    (void)context;
+}
+
+mdn_Status_t mdn_Logger_MmapSink_create(Logger_MmapSink_t **sink, const char *path, size_t chunkSize) {
+    (void)sink;
+    (void)path;
+    (void)chunkSize;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+#endif  // OS
+
+const Logger_SinkOps_t g_Logger_MmapSink_ops = {
+    .write = mdn_Logger_MmapSink_write,
+    .close = mdn_Logger_MmapSink_close,
+};
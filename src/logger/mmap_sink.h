@@ -0,0 +1,17 @@
+#ifndef LOGGER_MMAP_SINK_H
+#define LOGGER_MMAP_SINK_H
+
+#include "mdn/logger.h"
+#include "sink.h"
+
+#define LOGGER_MMAP_SINK_DEFAULT_CHUNK_SIZE (16 * 1024 * 1024)
+
+typedef struct Logger_MmapSink_t_ Logger_MmapSink_t;
+
+extern const Logger_SinkOps_t g_Logger_MmapSink_ops;
+
+// Creates (or truncates) the file at 'path'. Returns MDN_STATUS_ERROR_BAD_ARGUMENT when it can't be opened,
+// and on platforms without memory-mapped files
+mdn_Status_t mdn_Logger_MmapSink_create(Logger_MmapSink_t **sink, const char *path, size_t chunkSize);
+
+#endif  // LOGGER_MMAP_SINK_H
@@ -0,0 +1,61 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "mdn/logger.h"
+
+#include <stdatomic.h>
+
+#include "stats.h"
+#include "timestamp.h"
+
+#define NSEC_PER_SEC 1000000000ULL
+
+_Static_assert(sizeof(atomic_uint_least64_t) == sizeof(uint64_t), "Error: the call site state can't be updated atomically in place");
+#define AS_ATOMIC(field) ((atomic_uint_least64_t *)&(field))
+
+// Generic cell rate algorithm: a token bucket kept as the single time at which it will be full again, so that taking
+// a token is one compare-and-swap. A record is let through unless that time is more than 'burst - 1' intervals ahead.
+bool mdn_Logger_allowRateLimited(mdn_Logger_RateLimit_t *rateLimit, unsigned ratePerSec, unsigned burst, const mdn_Logger_CallSite_t *callSite, const char *funcName) {
+    uint64_t nowNs, intervalNs, toleranceNs, nextAllowedNs, newNextAllowedNs, suppressedCount;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((rateLimit == NULL) || (ratePerSec == 0) || (burst == 0) || (callSite == NULL) || (funcName == NULL)) {
+        return false;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    nowNs         = mdn_Logger_Timestamp_getMonotonicNs();
+    intervalNs    = NSEC_PER_SEC / ratePerSec;
+    toleranceNs   = intervalNs * (burst - 1);
+    nextAllowedNs = atomic_load_explicit(AS_ATOMIC(rateLimit->nextAllowedNs), memory_order_relaxed);
+    do {
+        if ((nextAllowedNs > nowNs) && ((nextAllowedNs - nowNs) > toleranceNs)) {
+            atomic_fetch_add_explicit(AS_ATOMIC(rateLimit->suppressedCount), 1, memory_order_relaxed);
+            mdn_Logger_Stats_countFiltered();
+            return false;
+        }
+        newNextAllowedNs = ((nextAllowedNs > nowNs) ? nextAllowedNs : nowNs) + intervalNs;
+    } while (!atomic_compare_exchange_weak_explicit(AS_ATOMIC(rateLimit->nextAllowedNs), &nextAllowedNs, newNextAllowedNs, memory_order_relaxed, memory_order_relaxed));
+
+    // Cheap check first, so that sites which never drop anything don't write the shared counter
+    if (atomic_load_explicit(AS_ATOMIC(rateLimit->suppressedCount), memory_order_relaxed) != 0) {
+        suppressedCount = atomic_exchange_explicit(AS_ATOMIC(rateLimit->suppressedCount), 0, memory_order_relaxed);
+        if (suppressedCount != 0) {
+            mdn_Logger_log(callSite->loggingLevel, callSite->file, callSite->line, funcName, "%llu records suppressed by the rate limit of this call site",
+                           (unsigned long long)suppressedCount);
+        }
+    }
+    return true;
+}
+
+bool mdn_Logger_allowSampled(mdn_Logger_Sample_t *sample, unsigned sampleEvery) {
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((sample == NULL) || (sampleEvery == 0)) {
+        return false;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    if ((atomic_fetch_add_explicit(AS_ATOMIC(sample->callsCount), 1, memory_order_relaxed) % sampleEvery) != 0) {
+        mdn_Logger_Stats_countFiltered();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,259 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "rotating_sink.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "compressed_format.h"
+#include "mdn/mock_wrapper.h"
+#include "thread.h"
+
+#if (defined __APPLE__) || (defined __linux__)
+# define ROTATION_IDLE_WAIT_MS  1000
+# define MSEC_PER_SEC           1000
+# define SEGMENT_INDEX_MAX_LEN  10  // Digits of UINT_MAX
+# define SEGMENT_PATH_EXTRA_LEN (1 + SEGMENT_INDEX_MAX_LEN + sizeof(LOGGER_ROTATING_SINK_COMPRESSED_SUFFIX))
+
+// Producers write to 'file' under 'mutex', and only ask the rotation thread to rotate it. That thread renames the file,
+// opens its replacement and only then takes 'mutex', to swap the two. Compression and retention happen afterwards,
+// without holding it. Rotated segments are named "<path>.1" (newest) to "<path>.<retainedCount>".
+struct Logger_RotatingSink_t_ {
+    Logger_Mutex_t  mutex;
+    Logger_Cond_t   cond;  // Wakes the rotation thread
+    Logger_Thread_t thread;
+    FILE           *file;
+    size_t          fileSize;
+    bool            rotationRequested;
+    bool            stopRequested;
+    size_t          maxFileSize;
+    time_t          rotationIntervalSec;
+    time_t          nextRotationTime;  // Wall-clock, a multiple of 'rotationIntervalSec'
+    unsigned        retainedCount;
+    bool            compress;
+    char           *segmentPath;  // Scratches for the paths of rotated segments
+    char           *otherSegmentPath;
+    size_t          pathLen;
+    char            path[];
+};
+
+static void mdn_Logger_RotatingSink_formatSegmentPath(const Logger_RotatingSink_t *sink, char *segmentPath, unsigned index, bool compressed) {
+    (void)snprintf(segmentPath, sink->pathLen + SEGMENT_PATH_EXTRA_LEN, "%s.%u%s", sink->path, index, compressed ? LOGGER_ROTATING_SINK_COMPRESSED_SUFFIX : "");  // NOLINT(hicpp-vararg)
+}
+
+// Makes room for the newest segment: drops the oldest one, and shifts the others
+static void mdn_Logger_RotatingSink_shiftSegments(Logger_RotatingSink_t *sink) {
+    for (int compressed = 0; compressed <= 1; ++compressed) {
+        mdn_Logger_RotatingSink_formatSegmentPath(sink, sink->segmentPath, sink->retainedCount, compressed);
+        (void)remove(sink->segmentPath);
+        for (unsigned index = sink->retainedCount - 1; index >= 1; --index) {
+            mdn_Logger_RotatingSink_formatSegmentPath(sink, sink->otherSegmentPath, index, compressed);
+            (void)rename(sink->otherSegmentPath, sink->segmentPath);
+            memcpy(sink->segmentPath, sink->otherSegmentPath, sink->pathLen + SEGMENT_PATH_EXTRA_LEN);
+        }
+    }
+}
+
+static void mdn_Logger_RotatingSink_compressSegment(Logger_RotatingSink_t *sink) {
+    FILE        *rawStream;
+    FILE        *compressedStream;
+    mdn_Status_t status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+
+    mdn_Logger_RotatingSink_formatSegmentPath(sink, sink->segmentPath, 1, false);
+    mdn_Logger_RotatingSink_formatSegmentPath(sink, sink->otherSegmentPath, 1, true);
+    rawStream = fopen(sink->segmentPath, "rb");
+    if (rawStream == NULL) {
+        return;
+    }
+    compressedStream = fopen(sink->otherSegmentPath, "wb");
+    if (compressedStream != NULL) {
+        status = mdn_Logger_CompressedFormat_compress(rawStream, compressedStream);
+        if (fclose(compressedStream) != 0) {
+            status = MDN_STATUS_ERROR_BAD_ARGUMENT;
+        }
+    }
+    (void)fclose(rawStream);
+
+    // Keeps the segment uncompressed rather than losing it
+    (void)remove((status == MDN_STATUS_SUCCESS) ? sink->segmentPath : sink->otherSegmentPath);
+}
+
+static void mdn_Logger_RotatingSink_rotate(Logger_RotatingSink_t *sink) {
+    FILE *newFile;
+    FILE *oldFile;
+
+    if (sink->retainedCount > 0) {
+        mdn_Logger_RotatingSink_shiftSegments(sink);
+    }
+    // Producers keep writing to the renamed file until the swap, so no record is lost
+    mdn_Logger_RotatingSink_formatSegmentPath(sink, sink->segmentPath, 1, false);
+    if (rename(sink->path, sink->segmentPath) != 0) {
+        return;
+    }
+    newFile = fopen(sink->path, "w");
+    if (newFile == NULL) {
+        (void)rename(sink->segmentPath, sink->path);
+        return;
+    }
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    oldFile        = sink->file;
+    sink->file     = newFile;
+    sink->fileSize = 0;
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    (void)fclose(oldFile);
+    if (sink->retainedCount == 0) {
+        (void)remove(sink->segmentPath);
+    } else if (sink->compress) {
+        mdn_Logger_RotatingSink_compressSegment(sink);
+    }
+}
+
+static time_t mdn_Logger_RotatingSink_nextRotationTime(const Logger_RotatingSink_t *sink, time_t now) {
+    return ((now / sink->rotationIntervalSec) + 1) * sink->rotationIntervalSec;
+}
+
+static void mdn_Logger_RotatingSink_thread(void *arg) {
+    Logger_RotatingSink_t *sink = arg;
+    time_t                 now;
+    unsigned               waitMs;
+    bool                   isRotationDue;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    while (!sink->stopRequested) {
+        now           = time(NULL);
+        isRotationDue = sink->rotationRequested || ((sink->rotationIntervalSec != 0) && (now >= sink->nextRotationTime));
+        if (!isRotationDue) {
+            waitMs = ROTATION_IDLE_WAIT_MS;
+            if ((sink->rotationIntervalSec != 0) && (((sink->nextRotationTime - now) * MSEC_PER_SEC) < waitMs)) {
+                waitMs = (unsigned)((sink->nextRotationTime - now) * MSEC_PER_SEC);
+            }
+            mdn_Logger_Cond_timedWait(&sink->cond, &sink->mutex, waitMs);
+            continue;
+        }
+        sink->rotationRequested = false;
+        if (sink->rotationIntervalSec != 0) {
+            sink->nextRotationTime = mdn_Logger_RotatingSink_nextRotationTime(sink, now);
+        }
+        if (sink->fileSize == 0) {
+            continue;
+        }
+        mdn_Logger_Mutex_unlock(&sink->mutex);
+        mdn_Logger_RotatingSink_rotate(sink);
+        mdn_Logger_Mutex_lock(&sink->mutex);
+    }
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+}
+
+static bool mdn_Logger_RotatingSink_write(void *context, const char *data, size_t len) {
+    Logger_RotatingSink_t *sink = context;
+    size_t                 writtenLen;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    writtenLen      = fwrite(data, 1, len, sink->file);
+    sink->fileSize += writtenLen;
+    if ((sink->maxFileSize != 0) && (sink->fileSize >= sink->maxFileSize) && !sink->rotationRequested) {
+        sink->rotationRequested = true;
+        mdn_Logger_Cond_signal(&sink->cond);
+    }
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return writtenLen == len;
+}
+
+// The current file isn't rotated, so it can be appended to by the next run
+static void mdn_Logger_RotatingSink_close(void *context) {
+    Logger_RotatingSink_t *sink = context;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    sink->stopRequested = true;
+    mdn_Logger_Cond_signal(&sink->cond);
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+    mdn_Logger_Thread_join(&sink->thread);
+
+    (void)fclose(sink->file);
+    mdn_Logger_Cond_destroy(&sink->cond);
+    mdn_Logger_Mutex_destroy(&sink->mutex);
+    free(sink);
+}
+
+mdn_Status_t mdn_Logger_RotatingSink_create(Logger_RotatingSink_t **sink, const mdn_Logger_RotatingFileConfig_t *config) {
+    Logger_RotatingSink_t *sinkTemp;
+    size_t                 pathLen = strlen(config->path);
+    size_t                 segmentPathSize;
+    long                   fileSize;
+    mdn_Status_t           status;
+
+    segmentPathSize = pathLen + SEGMENT_PATH_EXTRA_LEN;
+    sinkTemp        = MDN_MW_malloc(sizeof(*sinkTemp) + (pathLen + 1) + (2 * segmentPathSize));
+    if (sinkTemp == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    memcpy(sinkTemp->path, config->path, pathLen + 1);
+    sinkTemp->pathLen             = pathLen;
+    sinkTemp->segmentPath         = sinkTemp->path + pathLen + 1;
+    sinkTemp->otherSegmentPath    = sinkTemp->segmentPath + segmentPathSize;
+    sinkTemp->fileSize            = 0;
+    sinkTemp->rotationRequested   = false;
+    sinkTemp->stopRequested       = false;
+    sinkTemp->maxFileSize         = config->maxFileSize;
+    sinkTemp->rotationIntervalSec = (time_t)config->rotationIntervalSec;
+    sinkTemp->retainedCount       = config->retainedCount;
+    sinkTemp->compress            = config->compress;
+    if (sinkTemp->rotationIntervalSec != 0) {
+        sinkTemp->nextRotationTime = mdn_Logger_RotatingSink_nextRotationTime(sinkTemp, time(NULL));
+    }
+
+    // Appends to what the previous run left, and counts it, for size rotation to include it
+    sinkTemp->file = fopen(config->path, "a");
+    if (sinkTemp->file == NULL) {
+        free(sinkTemp);
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if ((fseek(sinkTemp->file, 0, SEEK_END) == 0) && ((fileSize = ftell(sinkTemp->file)) > 0)) {
+        sinkTemp->fileSize          = (size_t)fileSize;
+        sinkTemp->rotationRequested = (sinkTemp->maxFileSize != 0) && (sinkTemp->fileSize >= sinkTemp->maxFileSize);
+    }
+    // Thread primitives only fail on resources exhaustion, hence reported as memory allocation failures
+    status = MDN_STATUS_ERROR_MEM_ALLOC;
+    if (mdn_Logger_Mutex_init(&sinkTemp->mutex)) {
+        if (mdn_Logger_Cond_init(&sinkTemp->cond)) {
+            if (mdn_Logger_Thread_create(&sinkTemp->thread, mdn_Logger_RotatingSink_thread, sinkTemp)) {
+                *sink = sinkTemp;
+                return MDN_STATUS_SUCCESS;
+            }
+            mdn_Logger_Cond_destroy(&sinkTemp->cond);
+        }
+        mdn_Logger_Mutex_destroy(&sinkTemp->mutex);
+    }
+    (void)fclose(sinkTemp->file);
+    free(sinkTemp);
+
+    return status;
+}
+#elif defined _WIN32
+static bool mdn_Logger_RotatingSink_write(void *context, const char *data, size_t len) {
+    (void)context;
+    (void)data;
+    (void)len;
+    return false;
+}
+
+static void mdn_Logger_RotatingSink_close(void *context) {
+    (void)context;
+}
+
+// Open files can't be renamed on Windows
+mdn_Status_t mdn_Logger_RotatingSink_create(Logger_RotatingSink_t **sink, const mdn_Logger_RotatingFileConfig_t *config) {
+    (void)sink;
+    (void)config;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+#endif  // OS
+
+const Logger_SinkOps_t g_Logger_RotatingSink_ops = {
+    .write = mdn_Logger_RotatingSink_write,
+    .close = mdn_Logger_RotatingSink_close,
+};
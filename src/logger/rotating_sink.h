@@ -0,0 +1,17 @@
+#ifndef LOGGER_ROTATING_SINK_H
+#define LOGGER_ROTATING_SINK_H
+
+#include "mdn/logger.h"
+#include "sink.h"
+
+#define LOGGER_ROTATING_SINK_COMPRESSED_SUFFIX ".mdnz"
+
+typedef struct Logger_RotatingSink_t_ Logger_RotatingSink_t;
+
+extern const Logger_SinkOps_t g_Logger_RotatingSink_ops;
+
+// Creates (or truncates) the file at 'config->path', and starts the thread that rotates it.
+// Returns MDN_STATUS_ERROR_BAD_ARGUMENT when it can't be opened, and on Windows.
+mdn_Status_t mdn_Logger_RotatingSink_create(Logger_RotatingSink_t **sink, const mdn_Logger_RotatingFileConfig_t *config);
+
+#endif  // LOGGER_ROTATING_SINK_H
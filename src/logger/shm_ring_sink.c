@@ -0,0 +1,514 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "logger_internal.h"
+#include "mdn/logger.h"
+#include "mdn/mock_wrapper.h"
+#include "sink.h"
+#include "thread.h"
+#include "timestamp.h"
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <errno.h>
+# include <fcntl.h>
+# include <signal.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif  // OS
+
+#if (defined __APPLE__) || (defined __linux__)
+# define SHM_RING_MAGIC          "MDNLOGR"
+# define SHM_RING_MAGIC_LEN      8  // With the null-terminator
+# define SHM_RING_VERSION        2
+# define SHM_RING_HEADER_SIZE    8192
+# define SHM_RING_SIZE_GRANULE   4096
+# define SHM_RING_DEFAULT_SIZE   (4 * 1024 * 1024)
+# define SHM_RING_MAX_SIZE       (1024 * 1024 * 1024)
+# define SHM_RING_FILE_MODE      (S_IRUSR | S_IWUSR)
+# define FRAME_ALIGNMENT         16  // Frame heads never straddle the end of the ring, nor leave less room than one before it
+# define MAX_RECORD_LEN_DIVISOR  4   // Records take up to a quarter of the ring
+# define PUBLISH_LEN_DIVISOR     8   // The drain frees room every eighth of the ring, not after each record
+# define OPEN_TIMEOUT_NS         (1000 * 1000000ULL)  // How long openers wait for the creator to set the object up
+# define STUCK_TIMEOUT_NS        (1000 * 1000000ULL)  // How long the drain waits on a record before checking on its producer
+# define PRODUCER_OPEN           1ULL
+# define NO_POS                  UINT64_MAX
+
+// Shared between processes, which only works for atomics that are lock-free
+_Static_assert((ATOMIC_LONG_LOCK_FREE == 2) && (ATOMIC_LLONG_LOCK_FREE == 2), "Error: shared memory needs lock-free 64-bit atomics");
+
+typedef struct Logger_ShmRingProducer_t_ {
+    atomic_uint_least64_t state;         // 0 while never used, else the pid << 1, plus PRODUCER_OPEN while its sink is
+    atomic_uint_least64_t pendingCount;  // Frames reserved by the process and not written yet
+    atomic_uint_least64_t recordsCount;
+    atomic_uint_least64_t overrunsCount;
+} Logger_ShmRingProducer_t;
+
+// Positions count the bytes of every frame ever reserved, as if the ring never wrapped. Producers reserve frames by moving
+// 'reservePos' forward, as long as that stays within a ring of 'readPos', which only the drain moves.
+typedef struct Logger_ShmRingHeader_t_ {
+    char                                                   magic[SHM_RING_MAGIC_LEN];
+    atomic_uint_least32_t                                  version;  // Stored last by the creator, 0 until the rest is set up
+    uint64_t                                               ringSize;
+    atomic_uint_least64_t                                  skippedLen;
+    _Alignas(LOGGER_CACHE_LINE_SIZE) atomic_uint_least64_t reservePos;
+    _Alignas(LOGGER_CACHE_LINE_SIZE) atomic_uint_least64_t readPos;
+    _Alignas(LOGGER_CACHE_LINE_SIZE) Logger_ShmRingProducer_t producersArr[MDN_LOGGER_SHM_RING_MAX_PRODUCERS];
+} Logger_ShmRingHeader_t;
+
+_Static_assert(sizeof(Logger_ShmRingHeader_t) <= SHM_RING_HEADER_SIZE, "Error: the ring header doesn't fit before the ring");
+
+// Frames are FRAME_ALIGNMENT aligned. The drain zeroes the frames it is done with, so the head of a frame that is reserved
+// but not written yet reads as 0, and a frame is written once its 'commitPos' is its own position + 1. A frame of pid 0 pads
+// the end of the ring, when the next one doesn't fit there.
+typedef struct Logger_ShmRingFrame_t_ {
+    atomic_uint_least64_t commitPos;
+    uint32_t              len;
+    uint32_t              pid;
+    char                  data[];
+} Logger_ShmRingFrame_t;
+
+_Static_assert(sizeof(Logger_ShmRingFrame_t) == FRAME_ALIGNMENT, "Error: frame heads are expected to fill an alignment unit");
+
+typedef struct Logger_ShmRing_t_ {
+    Logger_ShmRingHeader_t *header;
+    unsigned char          *ring;
+    size_t                  ringSize;
+    size_t                  mappingSize;
+} Logger_ShmRing_t;
+
+typedef struct Logger_ShmRingSink_t_ {
+    Logger_ShmRing_t          ring;
+    Logger_ShmRingProducer_t *producer;
+    uint32_t                  pid;
+    size_t                    maxRecordLen;
+} Logger_ShmRingSink_t;
+
+struct mdn_Logger_ShmRingDrain_t_ {
+    Logger_ShmRing_t ring;
+    uint64_t         readPos;
+    uint64_t         stuckPos;  // Where the drain last found a frame not written yet (NO_POS if it didn't)
+    uint64_t         stuckReservePos;
+    uint64_t         stuckSinceNs;
+};
+
+static Logger_ShmRingFrame_t *mdn_Logger_ShmRing_getFrame(const Logger_ShmRing_t *ring, uint64_t pos) {
+    return (Logger_ShmRingFrame_t *)(void *)(ring->ring + (pos % ring->ringSize));
+}
+
+static bool mdn_Logger_ShmRing_map(Logger_ShmRing_t *ring, int fd, size_t mappingSize) {
+    void *mapping = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (mapping == MAP_FAILED) {  // NOLINT(performance-no-int-to-ptr)
+        return false;
+    }
+    ring->header      = mapping;
+    ring->ring        = (unsigned char *)mapping + SHM_RING_HEADER_SIZE;
+    ring->ringSize    = mappingSize - SHM_RING_HEADER_SIZE;
+    ring->mappingSize = mappingSize;
+
+    return true;
+}
+
+static void mdn_Logger_ShmRing_unmap(const Logger_ShmRing_t *ring) {
+    (void)munmap(ring->header, ring->mappingSize);
+}
+
+// The object is created zeroed, which is where all the positions and counts start
+static mdn_Status_t mdn_Logger_ShmRing_create(Logger_ShmRing_t *ring, int fd, const char *name, size_t ringSize) {
+    // Mapping only fails on resources exhaustion, as does sizing the object, hence reported as a memory allocation failure
+    if ((ftruncate(fd, (off_t)(SHM_RING_HEADER_SIZE + ringSize)) != 0) || !mdn_Logger_ShmRing_map(ring, fd, SHM_RING_HEADER_SIZE + ringSize)) {
+        (void)close(fd);
+        (void)shm_unlink(name);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    (void)close(fd);
+    memcpy(ring->header->magic, SHM_RING_MAGIC, SHM_RING_MAGIC_LEN);
+    ring->header->ringSize = ringSize;
+    atomic_store_explicit(&ring->header->version, SHM_RING_VERSION, memory_order_release);
+
+    return MDN_STATUS_SUCCESS;
+}
+
+// Waits for the creator, who may have created the object but not have sized it, or not have set its header up, yet
+static mdn_Status_t mdn_Logger_ShmRing_attach(Logger_ShmRing_t *ring, int fd) {
+    uint64_t    deadlineNs = mdn_Logger_Timestamp_getMonotonicNs() + OPEN_TIMEOUT_NS;
+    struct stat fileStat   = {.st_size = 0};
+    bool        isSetUp;
+
+    while ((fstat(fd, &fileStat) == 0) && (fileStat.st_size == 0) && (mdn_Logger_Timestamp_getMonotonicNs() < deadlineNs)) {
+        mdn_Logger_Thread_yield();
+    }
+    if ((fileStat.st_size <= SHM_RING_HEADER_SIZE) || ((uint64_t)fileStat.st_size > (SHM_RING_HEADER_SIZE + SHM_RING_MAX_SIZE))
+        || !mdn_Logger_ShmRing_map(ring, fd, (size_t)fileStat.st_size)) {
+        (void)close(fd);
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    (void)close(fd);
+    while (!(isSetUp = (atomic_load_explicit(&ring->header->version, memory_order_acquire) != 0)) && (mdn_Logger_Timestamp_getMonotonicNs() < deadlineNs)) {
+        mdn_Logger_Thread_yield();
+    }
+    if (!isSetUp || (memcmp(ring->header->magic, SHM_RING_MAGIC, SHM_RING_MAGIC_LEN) != 0)
+        || (atomic_load_explicit(&ring->header->version, memory_order_relaxed) != SHM_RING_VERSION) || (ring->header->ringSize != ring->ringSize)
+        || ((ring->ringSize % SHM_RING_SIZE_GRANULE) != 0)) {
+        mdn_Logger_ShmRing_unmap(ring);
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+
+    return MDN_STATUS_SUCCESS;
+}
+
+// Whoever comes first, producer or drain, creates the object. Objects that can't be opened (bad name, permissions...),
+// or that aren't rings, are reported as bad arguments.
+static mdn_Status_t mdn_Logger_ShmRing_open(Logger_ShmRing_t *ring, mdn_Logger_ShmRingConfig_t shmRingConfig) {
+    size_t ringSize = (shmRingConfig.ringSize == 0) ? SHM_RING_DEFAULT_SIZE : shmRingConfig.ringSize;
+    int    fd;
+
+    if (ringSize > SHM_RING_MAX_SIZE) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    ringSize = ((ringSize + SHM_RING_SIZE_GRANULE - 1) / SHM_RING_SIZE_GRANULE) * SHM_RING_SIZE_GRANULE;
+
+    fd = shm_open(shmRingConfig.name, O_RDWR | O_CREAT | O_EXCL, SHM_RING_FILE_MODE);  // NOLINT(hicpp-vararg)
+    if (fd >= 0) {
+        return mdn_Logger_ShmRing_create(ring, fd, shmRingConfig.name, ringSize);
+    }
+    if (errno == EEXIST) {
+        fd = shm_open(shmRingConfig.name, O_RDWR, SHM_RING_FILE_MODE);  // NOLINT(hicpp-vararg)
+        if (fd >= 0) {
+            return mdn_Logger_ShmRing_attach(ring, fd);
+        }
+    }
+
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+
+// Slots of closed sinks are only taken over once there are no unused ones left, so that the drain gets to see their counts,
+// and slots of processes that are gone without closing their sink last
+static bool mdn_Logger_ShmRingSink_isClaimable(uint64_t state, unsigned pass) {
+    switch (pass) {
+        case 0:
+            return state == 0;
+        case 1:
+            return (state != 0) && ((state & PRODUCER_OPEN) == 0);
+        default:
+            return ((state & PRODUCER_OPEN) != 0) && (kill((pid_t)(state >> 1), 0) != 0) && (errno == ESRCH);
+    }
+}
+
+static Logger_ShmRingProducer_t *mdn_Logger_ShmRingSink_claimProducer(Logger_ShmRingHeader_t *header, uint32_t pid) {
+    Logger_ShmRingProducer_t *producer;
+    uint64_t                  state;
+
+    for (unsigned pass = 0; pass < 3; ++pass) {
+        for (size_t idx = 0; idx < MDN_LOGGER_SHM_RING_MAX_PRODUCERS; ++idx) {
+            producer = &header->producersArr[idx];
+            state    = atomic_load_explicit(&producer->state, memory_order_relaxed);
+            if (mdn_Logger_ShmRingSink_isClaimable(state, pass)
+                && atomic_compare_exchange_strong_explicit(&producer->state, &state, ((uint64_t)pid << 1) | PRODUCER_OPEN, memory_order_relaxed, memory_order_relaxed)) {
+                atomic_store_explicit(&producer->pendingCount, 0, memory_order_relaxed);
+                atomic_store_explicit(&producer->recordsCount, 0, memory_order_relaxed);
+                atomic_store_explicit(&producer->overrunsCount, 0, memory_order_relaxed);
+                return producer;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+// Lock-free: retries only when another producer reserved a frame in between, and gives up on a full ring rather than wait
+static bool mdn_Logger_ShmRingSink_write(void *context, const char *data, size_t len) {
+    Logger_ShmRingSink_t   *sink     = context;
+    Logger_ShmRingHeader_t *header   = sink->ring.header;
+    size_t                  frameLen = (sizeof(Logger_ShmRingFrame_t) + len + FRAME_ALIGNMENT - 1) & ~(size_t)(FRAME_ALIGNMENT - 1);
+    size_t                  padLen;
+    uint64_t                readPos;
+    uint64_t                pos;
+    Logger_ShmRingFrame_t  *frame;
+
+    if (len == 0) {
+        return true;
+    }
+    if (len > sink->maxRecordLen) {
+        (void)atomic_fetch_add_explicit(&sink->producer->overrunsCount, 1, memory_order_relaxed);
+        return false;
+    }
+
+    // Counted as pending before reserving, which releases the count to the drain along with the reservation. 'readPos' is loaded
+    // first, so that 'pos' is never behind it. Acquiring it orders copying into the frame after the drain is done with what was there.
+    (void)atomic_fetch_add_explicit(&sink->producer->pendingCount, 1, memory_order_relaxed);
+    do {
+        readPos = atomic_load_explicit(&header->readPos, memory_order_acquire);
+        pos     = atomic_load_explicit(&header->reservePos, memory_order_relaxed);
+        padLen  = sink->ring.ringSize - (size_t)(pos % sink->ring.ringSize);
+        padLen  = (padLen < frameLen) ? padLen : 0;
+        if ((pos + padLen + frameLen - readPos) > sink->ring.ringSize) {
+            (void)atomic_fetch_sub_explicit(&sink->producer->pendingCount, 1, memory_order_relaxed);
+            (void)atomic_fetch_add_explicit(&sink->producer->overrunsCount, 1, memory_order_relaxed);
+            return false;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&header->reservePos, &pos, pos + padLen + frameLen, memory_order_release, memory_order_relaxed));
+
+    if (padLen != 0) {
+        frame      = mdn_Logger_ShmRing_getFrame(&sink->ring, pos);
+        frame->len = (uint32_t)(padLen - sizeof(*frame));
+        frame->pid = 0;
+        atomic_store_explicit(&frame->commitPos, pos + 1, memory_order_release);
+        pos += padLen;
+    }
+    frame      = mdn_Logger_ShmRing_getFrame(&sink->ring, pos);
+    frame->len = (uint32_t)len;
+    frame->pid = sink->pid;
+    memcpy(frame->data, data, len);
+    atomic_store_explicit(&frame->commitPos, pos + 1, memory_order_release);
+    (void)atomic_fetch_sub_explicit(&sink->producer->pendingCount, 1, memory_order_release);
+    (void)atomic_fetch_add_explicit(&sink->producer->recordsCount, 1, memory_order_relaxed);
+
+    return true;
+}
+
+// Keeps the pid and counts for the drain to read, until the slot is needed again
+static void mdn_Logger_ShmRingSink_close(void *context) {
+    Logger_ShmRingSink_t *sink = context;
+
+    atomic_store_explicit(&sink->producer->state, (uint64_t)sink->pid << 1, memory_order_relaxed);
+    mdn_Logger_ShmRing_unmap(&sink->ring);
+    free(sink);
+}
+
+static const Logger_SinkOps_t g_Logger_ShmRingSink_ops = {
+    .write = mdn_Logger_ShmRingSink_write,
+    .close = mdn_Logger_ShmRingSink_close,
+};
+
+mdn_Status_t mdn_Logger_createShmRingSink(mdn_Logger_Sink_t *sink, mdn_Logger_ShmRingConfig_t shmRingConfig) {
+    Logger_ShmRingSink_t *sinkContext;
+    mdn_Status_t          status;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((sink == NULL) || (shmRingConfig.name == NULL)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    sinkContext = MDN_MW_malloc(sizeof(*sinkContext));
+    if (sinkContext == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    status = mdn_Logger_ShmRing_open(&sinkContext->ring, shmRingConfig);
+    if (status != MDN_STATUS_SUCCESS) {
+        free(sinkContext);
+        return status;
+    }
+    sinkContext->pid          = (uint32_t)getpid();
+    sinkContext->maxRecordLen = (sinkContext->ring.ringSize / MAX_RECORD_LEN_DIVISOR) - sizeof(Logger_ShmRingFrame_t);
+    sinkContext->producer     = mdn_Logger_ShmRingSink_claimProducer(sinkContext->ring.header, sinkContext->pid);
+    if (sinkContext->producer == NULL) {
+        mdn_Logger_ShmRing_unmap(&sinkContext->ring);
+        free(sinkContext);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    *sink = (mdn_Logger_Sink_t){
+        .ops     = &g_Logger_ShmRingSink_ops,
+        .context = sinkContext,
+    };
+
+    return MDN_STATUS_SUCCESS;
+}
+
+mdn_Status_t mdn_Logger_openShmRingDrain(mdn_Logger_ShmRingDrain_t **drain, mdn_Logger_ShmRingConfig_t shmRingConfig) {
+    mdn_Logger_ShmRingDrain_t *drainTemp;
+    mdn_Status_t               status;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((drain == NULL) || (shmRingConfig.name == NULL)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    drainTemp = MDN_MW_malloc(sizeof(*drainTemp));
+    if (drainTemp == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    status = mdn_Logger_ShmRing_open(&drainTemp->ring, shmRingConfig);
+    if (status != MDN_STATUS_SUCCESS) {
+        free(drainTemp);
+        return status;
+    }
+    // Picks up where a previous drain left off
+    drainTemp->readPos  = atomic_load_explicit(&drainTemp->ring.header->readPos, memory_order_relaxed);
+    drainTemp->stuckPos = NO_POS;
+    *drain              = drainTemp;
+
+    return MDN_STATUS_SUCCESS;
+}
+
+// Frees the room of what was drained. Releasing it orders zeroing the frames before producers reuse them.
+static void mdn_Logger_ShmRingDrain_publish(mdn_Logger_ShmRingDrain_t *drain) {
+    atomic_store_explicit(&drain->ring.header->readPos, drain->readPos, memory_order_release);
+}
+
+static void mdn_Logger_ShmRingDrain_zero(const mdn_Logger_ShmRingDrain_t *drain, uint64_t pos, size_t len) {
+    size_t offset  = (size_t)(pos % drain->ring.ringSize);
+    size_t headLen = drain->ring.ringSize - offset;
+
+    headLen = (len < headLen) ? len : headLen;
+    memset(drain->ring.ring + offset, 0, headLen);
+    memset(drain->ring.ring, 0, len - headLen);
+}
+
+// Whether every process with frames still pending is gone. Those that were pending when the drain got stuck and are still alive
+// keep a count above 0 until they are done with them, so none of the frames reserved by then belongs to a live process.
+static bool mdn_Logger_ShmRingDrain_arePendingProducersDead(const mdn_Logger_ShmRingDrain_t *drain) {
+    const Logger_ShmRingProducer_t *producer;
+
+    for (size_t idx = 0; idx < MDN_LOGGER_SHM_RING_MAX_PRODUCERS; ++idx) {
+        producer = &drain->ring.header->producersArr[idx];
+        if ((atomic_load_explicit(&producer->pendingCount, memory_order_acquire) != 0)
+            && !((kill((pid_t)(atomic_load_explicit(&producer->state, memory_order_relaxed) >> 1), 0) != 0) && (errno == ESRCH))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Gives up on a frame that stayed unwritten for STUCK_TIMEOUT_NS, along with those reserved before that started, once no live
+// process has frames pending: its producer died while writing it. A producer that is only slow is waited for however long it takes.
+static void mdn_Logger_ShmRingDrain_checkStuck(mdn_Logger_ShmRingDrain_t *drain) {
+    uint64_t reservePos = atomic_load_explicit(&drain->ring.header->reservePos, memory_order_acquire);
+    uint64_t nowNs      = mdn_Logger_Timestamp_getMonotonicNs();
+
+    if (reservePos == drain->readPos) {
+        drain->stuckPos = NO_POS;
+    } else if (drain->stuckPos != drain->readPos) {
+        drain->stuckPos        = drain->readPos;
+        drain->stuckReservePos = reservePos;
+        drain->stuckSinceNs    = nowNs;
+    } else if (((nowNs - drain->stuckSinceNs) > STUCK_TIMEOUT_NS) && mdn_Logger_ShmRingDrain_arePendingProducersDead(drain)) {
+        mdn_Logger_ShmRingDrain_zero(drain, drain->readPos, (size_t)(drain->stuckReservePos - drain->readPos));
+        (void)atomic_fetch_add_explicit(&drain->ring.header->skippedLen, drain->stuckReservePos - drain->readPos, memory_order_relaxed);
+        drain->readPos  = drain->stuckReservePos;
+        drain->stuckPos = NO_POS;
+        mdn_Logger_ShmRingDrain_publish(drain);
+    }
+}
+
+mdn_Status_t mdn_Logger_drainShmRing(mdn_Logger_ShmRingDrain_t *drain, mdn_Logger_ShmRingCallback_t callback, void *userData, size_t *recordsCount) {
+    const Logger_ShmRingFrame_t *frame;
+    size_t                       frameLen;
+    size_t                       drainedCount = 0;
+    uint64_t                     publishedPos;
+    bool                         isWritten    = true;
+    bool                         isTaken      = true;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((drain == NULL) || (callback == NULL)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    publishedPos = drain->readPos;
+    while (isWritten && isTaken) {
+        frame     = mdn_Logger_ShmRing_getFrame(&drain->ring, drain->readPos);
+        isWritten = (atomic_load_explicit(&frame->commitPos, memory_order_acquire) == (drain->readPos + 1));
+        if (isWritten) {
+            frameLen = (sizeof(*frame) + frame->len + FRAME_ALIGNMENT - 1) & ~(size_t)(FRAME_ALIGNMENT - 1);
+            // A frame that runs past the end of the ring can't have been written by a producer, it is given up on like a stuck one
+            isWritten = (frameLen <= (drain->ring.ringSize - (size_t)(drain->readPos % drain->ring.ringSize)));
+        }
+        if (isWritten) {
+            isTaken = (frame->pid == 0) || callback((int)frame->pid, frame->data, frame->len, userData);
+            if (isTaken) {
+                drainedCount += (frame->pid != 0) ? 1 : 0;
+                mdn_Logger_ShmRingDrain_zero(drain, drain->readPos, frameLen);
+                drain->readPos += frameLen;
+                if ((drain->readPos - publishedPos) >= (drain->ring.ringSize / PUBLISH_LEN_DIVISOR)) {
+                    mdn_Logger_ShmRingDrain_publish(drain);
+                    publishedPos = drain->readPos;
+                }
+            }
+        }
+    }
+    mdn_Logger_ShmRingDrain_publish(drain);
+    if (!isWritten) {
+        mdn_Logger_ShmRingDrain_checkStuck(drain);
+    }
+    if (recordsCount != NULL) {
+        *recordsCount = drainedCount;
+    }
+
+    return MDN_STATUS_SUCCESS;
+}
+
+mdn_Status_t mdn_Logger_getShmRingStats(const mdn_Logger_ShmRingDrain_t *drain, mdn_Logger_ShmRingStats_t *stats) {
+    const Logger_ShmRingProducer_t *producer;
+    uint64_t                        state;
+
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((drain == NULL) || (stats == NULL)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    stats->producersArrLen = 0;
+    for (size_t idx = 0; idx < MDN_LOGGER_SHM_RING_MAX_PRODUCERS; ++idx) {
+        producer = &drain->ring.header->producersArr[idx];
+        state    = atomic_load_explicit(&producer->state, memory_order_relaxed);
+        if (state != 0) {
+            stats->producersArr[stats->producersArrLen++] = (mdn_Logger_ShmRingProducerStats_t){
+                .pid           = (int)(state >> 1),
+                .open          = ((state & PRODUCER_OPEN) != 0),
+                .recordsCount  = atomic_load_explicit(&producer->recordsCount, memory_order_relaxed),
+                .overrunsCount = atomic_load_explicit(&producer->overrunsCount, memory_order_relaxed),
+            };
+        }
+    }
+    stats->skippedLen = atomic_load_explicit(&drain->ring.header->skippedLen, memory_order_relaxed);
+
+    return MDN_STATUS_SUCCESS;
+}
+
+void mdn_Logger_closeShmRingDrain(mdn_Logger_ShmRingDrain_t *drain) {
+    if (drain != NULL) {
+        mdn_Logger_ShmRing_unmap(&drain->ring);
+        free(drain);
+    }
+}
+#elif defined _WIN32
+// No POSIX shared memory on Windows
+mdn_Status_t mdn_Logger_createShmRingSink(mdn_Logger_Sink_t *sink, mdn_Logger_ShmRingConfig_t shmRingConfig) {
+    (void)sink;
+    (void)shmRingConfig;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+
+mdn_Status_t mdn_Logger_openShmRingDrain(mdn_Logger_ShmRingDrain_t **drain, mdn_Logger_ShmRingConfig_t shmRingConfig) {
+    (void)drain;
+    (void)shmRingConfig;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+
+mdn_Status_t mdn_Logger_drainShmRing(mdn_Logger_ShmRingDrain_t *drain, mdn_Logger_ShmRingCallback_t callback, void *userData, size_t *recordsCount) {
+    (void)drain;
+    (void)callback;
+    (void)userData;
+    (void)recordsCount;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+
+mdn_Status_t mdn_Logger_getShmRingStats(const mdn_Logger_ShmRingDrain_t *drain, mdn_Logger_ShmRingStats_t *stats) {
+    (void)drain;
+    (void)stats;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+
+void mdn_Logger_closeShmRingDrain(mdn_Logger_ShmRingDrain_t *drain) {
+    (void)drain;
+}
+#endif  // OS
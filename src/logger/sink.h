@@ -0,0 +1,12 @@
+#ifndef LOGGER_SINK_H
+#define LOGGER_SINK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "mdn/logger.h"
+
+// Built-in sinks implement the same ops as the ones of mdn_Logger_addSink(), see mdn_Logger_SinkOps_t
+typedef mdn_Logger_SinkOps_t Logger_SinkOps_t;
+
+#endif  // LOGGER_SINK_H
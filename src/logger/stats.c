@@ -0,0 +1,442 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "stats.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <pthread.h>
+#elif defined _WIN32
+# include <Windows.h>
+#endif  // OS
+
+#include "mdn/mock_wrapper.h"
+#include "thread.h"
+
+#define NSEC_PER_SEC            1000000000ULL
+#define STATS_DUMP_TEMP_SUFFIX  ".tmp"
+#define STATS_STRINGIFY(value)  STATS_STRINGIFY_(value)  // Expands 'value' first
+#define STATS_STRINGIFY_(value) #value
+
+typedef struct Logger_ThreadStreamStats_t_ {
+    _Atomic uint64_t recordsCount;
+    _Atomic uint64_t bytesCount;
+    _Atomic uint64_t writeErrorsCount;
+} Logger_ThreadStreamStats_t;
+
+// Counters of one thread. Only that thread updates them, with a plain load and store rather than a read-modify-write, so
+// counting costs about as much as incrementing a local variable. Blocks outlive their thread and are taken over by the next
+// new one, so totals never go back, and there are never more blocks than threads were alive at once.
+typedef struct Logger_ThreadStats_t_ {
+    _Atomic uint64_t              recordsCountArr[MDN_LOGGER_LOGGING_LEVEL_COUNT];
+    _Atomic uint64_t              filteredCount;
+    _Atomic uint64_t              latencySampledCount;
+    _Atomic uint64_t              latencyTotalNs;
+    _Atomic uint64_t              latencyBucketsArr[MDN_LOGGER_STATS_LATENCY_BUCKETS_COUNT];
+    _Atomic uint64_t              callsCount;
+    Logger_ThreadStreamStats_t    streamsArr[MDN_LOGGER_STATS_MAX_STREAMS_COUNT];  // Indexed by stream slot
+    bool                          shared;  // Updated with atomic additions instead, see g_Logger_sharedThreadStats
+    atomic_bool                   inUse;
+    struct Logger_ThreadStats_t_ *next;
+} Logger_ThreadStats_t;
+
+struct Logger_StatsDump_t_ {
+    Logger_Thread_t thread;
+    Logger_Mutex_t  mutex;
+    Logger_Cond_t   cond;
+    bool            stopRequested;  // Under 'mutex'
+    unsigned        intervalMs;
+    char           *tempPath;  // Written first, then renamed over 'path'
+    char            path[];
+};
+
+// Only ever pushed onto, blocks are never freed
+static _Atomic(Logger_ThreadStats_t *) g_Logger_threadStatsList;
+
+// Counts for the threads whose own block couldn't be allocated
+static Logger_ThreadStats_t g_Logger_sharedThreadStats = {.shared = true};
+
+static _Thread_local Logger_ThreadStats_t *g_Logger_threadStats;
+
+// What the counters added up to when mdn_Logger_Stats_init() was last called
+static mdn_Logger_Stats_t g_Logger_statsBaseline;
+
+// Bit i is set while stream slot i is taken. The baseline of a slot is what its counters added up to when it was taken.
+static atomic_uint_least32_t    g_Logger_streamSlotsMask;
+static mdn_Logger_StreamStats_t g_Logger_streamSlotsBaselineArr[MDN_LOGGER_STATS_MAX_STREAMS_COUNT];
+_Static_assert(MDN_LOGGER_STATS_MAX_STREAMS_COUNT <= 32, "Error: stream slots don't fit in their mask");
+
+// Hands the block of an exiting thread over to the next new one
+#if (defined __APPLE__) || (defined __linux__)
+static pthread_key_t g_Logger_threadStatsKey;
+#elif defined _WIN32
+static DWORD g_Logger_threadStatsKey;
+#endif  // OS
+static bool g_Logger_threadStatsKeyCreated;
+
+static const char *const g_Logger_Stats_levelLabelsArr[] = {
+    [MDN_LOGGER_LOGGING_LEVEL_DEBUG]    = "debug",
+    [MDN_LOGGER_LOGGING_LEVEL_INFO]     = "info",
+    [MDN_LOGGER_LOGGING_LEVEL_WARNING]  = "warning",
+    [MDN_LOGGER_LOGGING_LEVEL_ERROR]    = "error",
+    [MDN_LOGGER_LOGGING_LEVEL_CRITICAL] = "critical",
+};
+
+static const char *const g_Logger_Stats_formatLabelsArr[] = {
+    [MDN_LOGGER_LOGGING_FORMAT_SCREEN] = "screen",
+    [MDN_LOGGER_LOGGING_FORMAT_FILE]   = "file",
+    [MDN_LOGGER_LOGGING_FORMAT_BINARY] = "binary",
+    [MDN_LOGGER_LOGGING_FORMAT_JSON]   = "json",
+    [MDN_LOGGER_LOGGING_FORMAT_LOGFMT] = "logfmt",
+};
+
+static void mdn_Logger_Stats_releaseThreadStats(void *value) {
+    Logger_ThreadStats_t *threadStats = value;
+
+    g_Logger_threadStats = NULL;
+    atomic_store_explicit(&threadStats->inUse, false, memory_order_release);
+}
+
+#if (defined __APPLE__) || (defined __linux__)
+static void mdn_Logger_Stats_onThreadExit(void *value) {
+    mdn_Logger_Stats_releaseThreadStats(value);
+}
+#elif defined _WIN32
+static void NTAPI mdn_Logger_Stats_onThreadExit(PVOID value) {
+    mdn_Logger_Stats_releaseThreadStats(value);
+}
+#endif  // OS
+
+static Logger_ThreadStats_t *mdn_Logger_Stats_attachThread(void) {
+    Logger_ThreadStats_t *threadStats;
+    bool                  inUse;
+
+    for (threadStats = atomic_load_explicit(&g_Logger_threadStatsList, memory_order_acquire); threadStats != NULL; threadStats = threadStats->next) {
+        inUse = false;
+        if (atomic_compare_exchange_strong_explicit(&threadStats->inUse, &inUse, true, memory_order_acquire, memory_order_relaxed)) {
+            break;
+        }
+    }
+    if (threadStats == NULL) {
+        threadStats = MDN_MW_malloc(sizeof(*threadStats));
+        if (threadStats == NULL) {
+            g_Logger_threadStats = &g_Logger_sharedThreadStats;
+            return g_Logger_threadStats;
+        }
+        memset(threadStats, 0, sizeof(*threadStats));
+        atomic_init(&threadStats->inUse, true);
+        threadStats->next = atomic_load_explicit(&g_Logger_threadStatsList, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&g_Logger_threadStatsList, &threadStats->next, threadStats, memory_order_release, memory_order_relaxed)) {
+        }
+    }
+
+    // Should this fail, the block just stays with the thread after it exits
+#if (defined __APPLE__) || (defined __linux__)
+    (void)pthread_setspecific(g_Logger_threadStatsKey, threadStats);
+#elif defined _WIN32
+    (void)FlsSetValue(g_Logger_threadStatsKey, threadStats);
+#endif  // OS
+    g_Logger_threadStats = threadStats;
+
+    return threadStats;
+}
+
+static Logger_ThreadStats_t *mdn_Logger_Stats_getThreadStats(void) {
+    Logger_ThreadStats_t *threadStats = g_Logger_threadStats;
+
+    return (threadStats != NULL) ? threadStats : mdn_Logger_Stats_attachThread();
+}
+
+static void mdn_Logger_Stats_add(const Logger_ThreadStats_t *threadStats, _Atomic uint64_t *counter, uint64_t value) {
+    if (threadStats->shared) {
+        atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+    } else {
+        atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + value, memory_order_relaxed);
+    }
+}
+
+static void mdn_Logger_Stats_addUp(mdn_Logger_Stats_t *stats, const Logger_ThreadStats_t *threadStats) {
+    for (size_t levelIdx = 0; levelIdx < MDN_LOGGER_LOGGING_LEVEL_COUNT; ++levelIdx) {
+        stats->recordsCountArr[levelIdx] += atomic_load_explicit(&threadStats->recordsCountArr[levelIdx], memory_order_relaxed);
+    }
+    stats->filteredCount       += atomic_load_explicit(&threadStats->filteredCount, memory_order_relaxed);
+    stats->latencySampledCount += atomic_load_explicit(&threadStats->latencySampledCount, memory_order_relaxed);
+    stats->latencyTotalNs      += atomic_load_explicit(&threadStats->latencyTotalNs, memory_order_relaxed);
+    for (size_t bucketIdx = 0; bucketIdx < MDN_LOGGER_STATS_LATENCY_BUCKETS_COUNT; ++bucketIdx) {
+        stats->latencyBucketsArr[bucketIdx] += atomic_load_explicit(&threadStats->latencyBucketsArr[bucketIdx], memory_order_relaxed);
+    }
+}
+
+static void mdn_Logger_Stats_addUpAll(mdn_Logger_Stats_t *stats) {
+    const Logger_ThreadStats_t *threadStats;
+
+    memset(stats, 0, sizeof(*stats));
+    mdn_Logger_Stats_addUp(stats, &g_Logger_sharedThreadStats);
+    threadStats = atomic_load_explicit(&g_Logger_threadStatsList, memory_order_acquire);
+    while (threadStats != NULL) {
+        mdn_Logger_Stats_addUp(stats, threadStats);
+        threadStats = threadStats->next;
+    }
+}
+
+bool mdn_Logger_Stats_init(void) {
+    if (!g_Logger_threadStatsKeyCreated) {
+#if (defined __APPLE__) || (defined __linux__)
+        if (pthread_key_create(&g_Logger_threadStatsKey, mdn_Logger_Stats_onThreadExit) != 0) {
+            return false;
+        }
+#elif defined _WIN32
+        g_Logger_threadStatsKey = FlsAlloc(mdn_Logger_Stats_onThreadExit);
+        if (g_Logger_threadStatsKey == FLS_OUT_OF_INDEXES) {
+            return false;
+        }
+#endif  // OS
+        g_Logger_threadStatsKeyCreated = true;
+    }
+    mdn_Logger_Stats_addUpAll(&g_Logger_statsBaseline);
+
+    return true;
+}
+
+bool mdn_Logger_Stats_countRecord(mdn_Logger_loggingLevel_t loggingLevel) {
+    Logger_ThreadStats_t *threadStats = mdn_Logger_Stats_getThreadStats();
+
+    mdn_Logger_Stats_add(threadStats, &threadStats->recordsCountArr[loggingLevel], 1);
+    mdn_Logger_Stats_add(threadStats, &threadStats->callsCount, 1);
+    return (atomic_load_explicit(&threadStats->callsCount, memory_order_relaxed) % LOGGER_STATS_LATENCY_SAMPLE_EVERY) == 0;
+}
+
+void mdn_Logger_Stats_countLatency(uint64_t durationNs) {
+    Logger_ThreadStats_t *threadStats = mdn_Logger_Stats_getThreadStats();
+    size_t                bucketIdx   = 0;
+
+    // Only once in LOGGER_STATS_LATENCY_SAMPLE_EVERY records, so the bit width is counted the portable way
+    while ((bucketIdx < (MDN_LOGGER_STATS_LATENCY_BUCKETS_COUNT - 1)) && ((durationNs >> bucketIdx) != 0)) {
+        ++bucketIdx;
+    }
+    mdn_Logger_Stats_add(threadStats, &threadStats->latencyBucketsArr[bucketIdx], 1);
+    mdn_Logger_Stats_add(threadStats, &threadStats->latencySampledCount, 1);
+    mdn_Logger_Stats_add(threadStats, &threadStats->latencyTotalNs, durationNs);
+}
+
+void mdn_Logger_Stats_countFiltered(void) {
+    Logger_ThreadStats_t *threadStats = mdn_Logger_Stats_getThreadStats();
+
+    mdn_Logger_Stats_add(threadStats, &threadStats->filteredCount, 1);
+}
+
+void mdn_Logger_Stats_sum(mdn_Logger_Stats_t *stats) {
+    mdn_Logger_Stats_addUpAll(stats);
+    for (size_t levelIdx = 0; levelIdx < MDN_LOGGER_LOGGING_LEVEL_COUNT; ++levelIdx) {
+        stats->recordsCountArr[levelIdx] -= g_Logger_statsBaseline.recordsCountArr[levelIdx];
+    }
+    stats->filteredCount       -= g_Logger_statsBaseline.filteredCount;
+    stats->latencySampledCount -= g_Logger_statsBaseline.latencySampledCount;
+    stats->latencyTotalNs      -= g_Logger_statsBaseline.latencyTotalNs;
+    for (size_t bucketIdx = 0; bucketIdx < MDN_LOGGER_STATS_LATENCY_BUCKETS_COUNT; ++bucketIdx) {
+        stats->latencyBucketsArr[bucketIdx] -= g_Logger_statsBaseline.latencyBucketsArr[bucketIdx];
+    }
+}
+
+static void mdn_Logger_Stats_addUpThreadStream(mdn_Logger_StreamStats_t *streamStats, const Logger_ThreadStats_t *threadStats, size_t streamSlot) {
+    streamStats->recordsCount     += atomic_load_explicit(&threadStats->streamsArr[streamSlot].recordsCount, memory_order_relaxed);
+    streamStats->bytesCount       += atomic_load_explicit(&threadStats->streamsArr[streamSlot].bytesCount, memory_order_relaxed);
+    streamStats->writeErrorsCount += atomic_load_explicit(&threadStats->streamsArr[streamSlot].writeErrorsCount, memory_order_relaxed);
+}
+
+static void mdn_Logger_Stats_addUpStream(mdn_Logger_StreamStats_t *streamStats, size_t streamSlot) {
+    const Logger_ThreadStats_t *threadStats;
+
+    streamStats->recordsCount     = 0;
+    streamStats->bytesCount       = 0;
+    streamStats->writeErrorsCount = 0;
+    mdn_Logger_Stats_addUpThreadStream(streamStats, &g_Logger_sharedThreadStats, streamSlot);
+    threadStats = atomic_load_explicit(&g_Logger_threadStatsList, memory_order_acquire);
+    while (threadStats != NULL) {
+        mdn_Logger_Stats_addUpThreadStream(streamStats, threadStats, streamSlot);
+        threadStats = threadStats->next;
+    }
+}
+
+size_t mdn_Logger_Stats_acquireStreamSlot(void) {
+    uint_least32_t slotsMask = atomic_load_explicit(&g_Logger_streamSlotsMask, memory_order_relaxed);
+    size_t         streamSlot;
+
+    do {
+        for (streamSlot = 0; (streamSlot < MDN_LOGGER_STATS_MAX_STREAMS_COUNT) && ((slotsMask & (1U << streamSlot)) != 0); ++streamSlot) {
+        }
+        if (streamSlot == MDN_LOGGER_STATS_MAX_STREAMS_COUNT) {
+            return LOGGER_STATS_NO_STREAM_SLOT;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&g_Logger_streamSlotsMask, &slotsMask, slotsMask | (1U << streamSlot), memory_order_acquire, memory_order_relaxed));
+
+    // Nothing writes to a slot while it is free, so these are its final counts
+    mdn_Logger_Stats_addUpStream(&g_Logger_streamSlotsBaselineArr[streamSlot], streamSlot);
+
+    return streamSlot;
+}
+
+void mdn_Logger_Stats_releaseStreamSlot(size_t streamSlot) {
+    if (streamSlot != LOGGER_STATS_NO_STREAM_SLOT) {
+        atomic_fetch_and_explicit(&g_Logger_streamSlotsMask, ~(1U << streamSlot), memory_order_release);
+    }
+}
+
+void mdn_Logger_Stats_countWrite(size_t streamSlot, size_t len, bool written) {
+    Logger_ThreadStats_t *threadStats;
+
+    if (streamSlot == LOGGER_STATS_NO_STREAM_SLOT) {
+        return;
+    }
+    threadStats = mdn_Logger_Stats_getThreadStats();
+    mdn_Logger_Stats_add(threadStats, &threadStats->streamsArr[streamSlot].recordsCount, 1);
+    mdn_Logger_Stats_add(threadStats, &threadStats->streamsArr[streamSlot].bytesCount, len);
+    if (!written) {
+        mdn_Logger_Stats_add(threadStats, &threadStats->streamsArr[streamSlot].writeErrorsCount, 1);
+    }
+}
+
+void mdn_Logger_Stats_sumStream(size_t streamSlot, mdn_Logger_StreamStats_t *streamStats) {
+    mdn_Logger_Stats_addUpStream(streamStats, streamSlot);
+    streamStats->recordsCount     -= g_Logger_streamSlotsBaselineArr[streamSlot].recordsCount;
+    streamStats->bytesCount       -= g_Logger_streamSlotsBaselineArr[streamSlot].bytesCount;
+    streamStats->writeErrorsCount -= g_Logger_streamSlotsBaselineArr[streamSlot].writeErrorsCount;
+}
+
+static void mdn_Logger_Stats_writeMetricHeader(FILE *stream, const char *name, const char *type, const char *help) {
+    (void)fprintf(stream, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);  // NOLINT(hicpp-vararg)
+}
+
+static void mdn_Logger_Stats_writeStreamSample(FILE *stream, const char *name, size_t streamIdx, mdn_Logger_loggingFormat_t loggingFormat, uint64_t value) {
+    (void)fprintf(stream, "%s{stream=\"%zu\",format=\"%s\"} %llu\n", name, streamIdx, g_Logger_Stats_formatLabelsArr[loggingFormat], (unsigned long long)value);  // NOLINT(hicpp-vararg)
+}
+
+void mdn_Logger_Stats_writePrometheus(FILE *stream, const mdn_Logger_Stats_t *stats) {
+    const mdn_Logger_StreamStats_t *streamStats;
+    uint64_t                        cumulativeCount = 0;
+
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_records_total", "counter", "Records logged.");
+    for (size_t levelIdx = 0; levelIdx < MDN_LOGGER_LOGGING_LEVEL_COUNT; ++levelIdx) {
+        (void)fprintf(stream, "mdn_logger_records_total{level=\"%s\"} %llu\n", g_Logger_Stats_levelLabelsArr[levelIdx],  // NOLINT(hicpp-vararg)
+                      (unsigned long long)stats->recordsCountArr[levelIdx]);
+    }
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_filtered_records_total", "counter", "Records dropped by rate limits and sampling.");
+    (void)fprintf(stream, "mdn_logger_filtered_records_total %llu\n", (unsigned long long)stats->filteredCount);  // NOLINT(hicpp-vararg)
+
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_log_duration_seconds", "histogram", "Time spent in logging calls, measured on one call in " STATS_STRINGIFY(LOGGER_STATS_LATENCY_SAMPLE_EVERY) " of each thread.");
+    for (size_t bucketIdx = 0; bucketIdx < (MDN_LOGGER_STATS_LATENCY_BUCKETS_COUNT - 1); ++bucketIdx) {
+        cumulativeCount += stats->latencyBucketsArr[bucketIdx];
+        (void)fprintf(stream, "mdn_logger_log_duration_seconds_bucket{le=\"%.10g\"} %llu\n", (double)(1ULL << bucketIdx) / (double)NSEC_PER_SEC,  // NOLINT(hicpp-vararg)
+                      (unsigned long long)cumulativeCount);
+    }
+    (void)fprintf(stream, "mdn_logger_log_duration_seconds_bucket{le=\"+Inf\"} %llu\n", (unsigned long long)stats->latencySampledCount);  // NOLINT(hicpp-vararg)
+    (void)fprintf(stream, "mdn_logger_log_duration_seconds_sum %llu.%09llu\n", (unsigned long long)(stats->latencyTotalNs / NSEC_PER_SEC),  // NOLINT(hicpp-vararg)
+                  (unsigned long long)(stats->latencyTotalNs % NSEC_PER_SEC));
+    (void)fprintf(stream, "mdn_logger_log_duration_seconds_count %llu\n", (unsigned long long)stats->latencySampledCount);  // NOLINT(hicpp-vararg)
+
+    // Streams are told apart by their index, as streams owned by the caller have no name the library knows of
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_stream_records_total", "counter", "Records written to each output stream.");
+    for (size_t streamIdx = 0; streamIdx < stats->streamsArrLen; ++streamIdx) {
+        streamStats = &stats->streamsArr[streamIdx];
+        mdn_Logger_Stats_writeStreamSample(stream, "mdn_logger_stream_records_total", streamIdx, streamStats->loggingFormat, streamStats->recordsCount);
+    }
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_stream_bytes_total", "counter", "Bytes written to each output stream, before any compression.");
+    for (size_t streamIdx = 0; streamIdx < stats->streamsArrLen; ++streamIdx) {
+        streamStats = &stats->streamsArr[streamIdx];
+        mdn_Logger_Stats_writeStreamSample(stream, "mdn_logger_stream_bytes_total", streamIdx, streamStats->loggingFormat, streamStats->bytesCount);
+    }
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_stream_write_errors_total", "counter", "Records an output stream failed to write whole.");
+    for (size_t streamIdx = 0; streamIdx < stats->streamsArrLen; ++streamIdx) {
+        streamStats = &stats->streamsArr[streamIdx];
+        mdn_Logger_Stats_writeStreamSample(stream, "mdn_logger_stream_write_errors_total", streamIdx, streamStats->loggingFormat, streamStats->writeErrorsCount);
+    }
+
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_async_queue_capacity", "gauge", "Records the async queue can hold, 0 when not logging asynchronously.");
+    (void)fprintf(stream, "mdn_logger_async_queue_capacity %zu\n", stats->asyncQueueCapacity);  // NOLINT(hicpp-vararg)
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_async_queue_depth", "gauge", "Records waiting for the async writer thread.");
+    (void)fprintf(stream, "mdn_logger_async_queue_depth %zu\n", stats->asyncQueueDepth);  // NOLINT(hicpp-vararg)
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_async_dropped_records_total", "counter", "Records discarded because the async queue was full.");
+    (void)fprintf(stream, "mdn_logger_async_dropped_records_total %llu\n", (unsigned long long)stats->asyncDroppedCount);  // NOLINT(hicpp-vararg)
+    mdn_Logger_Stats_writeMetricHeader(stream, "mdn_logger_async_overwritten_records_total", "counter", "Queued records discarded to make room for newer ones.");
+    (void)fprintf(stream, "mdn_logger_async_overwritten_records_total %llu\n", (unsigned long long)stats->asyncOverwrittenCount);  // NOLINT(hicpp-vararg)
+}
+
+// Readers of 'path' see either the previous dump or the new one whole
+static void mdn_Logger_StatsDump_write(const Logger_StatsDump_t *statsDump) {
+    FILE        *file;
+    mdn_Status_t status;
+
+    file = fopen(statsDump->tempPath, "w");
+    if (file == NULL) {
+        return;
+    }
+    status = mdn_Logger_writeStats(file);
+    if ((fclose(file) != 0) || (status != MDN_STATUS_SUCCESS)) {
+        (void)remove(statsDump->tempPath);
+        return;
+    }
+#if (defined __APPLE__) || (defined __linux__)
+    (void)rename(statsDump->tempPath, statsDump->path);
+#elif defined _WIN32
+    (void)MoveFileExA(statsDump->tempPath, statsDump->path, MOVEFILE_REPLACE_EXISTING);
+#endif  // OS
+}
+
+static void mdn_Logger_StatsDump_thread(void *arg) {
+    Logger_StatsDump_t *statsDump = arg;
+    bool                stopRequested;
+
+    mdn_Logger_Mutex_lock(&statsDump->mutex);
+    do {
+        if (!statsDump->stopRequested) {
+            mdn_Logger_Cond_timedWait(&statsDump->cond, &statsDump->mutex, statsDump->intervalMs);
+        }
+        stopRequested = statsDump->stopRequested;
+        mdn_Logger_Mutex_unlock(&statsDump->mutex);
+        mdn_Logger_StatsDump_write(statsDump);
+        mdn_Logger_Mutex_lock(&statsDump->mutex);
+    } while (!stopRequested);
+    mdn_Logger_Mutex_unlock(&statsDump->mutex);
+}
+
+Logger_StatsDump_t *mdn_Logger_StatsDump_start(const char *path, unsigned intervalMs) {
+    Logger_StatsDump_t *statsDump;
+    size_t              pathLen = strlen(path);
+
+    statsDump = MDN_MW_malloc(sizeof(*statsDump) + (2 * (pathLen + 1)) + sizeof(STATS_DUMP_TEMP_SUFFIX) - 1);
+    if (statsDump == NULL) {
+        return NULL;
+    }
+    statsDump->stopRequested = false;
+    statsDump->intervalMs    = intervalMs;
+    statsDump->tempPath      = statsDump->path + pathLen + 1;
+    memcpy(statsDump->path, path, pathLen + 1);
+    memcpy(statsDump->tempPath, path, pathLen);
+    memcpy(statsDump->tempPath + pathLen, STATS_DUMP_TEMP_SUFFIX, sizeof(STATS_DUMP_TEMP_SUFFIX));
+
+    if (mdn_Logger_Mutex_init(&statsDump->mutex)) {
+        if (mdn_Logger_Cond_init(&statsDump->cond)) {
+            if (mdn_Logger_Thread_create(&statsDump->thread, mdn_Logger_StatsDump_thread, statsDump)) {
+                return statsDump;
+            }
+            mdn_Logger_Cond_destroy(&statsDump->cond);
+        }
+        mdn_Logger_Mutex_destroy(&statsDump->mutex);
+    }
+    free(statsDump);
+
+    return NULL;
+}
+
+void mdn_Logger_StatsDump_stop(Logger_StatsDump_t *statsDump) {
+    mdn_Logger_Mutex_lock(&statsDump->mutex);
+    statsDump->stopRequested = true;
+    mdn_Logger_Cond_signal(&statsDump->cond);
+    mdn_Logger_Mutex_unlock(&statsDump->mutex);
+    mdn_Logger_Thread_join(&statsDump->thread);
+
+    mdn_Logger_Cond_destroy(&statsDump->cond);
+    mdn_Logger_Mutex_destroy(&statsDump->mutex);
+    free(statsDump);
+}
@@ -0,0 +1,50 @@
+#ifndef LOGGER_STATS_H
+#define LOGGER_STATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "mdn/logger.h"
+
+#define LOGGER_STATS_LATENCY_SAMPLE_EVERY 64  // Per thread
+
+#define LOGGER_STATS_NO_STREAM_SLOT MDN_LOGGER_STATS_MAX_STREAMS_COUNT
+
+typedef struct Logger_StatsDump_t_ Logger_StatsDump_t;
+
+// Must be called by mdn_Logger_init(), before any thread logs. Counts start over from there.
+bool mdn_Logger_Stats_init(void);
+
+// Counts a record of the calling thread, and returns whether its logging is one to time with mdn_Logger_Stats_countLatency()
+bool mdn_Logger_Stats_countRecord(mdn_Logger_loggingLevel_t loggingLevel);
+
+void mdn_Logger_Stats_countLatency(uint64_t durationNs);
+
+void mdn_Logger_Stats_countFiltered(void);
+
+// Sets the fields that the threads' counters make up, and zeroes the others
+void mdn_Logger_Stats_sum(mdn_Logger_Stats_t *stats);
+
+// Returns the slot the counters of a new stream are kept in, or LOGGER_STATS_NO_STREAM_SLOT if they are all taken.
+// Its counts start over.
+size_t mdn_Logger_Stats_acquireStreamSlot(void);
+
+// Once no thread can be writing to the stream anymore
+void mdn_Logger_Stats_releaseStreamSlot(size_t streamSlot);
+
+void mdn_Logger_Stats_countWrite(size_t streamSlot, size_t len, bool written);
+
+// Sets the counts of 'streamStats'
+void mdn_Logger_Stats_sumStream(size_t streamSlot, mdn_Logger_StreamStats_t *streamStats);
+
+void mdn_Logger_Stats_writePrometheus(FILE *stream, const mdn_Logger_Stats_t *stats);
+
+// Dumps with mdn_Logger_writeStats() on its own thread, until stopped
+Logger_StatsDump_t *mdn_Logger_StatsDump_start(const char *path, unsigned intervalMs);
+
+// Writes a last dump before returning
+void mdn_Logger_StatsDump_stop(Logger_StatsDump_t *statsDump);
+
+#endif  // LOGGER_STATS_H
@@ -0,0 +1,327 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "structured_format.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "text_format.h"
+#include "timestamp.h"
+
+#if (defined __SSE2__) || (defined _M_X64) || ((defined _M_IX86_FP) && (_M_IX86_FP >= 2))
+# define LOGGER_ESCAPE_SSE2
+# include <emmintrin.h>
+#endif  // SSE2
+#if (defined LOGGER_ESCAPE_SSE2) && ((defined __AVX2__) || (defined __GNUC__))
+# define LOGGER_ESCAPE_AVX2
+# include <immintrin.h>
+# ifdef __AVX2__
+#  define LOGGER_ESCAPE_AVX2_TARGET
+#  define LOGGER_ESCAPE_HAS_AVX2() true
+# else
+// Built for baseline x86-64: the AVX2 scan is compiled anyway, and only picked on CPUs that have it
+#  define LOGGER_ESCAPE_AVX2_TARGET __attribute__((target("avx2")))
+#  define LOGGER_ESCAPE_HAS_AVX2()  __builtin_cpu_supports("avx2")
+# endif  // __AVX2__
+#endif  // AVX2
+#ifdef _MSC_VER
+# include <intrin.h>
+#endif  // _MSC_VER
+
+#define APPEND_LITERAL(lineBuffer, literal) mdn_Logger_LineBuffer_append((lineBuffer), (literal), sizeof(literal) - 1)
+
+#define ESCAPE_MAX_LEN    6     // "\u00XX"
+#define LAST_CONTROL_CHAR 0x1F  // Control characters have to be escaped in JSON strings, DEL doesn't
+#define UINT64_MAX_DIGITS 20
+
+static bool mdn_Logger_StructuredFormat_needsEscape(unsigned char c) {
+    return (c <= LAST_CONTROL_CHAR) || (c == '"') || (c == '\\');
+}
+
+// Second character of the two-character escape of 'c', or '\0' if it takes a "\u00XX" one
+static char mdn_Logger_StructuredFormat_shortEscape(unsigned char c) {
+    switch (c) {
+        case '"':
+            return '"';
+        case '\\':
+            return '\\';
+        case '\b':
+            return 'b';
+        case '\f':
+            return 'f';
+        case '\n':
+            return 'n';
+        case '\r':
+            return 'r';
+        case '\t':
+            return 't';
+        default:
+            return '\0';
+    }
+}
+
+static size_t mdn_Logger_StructuredFormat_escapedLen(unsigned char c) {
+    return (mdn_Logger_StructuredFormat_shortEscape(c) != '\0') ? 2 : ESCAPE_MAX_LEN;
+}
+
+static size_t mdn_Logger_StructuredFormat_writeEscape(char *dst, unsigned char c) {
+    static const char hexDigits[] = "0123456789abcdef";
+    char              shortEscape = mdn_Logger_StructuredFormat_shortEscape(c);
+
+    dst[0] = '\\';
+    if (shortEscape != '\0') {
+        dst[1] = shortEscape;
+        return 2;
+    }
+    dst[1] = 'u';
+    dst[2] = '0';
+    dst[3] = '0';
+    dst[4] = hexDigits[c >> 4];
+    dst[5] = hexDigits[c & 0xF];
+    return ESCAPE_MAX_LEN;
+}
+
+static size_t mdn_Logger_StructuredFormat_findEscapeScalar(const char *str, size_t strLen) {
+    size_t idx = 0;
+
+    while ((idx < strLen) && !mdn_Logger_StructuredFormat_needsEscape((unsigned char)str[idx])) {
+        ++idx;
+    }
+    return idx;
+}
+
+#ifdef LOGGER_ESCAPE_SSE2
+static unsigned mdn_Logger_StructuredFormat_countTrailingZeros(uint32_t mask) {
+# ifdef _MSC_VER
+    unsigned long idx;
+
+    (void)_BitScanForward(&idx, mask);
+    return (unsigned)idx;
+# else
+    return (unsigned)__builtin_ctz(mask);
+# endif  // _MSC_VER
+}
+
+static size_t mdn_Logger_StructuredFormat_findEscapeSse2(const char *str, size_t strLen) {
+    const __m128i quote       = _mm_set1_epi8('"');
+    const __m128i backslash   = _mm_set1_epi8('\\');
+    const __m128i lastControl = _mm_set1_epi8(LAST_CONTROL_CHAR);
+    __m128i       chunk, special;
+    uint32_t      mask;
+    size_t        idx;
+
+    for (idx = 0; (idx + sizeof(__m128i)) <= strLen; idx += sizeof(__m128i)) {
+        chunk = _mm_loadu_si128((const __m128i *)(const void *)(str + idx));
+        // SSE2 only compares signed bytes, so unsigned 'c <= 0x1F' is checked as 'max(c, 0x1F) == 0x1F'
+        special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                               _mm_cmpeq_epi8(_mm_max_epu8(chunk, lastControl), lastControl));
+        mask    = (uint32_t)_mm_movemask_epi8(special);
+        if (mask != 0) {
+            return idx + mdn_Logger_StructuredFormat_countTrailingZeros(mask);
+        }
+    }
+    return idx + mdn_Logger_StructuredFormat_findEscapeScalar(str + idx, strLen - idx);
+}
+#endif  // LOGGER_ESCAPE_SSE2
+
+#ifdef LOGGER_ESCAPE_AVX2
+LOGGER_ESCAPE_AVX2_TARGET static size_t mdn_Logger_StructuredFormat_findEscapeAvx2(const char *str, size_t strLen) {
+    const __m256i quote       = _mm256_set1_epi8('"');
+    const __m256i backslash   = _mm256_set1_epi8('\\');
+    const __m256i lastControl = _mm256_set1_epi8(LAST_CONTROL_CHAR);
+    __m256i       chunk, special;
+    uint32_t      mask = 0;
+    size_t        idx;
+
+    for (idx = 0; (idx + sizeof(__m256i)) <= strLen; idx += sizeof(__m256i)) {
+        chunk   = _mm256_loadu_si256((const __m256i *)(const void *)(str + idx));
+        special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                                  _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, lastControl), lastControl));
+        mask    = (uint32_t)_mm256_movemask_epi8(special);
+        if (mask != 0) {
+            break;
+        }
+    }
+    // Compilers don't always clear the upper halves on their own, and legacy SSE code pays for them until then
+    _mm256_zeroupper();
+    if (mask != 0) {
+        return idx + mdn_Logger_StructuredFormat_countTrailingZeros(mask);
+    }
+    return idx + mdn_Logger_StructuredFormat_findEscapeSse2(str + idx, strLen - idx);
+}
+#endif  // LOGGER_ESCAPE_AVX2
+
+// Length of the run at the start of 'str' that can be copied as is
+static size_t mdn_Logger_StructuredFormat_findEscape(const char *str, size_t strLen) {
+#ifdef LOGGER_ESCAPE_AVX2
+    if (LOGGER_ESCAPE_HAS_AVX2()) {
+        return mdn_Logger_StructuredFormat_findEscapeAvx2(str, strLen);
+    }
+#endif  // LOGGER_ESCAPE_AVX2
+#ifdef LOGGER_ESCAPE_SSE2
+    return mdn_Logger_StructuredFormat_findEscapeSse2(str, strLen);
+#else
+    return mdn_Logger_StructuredFormat_findEscapeScalar(str, strLen);
+#endif  // LOGGER_ESCAPE_SSE2
+}
+
+void mdn_Logger_StructuredFormat_appendEscaped(Logger_LineBuffer_t *lineBuffer, const char *str, size_t strLen) {
+    char   escape[ESCAPE_MAX_LEN];
+    size_t runLen;
+
+    for (;;) {
+        runLen = mdn_Logger_StructuredFormat_findEscape(str, strLen);
+        mdn_Logger_LineBuffer_append(lineBuffer, str, runLen);
+        if (runLen == strLen) {
+            return;
+        }
+        mdn_Logger_LineBuffer_append(lineBuffer, escape, mdn_Logger_StructuredFormat_writeEscape(escape, (unsigned char)str[runLen]));
+        str    += runLen + 1;
+        strLen -= runLen + 1;
+    }
+}
+
+// Escapes what was appended since 'start' without copying it elsewhere first. Most messages need no escaping at all,
+// and only pay for the scan.
+static void mdn_Logger_StructuredFormat_escapeInPlace(Logger_LineBuffer_t *lineBuffer, size_t start) {
+    char         *message    = lineBuffer->data + start;
+    size_t        messageLen = lineBuffer->len - start;
+    size_t        firstIdx   = mdn_Logger_StructuredFormat_findEscape(message, messageLen);
+    size_t        extraLen   = 0;
+    size_t        leftLen, runLen;
+    char         *src, *dst;
+    unsigned char c;
+
+    if (firstIdx == messageLen) {
+        return;
+    }
+    for (size_t idx = firstIdx; idx < messageLen;) {
+        extraLen += mdn_Logger_StructuredFormat_escapedLen((unsigned char)message[idx]) - 1;
+        ++idx;
+        idx      += mdn_Logger_StructuredFormat_findEscape(message + idx, messageLen - idx);
+    }
+    if (!mdn_Logger_LineBuffer_reserve(lineBuffer, extraLen)) {
+        // Rather cut the message short than write an invalid record
+        lineBuffer->truncated = true;
+        lineBuffer->len       = start + firstIdx;
+        return;
+    }
+
+    // The unescaped rest is moved to the end of its final room, then escaped forward: each escape only takes up
+    // room freed by the ones after it, so writing never overtakes reading
+    message = lineBuffer->data + start;
+    leftLen = messageLen - firstIdx;
+    dst     = message + firstIdx;
+    src     = dst + extraLen;
+    memmove(src, dst, leftLen);
+    while (leftLen > 0) {
+        c        = (unsigned char)*src++;
+        dst     += mdn_Logger_StructuredFormat_writeEscape(dst, c);
+        runLen   = mdn_Logger_StructuredFormat_findEscape(src, --leftLen);
+        memmove(dst, src, runLen);
+        dst     += runLen;
+        src     += runLen;
+        leftLen -= runLen;
+    }
+    lineBuffer->len += extraLen;
+}
+
+static void mdn_Logger_StructuredFormat_appendUnsigned(Logger_LineBuffer_t *lineBuffer, uint64_t value) {
+    char   digits[UINT64_MAX_DIGITS];
+    size_t pos = sizeof(digits);
+
+    do {
+        digits[--pos]  = (char)('0' + (value % 10));
+        value         /= 10;
+    } while (value != 0);
+    mdn_Logger_LineBuffer_append(lineBuffer, digits + pos, sizeof(digits) - pos);
+}
+
+static void mdn_Logger_StructuredFormat_appendLine(Logger_LineBuffer_t *lineBuffer, int line) {
+    if (line < 0) {
+        APPEND_LITERAL(lineBuffer, "-");
+        mdn_Logger_StructuredFormat_appendUnsigned(lineBuffer, (uint64_t)(-(int64_t)line));
+    } else {
+        mdn_Logger_StructuredFormat_appendUnsigned(lineBuffer, (uint64_t)line);
+    }
+}
+
+// ISO 8601 ("YYYY-MM-DDTHH:MM:SS.fff"), in local time like the text formats
+static void mdn_Logger_StructuredFormat_appendTimestamp(Logger_LineBuffer_t *lineBuffer, const Logger_Timestamp_t *timestamp, mdn_Logger_timestampPrecision_t timestampPrecision) {
+    char   timestampBuf[LOGGER_TIMESTAMP_MAX_LEN];
+    size_t timestampLen;
+
+    timestampLen                                = mdn_Logger_Timestamp_format(timestamp, timestampPrecision, timestampBuf);
+    timestampBuf[LOGGER_TIMESTAMP_DATE_LEN - 1] = 'T';
+    mdn_Logger_LineBuffer_append(lineBuffer, timestampBuf, timestampLen);
+}
+
+// Bare when possible, quoted like a JSON string when empty or holding spaces, '=', quotes or control characters
+static void mdn_Logger_StructuredFormat_appendLogfmtValue(Logger_LineBuffer_t *lineBuffer, const char *value) {
+    size_t valueLen     = strlen(value);
+    bool   needsQuoting = (valueLen == 0);
+
+    for (size_t idx = 0; !needsQuoting && (idx < valueLen); ++idx) {
+        needsQuoting = ((unsigned char)value[idx] <= ' ') || (value[idx] == '=') || (value[idx] == '"') || (value[idx] == '\\');
+    }
+    if (!needsQuoting) {
+        mdn_Logger_LineBuffer_append(lineBuffer, value, valueLen);
+        return;
+    }
+    APPEND_LITERAL(lineBuffer, "\"");
+    mdn_Logger_StructuredFormat_appendEscaped(lineBuffer, value, valueLen);
+    APPEND_LITERAL(lineBuffer, "\"");
+}
+
+// {"time":"...","level":"INFO","file":"...","line":42,"func":"...","thread":1234,"msg":"..."}
+static void mdn_Logger_StructuredFormat_renderJsonPrefix(Logger_LineBuffer_t *lineBuffer, const Logger_Record_t *record, mdn_Logger_timestampPrecision_t timestampPrecision) {
+    APPEND_LITERAL(lineBuffer, "{\"time\":\"");
+    mdn_Logger_StructuredFormat_appendTimestamp(lineBuffer, &record->timestamp, timestampPrecision);
+    APPEND_LITERAL(lineBuffer, "\",\"level\":\"");
+    mdn_Logger_LineBuffer_appendStr(lineBuffer, mdn_Logger_TextFormat_levelName(record->loggingLevel));
+    APPEND_LITERAL(lineBuffer, "\",\"file\":\"");
+    mdn_Logger_StructuredFormat_appendEscaped(lineBuffer, record->file, strlen(record->file));
+    APPEND_LITERAL(lineBuffer, "\",\"line\":");
+    mdn_Logger_StructuredFormat_appendLine(lineBuffer, record->line);
+    APPEND_LITERAL(lineBuffer, ",\"func\":\"");
+    mdn_Logger_StructuredFormat_appendEscaped(lineBuffer, record->funcName, strlen(record->funcName));
+    APPEND_LITERAL(lineBuffer, "\",\"thread\":");
+    mdn_Logger_StructuredFormat_appendUnsigned(lineBuffer, record->threadId);
+    APPEND_LITERAL(lineBuffer, ",\"msg\":\"");
+}
+
+// time=... level=INFO file=... line=42 func=... thread=1234 msg="..."
+static void mdn_Logger_StructuredFormat_renderLogfmtPrefix(Logger_LineBuffer_t *lineBuffer, const Logger_Record_t *record, mdn_Logger_timestampPrecision_t timestampPrecision) {
+    APPEND_LITERAL(lineBuffer, "time=");
+    mdn_Logger_StructuredFormat_appendTimestamp(lineBuffer, &record->timestamp, timestampPrecision);
+    APPEND_LITERAL(lineBuffer, " level=");
+    mdn_Logger_LineBuffer_appendStr(lineBuffer, mdn_Logger_TextFormat_levelName(record->loggingLevel));
+    APPEND_LITERAL(lineBuffer, " file=");
+    mdn_Logger_StructuredFormat_appendLogfmtValue(lineBuffer, record->file);
+    APPEND_LITERAL(lineBuffer, " line=");
+    mdn_Logger_StructuredFormat_appendLine(lineBuffer, record->line);
+    APPEND_LITERAL(lineBuffer, " func=");
+    mdn_Logger_StructuredFormat_appendLogfmtValue(lineBuffer, record->funcName);
+    APPEND_LITERAL(lineBuffer, " thread=");
+    mdn_Logger_StructuredFormat_appendUnsigned(lineBuffer, record->threadId);
+    // Always quoted, since messages almost always hold spaces
+    APPEND_LITERAL(lineBuffer, " msg=\"");
+}
+
+void mdn_Logger_StructuredFormat_renderPrefix(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingFormat_t loggingFormat, const Logger_Record_t *record,
+                                              mdn_Logger_timestampPrecision_t timestampPrecision) {
+    if (loggingFormat == MDN_LOGGER_LOGGING_FORMAT_JSON) {
+        mdn_Logger_StructuredFormat_renderJsonPrefix(lineBuffer, record, timestampPrecision);
+    } else {
+        mdn_Logger_StructuredFormat_renderLogfmtPrefix(lineBuffer, record, timestampPrecision);
+    }
+}
+
+void mdn_Logger_StructuredFormat_renderSuffix(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingFormat_t loggingFormat, size_t messageStart) {
+    mdn_Logger_StructuredFormat_escapeInPlace(lineBuffer, messageStart);
+    if (loggingFormat == MDN_LOGGER_LOGGING_FORMAT_JSON) {
+        APPEND_LITERAL(lineBuffer, "\"}\n");
+    } else {
+        APPEND_LITERAL(lineBuffer, "\"\n");
+    }
+}
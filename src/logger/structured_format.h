@@ -0,0 +1,19 @@
+#ifndef LOGGER_STRUCTURED_FORMAT_H
+#define LOGGER_STRUCTURED_FORMAT_H
+
+#include <stddef.h>
+
+#include "line_buffer.h"
+#include "logger_internal.h"
+
+// Renders everything that comes before the message of a JSON Lines or logfmt record ('loggingFormat' is JSON or LOGFMT)
+void mdn_Logger_StructuredFormat_renderPrefix(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingFormat_t loggingFormat, const Logger_Record_t *record,
+                                              mdn_Logger_timestampPrecision_t timestampPrecision);
+
+// Escapes the raw message appended since 'messageStart' in place, then renders everything that comes after it, including the new line
+void mdn_Logger_StructuredFormat_renderSuffix(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingFormat_t loggingFormat, size_t messageStart);
+
+// Appends 'str' escaped as the inside of a JSON string, which logfmt quoted values share
+void mdn_Logger_StructuredFormat_appendEscaped(Logger_LineBuffer_t *lineBuffer, const char *str, size_t strLen);
+
+#endif  // LOGGER_STRUCTURED_FORMAT_H
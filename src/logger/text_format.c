@@ -0,0 +1,103 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "text_format.h"
+
+#include "timestamp.h"
+
+static const char *g_mdn_Logger_logLevelToStrMap[] = {
+    [MDN_LOGGER_LOGGING_LEVEL_DEBUG]    = "DEBUG",
+    [MDN_LOGGER_LOGGING_LEVEL_INFO]     = "INFO",
+    [MDN_LOGGER_LOGGING_LEVEL_WARNING]  = "WARNING",
+    [MDN_LOGGER_LOGGING_LEVEL_ERROR]    = "ERROR",
+    [MDN_LOGGER_LOGGING_LEVEL_CRITICAL] = "CRITICAL",
+};
+#define ARRAY_LEN(array) (sizeof(array) / sizeof(*(array)))
+_Static_assert(ARRAY_LEN(g_mdn_Logger_logLevelToStrMap) == MDN_LOGGER_LOGGING_LEVEL_COUNT,
+               "Error: seems like a description string for a log level is missing");
+
+#define ANSI_ESC                      "\033"
+#define ANSI_PARAM_BEGIN              "["
+#define ANSI_PARAM_END                "m"
+#define COLOR_PREFIX                  ANSI_ESC ANSI_PARAM_BEGIN
+#define COLOR_SUFFIX                  ANSI_PARAM_END
+#define COLOR(color)                  COLOR_PREFIX color COLOR_SUFFIX
+#define LOGGER_TERMINAL_COLOR_GRAY    COLOR("90")
+#define LOGGER_TERMINAL_COLOR_RESET   COLOR("0")
+#define LOGGER_TERMINAL_COLOR_YELLOW  COLOR("33")
+#define LOGGER_TERMINAL_COLOR_RED     COLOR("31")
+#define LOGGER_TERMINAL_COLOR_MAGENTA COLOR("35")
+
+typedef enum mdn_Logger_loggingColor_t_ {
+    LOGGING_COLOR_GRAY,
+    LOGGING_COLOR_RESET,
+    LOGGING_COLOR_YELLOW,
+    LOGGING_COLOR_RED,
+    LOGGING_COLOR_MAGENTA,
+    LOGGING_COLOR_COUNT,
+} mdn_Logger_loggingColor_t;
+
+static mdn_Logger_loggingColor_t g_mdn_Logger_loggingLevelToColorMap[] = {
+    [MDN_LOGGER_LOGGING_LEVEL_DEBUG]    = LOGGING_COLOR_GRAY,
+    [MDN_LOGGER_LOGGING_LEVEL_INFO]     = LOGGING_COLOR_RESET,
+    [MDN_LOGGER_LOGGING_LEVEL_WARNING]  = LOGGING_COLOR_YELLOW,
+    [MDN_LOGGER_LOGGING_LEVEL_ERROR]    = LOGGING_COLOR_RED,
+    [MDN_LOGGER_LOGGING_LEVEL_CRITICAL] = LOGGING_COLOR_MAGENTA,
+};
+
+static const char *g_Logger_colorToTerminalColorMap[] = {
+    [LOGGING_COLOR_GRAY]    = LOGGER_TERMINAL_COLOR_GRAY,
+    [LOGGING_COLOR_RESET]   = LOGGER_TERMINAL_COLOR_RESET,
+    [LOGGING_COLOR_YELLOW]  = LOGGER_TERMINAL_COLOR_YELLOW,
+    [LOGGING_COLOR_RED]     = LOGGER_TERMINAL_COLOR_RED,
+    [LOGGING_COLOR_MAGENTA] = LOGGER_TERMINAL_COLOR_MAGENTA,
+};
+
+static void mdn_Logger_renderColor(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingColor_t color) {
+    mdn_Logger_LineBuffer_appendStr(lineBuffer, g_Logger_colorToTerminalColorMap[color]);
+}
+
+static void mdn_Logger_renderTimestamp(Logger_LineBuffer_t *lineBuffer, const Logger_Timestamp_t *timestamp, mdn_Logger_timestampPrecision_t timestampPrecision, bool includeDate) {
+    char   timestampBuf[LOGGER_TIMESTAMP_MAX_LEN + 1];  // +1 for the trailing space
+    size_t timestampLen;
+    size_t timestampOffset = includeDate ? 0 : LOGGER_TIMESTAMP_DATE_LEN;
+
+    timestampLen                 = mdn_Logger_Timestamp_format(timestamp, timestampPrecision, timestampBuf);
+    timestampBuf[timestampLen++] = ' ';
+    mdn_Logger_LineBuffer_append(lineBuffer, timestampBuf + timestampOffset, timestampLen - timestampOffset);
+}
+
+static void mdn_Logger_renderLoggingLevel(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingLevel_t loggingLevel) {
+    mdn_Logger_LineBuffer_appendPadded(lineBuffer, g_mdn_Logger_logLevelToStrMap[loggingLevel], 8);
+    mdn_Logger_LineBuffer_append(lineBuffer, " ", 1);
+}
+
+static void mdn_Logger_renderFuncName(Logger_LineBuffer_t *lineBuffer, const char *funcName) {
+    mdn_Logger_LineBuffer_appendPadded(lineBuffer, funcName, 20);
+    mdn_Logger_LineBuffer_append(lineBuffer, " ", 1);
+}
+
+static void mdn_Logger_renderSeparator(Logger_LineBuffer_t *lineBuffer) {
+    mdn_Logger_LineBuffer_append(lineBuffer, "| ", 2);
+}
+
+const char *mdn_Logger_TextFormat_levelName(mdn_Logger_loggingLevel_t loggingLevel) {
+    return g_mdn_Logger_logLevelToStrMap[loggingLevel];
+}
+
+void mdn_Logger_TextFormat_renderPrefix(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingFormat_t loggingFormat, const Logger_Record_t *record, mdn_Logger_timestampPrecision_t timestampPrecision) {
+    if (loggingFormat == MDN_LOGGER_LOGGING_FORMAT_SCREEN) {
+        mdn_Logger_renderColor(lineBuffer, g_mdn_Logger_loggingLevelToColorMap[record->loggingLevel]);
+        mdn_Logger_renderTimestamp(lineBuffer, &record->timestamp, timestampPrecision, false);
+    } else {
+        mdn_Logger_renderTimestamp(lineBuffer, &record->timestamp, timestampPrecision, true);
+        mdn_Logger_renderLoggingLevel(lineBuffer, record->loggingLevel);
+    }
+    mdn_Logger_renderFuncName(lineBuffer, record->funcName);
+    mdn_Logger_renderSeparator(lineBuffer);
+}
+
+void mdn_Logger_TextFormat_renderSuffix(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingFormat_t loggingFormat) {
+    if (loggingFormat == MDN_LOGGER_LOGGING_FORMAT_SCREEN) {
+        mdn_Logger_renderColor(lineBuffer, LOGGING_COLOR_RESET);
+    }
+    mdn_Logger_LineBuffer_append(lineBuffer, "\n", 1);
+}
@@ -0,0 +1,16 @@
+#ifndef LOGGER_TEXT_FORMAT_H
+#define LOGGER_TEXT_FORMAT_H
+
+#include "line_buffer.h"
+#include "logger_internal.h"
+
+// "DEBUG", "INFO", ...
+const char *mdn_Logger_TextFormat_levelName(mdn_Logger_loggingLevel_t loggingLevel);
+
+// Renders everything that comes before the message of a text record ('loggingFormat' is SCREEN or FILE)
+void mdn_Logger_TextFormat_renderPrefix(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingFormat_t loggingFormat, const Logger_Record_t *record, mdn_Logger_timestampPrecision_t timestampPrecision);
+
+// Renders everything that comes after the message of a text record, including the new line
+void mdn_Logger_TextFormat_renderSuffix(Logger_LineBuffer_t *lineBuffer, mdn_Logger_loggingFormat_t loggingFormat);
+
+#endif  // LOGGER_TEXT_FORMAT_H
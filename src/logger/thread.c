@@ -0,0 +1,152 @@
+#include "thread.h"
+
+#include <time.h>
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <sched.h>
+#endif  // OS
+#ifdef __linux__
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif  // __linux__
+
+#define MSEC_PER_SEC  1000
+#define NSEC_PER_MSEC 1000000L
+#define NSEC_PER_SEC  1000000000L
+
+#if (defined __APPLE__) || (defined __linux__)
+static void *mdn_Logger_Thread_trampoline(void *arg) {
+    Logger_Thread_t *thread = arg;
+
+    thread->func(thread->arg);
+    return NULL;
+}
+#elif defined _WIN32
+static DWORD WINAPI mdn_Logger_Thread_trampoline(LPVOID arg) {
+    Logger_Thread_t *thread = arg;
+
+    thread->func(thread->arg);
+    return 0;
+}
+#endif  // OS
+
+bool mdn_Logger_Thread_create(Logger_Thread_t *thread, Logger_ThreadFunc_t func, void *arg) {
+    thread->func = func;
+    thread->arg  = arg;
+#if (defined __APPLE__) || (defined __linux__)
+    return pthread_create(&thread->handle, NULL, mdn_Logger_Thread_trampoline, thread) == 0;
+#elif defined _WIN32
+    thread->handle = CreateThread(NULL, 0, mdn_Logger_Thread_trampoline, thread, 0, NULL);
+    return thread->handle != NULL;
+#endif  // OS
+}
+
+void mdn_Logger_Thread_join(Logger_Thread_t *thread) {
+#if (defined __APPLE__) || (defined __linux__)
+    (void)pthread_join(thread->handle, NULL);
+#elif defined _WIN32
+    (void)WaitForSingleObject(thread->handle, INFINITE);
+    (void)CloseHandle(thread->handle);
+#endif  // OS
+}
+
+void mdn_Logger_Thread_yield(void) {
+#if (defined __APPLE__) || (defined __linux__)
+    (void)sched_yield();
+#elif defined _WIN32
+    (void)SwitchToThread();
+#endif  // OS
+}
+
+uint64_t mdn_Logger_Thread_getId(void) {
+    static _Thread_local uint64_t g_Logger_threadId = 0;
+
+    // A syscall on Linux, so only asked once per thread
+    if (g_Logger_threadId == 0) {
+#if defined __linux__
+        g_Logger_threadId = (uint64_t)syscall(SYS_gettid);
+#elif defined __APPLE__
+        (void)pthread_threadid_np(NULL, &g_Logger_threadId);
+#elif defined _WIN32
+        g_Logger_threadId = GetCurrentThreadId();
+#endif  // OS
+    }
+    return g_Logger_threadId;
+}
+
+bool mdn_Logger_Mutex_init(Logger_Mutex_t *mutex) {
+#if (defined __APPLE__) || (defined __linux__)
+    return pthread_mutex_init(&mutex->handle, NULL) == 0;
+#elif defined _WIN32
+    InitializeSRWLock(&mutex->handle);
+    return true;
+#endif  // OS
+}
+
+void mdn_Logger_Mutex_destroy(Logger_Mutex_t *mutex) {
+#if (defined __APPLE__) || (defined __linux__)
+    (void)pthread_mutex_destroy(&mutex->handle);
+#elif defined _WIN32
+    (void)mutex;
+#endif  // OS
+}
+
+void mdn_Logger_Mutex_lock(Logger_Mutex_t *mutex) {
+#if (defined __APPLE__) || (defined __linux__)
+    (void)pthread_mutex_lock(&mutex->handle);
+#elif defined _WIN32
+    AcquireSRWLockExclusive(&mutex->handle);
+#endif  // OS
+}
+
+void mdn_Logger_Mutex_unlock(Logger_Mutex_t *mutex) {
+#if (defined __APPLE__) || (defined __linux__)
+    (void)pthread_mutex_unlock(&mutex->handle);
+#elif defined _WIN32
+    ReleaseSRWLockExclusive(&mutex->handle);
+#endif  // OS
+}
+
+bool mdn_Logger_Cond_init(Logger_Cond_t *cond) {
+#if (defined __APPLE__) || (defined __linux__)
+    return pthread_cond_init(&cond->handle, NULL) == 0;
+#elif defined _WIN32
+    InitializeConditionVariable(&cond->handle);
+    return true;
+#endif  // OS
+}
+
+void mdn_Logger_Cond_destroy(Logger_Cond_t *cond) {
+#if (defined __APPLE__) || (defined __linux__)
+    (void)pthread_cond_destroy(&cond->handle);
+#elif defined _WIN32
+    (void)cond;
+#endif  // OS
+}
+
+void mdn_Logger_Cond_signal(Logger_Cond_t *cond) {
+#if (defined __APPLE__) || (defined __linux__)
+    (void)pthread_cond_signal(&cond->handle);
+#elif defined _WIN32
+    WakeConditionVariable(&cond->handle);
+#endif  // OS
+}
+
+void mdn_Logger_Cond_timedWait(Logger_Cond_t *cond, Logger_Mutex_t *mutex, unsigned timeoutMs) {
+#if (defined __APPLE__) || (defined __linux__)
+    struct timespec deadline;
+
+    if (clock_gettime(CLOCK_REALTIME, &deadline) != 0) {
+        return;
+    }
+    deadline.tv_sec  += (time_t)(timeoutMs / MSEC_PER_SEC);
+    deadline.tv_nsec += (long)(timeoutMs % MSEC_PER_SEC) * NSEC_PER_MSEC;
+    if (deadline.tv_nsec >= NSEC_PER_SEC) {
+        deadline.tv_sec  += 1;
+        deadline.tv_nsec -= NSEC_PER_SEC;
+    }
+    (void)pthread_cond_timedwait(&cond->handle, &mutex->handle, &deadline);
+#elif defined _WIN32
+    (void)SleepConditionVariableSRW(&cond->handle, &mutex->handle, timeoutMs, 0);
+#endif  // OS
+}
@@ -0,0 +1,68 @@
+#ifndef LOGGER_THREAD_H
+#define LOGGER_THREAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <pthread.h>
+#elif defined _WIN32
+# include <Windows.h>
+#endif  // OS
+
+typedef void (*Logger_ThreadFunc_t)(void *arg);
+
+typedef struct Logger_Thread_t_ {
+#if (defined __APPLE__) || (defined __linux__)
+    pthread_t handle;
+#elif defined _WIN32
+    HANDLE handle;
+#endif  // OS
+    Logger_ThreadFunc_t func;
+    void               *arg;
+} Logger_Thread_t;
+
+typedef struct Logger_Mutex_t_ {
+#if (defined __APPLE__) || (defined __linux__)
+    pthread_mutex_t handle;
+#elif defined _WIN32
+    SRWLOCK handle;
+#endif  // OS
+} Logger_Mutex_t;
+
+typedef struct Logger_Cond_t_ {
+#if (defined __APPLE__) || (defined __linux__)
+    pthread_cond_t handle;
+#elif defined _WIN32
+    CONDITION_VARIABLE handle;
+#endif  // OS
+} Logger_Cond_t;
+
+// Note: 'thread' must stay valid until mdn_Logger_Thread_join() returns
+bool mdn_Logger_Thread_create(Logger_Thread_t *thread, Logger_ThreadFunc_t func, void *arg);
+
+void mdn_Logger_Thread_join(Logger_Thread_t *thread);
+
+void mdn_Logger_Thread_yield(void);
+
+// ID of the calling thread as the OS shows it (e.g. in top or a debugger), not its pthread_t
+uint64_t mdn_Logger_Thread_getId(void);
+
+bool mdn_Logger_Mutex_init(Logger_Mutex_t *mutex);
+
+void mdn_Logger_Mutex_destroy(Logger_Mutex_t *mutex);
+
+void mdn_Logger_Mutex_lock(Logger_Mutex_t *mutex);
+
+void mdn_Logger_Mutex_unlock(Logger_Mutex_t *mutex);
+
+bool mdn_Logger_Cond_init(Logger_Cond_t *cond);
+
+void mdn_Logger_Cond_destroy(Logger_Cond_t *cond);
+
+void mdn_Logger_Cond_signal(Logger_Cond_t *cond);
+
+// Returns with 'mutex' locked, either when signaled, on timeout or spuriously
+void mdn_Logger_Cond_timedWait(Logger_Cond_t *cond, Logger_Mutex_t *mutex, unsigned timeoutMs);
+
+#endif  // LOGGER_THREAD_H
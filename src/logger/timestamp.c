@@ -0,0 +1,193 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "timestamp.h"
+
+#include <string.h>
+#include <time.h>
+
+#if defined _WIN32
+# include <Windows.h>
+#endif  // OS
+
+#define NSEC_PER_MSEC              1000000L
+#define NSEC_PER_SEC               1000000000L
+#define YEAR_OFFSET                1900
+#define MONTH_OFFSET               1
+#define WIN_TICKS_PER_SEC          10000000LL     // FILETIME counts 100ns ticks
+#define WIN_NSEC_PER_TICK          100
+#define WIN_EPOCH_TO_UNIX_EPOCH_S  11644473600LL  // Seconds between 1601-01-01 and 1970-01-01
+#define TIMESTAMP_FRACTION_SEP_LEN 1
+
+typedef struct Logger_TimestampCache_t_ {
+    int64_t sec;
+    bool    valid;
+    char    dateTime[LOGGER_TIMESTAMP_DATE_TIME_LEN];
+} Logger_TimestampCache_t;
+
+// Per thread, so that formatting never synchronizes, and so it is safe on the async writer thread as well
+static _Thread_local Logger_TimestampCache_t g_Logger_timestampCache;
+
+static const struct {
+    int     digitsCount;
+    int32_t nsecDenom;
+} g_Logger_timestampPrecisionToFractionMap[] = {
+    [MDN_LOGGER_TIMESTAMP_PRECISION_MSEC] = {.digitsCount = 3, .nsecDenom = 1000000},
+    [MDN_LOGGER_TIMESTAMP_PRECISION_USEC] = {.digitsCount = 6, .nsecDenom = 1000   },
+    [MDN_LOGGER_TIMESTAMP_PRECISION_NSEC] = {.digitsCount = 9, .nsecDenom = 1      },
+};
+
+bool mdn_Logger_Timestamp_isCoarseClockEnough(mdn_Logger_timestampPrecision_t timestampPrecision) {
+#if (defined __linux__) && (defined CLOCK_REALTIME_COARSE)
+    struct timespec resolution;
+
+    if (timestampPrecision != MDN_LOGGER_TIMESTAMP_PRECISION_MSEC) {
+        return false;
+    }
+    if (clock_getres(CLOCK_REALTIME_COARSE, &resolution) != 0) {
+        return false;
+    }
+    return (resolution.tv_sec == 0) && (resolution.tv_nsec <= NSEC_PER_MSEC);
+#else
+    (void)timestampPrecision;
+    return false;
+#endif  // OS
+}
+
+void mdn_Logger_Timestamp_get(Logger_Timestamp_t *timestamp, bool useCoarseClock) {
+#if (defined __APPLE__) || (defined __linux__)
+    struct timespec timeSpec;
+    clockid_t       clockId = CLOCK_REALTIME;
+
+# if (defined __linux__) && (defined CLOCK_REALTIME_COARSE)
+    if (useCoarseClock) {
+        clockId = CLOCK_REALTIME_COARSE;
+    }
+# else
+    (void)useCoarseClock;
+# endif  // OS
+
+    if (clock_gettime(clockId, &timeSpec) != 0) {
+        timeSpec.tv_sec  = 0;
+        timeSpec.tv_nsec = 0;
+    }
+    timestamp->sec  = (int64_t)timeSpec.tv_sec;
+    timestamp->nsec = (int32_t)timeSpec.tv_nsec;
+#elif defined _WIN32
+    FILETIME       fileTime;
+    ULARGE_INTEGER ticks;
+
+    (void)useCoarseClock;
+    GetSystemTimePreciseAsFileTime(&fileTime);
+    ticks.LowPart   = fileTime.dwLowDateTime;
+    ticks.HighPart  = fileTime.dwHighDateTime;
+    timestamp->sec  = (int64_t)(ticks.QuadPart / WIN_TICKS_PER_SEC) - WIN_EPOCH_TO_UNIX_EPOCH_S;
+    timestamp->nsec = (int32_t)(ticks.QuadPart % WIN_TICKS_PER_SEC) * WIN_NSEC_PER_TICK;
+#endif  // OS
+}
+
+uint64_t mdn_Logger_Timestamp_getMonotonicNs(void) {
+#if (defined __APPLE__) || (defined __linux__)
+    struct timespec timeSpec;
+# if (defined __linux__) && (defined CLOCK_MONOTONIC_COARSE)
+    clockid_t clockId = CLOCK_MONOTONIC_COARSE;
+# else
+    clockid_t clockId = CLOCK_MONOTONIC;
+# endif  // OS
+
+    if (clock_gettime(clockId, &timeSpec) != 0) {
+        return 0;
+    }
+    return ((uint64_t)timeSpec.tv_sec * NSEC_PER_SEC) + (uint64_t)timeSpec.tv_nsec;
+#elif defined _WIN32
+    return (uint64_t)GetTickCount64() * NSEC_PER_MSEC;
+#endif  // OS
+}
+
+uint64_t mdn_Logger_Timestamp_getPreciseMonotonicNs(void) {
+#if (defined __APPLE__) || (defined __linux__)
+    struct timespec timeSpec;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &timeSpec) != 0) {
+        return 0;
+    }
+    return ((uint64_t)timeSpec.tv_sec * NSEC_PER_SEC) + (uint64_t)timeSpec.tv_nsec;
+#elif defined _WIN32
+    LARGE_INTEGER counter, frequency;
+
+    (void)QueryPerformanceCounter(&counter);
+    (void)QueryPerformanceFrequency(&frequency);
+    return ((uint64_t)(counter.QuadPart / frequency.QuadPart) * NSEC_PER_SEC) + ((uint64_t)(counter.QuadPart % frequency.QuadPart) * NSEC_PER_SEC / (uint64_t)frequency.QuadPart);
+#endif  // OS
+}
+
+static void mdn_Logger_Timestamp_writeDigits(char *buf, int digitsCount, long value) {
+    for (int idx = digitsCount - 1; idx >= 0; --idx) {
+        buf[idx]  = (char)('0' + (value % 10));
+        value    /= 10;
+    }
+}
+
+static void mdn_Logger_Timestamp_refreshCache(Logger_TimestampCache_t *timestampCache, int64_t sec) {
+    int year, month, day, hour, minute, second;
+#if (defined __APPLE__) || (defined __linux__)
+    time_t    timeValue = (time_t)sec;
+    struct tm localTm;
+
+    if (localtime_r(&timeValue, &localTm) == NULL) {
+        memset(&localTm, 0, sizeof(localTm));
+    }
+    year   = localTm.tm_year + YEAR_OFFSET;
+    month  = localTm.tm_mon + MONTH_OFFSET;
+    day    = localTm.tm_mday;
+    hour   = localTm.tm_hour;
+    minute = localTm.tm_min;
+    second = localTm.tm_sec;
+#elif defined _WIN32
+    ULARGE_INTEGER ticks;
+    FILETIME       utcFileTime, localFileTime;
+    SYSTEMTIME     systemTime = {0};
+
+    ticks.QuadPart             = (ULONGLONG)(sec + WIN_EPOCH_TO_UNIX_EPOCH_S) * WIN_TICKS_PER_SEC;
+    utcFileTime.dwLowDateTime  = ticks.LowPart;
+    utcFileTime.dwHighDateTime = ticks.HighPart;
+    if (FileTimeToLocalFileTime(&utcFileTime, &localFileTime)) {
+        (void)FileTimeToSystemTime(&localFileTime, &systemTime);
+    }
+    year   = systemTime.wYear;
+    month  = systemTime.wMonth;
+    day    = systemTime.wDay;
+    hour   = systemTime.wHour;
+    minute = systemTime.wMinute;
+    second = systemTime.wSecond;
+#endif  // OS
+
+    // "YYYY-MM-DD HH:MM:SS"
+    mdn_Logger_Timestamp_writeDigits(timestampCache->dateTime, 4, year);
+    timestampCache->dateTime[4] = '-';
+    mdn_Logger_Timestamp_writeDigits(timestampCache->dateTime + 5, 2, month);
+    timestampCache->dateTime[7] = '-';
+    mdn_Logger_Timestamp_writeDigits(timestampCache->dateTime + 8, 2, day);
+    timestampCache->dateTime[10] = ' ';
+    mdn_Logger_Timestamp_writeDigits(timestampCache->dateTime + 11, 2, hour);
+    timestampCache->dateTime[13] = ':';
+    mdn_Logger_Timestamp_writeDigits(timestampCache->dateTime + 14, 2, minute);
+    timestampCache->dateTime[16] = ':';
+    mdn_Logger_Timestamp_writeDigits(timestampCache->dateTime + 17, 2, second);
+
+    timestampCache->sec   = sec;
+    timestampCache->valid = true;
+}
+
+size_t mdn_Logger_Timestamp_format(const Logger_Timestamp_t *timestamp, mdn_Logger_timestampPrecision_t timestampPrecision, char *buf) {
+    Logger_TimestampCache_t *timestampCache = &g_Logger_timestampCache;
+    int                      digitsCount    = g_Logger_timestampPrecisionToFractionMap[timestampPrecision].digitsCount;
+
+    if (!timestampCache->valid || (timestampCache->sec != timestamp->sec)) {
+        mdn_Logger_Timestamp_refreshCache(timestampCache, timestamp->sec);
+    }
+
+    memcpy(buf, timestampCache->dateTime, LOGGER_TIMESTAMP_DATE_TIME_LEN);
+    buf[LOGGER_TIMESTAMP_DATE_TIME_LEN] = '.';
+    mdn_Logger_Timestamp_writeDigits(buf + LOGGER_TIMESTAMP_DATE_TIME_LEN + TIMESTAMP_FRACTION_SEP_LEN, digitsCount, timestamp->nsec / g_Logger_timestampPrecisionToFractionMap[timestampPrecision].nsecDenom);
+
+    return LOGGER_TIMESTAMP_DATE_TIME_LEN + TIMESTAMP_FRACTION_SEP_LEN + (size_t)digitsCount;
+}
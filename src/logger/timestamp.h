@@ -0,0 +1,29 @@
+#ifndef LOGGER_TIMESTAMP_H
+#define LOGGER_TIMESTAMP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "logger_internal.h"
+
+#define LOGGER_TIMESTAMP_DATE_LEN      11                                        // "YYYY-MM-DD "
+#define LOGGER_TIMESTAMP_DATE_TIME_LEN 19                                        // "YYYY-MM-DD HH:MM:SS"
+#define LOGGER_TIMESTAMP_MAX_LEN       (LOGGER_TIMESTAMP_DATE_TIME_LEN + 1 + 9)  // ".nnnnnnnnn"
+
+// Whether the cheaper, tick-granular clock is accurate enough for 'timestampPrecision'
+bool mdn_Logger_Timestamp_isCoarseClockEnough(mdn_Logger_timestampPrecision_t timestampPrecision);
+
+void mdn_Logger_Timestamp_get(Logger_Timestamp_t *timestamp, bool useCoarseClock);
+
+// Nanoseconds on a clock that never goes back, only meaningful as differences. Tick-granular where that is cheaper.
+uint64_t mdn_Logger_Timestamp_getMonotonicNs(void);
+
+// Same clock at full resolution, for measuring short durations
+uint64_t mdn_Logger_Timestamp_getPreciseMonotonicNs(void);
+
+// Writes "YYYY-MM-DD HH:MM:SS.fff" in local time (not null-terminated) and returns its length.
+// Date and time are cached per thread and only recomputed when the second changes.
+size_t mdn_Logger_Timestamp_format(const Logger_Timestamp_t *timestamp, mdn_Logger_timestampPrecision_t timestampPrecision, char *buf);
+
+#endif  // LOGGER_TIMESTAMP_H
@@ -0,0 +1,323 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#if defined __linux__
+# define _GNU_SOURCE  // For sendmmsg()
+#endif  // OS
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mdn/logger.h"
+#include "mdn/mock_wrapper.h"
+#include "sink.h"
+#include "thread.h"
+#include "timestamp.h"
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <errno.h>
+# include <fcntl.h>
+# include <sys/socket.h>
+# include <sys/time.h>
+# include <sys/uio.h>
+# include <sys/un.h>
+# include <unistd.h>
+#endif  // OS
+
+#if (defined __APPLE__) || (defined __linux__)
+# define DEFAULT_DATAGRAM_SIZE (16 * 1024)
+# define DEFAULT_SPILL_SIZE    (1024 * 1024)
+# define RECONNECT_INTERVAL_NS (100 * 1000000ULL)
+# define MAX_DATAGRAMS_COUNT   64    // Per sendmmsg()
+# define MAX_IOVS_COUNT        1024  // Across the datagrams of a sendmmsg(), one per record
+# define RECORD_HEADER_SIZE    sizeof(uint32_t)
+# define CLOSE_SEND_TIMEOUT_MS 1000  // How long closing waits for the collector to take what is held
+
+# ifndef MSG_NOSIGNAL
+#  define MSG_NOSIGNAL 0  // SO_NOSIGPIPE is set on the socket instead
+# endif
+
+# if defined __linux__
+typedef struct mmsghdr Logger_UnixSocketDatagram_t;
+# else
+// The fields of Linux's struct mmsghdr, datagrams are sent with a sendmsg() each without sendmmsg()
+typedef struct Logger_UnixSocketDatagram_t_ {
+    struct msghdr msg_hdr;  // NOLINT(readability-identifier-naming)
+    unsigned int  msg_len;  // NOLINT(readability-identifier-naming)
+} Logger_UnixSocketDatagram_t;
+# endif
+
+// Records are spilled first, each as a u32 length followed by its bytes, then sent from there as long as the socket takes
+// them. 'spillStart' is the oldest record not sent yet. All under 'mutex', the datagrams and iovecs only live during a send.
+typedef struct Logger_UnixSocketSink_t_ {
+    Logger_Mutex_t              mutex;
+    int                         fd;  // -1 while disconnected
+    int                         type;
+    int                         sendFlags;  // Sends only block, on a blocking socket, while closing
+    struct sockaddr_un          address;
+    uint64_t                    nextConnectNs;
+    size_t                      datagramSize;
+    Logger_UnixSocketDatagram_t datagramsArr[MAX_DATAGRAMS_COUNT];
+    struct iovec                iovsArr[MAX_IOVS_COUNT];
+    size_t                      spillSize;
+    size_t                      spillStart;
+    size_t                      spillEnd;
+    char                        spill[];  // 'spillSize' bytes
+} Logger_UnixSocketSink_t;
+
+// Returns the count of datagrams sent, or -1 if none could be, with errno set
+static int mdn_Logger_UnixSocketSink_sendDatagrams(int fd, Logger_UnixSocketDatagram_t *datagramsArr, unsigned datagramsArrLen, int flags) {
+# if defined __linux__
+    return sendmmsg(fd, datagramsArr, datagramsArrLen, flags);
+# else
+    unsigned sentCount = 0;
+
+    while ((sentCount < datagramsArrLen) && (sendmsg(fd, &datagramsArr[sentCount].msg_hdr, flags) >= 0)) {
+        ++sentCount;
+    }
+    return ((sentCount == 0) && (datagramsArrLen > 0)) ? -1 : (int)sentCount;
+# endif
+}
+
+// Without blocking, and at most once per RECONNECT_INTERVAL_NS
+static bool mdn_Logger_UnixSocketSink_connect(Logger_UnixSocketSink_t *sink) {
+    uint64_t nowNs = mdn_Logger_Timestamp_getMonotonicNs();
+    int      fd;
+
+    if (nowNs < sink->nextConnectNs) {
+        return false;
+    }
+    fd = socket(AF_UNIX, sink->type, 0);
+    if (fd >= 0) {
+# ifdef SO_NOSIGPIPE
+        (void)setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &(int){1}, sizeof(int));
+# endif
+        if ((fcntl(fd, F_SETFD, FD_CLOEXEC) == 0) && (fcntl(fd, F_SETFL, O_NONBLOCK) == 0)
+            && (connect(fd, (const struct sockaddr *)&sink->address, sizeof(sink->address)) == 0)) {
+            sink->fd = fd;
+            return true;
+        }
+        (void)close(fd);
+    }
+    sink->nextConnectNs = nowNs + RECONNECT_INTERVAL_NS;
+
+    return false;
+}
+
+static void mdn_Logger_UnixSocketSink_disconnect(Logger_UnixSocketSink_t *sink) {
+    (void)close(sink->fd);
+    sink->fd            = -1;
+    sink->nextConnectNs = mdn_Logger_Timestamp_getMonotonicNs() + RECONNECT_INTERVAL_NS;
+}
+
+// Returns false if the record can't fit
+static bool mdn_Logger_UnixSocketSink_spill(Logger_UnixSocketSink_t *sink, const char *data, size_t len) {
+    uint32_t recordLen = (uint32_t)len;
+
+    if ((len > UINT32_MAX) || ((RECORD_HEADER_SIZE + len) > (sink->spillSize - (sink->spillEnd - sink->spillStart)))) {
+        return false;
+    }
+    if ((RECORD_HEADER_SIZE + len) > (sink->spillSize - sink->spillEnd)) {
+        memmove(sink->spill, sink->spill + sink->spillStart, sink->spillEnd - sink->spillStart);
+        sink->spillEnd   -= sink->spillStart;
+        sink->spillStart  = 0;
+    }
+    memcpy(sink->spill + sink->spillEnd, &recordLen, RECORD_HEADER_SIZE);
+    memcpy(sink->spill + sink->spillEnd + RECORD_HEADER_SIZE, data, len);
+    sink->spillEnd += RECORD_HEADER_SIZE + len;
+
+    return true;
+}
+
+// Packs the spilled records whole into datagrams of up to 'datagramSize' bytes (a bigger record goes alone), starting from
+// the oldest one. Returns the count of datagrams.
+static unsigned mdn_Logger_UnixSocketSink_pack(Logger_UnixSocketSink_t *sink) {
+    unsigned datagramsCount = 0;
+    size_t   iovsCount      = 0;
+    size_t   firstIovIdx;
+    size_t   datagramLen;
+    size_t   pos            = sink->spillStart;
+    uint32_t recordLen;
+
+    while ((pos < sink->spillEnd) && (datagramsCount < MAX_DATAGRAMS_COUNT) && (iovsCount < MAX_IOVS_COUNT)) {
+        firstIovIdx = iovsCount;
+        datagramLen = 0;
+        while ((pos < sink->spillEnd) && (iovsCount < MAX_IOVS_COUNT)) {
+            memcpy(&recordLen, sink->spill + pos, RECORD_HEADER_SIZE);
+            if ((datagramLen > 0) && ((datagramLen + recordLen) > sink->datagramSize)) {
+                break;
+            }
+            sink->iovsArr[iovsCount++] = (struct iovec){.iov_base = sink->spill + pos + RECORD_HEADER_SIZE, .iov_len = recordLen};
+            datagramLen += recordLen;
+            pos         += RECORD_HEADER_SIZE + recordLen;
+        }
+        memset(&sink->datagramsArr[datagramsCount], 0, sizeof(sink->datagramsArr[datagramsCount]));
+        sink->datagramsArr[datagramsCount].msg_hdr.msg_iov    = &sink->iovsArr[firstIovIdx];
+        sink->datagramsArr[datagramsCount].msg_hdr.msg_iovlen = iovsCount - firstIovIdx;
+        ++datagramsCount;
+    }
+
+    return datagramsCount;
+}
+
+// Moves 'spillStart' past the records of the datagram
+static void mdn_Logger_UnixSocketSink_release(Logger_UnixSocketSink_t *sink, const Logger_UnixSocketDatagram_t *datagram) {
+    const struct iovec *lastIov = &datagram->msg_hdr.msg_iov[datagram->msg_hdr.msg_iovlen - 1];
+
+    sink->spillStart = (size_t)((char *)lastIov->iov_base + lastIov->iov_len - sink->spill);
+}
+
+// Sends the spilled records until there are none left or the socket can't take more. Returns false if records were lost,
+// which only happens to a datagram too big for the socket.
+static bool mdn_Logger_UnixSocketSink_send(Logger_UnixSocketSink_t *sink) {
+    unsigned datagramsCount;
+    int      sentCount;
+    bool     written = true;
+
+    while (sink->spillStart < sink->spillEnd) {
+        if ((sink->fd < 0) && !mdn_Logger_UnixSocketSink_connect(sink)) {
+            break;
+        }
+        datagramsCount = mdn_Logger_UnixSocketSink_pack(sink);
+        sentCount      = mdn_Logger_UnixSocketSink_sendDatagrams(sink->fd, sink->datagramsArr, datagramsCount, sink->sendFlags);
+        if (sentCount < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS)) {
+                break;  // The collector is behind, sent with the next records
+            }
+            if (errno == EMSGSIZE) {
+                mdn_Logger_UnixSocketSink_release(sink, &sink->datagramsArr[0]);
+                written = false;
+                continue;
+            }
+            // The collector went away, or restarted and is bound to a new socket
+            mdn_Logger_UnixSocketSink_disconnect(sink);
+            break;
+        }
+        if (sentCount > 0) {
+            mdn_Logger_UnixSocketSink_release(sink, &sink->datagramsArr[sentCount - 1]);
+        }
+        if ((unsigned)sentCount < datagramsCount) {
+            break;
+        }
+    }
+    if (sink->spillStart == sink->spillEnd) {
+        sink->spillStart = 0;
+        sink->spillEnd   = 0;
+    }
+
+    return written;
+}
+
+static bool mdn_Logger_UnixSocketSink_write(void *context, const char *data, size_t len) {
+    Logger_UnixSocketSink_t *sink = context;
+    bool                     written;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    written = mdn_Logger_UnixSocketSink_spill(sink, data, len);
+    written = mdn_Logger_UnixSocketSink_send(sink) && written;
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return written;
+}
+
+static bool mdn_Logger_UnixSocketSink_writeBatch(void *context, const mdn_Logger_SinkBuffer_t *buffersArr, size_t buffersArrLen) {
+    Logger_UnixSocketSink_t *sink    = context;
+    bool                     written = true;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    for (size_t idx = 0; idx < buffersArrLen; ++idx) {
+        written = mdn_Logger_UnixSocketSink_spill(sink, buffersArr[idx].data, buffersArr[idx].len) && written;
+    }
+    written = mdn_Logger_UnixSocketSink_send(sink) && written;
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return written;
+}
+
+static bool mdn_Logger_UnixSocketSink_flush(void *context) {
+    Logger_UnixSocketSink_t *sink = context;
+    bool                     written;
+
+    mdn_Logger_Mutex_lock(&sink->mutex);
+    written = mdn_Logger_UnixSocketSink_send(sink);
+    mdn_Logger_Mutex_unlock(&sink->mutex);
+
+    return written;
+}
+
+// Waits up to CLOSE_SEND_TIMEOUT_MS for the collector to take what is held, once no thread is logging anymore
+static void mdn_Logger_UnixSocketSink_close(void *context) {
+    Logger_UnixSocketSink_t *sink    = context;
+    struct timeval           timeout = {.tv_sec = CLOSE_SEND_TIMEOUT_MS / 1000, .tv_usec = (CLOSE_SEND_TIMEOUT_MS % 1000) * 1000};
+
+    sink->nextConnectNs = 0;
+    if ((sink->spillStart < sink->spillEnd) && ((sink->fd >= 0) || mdn_Logger_UnixSocketSink_connect(sink))
+        && (setsockopt(sink->fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == 0) && (fcntl(sink->fd, F_SETFL, 0) == 0)) {
+        sink->sendFlags = MSG_NOSIGNAL;
+    }
+    (void)mdn_Logger_UnixSocketSink_send(sink);
+    if (sink->fd >= 0) {
+        (void)close(sink->fd);
+    }
+    mdn_Logger_Mutex_destroy(&sink->mutex);
+    free(sink);
+}
+
+static const Logger_SinkOps_t g_Logger_UnixSocketSink_ops = {
+    .write      = mdn_Logger_UnixSocketSink_write,
+    .writeBatch = mdn_Logger_UnixSocketSink_writeBatch,
+    .flush      = mdn_Logger_UnixSocketSink_flush,
+    .close      = mdn_Logger_UnixSocketSink_close,
+};
+
+mdn_Status_t mdn_Logger_createUnixSocketSink(mdn_Logger_Sink_t *sink, mdn_Logger_UnixSocketConfig_t unixSocketConfig) {
+    Logger_UnixSocketSink_t *sinkContext;
+    size_t                   spillSize = (unixSocketConfig.spillSize == 0) ? DEFAULT_SPILL_SIZE : unixSocketConfig.spillSize;
+#ifdef MDN_LOGGER_SAFE_MODE
+    if ((sink == NULL) || (unixSocketConfig.path == NULL)) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+#endif  // MDN_LOGGER_SAFE_MODE
+
+    if ((strlen(unixSocketConfig.path) >= sizeof(sinkContext->address.sun_path)) || (spillSize > (SIZE_MAX - sizeof(*sinkContext)))) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    sinkContext = MDN_MW_malloc(sizeof(*sinkContext) + spillSize);
+    if (sinkContext == NULL) {
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    // Thread primitives only fail on resources exhaustion, hence reported as memory allocation failures
+    if (!mdn_Logger_Mutex_init(&sinkContext->mutex)) {
+        free(sinkContext);
+        return MDN_STATUS_ERROR_MEM_ALLOC;
+    }
+    sinkContext->fd        = -1;
+    sinkContext->type      = unixSocketConfig.seqPacket ? SOCK_SEQPACKET : SOCK_DGRAM;
+    sinkContext->sendFlags = MSG_DONTWAIT | MSG_NOSIGNAL;
+    memset(&sinkContext->address, 0, sizeof(sinkContext->address));
+    sinkContext->address.sun_family = AF_UNIX;
+    strcpy(sinkContext->address.sun_path, unixSocketConfig.path);  // NOLINT(clang-analyzer-security.insecureAPI.strcpy): length checked above
+    sinkContext->nextConnectNs = 0;
+    sinkContext->datagramSize  = (unixSocketConfig.datagramSize == 0) ? DEFAULT_DATAGRAM_SIZE : unixSocketConfig.datagramSize;
+    sinkContext->spillSize     = spillSize;
+    sinkContext->spillStart    = 0;
+    sinkContext->spillEnd      = 0;
+    // The collector may not be there yet, records are then spilled until it is
+    (void)mdn_Logger_UnixSocketSink_connect(sinkContext);
+    *sink = (mdn_Logger_Sink_t){
+        .ops     = &g_Logger_UnixSocketSink_ops,
+        .context = sinkContext,
+    };
+
+    return MDN_STATUS_SUCCESS;
+}
+#elif defined _WIN32
+// No Unix datagram sockets on Windows
+mdn_Status_t mdn_Logger_createUnixSocketSink(mdn_Logger_Sink_t *sink, mdn_Logger_UnixSocketConfig_t unixSocketConfig) {
+    (void)sink;
+    (void)unixSocketConfig;
+    return MDN_STATUS_ERROR_BAD_ARGUMENT;
+}
+#endif  // OS
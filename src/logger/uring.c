@@ -0,0 +1,216 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include "uring.h"
+
+#include <stdlib.h>
+
+#include "mdn/mock_wrapper.h"
+
+#if defined __linux__
+# include <errno.h>
+# include <linux/io_uring.h>
+# include <stdatomic.h>
+# include <string.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <sys/uio.h>
+# include <unistd.h>
+#endif  // OS
+
+#if defined __linux__
+// Only the submitting thread writes the SQ tail and the CQ head (callers serialize), the kernel writes the SQ head and the CQ tail
+struct Logger_Uring_t_ {
+    int                  ringFd;
+    void                *sqRing;
+    size_t               sqRingSize;
+    void                *cqRing;
+    size_t               cqRingSize;
+    struct io_uring_sqe *sqesArr;
+    size_t               sqesArrSize;
+    unsigned            *sqTail;
+    unsigned            *sqMask;
+    unsigned            *sqIdxArr;
+    unsigned            *cqHead;
+    unsigned            *cqTail;
+    unsigned            *cqMask;
+    struct io_uring_cqe *cqesArr;
+    unsigned             buffersCount;
+    struct iovec         buffersArr[];
+};
+
+// The rings are shared with the kernel, hence accessed as atomics the way liburing does
+static unsigned mdn_Logger_Uring_loadAcquire(const unsigned *ptr) {
+    return atomic_load_explicit((const _Atomic unsigned *)(const void *)ptr, memory_order_acquire);
+}
+
+static void mdn_Logger_Uring_storeRelease(unsigned *ptr, unsigned value) {
+    atomic_store_explicit((_Atomic unsigned *)(void *)ptr, value, memory_order_release);
+}
+
+static void *mdn_Logger_Uring_map(int ringFd, size_t size, off_t offset) {
+    return mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+}
+
+// Mappings that failed are left as MAP_FAILED
+static bool mdn_Logger_Uring_mapRings(Logger_Uring_t *ring, const struct io_uring_params *params) {
+    ring->sqRingSize  = params->sq_off.array + (params->sq_entries * sizeof(unsigned));
+    ring->cqRingSize  = params->cq_off.cqes + (params->cq_entries * sizeof(struct io_uring_cqe));
+    ring->sqesArrSize = params->sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqRing      = mdn_Logger_Uring_map(ring->ringFd, ring->sqRingSize, IORING_OFF_SQ_RING);
+    ring->cqRing      = mdn_Logger_Uring_map(ring->ringFd, ring->cqRingSize, IORING_OFF_CQ_RING);
+    ring->sqesArr     = mdn_Logger_Uring_map(ring->ringFd, ring->sqesArrSize, IORING_OFF_SQES);
+    if ((ring->sqRing == MAP_FAILED) || (ring->cqRing == MAP_FAILED) || (ring->sqesArr == MAP_FAILED)) {
+        return false;
+    }
+
+    ring->sqTail   = (unsigned *)(void *)((char *)ring->sqRing + params->sq_off.tail);
+    ring->sqMask   = (unsigned *)(void *)((char *)ring->sqRing + params->sq_off.ring_mask);
+    ring->sqIdxArr = (unsigned *)(void *)((char *)ring->sqRing + params->sq_off.array);
+    ring->cqHead   = (unsigned *)(void *)((char *)ring->cqRing + params->cq_off.head);
+    ring->cqTail   = (unsigned *)(void *)((char *)ring->cqRing + params->cq_off.tail);
+    ring->cqMask   = (unsigned *)(void *)((char *)ring->cqRing + params->cq_off.ring_mask);
+    ring->cqesArr  = (struct io_uring_cqe *)(void *)((char *)ring->cqRing + params->cq_off.cqes);
+
+    return true;
+}
+
+static void mdn_Logger_Uring_unmapRings(Logger_Uring_t *ring) {
+    if (ring->sqesArr != MAP_FAILED) {
+        (void)munmap(ring->sqesArr, ring->sqesArrSize);
+    }
+    if (ring->cqRing != MAP_FAILED) {
+        (void)munmap(ring->cqRing, ring->cqRingSize);
+    }
+    if (ring->sqRing != MAP_FAILED) {
+        (void)munmap(ring->sqRing, ring->sqRingSize);
+    }
+}
+
+static bool mdn_Logger_Uring_register(const Logger_Uring_t *ring, int fd) {
+    int fdsArr[1] = {fd};
+
+    // Pins the buffers and takes a reference on the file once, instead of on each write
+    return (syscall(__NR_io_uring_register, ring->ringFd, IORING_REGISTER_BUFFERS, ring->buffersArr, ring->buffersCount) == 0)
+           && (syscall(__NR_io_uring_register, ring->ringFd, IORING_REGISTER_FILES, fdsArr, 1) == 0);
+}
+
+Logger_Uring_t *mdn_Logger_Uring_create(int fd, char *buffers, size_t bufferSize, unsigned buffersCount) {
+    Logger_Uring_t         *ring;
+    struct io_uring_params  params;
+
+    ring = MDN_MW_malloc(sizeof(*ring) + (buffersCount * sizeof(ring->buffersArr[0])));
+    if (ring == NULL) {
+        return NULL;
+    }
+    ring->buffersCount = buffersCount;
+    for (unsigned idx = 0; idx < buffersCount; ++idx) {
+        ring->buffersArr[idx] = (struct iovec){.iov_base = buffers + (idx * bufferSize), .iov_len = bufferSize};
+    }
+
+    memset(&params, 0, sizeof(params));
+    ring->ringFd = (int)syscall(__NR_io_uring_setup, buffersCount, &params);
+    if (ring->ringFd < 0) {
+        free(ring);
+        return NULL;
+    }
+    // Writing at the current file position (offset -1) needs Linux 5.6
+    if ((params.features & IORING_FEAT_RW_CUR_POS) != 0) {
+        if (mdn_Logger_Uring_mapRings(ring, &params)) {
+            if (mdn_Logger_Uring_register(ring, fd)) {
+                return ring;
+            }
+        }
+        mdn_Logger_Uring_unmapRings(ring);
+    }
+    (void)close(ring->ringFd);
+    free(ring);
+
+    return NULL;
+}
+
+void mdn_Logger_Uring_destroy(Logger_Uring_t *ring) {
+    // Closing the ring also unregisters the buffers and the file
+    mdn_Logger_Uring_unmapRings(ring);
+    (void)close(ring->ringFd);
+    free(ring);
+}
+
+bool mdn_Logger_Uring_submitWrite(Logger_Uring_t *ring, unsigned bufferIdx, size_t len) {
+    struct io_uring_sqe *sqe;
+    unsigned             tail = *ring->sqTail;
+    unsigned             idx  = tail & *ring->sqMask;
+    long                 submittedCount;
+
+    sqe = &ring->sqesArr[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = IORING_OP_WRITE_FIXED;
+    // Draining keeps the writes in order, each starts once the previous ones completed
+    sqe->flags     = IOSQE_FIXED_FILE | IOSQE_IO_DRAIN;
+    sqe->fd        = 0;  // Index of the registered file
+    sqe->off       = (uint64_t)-1;
+    sqe->addr      = (uint64_t)(uintptr_t)ring->buffersArr[bufferIdx].iov_base;
+    sqe->len       = (uint32_t)len;
+    sqe->buf_index = (uint16_t)bufferIdx;
+    sqe->user_data = bufferIdx;
+    ring->sqIdxArr[idx] = idx;
+    mdn_Logger_Uring_storeRelease(ring->sqTail, tail + 1);
+
+    do {
+        submittedCount = syscall(__NR_io_uring_enter, ring->ringFd, 1, 0, 0, NULL, 0);
+    } while ((submittedCount < 0) && (errno == EINTR));
+    if (submittedCount != 1) {
+        // Not consumed by the kernel, which only reads the tail when entered
+        mdn_Logger_Uring_storeRelease(ring->sqTail, tail);
+        return false;
+    }
+
+    return true;
+}
+
+bool mdn_Logger_Uring_reap(Logger_Uring_t *ring, bool wait, unsigned *bufferIdx, int32_t *result) {
+    const struct io_uring_cqe *cqe;
+    unsigned                   head;
+
+    for (;;) {
+        head = *ring->cqHead;
+        if (head != mdn_Logger_Uring_loadAcquire(ring->cqTail)) {
+            cqe        = &ring->cqesArr[head & *ring->cqMask];
+            *bufferIdx = (unsigned)cqe->user_data;
+            *result    = cqe->res;
+            mdn_Logger_Uring_storeRelease(ring->cqHead, head + 1);
+            return true;
+        }
+        if (!wait) {
+            return false;
+        }
+        // Only fails when interrupted, or with no write in flight, which callers rule out
+        (void)syscall(__NR_io_uring_enter, ring->ringFd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+    }
+}
+#else
+Logger_Uring_t *mdn_Logger_Uring_create(int fd, char *buffers, size_t bufferSize, unsigned buffersCount) {
+    (void)fd;
+    (void)buffers;
+    (void)bufferSize;
+    (void)buffersCount;
+    return NULL;
+}
+
+void mdn_Logger_Uring_destroy(Logger_Uring_t *ring) {
+    (void)ring;
+}
+
+bool mdn_Logger_Uring_submitWrite(Logger_Uring_t *ring, unsigned bufferIdx, size_t len) {
+    (void)ring;
+    (void)bufferIdx;
+    (void)len;
+    return false;
+}
+
+bool mdn_Logger_Uring_reap(Logger_Uring_t *ring, bool wait, unsigned *bufferIdx, int32_t *result) {
+    (void)ring;
+    (void)wait;
+    (void)bufferIdx;
+    (void)result;
+    return false;
+}
+#endif  // OS
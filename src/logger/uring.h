@@ -0,0 +1,26 @@
+#ifndef LOGGER_URING_H
+#define LOGGER_URING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Minimal io_uring, without liburing: writes of registered buffers to a single registered (fixed) file
+typedef struct Logger_Uring_t_ Logger_Uring_t;
+
+// Registers 'fd' and the 'buffersCount' buffers of 'bufferSize' bytes at 'buffers'. Returns NULL if io_uring is unavailable:
+// not Linux, kernel too old or with io_uring disabled, locked memory limit too low for the buffers...
+Logger_Uring_t *mdn_Logger_Uring_create(int fd, char *buffers, size_t bufferSize, unsigned buffersCount);
+
+// Once all writes completed. The buffers and fd stay the caller's.
+void mdn_Logger_Uring_destroy(Logger_Uring_t *ring);
+
+// Writes the first 'len' bytes of buffer 'bufferIdx' at the current file position, once all writes submitted before completed.
+// At most 'buffersCount' writes can be in flight.
+bool mdn_Logger_Uring_submitWrite(Logger_Uring_t *ring, unsigned bufferIdx, size_t len);
+
+// Gets the completion of a submitted write, waiting for one if 'wait' (at least one must be in flight then). Returns false
+// if there is none yet. 'result' is the count of bytes written, or a negated errno.
+bool mdn_Logger_Uring_reap(Logger_Uring_t *ring, bool wait, unsigned *bufferIdx, int32_t *result);
+
+#endif  // LOGGER_URING_H
@@ -0,0 +1,68 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mdn/logger.h"
+
+#define COMPRESSED_LOG_MAGIC     "MDNLOGZ"  // Start of every compressed log, see mdn_Logger_decompress()
+#define COMPRESSED_LOG_MAGIC_LEN 7
+#define COPY_BUFFER_SIZE         (64 * 1024)
+
+static mdn_Status_t copyStream(FILE *inStream, FILE *outStream) {
+    static char buffer[COPY_BUFFER_SIZE];
+    size_t      len;
+
+    while ((len = fread(buffer, 1, sizeof(buffer), inStream)) > 0) {
+        if (fwrite(buffer, 1, len, outStream) != len) {
+            return MDN_STATUS_ERROR_BAD_ARGUMENT;
+        }
+    }
+
+    return ferror(inStream) ? MDN_STATUS_ERROR_BAD_ARGUMENT : MDN_STATUS_SUCCESS;
+}
+
+static mdn_Status_t catLog(FILE *logStream) {
+    char   magic[COMPRESSED_LOG_MAGIC_LEN];
+    size_t magicLen;
+
+    magicLen = fread(magic, 1, sizeof(magic), logStream);
+    if (fseek(logStream, 0, SEEK_SET) != 0) {
+        return MDN_STATUS_ERROR_BAD_ARGUMENT;
+    }
+    if ((magicLen == sizeof(magic)) && (memcmp(magic, COMPRESSED_LOG_MAGIC, sizeof(magic)) == 0)) {
+        return mdn_Logger_decompress(logStream, stdout);
+    }
+
+    return copyStream(logStream, stdout);
+}
+
+// Usage: mdn_logger_cat <log>...
+// Writes logs to stdout one after the other, decompressing the compressed ones (and copying the others as is).
+int main(int argc, char *argv[]) {
+    FILE        *logStream;
+    mdn_Status_t status;
+    int          exitCode = EXIT_SUCCESS;
+
+    if (argc < 2) {
+        (void)fprintf(stderr, "Usage: %s <log>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (int argIdx = 1; argIdx < argc; ++argIdx) {
+        logStream = fopen(argv[argIdx], "rb");
+        if (logStream == NULL) {
+            (void)fprintf(stderr, "Failed to open '%s'\n", argv[argIdx]);
+            exitCode = EXIT_FAILURE;
+            continue;
+        }
+        status = catLog(logStream);
+        if (status != MDN_STATUS_SUCCESS) {
+            (void)fprintf(stderr, "Failed to read '%s' (status %d)\n", argv[argIdx], (int)status);
+            exitCode = EXIT_FAILURE;
+        }
+        (void)fclose(logStream);
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,44 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mdn/logger.h"
+
+// Usage: mdn_logger_decode <binary log> [<text log>]
+// Turns a log written with MDN_LOGGER_LOGGING_FORMAT_BINARY into MDN_LOGGER_LOGGING_FORMAT_FILE text, on stdout by default.
+int main(int argc, char *argv[]) {
+    FILE        *binaryStream;
+    FILE        *textStream = stdout;
+    mdn_Status_t status;
+
+    if ((argc != 2) && (argc != 3)) {
+        (void)fprintf(stderr, "Usage: %s <binary log> [<text log>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    binaryStream = fopen(argv[1], "rb");
+    if (binaryStream == NULL) {
+        (void)fprintf(stderr, "Failed to open '%s'\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    if (argc == 3) {
+        textStream = fopen(argv[2], "wb");
+        if (textStream == NULL) {
+            (void)fprintf(stderr, "Failed to open '%s'\n", argv[2]);
+            (void)fclose(binaryStream);
+            return EXIT_FAILURE;
+        }
+    }
+
+    status = mdn_Logger_decodeBinary(binaryStream, textStream);
+    if (status != MDN_STATUS_SUCCESS) {
+        (void)fprintf(stderr, "Failed to decode '%s' (status %d)\n", argv[1], (int)status);
+    }
+
+    (void)fclose(binaryStream);
+    if (textStream != stdout) {
+        (void)fclose(textStream);
+    }
+
+    return (status == MDN_STATUS_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
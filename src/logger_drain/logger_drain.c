@@ -0,0 +1,163 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mdn/logger.h"
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <time.h>
+#endif  // OS
+
+#define IDLE_SLEEP_NS         (10 * 1000000L)  // Between drains that found nothing
+#define PRODUCER_PATH_MAX_LEN 4096
+
+typedef struct ProducerStream_t_ {
+    int   pid;
+    FILE *stream;
+} ProducerStream_t;
+
+// Either all records go to 'stream', or each producer's go to "<path>.<pid>"
+typedef struct Output_t_ {
+    FILE            *stream;
+    const char      *path;
+    ProducerStream_t producerStreamsArr[MDN_LOGGER_SHM_RING_MAX_PRODUCERS];
+    size_t           producerStreamsArrLen;
+} Output_t;
+
+static volatile sig_atomic_t g_stopRequested = 0;
+
+static void onStopSignal(int signalNumber) {
+    (void)signalNumber;
+    g_stopRequested = 1;
+}
+
+static void sleepIdle(void) {
+#if (defined __APPLE__) || (defined __linux__)
+    struct timespec idle = {.tv_sec = 0, .tv_nsec = IDLE_SLEEP_NS};
+
+    (void)nanosleep(&idle, NULL);
+#endif  // OS
+}
+
+static void closeProducerStreams(Output_t *output) {
+    for (size_t idx = 0; idx < output->producerStreamsArrLen; ++idx) {
+        (void)fclose(output->producerStreamsArr[idx].stream);
+    }
+    output->producerStreamsArrLen = 0;
+}
+
+// Streams are opened for appending, so once the table is full (pids keep changing) they can all be closed and reopened later
+static FILE *getProducerStream(Output_t *output, int pid) {
+    char  path[PRODUCER_PATH_MAX_LEN];
+    FILE *stream;
+
+    for (size_t idx = 0; idx < output->producerStreamsArrLen; ++idx) {
+        if (output->producerStreamsArr[idx].pid == pid) {
+            return output->producerStreamsArr[idx].stream;
+        }
+    }
+    if (output->producerStreamsArrLen == MDN_LOGGER_SHM_RING_MAX_PRODUCERS) {
+        closeProducerStreams(output);
+    }
+    if (snprintf(path, sizeof(path), "%s.%d", output->path, pid) >= (int)sizeof(path)) {
+        return NULL;
+    }
+    stream = fopen(path, "ab");
+    if (stream != NULL) {
+        output->producerStreamsArr[output->producerStreamsArrLen++] = (ProducerStream_t){.pid = pid, .stream = stream};
+    }
+
+    return stream;
+}
+
+static bool writeRecord(int pid, const char *data, size_t len, void *userData) {
+    Output_t *output = userData;
+    FILE     *stream = (output->stream != NULL) ? output->stream : getProducerStream(output, pid);
+
+    return (stream != NULL) && (fwrite(data, 1, len, stream) == len);
+}
+
+static void flushOutput(const Output_t *output) {
+    if (output->stream != NULL) {
+        (void)fflush(output->stream);
+    }
+    for (size_t idx = 0; idx < output->producerStreamsArrLen; ++idx) {
+        (void)fflush(output->producerStreamsArr[idx].stream);
+    }
+}
+
+static void writeStats(const mdn_Logger_ShmRingDrain_t *drain) {
+    static mdn_Logger_ShmRingStats_t stats;
+
+    if (mdn_Logger_getShmRingStats(drain, &stats) != MDN_STATUS_SUCCESS) {
+        return;
+    }
+    for (size_t idx = 0; idx < stats.producersArrLen; ++idx) {
+        (void)fprintf(stderr, "pid %d%s: %llu records, %llu overruns\n", stats.producersArr[idx].pid, stats.producersArr[idx].open ? "" : " (closed)",
+                      (unsigned long long)stats.producersArr[idx].recordsCount, (unsigned long long)stats.producersArr[idx].overrunsCount);
+    }
+    if (stats.skippedLen != 0) {
+        (void)fprintf(stderr, "%llu bytes skipped past records left unfinished\n", (unsigned long long)stats.skippedLen);
+    }
+}
+
+// Usage: mdn_logger_drain [-p] <ring name> <log file>
+// Appends the records of the shared memory ring of mdn_Logger_createShmRingSink() to the log file, as they are written,
+// or with -p to "<log file>.<pid>" for each producer. Stops on SIGINT or SIGTERM, once the ring is empty, and then writes
+// the counts of records and overruns of each producer to stderr.
+int main(int argc, char *argv[]) {
+    static Output_t            output;
+    mdn_Logger_ShmRingDrain_t *drain;
+    mdn_Status_t               status;
+    size_t                     recordsCount;
+    bool                       isStopping;
+    bool                       perProducer = (argc == 4) && (strcmp(argv[1], "-p") == 0);
+    int                        argIdx      = perProducer ? 2 : 1;
+
+    if ((argc - argIdx) != 2) {
+        (void)fprintf(stderr, "Usage: %s [-p] <ring name> <log file>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    output.path = argv[argIdx + 1];
+    if (!perProducer) {
+        output.stream = fopen(output.path, "ab");
+        if (output.stream == NULL) {
+            (void)fprintf(stderr, "Failed to open '%s'\n", output.path);
+            return EXIT_FAILURE;
+        }
+    }
+    status = mdn_Logger_openShmRingDrain(&drain, (mdn_Logger_ShmRingConfig_t){.name = argv[argIdx], .ringSize = 0});
+    if (status != MDN_STATUS_SUCCESS) {
+        (void)fprintf(stderr, "Failed to open ring '%s' (status %d)\n", argv[argIdx], (int)status);
+        if (output.stream != NULL) {
+            (void)fclose(output.stream);
+        }
+        return EXIT_FAILURE;
+    }
+    (void)signal(SIGINT, onStopSignal);
+    (void)signal(SIGTERM, onStopSignal);
+
+    // Keeps going until stopped, and then until a drain started since finds the ring empty
+    do {
+        isStopping = (g_stopRequested != 0);
+        (void)mdn_Logger_drainShmRing(drain, writeRecord, &output, &recordsCount);
+        if (recordsCount != 0) {
+            flushOutput(&output);
+        } else if (!isStopping) {
+            sleepIdle();
+        }
+    } while (!isStopping || (recordsCount != 0));
+
+    writeStats(drain);
+    mdn_Logger_closeShmRingDrain(drain);
+    closeProducerStreams(&output);
+    if (output.stream != NULL) {
+        (void)fclose(output.stream);
+    }
+
+    return EXIT_SUCCESS;
+}
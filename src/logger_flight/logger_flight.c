@@ -0,0 +1,61 @@
+#define MDN_LOGGER_SET_LEVEL_NONE
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mdn/logger.h"
+
+// Usage: mdn_logger_flight <flight recorder file> [<text log>]
+// Writes the records left in the file of a flight recorder (see mdn_Logger_addFlightRecorder()), oldest first,
+// as MDN_LOGGER_LOGGING_FORMAT_FILE text, on stdout by default.
+int main(int argc, char *argv[]) {
+    FILE        *flightRecorderStream;
+    FILE        *binaryStream;
+    FILE        *textStream = stdout;
+    mdn_Status_t status;
+
+    if ((argc != 2) && (argc != 3)) {
+        (void)fprintf(stderr, "Usage: %s <flight recorder file> [<text log>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    flightRecorderStream = fopen(argv[1], "rb");
+    if (flightRecorderStream == NULL) {
+        (void)fprintf(stderr, "Failed to open '%s'\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    binaryStream = tmpfile();
+    if (binaryStream == NULL) {
+        (void)fprintf(stderr, "Failed to create a temporary file\n");
+        (void)fclose(flightRecorderStream);
+        return EXIT_FAILURE;
+    }
+    if (argc == 3) {
+        textStream = fopen(argv[2], "wb");
+        if (textStream == NULL) {
+            (void)fprintf(stderr, "Failed to open '%s'\n", argv[2]);
+            (void)fclose(binaryStream);
+            (void)fclose(flightRecorderStream);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Extracted as a binary log first, which is then decoded like any other
+    status = mdn_Logger_extractFlightRecorder(flightRecorderStream, binaryStream);
+    if (status != MDN_STATUS_SUCCESS) {
+        (void)fprintf(stderr, "Failed to extract '%s' (status %d)\n", argv[1], (int)status);
+    } else {
+        rewind(binaryStream);
+        status = mdn_Logger_decodeBinary(binaryStream, textStream);
+        if (status != MDN_STATUS_SUCCESS) {
+            (void)fprintf(stderr, "Failed to decode the records of '%s' (status %d)\n", argv[1], (int)status);
+        }
+    }
+
+    (void)fclose(flightRecorderStream);
+    (void)fclose(binaryStream);
+    if (textStream != stdout) {
+        (void)fclose(textStream);
+    }
+
+    return (status == MDN_STATUS_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,730 @@
+// NO_LINT_BEGIN
+#define MDN_LOGGER_SET_LEVEL_DEBUG
+#include "mdn/logger.h"
+#include "mdn/logger.hpp"
+// NO_LINT_END
+
+#include <array>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if (defined __APPLE__) || (defined __linux__)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/socket.h>
+# include <sys/time.h>
+# include <sys/un.h>
+# include <unistd.h>
+#endif  // OS
+
+extern "C" {
+#include "fast_printf.h"
+#include "line_buffer.h"
+#include "lz_codec.h"
+#include "structured_format.h"
+#include "timestamp.h"
+}
+
+namespace {
+constexpr int maxBenchThreads = 8;
+
+const char *nullDevicePath() {
+#if (defined __APPLE__) || (defined __linux__)
+    return "/dev/null";
+#elif defined _WIN32
+    return "NUL";
+#endif  // OS
+}
+
+// Where "tmpfs" benchmarks write: a file in memory, so that records/s reflect the logger and the kernel's write path rather than the disk
+std::string tmpfsFilePath(const char *fileName) {
+#if defined __linux__
+    if (std::filesystem::is_directory("/dev/shm")) {
+        return std::string("/dev/shm/") + fileName;
+    }
+#endif  // OS
+    return (std::filesystem::temp_directory_path() / fileName).string();
+}
+
+// Log-linear histogram of per-call latencies in nanoseconds: values below 16 are exact, larger ones fall in one of 16
+// buckets per power of two, so within 1/16 of the exact value. Recording is an index computation and an increment.
+class LatencyHistogram {
+public:
+    void record(uint64_t latencyNs) {
+        ++buckets[bucketIndex(latencyNs)];
+        ++count;
+    }
+
+    // Middle of the bucket holding the 'fraction' quantile, 0 if nothing was recorded
+    [[nodiscard]] uint64_t percentile(double fraction) const {
+        const auto target     = static_cast<uint64_t>(fraction * static_cast<double>(count));
+        uint64_t   cumulative = 0;
+
+        for (size_t index = 0; index < buckets.size(); ++index) {
+            cumulative += buckets[index];
+            if ((cumulative > target) && (buckets[index] != 0)) {
+                return bucketLowerBound(index) + (bucketWidth(index) / 2);
+            }
+        }
+        return 0;
+    }
+
+    // Percentiles as counters, averaged over the benchmark's threads since each of them records its own calls
+    void report(benchmark::State &state) const {
+        state.counters["p50_ns"]  = benchmark::Counter(static_cast<double>(percentile(0.5)), benchmark::Counter::kAvgThreads);    // NOLINT(readability-magic-numbers)
+        state.counters["p99_ns"]  = benchmark::Counter(static_cast<double>(percentile(0.99)), benchmark::Counter::kAvgThreads);   // NOLINT(readability-magic-numbers)
+        state.counters["p999_ns"] = benchmark::Counter(static_cast<double>(percentile(0.999)), benchmark::Counter::kAvgThreads);  // NOLINT(readability-magic-numbers)
+    }
+
+private:
+    static constexpr unsigned subBucketBits  = 4;
+    static constexpr uint64_t subBucketCount = uint64_t{1} << subBucketBits;
+
+    static size_t bucketIndex(uint64_t value) {
+        if (value < subBucketCount) {
+            return static_cast<size_t>(value);
+        }
+        const auto magnitude = static_cast<unsigned>(std::bit_width(value)) - 1 - subBucketBits;
+        return static_cast<size_t>(((magnitude + 1) << subBucketBits) + ((value >> magnitude) & (subBucketCount - 1)));
+    }
+
+    static unsigned bucketMagnitude(size_t index) {
+        return (index < subBucketCount) ? 0 : static_cast<unsigned>((index >> subBucketBits) - 1);
+    }
+
+    static uint64_t bucketLowerBound(size_t index) {
+        if (index < subBucketCount) {
+            return index;
+        }
+        return (subBucketCount + (index & (subBucketCount - 1))) << bucketMagnitude(index);
+    }
+
+    static uint64_t bucketWidth(size_t index) {
+        return uint64_t{1} << bucketMagnitude(index);
+    }
+
+    std::array<uint64_t, (64 - subBucketBits + 1) * subBucketCount> buckets{};  // NOLINT(readability-magic-numbers)
+    uint64_t                                                         count = 0;
+};
+
+// Times a single call, clock reads included (a few tens of nanoseconds with a vDSO clock)
+template <typename Callable>
+void timeCall(LatencyHistogram &histogram, Callable &&callable) {
+    const auto start = std::chrono::steady_clock::now();
+    callable();
+    const auto end = std::chrono::steady_clock::now();
+    histogram.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+}
+
+#if (defined __APPLE__) || (defined __linux__)
+// The way timestamps were rendered before being cached: gettimeofday() + localtime() + strftime() + snprintf() per record
+void BM_TimestampLocaltimeStrftime(benchmark::State &state) {
+    constexpr int                                  usecToMsecDenom = 1000;
+    std::array<char, LOGGER_TIMESTAMP_MAX_LEN + 1> timestampBuf{};
+    struct timeval                                 timeValue{};
+
+    for (auto _ : state) {
+        (void)gettimeofday(&timeValue, nullptr);
+        const struct tm *tmInfo = localtime(&timeValue.tv_sec);  // NOLINT(concurrency-mt-unsafe)
+        (void)strftime(timestampBuf.data(), timestampBuf.size(), "%Y-%m-%d %H:%M:%S", tmInfo);
+        (void)snprintf(timestampBuf.data() + LOGGER_TIMESTAMP_DATE_TIME_LEN, timestampBuf.size() - LOGGER_TIMESTAMP_DATE_TIME_LEN, ".%03d", static_cast<int>(timeValue.tv_usec / usecToMsecDenom));  // NOLINT(hicpp-vararg)
+        benchmark::DoNotOptimize(timestampBuf.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TimestampLocaltimeStrftime);
+#endif  // OS
+
+void BM_TimestampCached(benchmark::State &state) {
+    const auto                                     timestampPrecision = static_cast<mdn_Logger_timestampPrecision_t>(state.range(0));
+    const bool                                     useCoarseClock     = mdn_Logger_Timestamp_isCoarseClockEnough(timestampPrecision);
+    std::array<char, LOGGER_TIMESTAMP_MAX_LEN + 1> timestampBuf{};
+    Logger_Timestamp_t                             timestamp{};
+
+    for (auto _ : state) {
+        mdn_Logger_Timestamp_get(&timestamp, useCoarseClock);
+        benchmark::DoNotOptimize(mdn_Logger_Timestamp_format(&timestamp, timestampPrecision, timestampBuf.data()));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TimestampCached)
+    ->ArgName("precision")
+    ->Arg(MDN_LOGGER_TIMESTAMP_PRECISION_MSEC)
+    ->Arg(MDN_LOGGER_TIMESTAMP_PRECISION_USEC)
+    ->Arg(MDN_LOGGER_TIMESTAMP_PRECISION_NSEC);
+
+// Debug records while no stream wants them: a single branch in the macro, the arguments aren't evaluated
+void BM_LogDisabledLevel(benchmark::State &state) {
+    (void)mdn_Logger_init();
+    (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stdout, MDN_LOGGER_LOGGING_LEVEL_ERROR, MDN_LOGGER_LOGGING_FORMAT_SCREEN});
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_DEBUG("Disabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+        benchmark::ClobberMemory();
+    }
+
+    (void)mdn_Logger_deinit();
+}
+BENCHMARK(BM_LogDisabledLevel);
+
+// A flooding call site once its rate limit is exhausted: a clock read and a shared counter increment per dropped record
+void BM_LogRateLimitedSuppressed(benchmark::State &state) {
+    constexpr unsigned ratePerSec = 1;
+    constexpr unsigned burst      = 1;
+    static FILE       *stream;
+
+    if (state.thread_index() == 0) {
+        stream = fopen("/dev/null", "w");
+        (void)mdn_Logger_init();
+        (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stream, MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE});
+    }
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_WARNING_RATE_LIMITED(ratePerSec, burst, "Flooding record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+    }
+
+    if (state.thread_index() == 0) {
+        (void)mdn_Logger_deinit();
+        (void)fclose(stream);
+    }
+}
+BENCHMARK(BM_LogRateLimitedSuppressed)->ThreadRange(1, 4);
+
+// Enabled records written to a file through stdio
+void BM_LogToFileStream(benchmark::State &state) {
+    const char  *path = "logger_bench_stream.log";
+    static FILE *stream;
+
+    // The loop starts and ends with all threads in sync, so the first thread alone sets the logger up and tears it down
+    if (state.thread_index() == 0) {
+        stream = fopen(path, "w");
+        (void)mdn_Logger_init();
+        (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stream, MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE});
+    }
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_INFO("Enabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+    }
+
+    if (state.thread_index() == 0) {
+        (void)mdn_Logger_deinit();
+        (void)fclose(stream);
+        state.SetBytesProcessed(static_cast<int64_t>(std::filesystem::file_size(path)));
+        (void)std::remove(path);
+    }
+}
+BENCHMARK(BM_LogToFileStream)->ThreadRange(1, 4);
+
+// Each format written to the null device, so that rendering isn't hidden behind the disk. The second argument picks
+// messages that need escaping in JSON and logfmt.
+void BM_LogFormat(benchmark::State &state) {
+    const auto  loggingFormat = static_cast<mdn_Logger_loggingFormat_t>(state.range(0));
+    const char *user          = (state.range(1) != 0) ? "\"guest\"\tfrom C:\\Users" : "guest from home directory";
+    FILE       *stream        = fopen(nullDevicePath(), "w");
+
+    (void)mdn_Logger_init();
+    (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stream, MDN_LOGGER_LOGGING_LEVEL_DEBUG, loggingFormat});
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_INFO("Request %lld served for user %s in %d us", static_cast<long long>(state.iterations()), user, 42);  // NOLINT(hicpp-vararg,readability-magic-numbers)
+    }
+
+    (void)mdn_Logger_deinit();
+    (void)fclose(stream);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogFormat)
+    ->ArgNames({"format", "escaped"})
+    ->ArgsProduct({{MDN_LOGGER_LOGGING_FORMAT_FILE, MDN_LOGGER_LOGGING_FORMAT_JSON, MDN_LOGGER_LOGGING_FORMAT_LOGFMT}, {0, 1}});
+
+// The same record through the varargs macros (first argument 0) and the C++ front end (1), written to the null device
+void BM_LogFrontEnd(benchmark::State &state) {
+    const std::string path      = "/api/v1/users";
+    const double      elapsedMs = 12.345;
+    FILE             *stream    = fopen(nullDevicePath(), "w");
+
+    (void)mdn_Logger_init();
+    (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stream, MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE});
+
+    if (state.range(0) == 0) {
+        for (auto _ : state) {
+            MDN_LOGGER_LOG_INFO("Request %lld served %s in %.3f ms with status %d", static_cast<long long>(state.iterations()), path.c_str(), elapsedMs, 200);  // NOLINT(hicpp-vararg,readability-magic-numbers)
+        }
+    } else {
+        for (auto _ : state) {
+            mdn::log::info("Request {} served {} in {:.3f} ms with status {}", state.iterations(), path, elapsedMs, 200);  // NOLINT(readability-magic-numbers)
+        }
+    }
+
+    (void)mdn_Logger_deinit();
+    (void)fclose(stream);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogFrontEnd)->ArgName("cpp")->Arg(0)->Arg(1);
+
+// The escaping alone, on a long message that is clean or has a quote every 64 bytes (argument)
+void BM_StructuredEscape(benchmark::State &state) {
+    constexpr size_t    messageLen = 4096;
+    std::string         message(messageLen, 'x');
+    std::vector<char>   storage(messageLen * 2);
+    Logger_LineBuffer_t lineBuffer;
+
+    for (size_t idx = 0; (state.range(0) != 0) && (idx < messageLen); idx += 64) {  // NOLINT(readability-magic-numbers)
+        message[idx] = '"';
+    }
+
+    for (auto _ : state) {
+        mdn_Logger_LineBuffer_init(&lineBuffer, storage.data(), storage.size());
+        mdn_Logger_StructuredFormat_appendEscaped(&lineBuffer, message.data(), message.size());
+        benchmark::DoNotOptimize(lineBuffer.data);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * messageLen));
+}
+BENCHMARK(BM_StructuredEscape)->Arg(0)->Arg(1);
+
+// Per-call latency percentiles of each format, written to the null device from 1 to 'maxBenchThreads' threads
+void BM_LogLatency(benchmark::State &state) {
+    const auto       loggingFormat = static_cast<mdn_Logger_loggingFormat_t>(state.range(0));
+    static FILE     *stream;
+    LatencyHistogram histogram;
+
+    if (state.thread_index() == 0) {
+        stream = fopen(nullDevicePath(), (loggingFormat == MDN_LOGGER_LOGGING_FORMAT_BINARY) ? "wb" : "w");
+        (void)mdn_Logger_init();
+        (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stream, MDN_LOGGER_LOGGING_LEVEL_DEBUG, loggingFormat});
+    }
+
+    for (auto _ : state) {
+        timeCall(histogram, [&state]() {
+            MDN_LOGGER_LOG_INFO("Request %lld served for user %s in %d us", static_cast<long long>(state.iterations()), "guest", 42);  // NOLINT(hicpp-vararg,readability-magic-numbers)
+        });
+    }
+
+    histogram.report(state);
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        (void)mdn_Logger_deinit();
+        (void)fclose(stream);
+    }
+}
+BENCHMARK(BM_LogLatency)
+    ->ArgName("format")
+    ->DenseRange(0, MDN_LOGGER_LOGGING_FORMAT_COUNT - 1)
+    ->ThreadRange(1, maxBenchThreads)
+    ->UseRealTime();
+
+// Latency of a disabled level, to compare with the enabled ones above (mostly the clock reads themselves)
+void BM_LogDisabledLevelLatency(benchmark::State &state) {
+    LatencyHistogram histogram;
+
+    (void)mdn_Logger_init();
+    (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stdout, MDN_LOGGER_LOGGING_LEVEL_ERROR, MDN_LOGGER_LOGGING_FORMAT_SCREEN});
+
+    for (auto _ : state) {
+        timeCall(histogram, [&state]() {
+            MDN_LOGGER_LOG_DEBUG("Disabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+        });
+    }
+
+    histogram.report(state);
+    (void)mdn_Logger_deinit();
+}
+BENCHMARK(BM_LogDisabledLevelLatency);
+
+// Records/s to the null device (destination 0) and to a file on tmpfs (1), from 1 to 'maxBenchThreads' threads
+void BM_LogThroughput(benchmark::State &state) {
+    const std::string path = (state.range(0) == 0) ? nullDevicePath() : tmpfsFilePath("logger_bench_throughput.log");
+    static FILE      *stream;
+
+    if (state.thread_index() == 0) {
+        stream = fopen(path.c_str(), "w");
+        (void)mdn_Logger_init();
+        (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stream, MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE});
+    }
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_INFO("Enabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        (void)mdn_Logger_deinit();
+        (void)fclose(stream);
+        if (state.range(0) != 0) {
+            (void)std::remove(path.c_str());
+        }
+    }
+}
+BENCHMARK(BM_LogThroughput)
+    ->ArgName("destination")
+    ->DenseRange(0, 1)
+    ->ThreadRange(1, maxBenchThreads)
+    ->UseRealTime();
+
+// One record fanned out to several streams on the null device, all FILE format (formats 1), which share a single rendering,
+// or alternating FILE and JSON (formats 2), rendered once each
+void BM_LogFanOut(benchmark::State &state) {
+    const mdn_Logger_loggingFormat_t loggingFormats[] = {MDN_LOGGER_LOGGING_FORMAT_FILE, MDN_LOGGER_LOGGING_FORMAT_JSON};
+    std::vector<FILE *>              streams;
+    LatencyHistogram                 histogram;
+
+    (void)mdn_Logger_init();
+    for (int64_t streamIdx = 0; streamIdx < state.range(0); ++streamIdx) {
+        streams.push_back(fopen(nullDevicePath(), "w"));
+        (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{streams.back(), MDN_LOGGER_LOGGING_LEVEL_DEBUG, loggingFormats[streamIdx % state.range(1)]});
+    }
+
+    for (auto _ : state) {
+        timeCall(histogram, [&state]() {
+            MDN_LOGGER_LOG_INFO("Request %lld served for user %s in %d us", static_cast<long long>(state.iterations()), "guest", 42);  // NOLINT(hicpp-vararg,readability-magic-numbers)
+        });
+    }
+
+    histogram.report(state);
+    state.SetItemsProcessed(state.iterations());
+    (void)mdn_Logger_deinit();
+    for (FILE *stream : streams) {
+        (void)fclose(stream);
+    }
+}
+BENCHMARK(BM_LogFanOut)->ArgNames({"streams", "formats"})->ArgsProduct({{1, 2, 4, 8}, {1, 2}});  // NOLINT(readability-magic-numbers)
+
+// A typical message formatted with vsnprintf() (argument 0) and with the in-house formatter (1)
+void BM_FormatMessage(benchmark::State &state) {
+    std::array<char, 512> storage;  // NOLINT(readability-magic-numbers)
+    Logger_LineBuffer_t   lineBuffer;
+    const auto            appendFormat = (state.range(0) == 0) ? mdn_Logger_LineBuffer_appendFormat : mdn_Logger_FastPrintf_appendFormat;
+    const char           *path         = "/api/v1/users";
+    const double          elapsedMs    = 12.345;
+
+    for (auto _ : state) {
+        mdn_Logger_LineBuffer_init(&lineBuffer, storage.data(), storage.size());
+        appendFormat(&lineBuffer, "Request %lld served %s in %.3f ms with status %d, %zu bytes, id %08x",  // NOLINT(hicpp-vararg)
+                     static_cast<long long>(state.iterations()), path, elapsedMs, 200, static_cast<size_t>(4096), 0xC0FFEEU);  // NOLINT(readability-magic-numbers)
+        benchmark::DoNotOptimize(lineBuffer.data);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormatMessage)->ArgName("fast")->Arg(0)->Arg(1);
+
+// The same records compressed in blocks. Bytes per second are counted before compression, to compare with the plain file.
+void BM_LogToCompressedFileStream(benchmark::State &state) {
+    const char  *path             = "logger_bench_compressed.log";
+    const char  *decompressedPath = "logger_bench_decompressed.log";
+    static FILE *stream;
+
+    if (state.thread_index() == 0) {
+        stream = fopen(path, "wb");
+        (void)mdn_Logger_init();
+        (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stream, MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE, true});
+    }
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_INFO("Enabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+    }
+
+    if (state.thread_index() == 0) {
+        (void)mdn_Logger_deinit();
+        (void)fclose(stream);
+        stream = fopen(path, "rb");
+        FILE *decompressedStream = fopen(decompressedPath, "wb");
+        (void)mdn_Logger_decompress(stream, decompressedStream);
+        (void)fclose(decompressedStream);
+        (void)fclose(stream);
+        const auto compressedSize   = std::filesystem::file_size(path);
+        const auto decompressedSize = std::filesystem::file_size(decompressedPath);
+        state.SetBytesProcessed(static_cast<int64_t>(decompressedSize));
+        state.counters["ratio"] = static_cast<double>(decompressedSize) / static_cast<double>(compressedSize);
+        (void)std::remove(path);
+        (void)std::remove(decompressedPath);
+    }
+}
+BENCHMARK(BM_LogToCompressedFileStream)->ThreadRange(1, 4);
+
+// The codec alone, on a block of FILE format lines
+void BM_LzCompressBlock(benchmark::State &state) {
+    constexpr size_t     blockSize = 64 * 1024;
+    std::string          block;
+    std::vector<uint8_t> compressed(LOGGER_LZ_COMPRESS_BOUND(blockSize));
+    size_t               compressedLen = 0;
+
+    for (size_t lineIdx = 0; block.size() < blockSize; ++lineIdx) {
+        block += "2026-01-01 12:00:00." + std::to_string(100 + (lineIdx % 900)) + " INFO     handleRequest        | Request " + std::to_string(lineIdx * 7919) + " served\n";
+    }
+    block.resize(blockSize);
+
+    for (auto _ : state) {
+        compressedLen = mdn_Logger_Lz_compress(reinterpret_cast<const uint8_t *>(block.data()), block.size(), compressed.data());  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        benchmark::DoNotOptimize(compressed.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * blockSize));
+    state.counters["ratio"] = static_cast<double>(blockSize) / static_cast<double>(compressedLen);
+}
+BENCHMARK(BM_LzCompressBlock);
+
+#if (defined __APPLE__) || (defined __linux__)
+// The same records copied into a memory-mapped, preallocated file
+void BM_LogToMmapFile(benchmark::State &state) {
+    const char *path = "logger_bench_mmap.log";
+
+    if (state.thread_index() == 0) {
+        (void)mdn_Logger_init();
+        (void)mdn_Logger_addMmapFile(mdn_Logger_MmapFileConfig_t{path, MDN_LOGGER_LOGGING_LEVEL_DEBUG, 0});
+    }
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_INFO("Enabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+    }
+
+    if (state.thread_index() == 0) {
+        (void)mdn_Logger_deinit();
+        (void)std::remove(path);
+    }
+}
+BENCHMARK(BM_LogToMmapFile)->ThreadRange(1, 4);
+
+// Write syscalls the process made so far, 0 where the kernel doesn't tell
+uint64_t writeSyscallsCount() {
+    std::ifstream file("/proc/self/io");
+    std::string   key;
+    uint64_t      value = 0;
+
+    while (file >> key >> value) {
+        if (key == "syscw:") {
+            return value;
+        }
+    }
+    return 0;
+}
+
+// An unbuffered FILE, the way stderr is, against a batched fd. "syscallsPerRecord" shows how many writes each record cost.
+void BM_LogBatchedFd(benchmark::State &state) {
+    const std::string path    = tmpfsFilePath("logger_bench_fd.log");
+    const bool        batched = (state.range(0) != 0);
+    FILE             *stream  = fopen(path.c_str(), "w");
+    uint64_t          startWritesCount;
+
+    (void)mdn_Logger_init();
+    if (batched) {
+        (void)mdn_Logger_addFd(mdn_Logger_FdConfig_t{fileno(stream), MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE, 0, 0, 0});
+    } else {
+        (void)setvbuf(stream, nullptr, _IONBF, 0);
+        (void)mdn_Logger_addOutputStream(mdn_Logger_StreamConfig_t{stream, MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE});
+    }
+    startWritesCount = writeSyscallsCount();
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_INFO("Enabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+    }
+
+    (void)mdn_Logger_deinit();
+    state.counters["syscallsPerRecord"] = benchmark::Counter(static_cast<double>(writeSyscallsCount() - startWritesCount) / static_cast<double>(state.iterations()));
+    state.SetItemsProcessed(state.iterations());
+    (void)fclose(stream);
+    (void)std::remove(path.c_str());
+}
+BENCHMARK(BM_LogBatchedFd)->ArgName("batched")->Arg(0)->Arg(1);
+
+// Per-call latency of a batched fd on disk, with writev() against io_uring. Batches are small so that the calls that flush
+// show in the tail percentiles: with writev() they wait for the write, with io_uring only for its submission.
+void BM_LogIoUringFd(benchmark::State &state) {
+    const std::string path    = (std::filesystem::temp_directory_path() / "logger_bench_io_uring.log").string();
+    const bool        ioUring = (state.range(0) != 0);
+    FILE             *stream  = fopen(path.c_str(), "w");
+    LatencyHistogram  histogram;
+
+    (void)mdn_Logger_init();
+    (void)mdn_Logger_addFd(mdn_Logger_FdConfig_t{fileno(stream), MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE, 4096, 0, 0, ioUring});  // NOLINT(readability-magic-numbers)
+
+    for (auto _ : state) {
+        timeCall(histogram, [&state]() {
+            MDN_LOGGER_LOG_INFO("Enabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+        });
+    }
+
+    (void)mdn_Logger_deinit();
+    histogram.report(state);
+    state.SetItemsProcessed(state.iterations());
+    (void)fclose(stream);
+    (void)std::remove(path.c_str());
+}
+BENCHMARK(BM_LogIoUringFd)->ArgName("ioUring")->Arg(0)->Arg(1);
+
+// Async logging to an unbuffered FILE against a raw fd sink, which takes the records the writer thread dequeued in a row with
+// a single writev(). The full queue blocks, so logging goes at the pace of the writer thread. "syscallsPerRecord" shows how many
+// writes each record cost.
+void BM_LogAsyncRawFdSink(benchmark::State &state) {
+    const std::string        path        = tmpfsFilePath("logger_bench_raw_fd.log");
+    const bool               rawFd       = (state.range(0) != 0);
+    FILE                    *stream      = fopen(path.c_str(), "w");
+    mdn_Logger_AsyncConfig_t asyncConfig = {.queueCapacity = 4096, .maxMessageLen = 256, .fullPolicy = MDN_LOGGER_ASYNC_FULL_POLICY_BLOCK};  // NOLINT(readability-magic-numbers)
+    mdn_Logger_Sink_t        sink;
+    uint64_t                 startWritesCount;
+
+    (void)mdn_Logger_initAsync(asyncConfig);
+    if (rawFd) {
+        (void)mdn_Logger_createRawFdSink(&sink, fileno(stream));
+    } else {
+        (void)setvbuf(stream, nullptr, _IONBF, 0);
+        sink = mdn_Logger_fileSink(stream);
+    }
+    (void)mdn_Logger_addSink(mdn_Logger_SinkConfig_t{sink, MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE});
+    startWritesCount = writeSyscallsCount();
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_INFO("Enabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+    }
+    (void)mdn_Logger_deinit();
+
+    state.counters["syscallsPerRecord"] = benchmark::Counter(static_cast<double>(writeSyscallsCount() - startWritesCount) / static_cast<double>(state.iterations()));
+    state.SetItemsProcessed(state.iterations());
+    (void)fclose(stream);
+    (void)std::remove(path.c_str());
+}
+BENCHMARK(BM_LogAsyncRawFdSink)->ArgName("rawFd")->Arg(0)->Arg(1)->UseRealTime();
+
+// Async logging to a local collector, through a pipe written by an unbuffered FILE, against a Unix datagram socket sink that
+// packs the records of each batch into datagrams. "messagesPerRecord" counts the pipe's write() calls, or the datagrams received.
+void BM_LogToCollector(benchmark::State &state) {
+    const std::string        path        = (std::filesystem::temp_directory_path() / "logger_bench_collector.sock").string();
+    const bool               unixSocket  = (state.range(0) != 0);
+    mdn_Logger_AsyncConfig_t asyncConfig = {.queueCapacity = 4096, .maxMessageLen = 256, .fullPolicy = MDN_LOGGER_ASYNC_FULL_POLICY_BLOCK};  // NOLINT(readability-magic-numbers)
+    std::array<int, 2>       pipeFds     = {-1, -1};
+    int                      collectorFd = -1;
+    FILE                    *stream      = nullptr;
+    std::atomic_bool         stopRequested(false);
+    uint64_t                 datagramsCount = 0;
+    uint64_t                 startWritesCount;
+    mdn_Logger_Sink_t        sink;
+    sockaddr_un              address{};
+    timeval                  timeout = {.tv_sec = 0, .tv_usec = 10000};  // NOLINT(readability-magic-numbers)
+
+    if (unixSocket) {
+        address.sun_family = AF_UNIX;
+        path.copy(static_cast<char *>(address.sun_path), sizeof(address.sun_path) - 1);
+        (void)unlink(path.c_str());
+        collectorFd = socket(AF_UNIX, SOCK_DGRAM, 0);
+        (void)bind(collectorFd, reinterpret_cast<const sockaddr *>(&address), sizeof(address));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        (void)setsockopt(collectorFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    } else {
+        (void)pipe(pipeFds.data());
+        collectorFd = pipeFds[0];
+        stream      = fdopen(pipeFds[1], "w");
+        (void)setvbuf(stream, nullptr, _IONBF, 0);
+    }
+    std::thread collector([collectorFd, unixSocket, &stopRequested, &datagramsCount]() {
+        std::vector<char> buffer(64 * 1024);  // NOLINT(readability-magic-numbers)
+        ssize_t           len;
+
+        while (((len = read(collectorFd, buffer.data(), buffer.size())) > 0) || (unixSocket && !stopRequested.load())) {
+            datagramsCount += (len > 0) ? 1 : 0;
+        }
+    });
+
+    (void)mdn_Logger_initAsync(asyncConfig);
+    if (unixSocket) {
+        (void)mdn_Logger_createUnixSocketSink(&sink, mdn_Logger_UnixSocketConfig_t{path.c_str(), false, 0, 0});
+    } else {
+        sink = mdn_Logger_fileSink(stream);
+    }
+    (void)mdn_Logger_addSink(mdn_Logger_SinkConfig_t{sink, MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE});
+    startWritesCount = writeSyscallsCount();
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_INFO("Enabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+    }
+    (void)mdn_Logger_deinit();
+
+    if (!unixSocket) {
+        state.counters["messagesPerRecord"] = benchmark::Counter(static_cast<double>(writeSyscallsCount() - startWritesCount) / static_cast<double>(state.iterations()));
+        (void)fclose(stream);
+    }
+    stopRequested.store(true);
+    collector.join();
+    if (unixSocket) {
+        state.counters["messagesPerRecord"] = benchmark::Counter(static_cast<double>(datagramsCount) / static_cast<double>(state.iterations()));
+        (void)unlink(path.c_str());
+    }
+    (void)close(collectorFd);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogToCollector)->ArgName("unixSocket")->Arg(0)->Arg(1)->UseRealTime();
+
+// A worker process logging synchronously to the log file it shares with others, with a write() per record to an O_APPEND fd,
+// against the shared memory ring, which a drain thread empties into the same kind of file. "overrunsPerRecord" counts the
+// records the ring dropped because the drain fell behind.
+void BM_LogShmRingSink(benchmark::State &state) {
+    const std::string                path    = tmpfsFilePath("logger_bench_shm_ring.log");
+    const std::string                name    = "/mdn_logger_bench";
+    const bool                       shmRing = (state.range(0) != 0);
+    const mdn_Logger_ShmRingConfig_t config  = {.name = name.c_str(), .ringSize = 0};
+    const int                        fd      = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);  // NOLINT(hicpp-vararg, readability-magic-numbers)
+    FILE                            *stream  = fdopen(fd, "w");
+    mdn_Logger_ShmRingDrain_t       *drain   = nullptr;
+    mdn_Logger_ShmRingStats_t        stats{};
+    std::atomic_bool                 stopRequested(false);
+    std::thread                      drainer;
+    mdn_Logger_Sink_t                sink;
+
+    const auto writeRecord = [](int pid, const char *data, size_t len, void *userData) {
+        (void)pid;
+        return fwrite(data, 1, len, static_cast<FILE *>(userData)) == len;
+    };
+
+    (void)shm_unlink(name.c_str());
+    (void)mdn_Logger_init();
+    if (shmRing) {
+        (void)mdn_Logger_openShmRingDrain(&drain, config);
+        (void)mdn_Logger_createShmRingSink(&sink, config);
+        drainer = std::thread([drain, stream, &stopRequested, writeRecord]() {
+            size_t recordsCount;
+
+            while (!stopRequested.load()) {
+                (void)mdn_Logger_drainShmRing(drain, writeRecord, stream, &recordsCount);
+                if (recordsCount == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            (void)mdn_Logger_drainShmRing(drain, writeRecord, stream, nullptr);
+        });
+    } else {
+        (void)mdn_Logger_createRawFdSink(&sink, fd);
+    }
+    (void)mdn_Logger_addSink(mdn_Logger_SinkConfig_t{sink, MDN_LOGGER_LOGGING_LEVEL_DEBUG, MDN_LOGGER_LOGGING_FORMAT_FILE});
+
+    for (auto _ : state) {
+        MDN_LOGGER_LOG_INFO("Enabled record %lld", static_cast<long long>(state.iterations()));  // NOLINT(hicpp-vararg)
+    }
+
+    if (shmRing) {
+        stopRequested.store(true);
+        drainer.join();
+        (void)mdn_Logger_getShmRingStats(drain, &stats);
+        mdn_Logger_closeShmRingDrain(drain);
+        (void)shm_unlink(name.c_str());
+    }
+    (void)mdn_Logger_deinit();
+
+    state.counters["overrunsPerRecord"] = benchmark::Counter((stats.producersArrLen == 0) ? 0.0 : static_cast<double>(stats.producersArr[0].overrunsCount) / static_cast<double>(state.iterations()));
+    state.SetItemsProcessed(state.iterations());
+    (void)fclose(stream);
+    (void)std::remove(path.c_str());
+}
+BENCHMARK(BM_LogShmRingSink)->ArgName("shmRing")->Arg(0)->Arg(1)->UseRealTime();
+#endif  // OS
+}  // namespace
+
+BENCHMARK_MAIN();
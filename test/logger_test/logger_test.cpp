@@ -1,20 +1,29 @@
 // NO_LINT_BEGIN
 #define MDN_LOGGER_SET_LEVEL_DEBUG
 #include "mdn/logger.h"  // Has to be included before "mock_wrapper.h"
+#include "mdn/logger.hpp"
 // NO_LINT_END
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <charconv>
 #include <chrono>
 #include <climits>
+#include <cmath>
 #include <cstdio>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <gmock/gmock.h>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <optional>
+#include <random>
 #include <regex>
+#include <sstream>
+#include <thread>
 
 #if defined __linux__
 #elif defined __APPLE__
@@ -22,6 +31,14 @@
 #elif defined _WIN32
 #endif  // OS
 
+#if (defined __APPLE__) || (defined __linux__)
+# include <sys/mman.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+# include <sys/wait.h>
+# include <unistd.h>
+#endif  // OS
+
 #include "mdn/gtest_extension.hpp"
 #include "mdn/mock_wrapper.hpp"
 #include "mdn/standard_streams_redirection.h"
@@ -45,6 +62,12 @@ void safeLocalTime(std::time_t time, struct tm &result) {
     }
 #endif
 }
+
+// Defined before MDN_LOGGER_FUNC_NAME is overridden below, so its call site carries the __func__ it returns
+const char *logFromNamedFunction() {
+    MDN_LOGGER_LOG_INFO("Logged from a named function");  // NOLINT(hicpp-vararg)
+    return __func__;
+}
 }  // namespace
 
 #undef MDN_LOGGER_FUNC_NAME
@@ -144,7 +167,9 @@ private:
 
 class LoggerTest : public mdn::GTestExtension {
 protected:
-    static inline mdn_Logger_StreamConfig_t streamConfigDefault;
+    static inline mdn_Logger_StreamConfig_t    streamConfigDefault;
+    static inline mdn_Logger_AsyncConfig_t     asyncConfigDefault;
+    static inline mdn_Logger_BacktraceConfig_t backtraceConfigDefault;
 
     static inline std::regex regexFormatForFile;
     static inline std::regex regexFormatForScreen;
@@ -279,7 +304,7 @@ protected:
             outputFileRef.path       += "_";
             outputFileRef.path       += outputFileRef.suffix;
             outputFileRef.path       += ".log";
-            outputFileRef.fileToRead  = fopen(outputFileRef.path.c_str(), "w");
+            outputFileRef.fileToRead  = fopen(outputFileRef.path.c_str(), ((outputFileRef.streamConfig.loggingFormat == MDN_LOGGER_LOGGING_FORMAT_BINARY) || outputFileRef.streamConfig.compressed) ? "wb" : "w");
             ASSERT_NE(outputFileRef.fileToRead, nullptr)
                 << "Failed to open file for writing: " << outputFileRef.path << "\n";
             if (outputFileRef.streamConfig.stream == nullptr) {
@@ -290,7 +315,11 @@ protected:
 
     void closeTestOutputFiles(const std::vector<OutputFiles> &outputFiles) {
         for (const auto outputFile : outputFiles) {
-            const auto &outputFileRef = outputFilesInfo[static_cast<std::size_t>(outputFile)];
+            auto &outputFileRef = outputFilesInfo[static_cast<std::size_t>(outputFile)];
+            // Lets openTestOutputFiles() hand the logger a fresh stream when a test opens the files again
+            if (outputFileRef.streamConfig.stream == outputFileRef.fileToRead) {
+                outputFileRef.streamConfig.stream = nullptr;
+            }
             if (fclose(outputFileRef.fileToRead) != 0) {
                 FAIL() << "Failed to close file: " << outputFileRef.path;
             }
@@ -408,6 +437,358 @@ protected:
                                                                   << actualLogLine;
     }
 
+    [[nodiscard]]
+    size_t countLogLines(OutputFiles outputFile) const {
+        const auto &outputFileRef    = outputFilesInfo[static_cast<std::size_t>(outputFile)];
+        auto        binaryFileReader = BinaryFileReader(outputFileRef.path);
+        std::string actualLogLine;
+        size_t      linesCount = 0;
+
+        while (binaryFileReader.getLine(actualLogLine)) {
+            ++linesCount;
+        }
+        return linesCount;
+    }
+
+    // Lines of different threads may appear out of timestamp order, so only their structure is verified
+    void verifyLogLinesFormat(OutputFiles outputFile, size_t expectedLinesCount) {
+        const auto &outputFileRef    = outputFilesInfo[static_cast<std::size_t>(outputFile)];
+        auto        binaryFileReader = BinaryFileReader(outputFileRef.path);
+        const auto &format           = loggingFormatToRegexMap[outputFileRef.streamConfig.loggingFormat];
+        std::string actualLogLine;
+        size_t      linesCount = 0;
+
+        ASSERT_NO_FATAL_FAILURE(binaryFileReader.verifyOpen());
+        while (binaryFileReader.getLine(actualLogLine)) {
+            ASSERT_EQ(std::regex_match(actualLogLine, format), true) << "Line format isn't valid:\n"
+                                                                     << actualLogLine;
+            ++linesCount;
+        }
+        ASSERT_EQ(linesCount, expectedLinesCount);
+    }
+
+    void logFromThreads(size_t threadsCount, size_t linesPerThread) {
+        std::vector<std::thread> threads;
+
+        threads.reserve(threadsCount);
+        for (size_t threadIdx = 0; threadIdx < threadsCount; ++threadIdx) {
+            threads.emplace_back([this, threadIdx, linesPerThread]() {
+                for (size_t lineIdx = 0; lineIdx < linesPerThread; ++lineIdx) {
+                    MDN_LOGGER_LOG_INFO("Thread %zu line %zu", threadIdx, lineIdx);  // NOLINT(hicpp-vararg)
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    static std::string readFileContent(const std::string &path) {
+        std::ifstream      file(path, std::ios::in | std::ios::binary);  // NOLINT(hicpp-signed-bitwise)
+        std::ostringstream content;
+
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Reference for what the JSON and logfmt formats write between the quotes of a string
+    static std::string jsonEscape(const std::string &str) {
+        static constexpr const char *hexDigits = "0123456789abcdef";
+        std::string                  escaped;
+
+        for (const char chr : str) {
+            const auto byte = static_cast<unsigned char>(chr);
+            switch (chr) {
+                case '"':
+                    escaped += "\\\"";
+                    break;
+                case '\\':
+                    escaped += "\\\\";
+                    break;
+                case '\b':
+                    escaped += "\\b";
+                    break;
+                case '\f':
+                    escaped += "\\f";
+                    break;
+                case '\n':
+                    escaped += "\\n";
+                    break;
+                case '\r':
+                    escaped += "\\r";
+                    break;
+                case '\t':
+                    escaped += "\\t";
+                    break;
+                default:
+                    if (byte < 0x20) {  // NOLINT(readability-magic-numbers)
+                        escaped += "\\u00";
+                        escaped += hexDigits[byte >> 4];    // NOLINT(readability-magic-numbers)
+                        escaped += hexDigits[byte & 0xFU];  // NOLINT(readability-magic-numbers)
+                    } else {
+                        escaped += chr;
+                    }
+                    break;
+            }
+        }
+        return escaped;
+    }
+
+    // Logs 'format' with 'args', and returns what snprintf() makes of them
+    template <typename... Args>
+    static std::string logAndSnprintf(const std::string &format, Args... args) {
+        std::array<char, 256> expected{};  // NOLINT(readability-magic-numbers)
+
+        mdn_Logger_log(MDN_LOGGER_LOGGING_LEVEL_INFO, __FILE__, __LINE__, __func__, format.c_str(), args...);  // NOLINT(hicpp-vararg)
+        (void)snprintf(expected.data(), expected.size(), format.c_str(), args...);  // NOLINT(hicpp-vararg,clang-diagnostic-format-nonliteral)
+        return expected.data();
+    }
+
+    // Wraps 'conversion' (length modifier and conversion character) with random flags, width and precision, either literal or
+    // passed as '*' arguments (negative ones included), then logs it with 'value'
+    template <typename T>
+    static std::string logRandomConversion(std::mt19937_64 &generator, const std::string &conversion, T value) {
+        std::uniform_int_distribution<int> modeDistribution(0, 2);
+        std::uniform_int_distribution<int> flagDistribution(0, 3);
+        std::uniform_int_distribution<int> widthDistribution(-25, 25);    // NOLINT(readability-magic-numbers)
+        std::uniform_int_distribution<int> precisionDistribution(-1, 20);  // NOLINT(readability-magic-numbers)
+        const int                          widthMode      = modeDistribution(generator);
+        const int                          precisionMode  = modeDistribution(generator);
+        const int                          width          = widthDistribution(generator);
+        const int                          precision      = precisionDistribution(generator);
+        std::string                        format         = "[%";
+
+        for (const char flag : std::string("-0+ ")) {
+            if (flagDistribution(generator) == 0) {
+                format += flag;
+            }
+        }
+        // '#' only where its meaning is defined
+        if ((conversion.find_first_of("xXofFeg") != std::string::npos) && (flagDistribution(generator) == 0)) {
+            format += '#';
+        }
+        if (widthMode == 1) {
+            format += std::to_string(std::abs(width));
+        } else if (widthMode == 2) {
+            format += '*';
+        }
+        // A precision is undefined for %c and %p
+        if ((conversion.back() != 'c') && (conversion.back() != 'p')) {
+            if (precisionMode == 1) {
+                format += "." + std::to_string(std::max(precision, 0));
+            } else if (precisionMode == 2) {
+                format += ".*";
+            }
+        }
+        format += conversion + "] 100%%";
+
+        const bool starWidth     = (widthMode == 2);
+        const bool starPrecision = (format.find(".*") != std::string::npos);
+        if (starWidth && starPrecision) {
+            return logAndSnprintf(format, width, precision, value);
+        }
+        if (starWidth) {
+            return logAndSnprintf(format, width, value);
+        }
+        if (starPrecision) {
+            return logAndSnprintf(format, precision, value);
+        }
+        return logAndSnprintf(format, value);
+    }
+
+    // Random conversions of every kind the fast formatter handles, plus a few it leaves to vsnprintf()
+    static void logRandomConversions(std::mt19937_64 &generator, std::vector<std::string> &expectedMessages) {
+        constexpr int                           casesCount = 4000;
+        static const std::vector<std::string>   strings    = {"", "a", "abc", "hello world", "0123456789abcdefghij"};
+        std::uniform_int_distribution<int>      kindDistribution(0, 14);                // NOLINT(readability-magic-numbers)
+        std::uniform_int_distribution<uint64_t> bitsDistribution;
+        std::uniform_int_distribution<int>      shiftDistribution(0, 63);               // NOLINT(readability-magic-numbers)
+        std::uniform_int_distribution<int>      exponentDistribution(-12, 20);          // NOLINT(readability-magic-numbers)
+        std::uniform_int_distribution<int>      printableDistribution(' ', '~');
+        std::uniform_real_distribution<double>  mantissaDistribution(-10.0, 10.0);      // NOLINT(readability-magic-numbers)
+
+        for (int caseIdx = 0; caseIdx < casesCount; ++caseIdx) {
+            // Random bits shifted right, so that small values are as likely as large ones
+            const uint64_t bits = bitsDistribution(generator) >> shiftDistribution(generator);
+            // Values with few significant bits make exact ties between two rounded values
+            const double   value =
+                ((caseIdx % 3) == 0) ? (static_cast<double>(static_cast<int64_t>(bits % 100000) - 50000) / static_cast<double>(1U << (bits % 12)))  // NOLINT(readability-magic-numbers)
+                                      : (mantissaDistribution(generator) * std::pow(10.0, exponentDistribution(generator)));  // NOLINT(readability-magic-numbers)
+
+            switch (kindDistribution(generator)) {
+                case 0:
+                    expectedMessages.push_back(logRandomConversion(generator, "d", static_cast<int>(bits)));
+                    break;
+                case 1:
+                    expectedMessages.push_back(logRandomConversion(generator, "i", static_cast<int>(bits)));
+                    break;
+                case 2:
+                    expectedMessages.push_back(logRandomConversion(generator, "hhd", static_cast<int>(bits)));
+                    break;
+                case 3:
+                    expectedMessages.push_back(logRandomConversion(generator, "ld", static_cast<long>(bits)));
+                    break;
+                case 4:
+                    expectedMessages.push_back(logRandomConversion(generator, "lld", static_cast<long long>(bits)));
+                    break;
+                case 5:
+                    expectedMessages.push_back(logRandomConversion(generator, "u", static_cast<unsigned int>(bits)));
+                    break;
+                case 6:
+                    expectedMessages.push_back(logRandomConversion(generator, "zu", static_cast<size_t>(bits)));
+                    break;
+                case 7:
+                    expectedMessages.push_back(logRandomConversion(generator, (bits % 2) ? "x" : "hX", static_cast<unsigned int>(bits)));
+                    break;
+                case 8:
+                    expectedMessages.push_back(logRandomConversion(generator, "c", printableDistribution(generator)));
+                    break;
+                case 9:
+                    expectedMessages.push_back(logRandomConversion(generator, "s", strings[bits % strings.size()].c_str()));
+                    break;
+                case 10:
+                    expectedMessages.push_back(logRandomConversion(generator, "p", reinterpret_cast<void *>(static_cast<uintptr_t>(bits) | 1U)));  // NOLINT(performance-no-int-to-ptr)
+                    break;
+                case 11:
+                    expectedMessages.push_back(logRandomConversion(generator, (bits % 2) ? "f" : "F", value));
+                    break;
+                case 12:
+                    // Negative zero keeps its sign, infinities and NaN are left to vsnprintf()
+                    expectedMessages.push_back(logRandomConversion(generator, "f", std::array<double, 4>{0.0, -0.0, HUGE_VAL, std::nan("")}[bits % 4]));
+                    break;
+                case 13:
+                    expectedMessages.push_back(logRandomConversion(generator, (bits % 2) ? "e" : "g", value));
+                    break;
+                default:
+                    expectedMessages.push_back(logRandomConversion(generator, (bits % 2) ? "o" : "lo", static_cast<unsigned long>(bits)));
+                    break;
+            }
+        }
+    }
+
+    static void appendLines(const std::string &content, std::vector<std::string> &lines) {
+        std::istringstream contentStream(content);
+        std::string        line;
+
+        while (std::getline(contentStream, line)) {
+            lines.push_back(line);
+        }
+    }
+
+    // Returns an empty string if the file doesn't exist
+    static std::string decompressFile(const std::string &path) {
+        const std::string decompressedPath = path + ".decompressed";
+        FILE             *compressedStream = fopen(path.c_str(), "rb");
+        FILE             *rawStream;
+
+        if (compressedStream == nullptr) {
+            return "";
+        }
+        rawStream = fopen(decompressedPath.c_str(), "wb");
+        EXPECT_NE(rawStream, nullptr);
+        if (rawStream != nullptr) {
+            EXPECT_EQ(mdn_Logger_decompress(compressedStream, rawStream), MDN_STATUS_SUCCESS);
+            (void)fclose(rawStream);
+        }
+        (void)fclose(compressedStream);
+        return readFileContent(decompressedPath);
+    }
+
+    // Lines of a rotated log, oldest first: "<path>.<retainedCount>" down to "<path>.1", then "<path>" itself
+    static std::vector<std::string> readRotatedLines(const std::string &path, unsigned retainedCount, bool compressed) {
+        std::vector<std::string> lines;
+        std::string              segmentPath;
+
+        for (unsigned index = retainedCount; index >= 1; --index) {
+            segmentPath = path + "." + std::to_string(index);
+            appendLines(compressed ? decompressFile(segmentPath + ".mdnz") : readFileContent(segmentPath), lines);
+        }
+        appendLines(readFileContent(path), lines);
+        return lines;
+    }
+
+    // Rotated files of previous runs would be taken for this run's
+    static void removeRotatedFiles(const std::string &path) {
+        const auto fileName = fs::path(path).filename().string();
+
+        for (const auto &entry : fs::directory_iterator(fs::path(path).parent_path())) {
+            if (entry.path().filename().string().starts_with(fileName)) {
+                fs::remove(entry.path());
+            }
+        }
+    }
+
+    // Checks the lines written by logFromThreads() with a single thread are in order, with none missing after the first one
+    void verifyRotatedLines(const std::vector<std::string> &lines, size_t linesCount) {
+        const auto &format = loggingFormatToRegexMap[MDN_LOGGER_LOGGING_FORMAT_FILE];
+        size_t      lineIdx = linesCount - lines.size();
+
+        for (const auto &line : lines) {
+            ASSERT_EQ(std::regex_match(line, format), true) << "Line format isn't valid:\n"
+                                                            << line;
+            ASSERT_EQ(line.ends_with(" Thread 0 line " + std::to_string(lineIdx)), true) << "Unexpected line:\n"
+                                                                                           << line;
+            ++lineIdx;
+        }
+    }
+
+    // Decodes a binary output file next to it, and returns the decoded file's path
+    std::string decodeBinaryOutputFile(OutputFiles outputFile) {
+        const auto &outputFileRef = outputFilesInfo[static_cast<std::size_t>(outputFile)];
+        std::string decodedPath   = outputFileRef.path + ".decoded.log";
+        FILE       *binaryStream  = fopen(outputFileRef.path.c_str(), "rb");
+        FILE       *textStream    = fopen(decodedPath.c_str(), "wb");
+
+        EXPECT_NE(binaryStream, nullptr);
+        EXPECT_NE(textStream, nullptr);
+        if ((binaryStream != nullptr) && (textStream != nullptr)) {
+            EXPECT_EQ(mdn_Logger_decodeBinary(binaryStream, textStream), MDN_STATUS_SUCCESS);
+        }
+        if (binaryStream != nullptr) {
+            (void)fclose(binaryStream);
+        }
+        if (textStream != nullptr) {
+            (void)fclose(textStream);
+        }
+        return decodedPath;
+    }
+
+    // Extracts the records of a flight recorder file, then decodes them like a binary log
+    static std::string extractFlightRecorderFile(const std::string &path) {
+        const std::string binaryPath  = path + ".mdnlog";
+        const std::string decodedPath = path + ".decoded.log";
+        FILE             *flightRecorderStream = fopen(path.c_str(), "rb");
+        FILE             *binaryStream         = fopen(binaryPath.c_str(), "wb");
+        FILE             *textStream;
+
+        EXPECT_NE(flightRecorderStream, nullptr);
+        EXPECT_NE(binaryStream, nullptr);
+        if ((flightRecorderStream != nullptr) && (binaryStream != nullptr)) {
+            EXPECT_EQ(mdn_Logger_extractFlightRecorder(flightRecorderStream, binaryStream), MDN_STATUS_SUCCESS);
+        }
+        if (flightRecorderStream != nullptr) {
+            (void)fclose(flightRecorderStream);
+        }
+        if (binaryStream != nullptr) {
+            (void)fclose(binaryStream);
+        }
+
+        binaryStream = fopen(binaryPath.c_str(), "rb");
+        textStream   = fopen(decodedPath.c_str(), "wb");
+        EXPECT_NE(binaryStream, nullptr);
+        EXPECT_NE(textStream, nullptr);
+        if ((binaryStream != nullptr) && (textStream != nullptr)) {
+            EXPECT_EQ(mdn_Logger_decodeBinary(binaryStream, textStream), MDN_STATUS_SUCCESS);
+        }
+        if (binaryStream != nullptr) {
+            (void)fclose(binaryStream);
+        }
+        if (textStream != nullptr) {
+            (void)fclose(textStream);
+        }
+        return decodedPath;
+    }
+
     void verifyLogFiles(const std::vector<LogLine> &logLines, const std::vector<OutputFiles> &outputFiles) {
         for (const auto outputFile : outputFiles) {
             auto &outputFileRef    = outputFilesInfo[static_cast<std::size_t>(outputFile)];
@@ -431,6 +812,17 @@ public:
             .loggingLevel  = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
             .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_SCREEN};
 
+        asyncConfigDefault = {
+            .queueCapacity = 1024,
+            .maxMessageLen = 256,
+            .fullPolicy    = MDN_LOGGER_ASYNC_FULL_POLICY_BLOCK};
+
+        backtraceConfigDefault = {
+            .recordsCount  = 3,
+            .maxMessageLen = 256,
+            .loggingLevel  = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+            .flushLevel    = MDN_LOGGER_LOGGING_LEVEL_ERROR};
+
         loggingFormatToRegexMap.resize(MDN_LOGGER_LOGGING_FORMAT_COUNT);
         loggingFormatToRegexMap[MDN_LOGGER_LOGGING_FORMAT_SCREEN] = R"(^(\x1B\[\d+m)(\d{2}:\d{2}:\d{2}\.\d{3}) ([\w\.]+) \| ([[:print:]\s]+)(\x1B\[\d+m)$)";
         loggingFormatToRegexMap[MDN_LOGGER_LOGGING_FORMAT_FILE]   = R"(^(\d{4}-\d{2}-\d{2}) (\d{2}:\d{2}:\d{2}\.\d{3}) (\w+) +([\w\.]+) +\| ([[:print:]\s]+)$)";
@@ -638,87 +1030,2283 @@ TEST_F(LoggerTest, FileDebugScreenWarning) {
     ASSERT_NO_FATAL_FAILURE(verifyLogFiles(defaultLogLines, outputFiles));
 }
 
-#ifdef MDN_LOGGER_SAFE_MODE
+TEST_F(LoggerTest, DisabledLevelSkipsArguments) {
+    const std::vector<OutputFiles> outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+    const std::vector<LogLine>     logLines    = {
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING, .message = "Evaluation 1"},
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_ERROR,   .message = "Evaluation 2"},
+    };
+    int  evaluationsCount = 0;
+    auto evaluate         = [&evaluationsCount]() { return ++evaluationsCount; };
 
-class LoggerSafeModeTest : public ::LoggerTest {
-protected:
-    static inline mdn_Logger_StreamConfig_t streamConfigNullStream;
-    static inline mdn_Logger_StreamConfig_t streamConfigLoggingLevelTooBig;
-    static inline mdn_Logger_StreamConfig_t streamConfigLoggingLevelTooSmall;
-    static inline mdn_Logger_StreamConfig_t streamConfigLoggingFormatTooBig;
-    static inline mdn_Logger_StreamConfig_t streamConfigLoggingFormatTooSmall;
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].streamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING;
 
-public:
-    static void SetUpTestSuite() {
-        streamConfigNullStream        = streamConfigDefault;
-        streamConfigNullStream.stream = nullptr;
+    // NOLINTBEGIN(hicpp-vararg)
+    MDN_LOGGER_LOG_CRITICAL("Evaluation %d", evaluate());  // Not initialized, no stream wants anything
+    ASSERT_EQ(evaluationsCount, 0);
 
-        streamConfigLoggingLevelTooBig              = streamConfigDefault;
-        streamConfigLoggingLevelTooBig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    MDN_LOGGER_LOG_DEBUG("Evaluation %d", evaluate());
+    MDN_LOGGER_LOG_INFO("Evaluation %d", evaluate());
+    ASSERT_EQ(evaluationsCount, 0);
+    MDN_LOGGER_LOG_WARNING("Evaluation %d", evaluate());
+    MDN_LOGGER_LOG_ERROR("Evaluation %d", evaluate());
+    ASSERT_EQ(evaluationsCount, 2);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
 
-        streamConfigLoggingLevelTooSmall              = streamConfigDefault;
-        streamConfigLoggingLevelTooSmall.loggingLevel = static_cast<mdn_Logger_loggingLevel_t>(-1);  // NOLINT(clang-analyzer-optin.core.EnumCastOutOfRange)
+    MDN_LOGGER_LOG_CRITICAL("Evaluation %d", evaluate());  // Deinitialized
+    ASSERT_EQ(evaluationsCount, 2);
+    // NOLINTEND(hicpp-vararg)
 
-        streamConfigLoggingFormatTooBig               = streamConfigDefault;
-        streamConfigLoggingFormatTooBig.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_COUNT;
+    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(logLines, outputFiles));
+}
 
-        streamConfigLoggingFormatTooSmall               = streamConfigDefault;
-        streamConfigLoggingFormatTooSmall.loggingFormat = static_cast<mdn_Logger_loggingFormat_t>(-1);  // NOLINT(clang-analyzer-optin.core.EnumCastOutOfRange)
+TEST_F(LoggerTest, TimestampPrecision) {
+    const std::vector<OutputFiles>                                        outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+    const std::vector<std::pair<mdn_Logger_timestampPrecision_t, size_t>> precisionToFractionDigitsMap{
+        {MDN_LOGGER_TIMESTAMP_PRECISION_MSEC, 3},
+        {MDN_LOGGER_TIMESTAMP_PRECISION_USEC, 6},
+        {MDN_LOGGER_TIMESTAMP_PRECISION_NSEC, 9},
+    };
+
+    for (const auto &[timestampPrecision, fractionDigits] : precisionToFractionDigitsMap) {
+        const std::regex format(R"(^\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2}\.\d{)" + std::to_string(fractionDigits) + R"(} INFO +[\w\.]+ +\| Precision message$)");
+        std::string      actualLogLine;
+
+        ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+        ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+        ASSERT_EQ(mdn_Logger_setTimestampPrecision(timestampPrecision), MDN_STATUS_SUCCESS);
+        ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+        MDN_LOGGER_LOG_INFO("Precision message");  // NOLINT(hicpp-vararg)
+        ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+        ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+        auto binaryFileReader = BinaryFileReader(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path);
+        ASSERT_EQ(binaryFileReader.getLine(actualLogLine), true);
+        ASSERT_EQ(std::regex_match(actualLogLine, format), true) << "Line format isn't valid:\n"
+                                                                 << actualLogLine;
     }
-};
+}
 
-TEST_F(LoggerSafeModeTest, InvalidArguments) {
-    const std::vector<OutputFiles> outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+TEST_F(LoggerTest, LogLongMessage) {
+    constexpr size_t               longMessageLen = 10000;
+    const std::vector<OutputFiles> outputFiles    = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::STDOUT_REDIRECTION,
+    };
+    const std::vector<LogLine> logLines = {
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO, .message = std::string(longMessageLen, 'x')},
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO, .message = "Short message after a long one"},
+    };
 
     ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(logLines, outputFiles));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
 
-    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigDefault), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
-    MDN_LOGGER_LOG_DEBUG("Test message (should not be logged, library not initialized)");  // NOLINT(hicpp-vararg)
+    // The format regexes backtrack over the message, which overflows the stack on a long one, hence only matched against the
+    // prefix and suffix around a short message
+    for (const auto outputFile : outputFiles) {
+        const auto              &outputFileRef = outputFilesInfo[static_cast<std::size_t>(outputFile)];
+        const auto               loggingFormat = outputFileRef.streamConfig.loggingFormat;
+        const std::string        suffix        = (loggingFormat == MDN_LOGGER_LOGGING_FORMAT_SCREEN) ? ansiResetColor : "";
+        std::vector<std::string> lines;
+
+        appendLines(readFileContent(outputFileRef.path), lines);
+        ASSERT_EQ(lines.size(), logLines.size()) << "In " << outputFileRef.path;
+        for (size_t idx = 0; idx < lines.size(); ++idx) {
+            const auto  &line       = lines[idx];
+            const auto  &message    = logLines[idx].message;
+            const size_t separator  = line.find(" | ");
+            const size_t messagePos = separator + 3;
+
+            ASSERT_NE(separator, std::string::npos) << "No message separator in line " << idx << " of " << outputFileRef.path;
+            ASSERT_EQ(line.size(), messagePos + message.size() + suffix.size()) << "Unexpected length of line " << idx << " of " << outputFileRef.path;
+            ASSERT_EQ(line.compare(messagePos, message.size(), message), 0) << "Unexpected message in line " << idx << " of " << outputFileRef.path;
+            ASSERT_EQ(line.ends_with(suffix), true) << "Unexpected suffix in line " << idx << " of " << outputFileRef.path;
+            ASSERT_EQ(std::regex_match(line.substr(0, messagePos) + "x" + suffix, loggingFormatToRegexMap[loggingFormat]), true)
+                << "Unexpected prefix in line " << idx << " of " << outputFileRef.path << ":\n"
+                << line.substr(0, messagePos);
+        }
+    }
+}
 
+TEST_F(LoggerTest, LogFromMultipleThreads) {
+    constexpr size_t               threadsCount   = 8;
+    constexpr size_t               linesPerThread = 500;
+    const std::vector<OutputFiles> outputFiles    = {OutputFiles::LOGGER_OUTPUT_1};
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
     ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
-    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_ERROR_LIBRARY_ALREADY_INITIALIZED);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
 
-    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigNullStream), MDN_STATUS_ERROR_BAD_ARGUMENT);
-    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigLoggingLevelTooBig), MDN_STATUS_ERROR_BAD_ARGUMENT);
-    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigLoggingLevelTooSmall), MDN_STATUS_ERROR_BAD_ARGUMENT);
-    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigLoggingFormatTooBig), MDN_STATUS_ERROR_BAD_ARGUMENT);
-    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigLoggingFormatTooSmall), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_NO_FATAL_FAILURE(verifyLogLinesFormat(outputFiles[0], threadsCount * linesPerThread));
+}
+
+TEST_F(LoggerTest, RemoveOutputStream) {
+    const std::vector<OutputFiles> outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    std::vector<LogLine> logLinesTwice = defaultLogLines;
+
+    logLinesTwice.insert(logLinesTwice.end(), defaultLogLines.begin(), defaultLogLines.end());
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
     ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
     ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, outputFiles));
+    ASSERT_EQ(mdn_Logger_removeOutputStream(outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.stream), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_removeOutputStream(outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.stream), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, outputFiles));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
 
-    mdn_Logger_log(static_cast<mdn_Logger_loggingLevel_t>(-1), __FILE__, __LINE__, MDN_LOGGER_FUNC_NAME, "Test message (should not be logged, logging format too small)");  // NOLINT(clang-analyzer-optin.core.EnumCastOutOfRange,hicpp-vararg)
-    mdn_Logger_log(MDN_LOGGER_LOGGING_LEVEL_COUNT, __FILE__, __LINE__, MDN_LOGGER_FUNC_NAME, "Test message (should not be logged, logging format too big)");                // NOLINT(hicpp-vararg)
-    mdn_Logger_log(MDN_LOGGER_LOGGING_LEVEL_DEBUG, nullptr, __LINE__, MDN_LOGGER_FUNC_NAME, "Test message (should not be logged, file is null)");                           // NOLINT(hicpp-vararg)
-    mdn_Logger_log(MDN_LOGGER_LOGGING_LEVEL_DEBUG, __FILE__, -1, MDN_LOGGER_FUNC_NAME, "Test message (should not be logged, line is negative)");                            // NOLINT(hicpp-vararg)
-    mdn_Logger_log(MDN_LOGGER_LOGGING_LEVEL_DEBUG, __FILE__, __LINE__, nullptr, "Test message (should not be logged, function is null)");                                   // NOLINT(hicpp-vararg)
+    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(logLinesTwice, {outputFiles[0]}));
+    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(defaultLogLines, {outputFiles[1]}));
+}
+
+// Streams sharing a format get the same rendering, timestamp included, unless their level keeps the record out
+TEST_F(LoggerTest, SharedFormatRenderedOnce) {
+    const std::vector<OutputFiles> outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    mdn_Logger_StreamConfig_t      warningStreamConfig;
+    std::vector<std::string>       allLines, warningLines;
 
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    warningStreamConfig              = outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig;
+    warningStreamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING;
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_setTimestampPrecision(MDN_LOGGER_TIMESTAMP_PRECISION_NSEC), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams({outputFiles[0]}));
+    ASSERT_EQ(mdn_Logger_addOutputStream(warningStreamConfig), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, {}));
     ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
-    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path), allLines);
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].path), warningLines);
+    ASSERT_EQ(allLines.size(), defaultLogLines.size());
+    ASSERT_EQ(warningLines.size(), 3);
+    for (size_t idx = 0; idx < warningLines.size(); ++idx) {
+        ASSERT_EQ(warningLines[idx], allLines[idx + 2]);
+    }
+}
 
+TEST_F(LoggerTest, StreamsChurnWhileLogging) {
+    constexpr size_t               threadsCount   = 4;
+    constexpr size_t               linesPerThread = 2000;
+    constexpr size_t               churnCount     = 200;
+    const std::vector<OutputFiles> outputFiles    = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    const auto &churnedStreamConfig = outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams({outputFiles[0]}));
+    std::thread churnThread([&churnedStreamConfig]() {
+        for (size_t churnIdx = 0; churnIdx < churnCount; ++churnIdx) {
+            EXPECT_EQ(mdn_Logger_addOutputStream(churnedStreamConfig), MDN_STATUS_SUCCESS);
+            EXPECT_EQ(mdn_Logger_removeOutputStream(churnedStreamConfig.stream), MDN_STATUS_SUCCESS);
+        }
+    });
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    churnThread.join();
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
     ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
-    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(defaultLogLines, outputFiles));
+
+    ASSERT_NO_FATAL_FAILURE(verifyLogLinesFormat(outputFiles[0], threadsCount * linesPerThread));
+    ASSERT_LE(countLogLines(outputFiles[1]), threadsCount * linesPerThread);
 }
 
-#endif  // MDN_LOGGER_SAFE_MODE
+TEST_F(LoggerTest, RateLimitedCallSite) {
+    constexpr unsigned             ratePerSec  = 4;
+    constexpr unsigned             burst       = 5;
+    constexpr size_t               callsCount  = 1000;
+    constexpr auto                 refillTime  = std::chrono::milliseconds(1000 / ratePerSec + 50);
+    const std::vector<OutputFiles> outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+    const std::string              message     = "Rate limited warning";
+    const std::string              summary     = std::to_string(callsCount - burst) + " records suppressed by the rate limit of this call site";
+    std::vector<LogLine>           expectedLines(burst, LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING, .message = message});
+    const auto                     logFromSite = [this, &message](size_t count) {
+        for (size_t callIdx = 0; callIdx < count; ++callIdx) {
+            MDN_LOGGER_LOG_WARNING_RATE_LIMITED(ratePerSec, burst, "%s", message.c_str());  // NOLINT(hicpp-vararg)
+        }
+    };
 
-#ifdef MDN_MW_ENABLE_MOCKING
+    expectedLines.push_back(LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING, .message = summary});
+    expectedLines.push_back(LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING, .message = message});
 
-class LoggerTestMemoryAllocationFailure : public LoggerTest {};
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    logFromSite(callsCount);  // Only the burst goes through
+    std::this_thread::sleep_for(refillTime);
+    logFromSite(1);  // Preceded by the summary of the dropped ones
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
 
-TEST_F(LoggerTestMemoryAllocationFailure, InitFail) {
-    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_init"), _))
-        .WillOnce(Return(nullptr));
+    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(expectedLines, outputFiles));
+}
 
-    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_ERROR_MEM_ALLOC);
+TEST_F(LoggerTest, SampledCallSiteFromMultipleThreads) {
+    constexpr size_t               threadsCount     = 4;
+    constexpr size_t               callsPerThread   = 1000;
+    constexpr unsigned             sampleEvery      = 8;
+    const std::vector<OutputFiles> outputFiles      = {OutputFiles::LOGGER_OUTPUT_1};
+    std::vector<std::thread>       threads;
+    size_t                         evaluationsCount = 0;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    for (size_t threadIdx = 0; threadIdx < threadsCount; ++threadIdx) {
+        threads.emplace_back([this]() {
+            for (size_t callIdx = 0; callIdx < callsPerThread; ++callIdx) {
+                MDN_LOGGER_LOG_INFO_SAMPLED(sampleEvery, "Sampled message %zu", callIdx);  // NOLINT(hicpp-vararg)
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (size_t callIdx = 0; callIdx < sampleEvery; ++callIdx) {
+        MDN_LOGGER_LOG_INFO_SAMPLED(sampleEvery, "Evaluated %zu times", ++evaluationsCount);  // NOLINT(hicpp-vararg)
+    }
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_EQ(evaluationsCount, 1);  // Arguments of the calls sampled out aren't evaluated
+    ASSERT_NO_FATAL_FAILURE(verifyLogLinesFormat(outputFiles[0], (threadsCount * callsPerThread / sampleEvery) + 1));
 }
 
-TEST_F(LoggerTestMemoryAllocationFailure, AddOutputStreamFail) {
-    EXPECT_CALL(*mWMock, realloc(StrEq("mdn_Logger_addOutputStream"), _, _))
-        .WillOnce(Return(nullptr));
+TEST_F(LoggerTest, DynamicSiteLevels) {
+    const std::vector<OutputFiles> outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+    const auto                     debugLine   = std::to_string(__LINE__ + 3);
+    const auto                     logAll      = [this]() {
+        // NOLINTBEGIN(hicpp-vararg)
+        MDN_LOGGER_LOG_DEBUG("Selected debug");
+        MDN_LOGGER_LOG_DEBUG("Other debug");
+        MDN_LOGGER_LOG_INFO("Info");
+        // NOLINTEND(hicpp-vararg)
+    };
+    const std::vector<std::string> expectedMessages = {
+        "Info",                                  // Stream levels only
+        "Selected debug", "Info",                // A single line
+        "Selected debug", "Other debug", "Info", // A whole file
+                                                 // Everything below WARNING turned off
+        "Info",                                  // Reset
+        "Not run before",                        // Rules apply to call sites registered later
+    };
+    std::vector<std::string> lines;
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].streamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO;
 
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
     ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
-    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigDefault), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    logAll();
+    ASSERT_EQ(mdn_Logger_setSiteLevel(("logger_test.cpp:" + debugLine).c_str(), nullptr, MDN_LOGGER_LOGGING_LEVEL_DEBUG), MDN_STATUS_SUCCESS);
+    logAll();
+    // Function globs match the __func__ of the call sites, whatever MDN_LOGGER_FUNC_NAME logs
+    ASSERT_EQ(mdn_Logger_setSiteLevel("logger_*.cpp", "operator()", MDN_LOGGER_LOGGING_LEVEL_DEBUG), MDN_STATUS_SUCCESS);
+    logAll();
+    ASSERT_EQ(mdn_Logger_setSiteLevel(nullptr, "operat?r*", MDN_LOGGER_LOGGING_LEVEL_WARNING), MDN_STATUS_SUCCESS);
+    logAll();
+    ASSERT_EQ(mdn_Logger_resetSiteLevels(), MDN_STATUS_SUCCESS);
+    logAll();
+    ASSERT_EQ(mdn_Logger_setSiteLevel("*/logger_test.cpp", nullptr, MDN_LOGGER_LOGGING_LEVEL_DEBUG), MDN_STATUS_SUCCESS);
+    MDN_LOGGER_LOG_DEBUG("Not run before");  // NOLINT(hicpp-vararg)
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path), lines);
+    ASSERT_EQ(lines.size(), expectedMessages.size());
+    for (size_t idx = 0; idx < lines.size(); ++idx) {
+        ASSERT_EQ(lines[idx].ends_with("| " + expectedMessages[idx]), true) << "Unexpected line:\n"
+                                                                             << lines[idx];
+    }
+}
+
+TEST_F(LoggerTest, CallSiteFunctionName) {
+    const std::vector<OutputFiles> outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+    const auto                    &indices     = loggingFormatToIndicesMap[MDN_LOGGER_LOGGING_FORMAT_FILE];
+    std::string                    functionName;
+    std::vector<std::string>       lines;
+    std::smatch                    matches;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    functionName = logFromNamedFunction();
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path), lines);
+    ASSERT_EQ(lines.size(), 1);
+    ASSERT_EQ(std::regex_match(lines[0], matches, loggingFormatToRegexMap[MDN_LOGGER_LOGGING_FORMAT_FILE]), true) << "Line format isn't valid:\n"
+                                                                                                                 << lines[0];
+    ASSERT_EQ(functionName, "logFromNamedFunction");
+    ASSERT_EQ(matches[indices.functionIndex].str(), functionName);
+    ASSERT_EQ(matches[indices.messageIndex].str(), "Logged from a named function");
+}
+
+TEST_F(LoggerTest, JsonAndLogfmtFormats) {
+    const std::vector<OutputFiles> outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    const std::regex  jsonPrefixRegex(R"re(^\{"time":"\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3}","level":"(\w+)","file":"([^"]*)","line":\d+,"func":"([^"]*)","thread":(\d+),"msg":")re");
+    const std::regex  logfmtPrefixRegex(R"re(^time=\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3} level=(\w+) file=(\S+) line=\d+ func=(\S+) thread=(\d+) msg=")re");
+    const std::string otherThreadMessage = "From another thread";
+    std::vector<LogLine> logLines = {
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO,    .message = "Plain message"                                                        },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG,   .message = ""                                                                     },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING, .message = "Quotes \"inside\" and a \\ backslash"                                 },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_ERROR,   .message = "New\nline, tab\t, carriage return\r, backspace\b, form feed\f"        },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO,    .message = "Other control characters \x01 \x1f, DEL \x7f and UTF-8 \xc3\xa9 as is"},
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO,    .message = std::string(3000, '\x02')                                              }, // Grows past the thread-local line buffer once escaped
+    };
+    std::vector<std::string> jsonLines, logfmtLines;
+    std::smatch              jsonMatches, logfmtMatches;
+    std::string              mainThreadId;
+
+    // Characters to escape at every position of the vector, tail and scalar parts of the scan
+    for (size_t offset = 0; offset < 70; ++offset) {  // NOLINT(readability-magic-numbers)
+        logLines.push_back(LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_CRITICAL,
+                                   .message      = std::string(offset, 'a') + "\"" + std::string(offset % 33, 'b') + "\\" + std::string(offset % 17, 'c') + "\n"});  // NOLINT(readability-magic-numbers)
+    }
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].streamConfig.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_JSON;
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_LOGFMT;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(logLines, outputFiles));
+    std::thread([this, &otherThreadMessage]() { logInfo(otherThreadMessage); }).join();
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+    logLines.push_back(LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO, .message = otherThreadMessage});
+
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path), jsonLines);
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].path), logfmtLines);
+    ASSERT_EQ(jsonLines.size(), logLines.size());
+    ASSERT_EQ(logfmtLines.size(), logLines.size());
+    for (size_t idx = 0; idx < logLines.size(); ++idx) {
+        const auto &jsonLine   = jsonLines[idx];
+        const auto &logfmtLine = logfmtLines[idx];
+
+        // Only the prefixes go through std::regex, which recurses per character
+        ASSERT_EQ(std::regex_search(jsonLine, jsonMatches, jsonPrefixRegex), true) << jsonLine;
+        ASSERT_EQ(jsonMatches[1].str(), logLevelToStringMap[logLines[idx].loggingLevel]);
+        ASSERT_EQ(jsonMatches[2].str(), jsonEscape(__FILE__));
+        ASSERT_EQ(jsonMatches[3].str(), testFullName);
+        ASSERT_EQ(jsonLine.substr(jsonMatches.length(0)), jsonEscape(logLines[idx].message) + "\"}");
+
+        ASSERT_EQ(std::regex_search(logfmtLine, logfmtMatches, logfmtPrefixRegex), true) << logfmtLine;
+        ASSERT_EQ(logfmtMatches[1].str(), logLevelToStringMap[logLines[idx].loggingLevel]);
+        ASSERT_EQ(logfmtMatches[2].str(), __FILE__);
+        ASSERT_EQ(logfmtMatches[3].str(), testFullName);
+        ASSERT_EQ(logfmtLine.substr(logfmtMatches.length(0)), jsonEscape(logLines[idx].message) + "\"");
+
+        // Same thread ID in both formats, and a different one for the record of the other thread
+        ASSERT_EQ(logfmtMatches[4].str(), jsonMatches[4].str());
+        ASSERT_NE(jsonMatches[4].str(), "0");
+        if (idx == 0) {
+            mainThreadId = jsonMatches[4].str();
+        }
+        ASSERT_EQ(jsonMatches[4].str() == mainThreadId, idx + 1 < logLines.size());
+    }
+}
+
+TEST_F(LoggerTest, CppFrontEnd) {
+    const std::vector<OutputFiles> outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    const std::string              longArgument(2000, 'z');  // Past the stack buffer
+    const std::vector<LogLine>     expectedLogLines = {
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO,     .message = "x=1 y=two"                                 },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG,    .message = "Debug 0x2a, 3.14, true"                    },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING,  .message = "Long " + longArgument + " done"            },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_ERROR,    .message = "Braces {} and percents %d stay as they are"},
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_CRITICAL, .message = "Critical -7"                               },
+    };
+    std::vector<std::string> lines;
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_BINARY;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    // NOLINTBEGIN(readability-magic-numbers)
+    mdn::log::info("x={} y={}", 1, "two");
+    mdn::log::debug("Debug {:#x}, {:.2f}, {}", 42, 3.14159, true);
+    mdn::log::warning("Long {} done", longArgument);
+    mdn::log::error("Braces {{}} and percents %d stay as they are");
+    mdn::log::critical("Critical {}", -7);
+    // NOLINTEND(readability-magic-numbers)
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    const auto &fileOutputPath = outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path;
+    appendLines(readFileContent(fileOutputPath), lines);
+    ASSERT_EQ(lines.size(), expectedLogLines.size());
+    for (size_t idx = 0; idx < lines.size(); ++idx) {
+        ASSERT_EQ(lines[idx].find(logLevelToStringMap[expectedLogLines[idx].loggingLevel]) != std::string::npos, true) << lines[idx];
+        ASSERT_EQ(lines[idx].ends_with("| " + expectedLogLines[idx].message), true) << "Unexpected line:\n"
+                                                                                     << lines[idx];
+    }
+    ASSERT_EQ(readFileContent(decodeBinaryOutputFile(outputFiles[1])), readFileContent(fileOutputPath));
+}
+
+TEST_F(LoggerTest, FastPrintfMatchesSnprintf) {
+    constexpr uint64_t             seed        = 20261016;  // Fixed, so that a failure can be reproduced
+    const std::vector<OutputFiles> outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    std::mt19937_64                generator(seed);
+    std::vector<std::string>       expectedMessages, syncLines, asyncLines;
+
+    // Same random conversions formatted on the caller's line buffer, then into async queue slots
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles({outputFiles[0]}));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams({outputFiles[0]}));
+    logRandomConversions(generator, expectedMessages);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles({outputFiles[0]}));
+
+    generator.seed(seed);
+    expectedMessages.clear();
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles({outputFiles[1]}));
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams({outputFiles[1]}));
+    logRandomConversions(generator, expectedMessages);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles({outputFiles[1]}));
+
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path), syncLines);
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].path), asyncLines);
+    ASSERT_EQ(syncLines.size(), expectedMessages.size());
+    ASSERT_EQ(asyncLines.size(), expectedMessages.size());
+    for (size_t idx = 0; idx < expectedMessages.size(); ++idx) {
+        ASSERT_EQ(syncLines[idx].ends_with("| " + expectedMessages[idx]), true) << "Expected message: " << expectedMessages[idx] << "\nActual line:\n"
+                                                                                << syncLines[idx];
+        ASSERT_EQ(asyncLines[idx].ends_with("| " + expectedMessages[idx]), true) << "Expected message: " << expectedMessages[idx] << "\nActual line:\n"
+                                                                                 << asyncLines[idx];
+    }
+}
+
+namespace {
+// A custom destination, which keeps whole records and counts how they were handed over
+struct RecordingSink {
+    std::mutex               mutex;
+    std::vector<std::string> records;
+    size_t                   writesCount  = 0;
+    size_t                   batchesCount = 0;
+    size_t                   maxBatchLen  = 0;
+    size_t                   closesCount  = 0;
+
+    static bool write(void *context, const char *data, size_t len) {
+        auto                 *sink = static_cast<RecordingSink *>(context);
+        const std::lock_guard lock(sink->mutex);
+
+        sink->records.emplace_back(data, len);
+        ++sink->writesCount;
+        return true;
+    }
+
+    static bool writeBatch(void *context, const mdn_Logger_SinkBuffer_t *buffersArr, size_t buffersArrLen) {
+        auto                 *sink = static_cast<RecordingSink *>(context);
+        const std::lock_guard lock(sink->mutex);
+
+        for (size_t idx = 0; idx < buffersArrLen; ++idx) {
+            sink->records.emplace_back(buffersArr[idx].data, buffersArr[idx].len);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        ++sink->batchesCount;
+        sink->maxBatchLen = std::max(sink->maxBatchLen, buffersArrLen);
+        return true;
+    }
+
+    static void close(void *context) {
+        ++static_cast<RecordingSink *>(context)->closesCount;
+    }
+
+    static constexpr mdn_Logger_SinkOps_t ops = {
+        .write      = write,
+        .writeBatch = writeBatch,
+        .flush      = nullptr,
+        .close      = close};
+};
+
+bool appendToRecords(const char *data, size_t len, void *userData) {
+    static_cast<std::vector<std::string> *>(userData)->emplace_back(data, len);
+    return true;
+}
+}  // namespace
+
+TEST_F(LoggerTest, MemorySink) {
+    constexpr size_t         capacity = 4096;
+    mdn_Logger_Sink_t        sink;
+    mdn_Logger_Stats_t       stats;
+    std::array<char, 16>     chunk{};  // Smaller than a record, which then spans several reads
+    std::string              content;
+    std::vector<std::string> lines;
+    size_t                   readLen;
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createMemorySink(&sink, capacity), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, {}));
+    while ((readLen = mdn_Logger_readMemorySink(sink, chunk.data(), chunk.size())) > 0) {
+        content.append(chunk.data(), readLen);
+    }
+    logInfo(std::string(capacity, 'x'));  // Dropped, it can't fit whole
+    ASSERT_EQ(mdn_Logger_readMemorySink(sink, chunk.data(), chunk.size()), 0);
+    ASSERT_EQ(mdn_Logger_getStats(&stats), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_removeSink(sink), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+
+    appendLines(content, lines);
+    ASSERT_EQ(lines.size(), defaultLogLines.size());
+    for (size_t idx = 0; idx < defaultLogLines.size(); ++idx) {
+        ASSERT_EQ(lines[idx].ends_with(defaultLogLines[idx].message), true) << lines[idx];
+    }
+    ASSERT_EQ(stats.streamsArrLen, 1);
+    ASSERT_EQ(stats.streamsArr[0].stream, nullptr);
+    ASSERT_EQ(stats.streamsArr[0].recordsCount, defaultLogLines.size() + 1);
+    ASSERT_EQ(stats.streamsArr[0].writeErrorsCount, 1);
+}
+
+// Sinks are closed once removed or by mdn_Logger_deinit(), and found by their ops and context
+TEST_F(LoggerTest, CallbackAndCustomSinks) {
+    std::vector<std::string> records;
+    RecordingSink            recordingSink;
+    mdn_Logger_Sink_t        callbackSink;
+    const mdn_Logger_Sink_t  customSink = {.ops = &RecordingSink::ops, .context = &recordingSink};
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createCallbackSink(&callbackSink, appendToRecords, &records), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = callbackSink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_JSON}), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = customSink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_LOGFMT}), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, {}));
+    ASSERT_EQ(mdn_Logger_removeSink(callbackSink), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_removeSink(callbackSink), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    logInfo("After removal");
+    ASSERT_EQ(recordingSink.closesCount, 0);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+
+    ASSERT_EQ(records.size(), 3);
+    for (const auto &record : records) {
+        ASSERT_EQ(record.starts_with("{"), true) << record;
+        ASSERT_EQ(record.ends_with("}\n"), true) << record;
+    }
+    // Logged without mdn_Logger_initAsync(), hence record by record
+    ASSERT_EQ(recordingSink.records.size(), defaultLogLines.size() + 1);
+    ASSERT_EQ(recordingSink.writesCount, recordingSink.records.size());
+    ASSERT_EQ(recordingSink.batchesCount, 0);
+    ASSERT_EQ(recordingSink.closesCount, 1);
+}
+
+// The async writer hands the records it dequeued in a row over as a batch, in order, and critical ones right away
+TEST_F(LoggerTest, AsyncSinkBatches) {
+    constexpr size_t        threadsCount   = 4;
+    constexpr size_t        linesPerThread = 2000;
+    RecordingSink           recordingSink;
+    const mdn_Logger_Sink_t customSink = {.ops = &RecordingSink::ops, .context = &recordingSink};
+    std::vector<size_t>     nextLineIdxArr(threadsCount, 0);
+    size_t                  threadIdx;
+    size_t                  lineIdx;
+
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = customSink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    logCritical("Critical");
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+
+    ASSERT_EQ(recordingSink.records.size(), (threadsCount * linesPerThread) + 1);
+    ASSERT_EQ(recordingSink.writesCount, 1);
+    ASSERT_GT(recordingSink.batchesCount, 0);
+    ASSERT_LE(recordingSink.maxBatchLen, 64);
+    for (size_t idx = 0; idx < (threadsCount * linesPerThread); ++idx) {
+        ASSERT_EQ(sscanf(recordingSink.records[idx].substr(recordingSink.records[idx].find("Thread ")).c_str(), "Thread %zu line %zu", &threadIdx, &lineIdx), 2);  // NOLINT(cert-err34-c,hicpp-vararg)
+        ASSERT_EQ(lineIdx, nextLineIdxArr[threadIdx]++);
+    }
+    ASSERT_EQ(recordingSink.records.back().ends_with("Critical\n"), true);
+    ASSERT_EQ(recordingSink.closesCount, 1);
+}
+
+// A batching sink after a stream that writes record by record, in the same format, still gets each record's own line, as
+// the lines of the file (each message is unique) show
+TEST_F(LoggerTest, AsyncSinkBatchesAfterUnbatchedStream) {
+    constexpr size_t               threadsCount   = 4;
+    constexpr size_t               linesPerThread = 500;
+    const std::vector<OutputFiles> outputFiles    = {OutputFiles::LOGGER_OUTPUT_1};
+    RecordingSink                  recordingSink;
+    const mdn_Logger_Sink_t        customSink = {.ops = &RecordingSink::ops, .context = &recordingSink};
+    std::vector<std::string>       fileLines;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    ASSERT_EQ(mdn_Logger_addSink({.sink = customSink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path), fileLines);
+    ASSERT_EQ(fileLines.size(), threadsCount * linesPerThread);
+    ASSERT_EQ(recordingSink.records.size(), fileLines.size());
+    ASSERT_GT(recordingSink.batchesCount, 0);
+    for (size_t idx = 0; idx < fileLines.size(); ++idx) {
+        ASSERT_EQ(recordingSink.records[idx], fileLines[idx] + "\n") << "Record " << idx;
+    }
+}
+
+#if (defined __APPLE__) || (defined __linux__)
+// Records only reach the files by batches: of 3 records for the first, after 50 ms for the second, and right away when critical
+TEST_F(LoggerTest, FdFlushPolicies) {
+    constexpr auto                 pollInterval = std::chrono::milliseconds(10);
+    constexpr auto                 pollTimeout  = std::chrono::seconds(10);
+    const std::vector<OutputFiles> outputFiles  = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    const std::vector<LogLine> logLines = {
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO,     .message = "First"   },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO,     .message = "Second"  },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO,     .message = "Third"   },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO,     .message = "Fourth"  },
+        LogLine{.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_CRITICAL, .message = "Critical"},
+    };
+    mdn_Logger_FdConfig_t countFdConfig;
+    mdn_Logger_FdConfig_t intervalFdConfig;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    countFdConfig = {
+        .fd                = fileno(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].fileToRead),
+        .loggingLevel      = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .loggingFormat     = MDN_LOGGER_LOGGING_FORMAT_FILE,
+        .flushSize         = 0,
+        .flushRecordsCount = 3,
+        .flushIntervalMs   = 60000};  // NOLINT(readability-magic-numbers)
+    intervalFdConfig = {
+        .fd                = fileno(outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].fileToRead),
+        .loggingLevel      = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .loggingFormat     = MDN_LOGGER_LOGGING_FORMAT_FILE,
+        .flushSize         = 0,
+        .flushRecordsCount = 0,
+        .flushIntervalMs   = 50};  // NOLINT(readability-magic-numbers)
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addFd(countFdConfig), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addFd(intervalFdConfig), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs({logLines[0], logLines[1]}, {}));
+    ASSERT_EQ(countLogLines(outputFiles[0]), 0);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs({logLines[2]}, {}));
+    ASSERT_EQ(countLogLines(outputFiles[0]), 3);
+    for (auto waited = std::chrono::milliseconds(0); (countLogLines(outputFiles[1]) < 3) && (waited < pollTimeout); waited += pollInterval) {
+        std::this_thread::sleep_for(pollInterval);
+    }
+    ASSERT_EQ(countLogLines(outputFiles[1]), 3);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs({logLines[3]}, {}));
+    ASSERT_EQ(countLogLines(outputFiles[0]), 3);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs({logLines[4]}, {}));
+    ASSERT_EQ(countLogLines(outputFiles[0]), logLines.size());
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(logLines, outputFiles));
+}
+
+// Records larger than the buffer are written along with the ones buffered before them, in order
+TEST_F(LoggerTest, FdFromMultipleThreads) {
+    constexpr size_t               threadsCount   = 4;
+    constexpr size_t               linesPerThread = 2000;
+    const std::vector<OutputFiles> outputFiles    = {OutputFiles::LOGGER_OUTPUT_1};
+    mdn_Logger_FdConfig_t          fdConfig;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    fdConfig = {
+        .fd                = fileno(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].fileToRead),
+        .loggingLevel      = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .loggingFormat     = MDN_LOGGER_LOGGING_FORMAT_FILE,
+        .flushSize         = 81,  // NOLINT(readability-magic-numbers): about the length of a record, some fit and others don't
+        .flushRecordsCount = 0,
+        .flushIntervalMs   = 0};
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addFd(fdConfig), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_NO_FATAL_FAILURE(verifyLogLinesFormat(outputFiles[0], threadsCount * linesPerThread));
+}
+
+// Same as above through io_uring, with up to 3 batches in flight, or through writev() where io_uring is unavailable
+TEST_F(LoggerTest, FdIoUringFromMultipleThreads) {
+    constexpr size_t               threadsCount   = 4;
+    constexpr size_t               linesPerThread = 2000;
+    const std::vector<OutputFiles> outputFiles    = {OutputFiles::LOGGER_OUTPUT_1};
+    mdn_Logger_FdConfig_t          fdConfig;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    fdConfig = {
+        .fd                = fileno(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].fileToRead),
+        .loggingLevel      = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .loggingFormat     = MDN_LOGGER_LOGGING_FORMAT_FILE,
+        .flushSize         = 81,  // NOLINT(readability-magic-numbers): about the length of a record, some fit and others don't
+        .flushRecordsCount = 0,
+        .flushIntervalMs   = 0,
+        .ioUring           = true};
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addFd(fdConfig), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_NO_FATAL_FAILURE(verifyLogLinesFormat(outputFiles[0], threadsCount * linesPerThread));
+}
+
+// What the FILE buffered before is written first, and the records are all written once the stream is removed
+TEST_F(LoggerTest, OutputStreamIoUring) {
+    const std::vector<OutputFiles> outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+    mdn_Logger_StreamConfig_t      streamConfig;
+    std::vector<std::string>       lines;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    streamConfig         = outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].streamConfig;
+    streamConfig.ioUring = true;
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_GE(fputs("Before\n", streamConfig.stream), 0);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfig), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, {}));
+    ASSERT_EQ(mdn_Logger_removeOutputStream(streamConfig.stream), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path), lines);
+    ASSERT_EQ(lines.size(), defaultLogLines.size() + 1);
+    ASSERT_EQ(lines[0], "Before");
+    for (size_t idx = 0; idx < defaultLogLines.size(); ++idx) {
+        ASSERT_EQ(lines[idx + 1].ends_with(defaultLogLines[idx].message), true) << lines[idx + 1];
+    }
+}
+
+// Through a batch per writev() when logging asynchronously
+TEST_F(LoggerTest, RawFdSinkFromMultipleThreads) {
+    constexpr size_t               threadsCount   = 4;
+    constexpr size_t               linesPerThread = 2000;
+    const std::vector<OutputFiles> outputFiles    = {OutputFiles::LOGGER_OUTPUT_1};
+    mdn_Logger_Sink_t              syncSink;
+    mdn_Logger_Sink_t              asyncSink;
+    int                            fd;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    fd = fileno(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].fileToRead);
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createRawFdSink(&syncSink, fd), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = syncSink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createRawFdSink(&asyncSink, fd), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = asyncSink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_NO_FATAL_FAILURE(verifyLogLinesFormat(outputFiles[0], 2 * threadsCount * linesPerThread));
+}
+
+TEST_F(LoggerTest, MmapFileLogToFile) {
+    const std::vector<OutputFiles> outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+    mdn_Logger_MmapFileConfig_t    mmapFileConfig;
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].streamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    mmapFileConfig = {
+        .path         = outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path.c_str(),
+        .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO,
+        .chunkSize    = 0};
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addMmapFile(mmapFileConfig), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, {}));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(defaultLogLines, outputFiles));
+}
+
+// Small chunks, so that records keep crossing from a mapped window to the next
+TEST_F(LoggerTest, MmapFileFromMultipleThreads) {
+    constexpr size_t               threadsCount   = 8;
+    constexpr size_t               linesPerThread = 500;
+    const std::vector<OutputFiles> outputFiles    = {OutputFiles::LOGGER_OUTPUT_1};
+    mdn_Logger_MmapFileConfig_t    mmapFileConfig;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    mmapFileConfig = {
+        .path         = outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path.c_str(),
+        .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .chunkSize    = 1};
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addMmapFile(mmapFileConfig), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_NO_FATAL_FAILURE(verifyLogLinesFormat(outputFiles[0], threadsCount * linesPerThread));
+}
+#endif  // OS
+
+#if (defined __APPLE__) || (defined __linux__)
+// Records below the level of the other streams only go to the flight recorder, and come back as a FILE stream would have written them
+TEST_F(LoggerTest, FlightRecorderKeepsAllLevels) {
+    const std::vector<OutputFiles>          outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    const std::string                       path                 = (testOutputDirPath / (testFullName + ".mdnf")).string();
+    const mdn_Logger_FlightRecorderConfig_t flightRecorderConfig = {
+        .path         = path.c_str(),
+        .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .ringSize     = 0};
+    mdn_Logger_Stats_t stats;
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].streamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG;
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_ERROR;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addOutputStream(outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addFlightRecorder(flightRecorderConfig), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(MDN_LOGGER_IS_LEVEL_ENABLED(MDN_LOGGER_LOGGING_LEVEL_DEBUG), true);
+    ASSERT_EQ(mdn_Logger_addOutputStream(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].streamConfig), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, {}));
+    MDN_LOGGER_LOG_DEBUG("Arguments %d %s %.2f %p", -1, "string", 0.5, static_cast<void *>(&stats));  // NOLINT(hicpp-vararg,readability-magic-numbers)
+    MDN_LOGGER_LOG_INFO("Formatted message of %zu bytes", sizeof("formatted"));                      // NOLINT(hicpp-vararg)
+    ASSERT_EQ(mdn_Logger_getStats(&stats), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(stats.streamsArrLen, 3);
+    ASSERT_EQ(stats.streamsArr[1].stream, nullptr);
+    ASSERT_EQ(stats.streamsArr[1].loggingFormat, MDN_LOGGER_LOGGING_FORMAT_BINARY);
+    ASSERT_EQ(stats.streamsArr[1].recordsCount, stats.streamsArr[2].recordsCount);
+    ASSERT_EQ(stats.streamsArr[1].writeErrorsCount, 0);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_EQ(readFileContent(extractFlightRecorderFile(path)), readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path));
+
+    // Text files aren't flight recorders
+    FILE *textStream = fopen(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path.c_str(), "rb");
+    ASSERT_NE(textStream, nullptr);
+    ASSERT_EQ(mdn_Logger_extractFlightRecorder(textStream, stdout), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(fclose(textStream), 0);
+}
+
+// The process dies with the ring wrapped several times: the latest records are all there, in order
+TEST_F(LoggerTest, FlightRecorderSurvivesCrash) {
+    constexpr int                           linesCount           = 20000;
+    const std::string                       path                 = (testOutputDirPath / (testFullName + ".mdnf")).string();
+    const mdn_Logger_FlightRecorderConfig_t flightRecorderConfig = {
+        .path         = path.c_str(),
+        .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .ringSize     = 1};  // Two blocks
+    std::vector<std::string> lines;
+    std::string              line;
+    std::istringstream       decoded;
+    int                      lineIdx;
+
+    const auto logAndCrash = [this, &flightRecorderConfig]() {
+        (void)mdn_Logger_init();
+        (void)mdn_Logger_addFlightRecorder(flightRecorderConfig);
+        for (int idx = 0; idx < linesCount; ++idx) {
+            MDN_LOGGER_LOG_DEBUG("Line %d of %s", idx, "the crashing process");  // NOLINT(hicpp-vararg)
+        }
+        std::abort();
+    };
+
+    ASSERT_DEATH(logAndCrash(), "");
+
+    decoded.str(readFileContent(extractFlightRecorderFile(path)));
+    while (std::getline(decoded, line)) {
+        lines.push_back(line);
+    }
+    ASSERT_GT(lines.size(), 1000);
+    ASSERT_LT(lines.size(), linesCount);
+    lineIdx = linesCount - static_cast<int>(lines.size());
+    for (const auto &decodedLine : lines) {
+        ASSERT_NE(decodedLine.find("Line " + std::to_string(lineIdx) + " of the crashing process"), std::string::npos) << decodedLine;
+        ++lineIdx;
+    }
+}
+#endif  // OS
+
+#if (defined __APPLE__) || (defined __linux__)
+TEST_F(LoggerTest, RotatingFileBySize) {
+    constexpr size_t                      linesCount    = 2000;
+    constexpr unsigned                    retainedCount = 1000;  // Enough to keep every line
+    const std::string                     path          = (testOutputDirPath / (testFullName + ".log")).string();
+    const mdn_Logger_RotatingFileConfig_t config        = {
+               .path                = path.c_str(),
+               .loggingLevel        = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+               .maxFileSize         = 4096,
+               .rotationIntervalSec = 0,
+               .retainedCount       = retainedCount,
+               .compress            = false};
+    std::vector<std::string> lines;
+
+    removeRotatedFiles(path);
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addRotatingFile(config), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(1, linesCount));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+
+    ASSERT_EQ(fs::exists(path + ".1"), true);
+    lines = readRotatedLines(path, retainedCount, false);
+    ASSERT_EQ(lines.size(), linesCount);
+    ASSERT_NO_FATAL_FAILURE(verifyRotatedLines(lines, linesCount));
+}
+
+TEST_F(LoggerTest, RotatingFileCompressedWithRetention) {
+    constexpr size_t                      batchesCount  = 4;
+    constexpr size_t                      linesPerBatch = 200;
+    constexpr size_t                      linesCount    = batchesCount * linesPerBatch;
+    constexpr unsigned                    retainedCount = 2;
+    const std::string                     path          = (testOutputDirPath / (testFullName + ".log")).string();
+    const mdn_Logger_RotatingFileConfig_t config        = {
+               .path                = path.c_str(),
+               .loggingLevel        = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+               .maxFileSize         = 4096,
+               .rotationIntervalSec = 0,
+               .retainedCount       = retainedCount,
+               .compress            = true};
+    std::vector<std::string> lines;
+
+    removeRotatedFiles(path);
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addRotatingFile(config), MDN_STATUS_SUCCESS);
+    // Waits for each batch to be rotated away, so that more files are rotated than retained
+    for (size_t batchIdx = 0; batchIdx < batchesCount; ++batchIdx) {
+        for (size_t lineIdx = batchIdx * linesPerBatch; lineIdx < (batchIdx + 1) * linesPerBatch; ++lineIdx) {
+            MDN_LOGGER_LOG_INFO("Thread %zu line %zu", size_t{0}, lineIdx);  // NOLINT(hicpp-vararg)
+        }
+        while (fs::file_size(path) >= config.maxFileSize) {
+            std::this_thread::yield();
+        }
+    }
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+
+    ASSERT_EQ(fs::exists(path + ".1"), false);
+    ASSERT_EQ(fs::exists(path + ".1.mdnz"), true);
+    ASSERT_EQ(fs::exists(path + ".3.mdnz"), false);
+    ASSERT_LT(fs::file_size(path + ".1.mdnz"), decompressFile(path + ".1.mdnz").size());
+    lines = readRotatedLines(path, retainedCount, true);
+    ASSERT_LT(lines.size(), linesCount);
+    ASSERT_NO_FATAL_FAILURE(verifyRotatedLines(lines, linesCount));
+}
+
+// A new run appends to the file of the previous one, and rotates it away first if it's already too big
+TEST_F(LoggerTest, RotatingFileReopened) {
+    constexpr auto                  pollInterval  = std::chrono::milliseconds(10);
+    constexpr auto                  pollTimeout   = std::chrono::seconds(10);
+    constexpr size_t                linesPerRun   = 100;
+    constexpr size_t                maxFileSize   = 4096;
+    constexpr unsigned              retainedCount = 1000;  // Enough to keep every line
+    const std::string               path          = (testOutputDirPath / (testFullName + ".log")).string();
+    mdn_Logger_RotatingFileConfig_t config        = {
+               .path                = path.c_str(),
+               .loggingLevel        = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+               .maxFileSize         = 0,
+               .rotationIntervalSec = 0,
+               .retainedCount       = retainedCount,
+               .compress            = false};
+    std::vector<std::string> lines;
+
+    removeRotatedFiles(path);
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addRotatingFile(config), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(1, linesPerRun));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_GT(fs::file_size(path), maxFileSize);
+
+    config.maxFileSize = maxFileSize;
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addRotatingFile(config), MDN_STATUS_SUCCESS);
+    for (auto waited = std::chrono::milliseconds(0); !fs::exists(path + ".1") && (waited < pollTimeout); waited += pollInterval) {
+        std::this_thread::sleep_for(pollInterval);
+    }
+    ASSERT_EQ(fs::exists(path + ".1"), true);
+    for (size_t lineIdx = linesPerRun; lineIdx < (2 * linesPerRun); ++lineIdx) {
+        MDN_LOGGER_LOG_INFO("Thread %zu line %zu", size_t{0}, lineIdx);  // NOLINT(hicpp-vararg)
+    }
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+
+    lines = readRotatedLines(path, retainedCount, false);
+    ASSERT_EQ(lines.size(), 2 * linesPerRun);
+    ASSERT_NO_FATAL_FAILURE(verifyRotatedLines(lines, 2 * linesPerRun));
+}
+
+TEST_F(LoggerTest, RotatingFileByTime) {
+    constexpr auto                        sleepDuration = std::chrono::milliseconds(1500);
+    const std::string                     path          = (testOutputDirPath / (testFullName + ".log")).string();
+    const mdn_Logger_RotatingFileConfig_t config        = {
+               .path                = path.c_str(),
+               .loggingLevel        = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+               .maxFileSize         = 0,
+               .rotationIntervalSec = 1,
+               .retainedCount       = 1,
+               .compress            = false};
+    std::vector<std::string> lines;
+
+    removeRotatedFiles(path);
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addRotatingFile(config), MDN_STATUS_SUCCESS);
+    MDN_LOGGER_LOG_INFO("Thread %zu line %zu", size_t{0}, size_t{0});  // NOLINT(hicpp-vararg)
+    std::this_thread::sleep_for(sleepDuration);
+    MDN_LOGGER_LOG_INFO("Thread %zu line %zu", size_t{0}, size_t{1});  // NOLINT(hicpp-vararg)
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+
+    lines.clear();
+    appendLines(readFileContent(path + ".1"), lines);
+    ASSERT_EQ(lines.size(), 1);
+    lines = readRotatedLines(path, 1, false);
+    ASSERT_EQ(lines.size(), 2);
+    ASSERT_NO_FATAL_FAILURE(verifyRotatedLines(lines, 2));
+}
+#endif  // OS
+
+TEST_F(LoggerTest, AsyncLogToMultipleFiles) {
+    const std::vector<OutputFiles> outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, outputFiles));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(defaultLogLines, outputFiles));
+}
+
+TEST_F(LoggerTest, AsyncFullPolicies) {
+    constexpr size_t                   threadsCount   = 4;
+    constexpr size_t                   linesPerThread = 2000;
+    const std::vector<OutputFiles>     outputFiles    = {OutputFiles::LOGGER_OUTPUT_1};
+    const mdn_Logger_asyncFullPolicy_t fullPolicies[] = {
+        MDN_LOGGER_ASYNC_FULL_POLICY_BLOCK,
+        MDN_LOGGER_ASYNC_FULL_POLICY_DROP_NEWEST,
+        MDN_LOGGER_ASYNC_FULL_POLICY_OVERWRITE_OLDEST,
+    };
+    mdn_Logger_AsyncConfig_t asyncConfig = asyncConfigDefault;
+    mdn_Logger_AsyncStats_t  asyncStats;
+    mdn_Logger_Stats_t       stats;
+
+    asyncConfig.queueCapacity = 4;
+    for (const auto fullPolicy : fullPolicies) {
+        asyncConfig.fullPolicy = fullPolicy;
+
+        ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+        ASSERT_EQ(mdn_Logger_initAsync(asyncConfig), MDN_STATUS_SUCCESS);
+        ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+        ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+        ASSERT_EQ(mdn_Logger_getAsyncStats(&asyncStats), MDN_STATUS_SUCCESS);
+        ASSERT_EQ(mdn_Logger_getStats(&stats), MDN_STATUS_SUCCESS);
+        ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+        ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+        ASSERT_EQ(countLogLines(outputFiles[0]) + asyncStats.droppedCount + asyncStats.overwrittenCount, threadsCount * linesPerThread);
+        ASSERT_EQ(stats.asyncQueueCapacity, asyncConfig.queueCapacity);
+        ASSERT_LE(stats.asyncQueueDepth, stats.asyncQueueCapacity);
+        ASSERT_EQ(stats.asyncDroppedCount, asyncStats.droppedCount);
+        ASSERT_EQ(stats.asyncOverwrittenCount, asyncStats.overwrittenCount);
+        if (fullPolicy != MDN_LOGGER_ASYNC_FULL_POLICY_DROP_NEWEST) {
+            ASSERT_EQ(asyncStats.droppedCount, 0);
+        }
+        if (fullPolicy != MDN_LOGGER_ASYNC_FULL_POLICY_OVERWRITE_OLDEST) {
+            ASSERT_EQ(asyncStats.overwrittenCount, 0);
+        }
+    }
+}
+
+// Records below the level of a stream only reach it when their thread logs an error, right before it
+TEST_F(LoggerTest, BacktraceFlushedOnError) {
+    const std::vector<OutputFiles> outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    const std::vector<std::string> expectedInfoMessages = {
+        "Info", "Warning", "Backtrace start", "Debug 1", "Debug 2", "Backtrace end", "Error", "Second error",
+    };
+    const std::vector<std::string> expectedWarningMessages = {
+        "Warning", "Backtrace start", "Info", "Debug 1", "Debug 2", "Backtrace end", "Error", "Second error",
+    };
+    std::vector<std::string> infoLines;
+    std::vector<std::string> warningLines;
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].streamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_INFO;
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING;
+
+    for (const bool async : {false, true}) {
+        infoLines.clear();
+        warningLines.clear();
+
+        ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+        ASSERT_EQ(async ? mdn_Logger_initAsync(asyncConfigDefault) : mdn_Logger_init(), MDN_STATUS_SUCCESS);
+        ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+        ASSERT_EQ(MDN_LOGGER_IS_LEVEL_ENABLED(MDN_LOGGER_LOGGING_LEVEL_DEBUG), false);
+        ASSERT_EQ(mdn_Logger_enableBacktrace(backtraceConfigDefault), MDN_STATUS_SUCCESS);
+        ASSERT_EQ(MDN_LOGGER_IS_LEVEL_ENABLED(MDN_LOGGER_LOGGING_LEVEL_DEBUG), true);
+        // NOLINTBEGIN(hicpp-vararg)
+        MDN_LOGGER_LOG_DEBUG("Aged out 1");
+        MDN_LOGGER_LOG_DEBUG("Aged out 2");
+        MDN_LOGGER_LOG_INFO("Info");
+        MDN_LOGGER_LOG_DEBUG("Debug %d", 1);
+        MDN_LOGGER_LOG_DEBUG("Debug %d", 2);
+        MDN_LOGGER_LOG_WARNING("Warning");
+        MDN_LOGGER_LOG_ERROR("Error");
+        // Held back by another thread, which is the only one that could flush it
+        std::thread([this]() { MDN_LOGGER_LOG_DEBUG("Other thread"); }).join();
+        MDN_LOGGER_LOG_ERROR("Second error");
+        MDN_LOGGER_LOG_DEBUG("Never flushed");
+        // NOLINTEND(hicpp-vararg)
+        ASSERT_EQ(mdn_Logger_disableBacktrace(), MDN_STATUS_SUCCESS);
+        ASSERT_EQ(MDN_LOGGER_IS_LEVEL_ENABLED(MDN_LOGGER_LOGGING_LEVEL_DEBUG), false);
+        ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+        ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+        appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path), infoLines);
+        appendLines(readFileContent(outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].path), warningLines);
+        ASSERT_EQ(infoLines.size(), expectedInfoMessages.size());
+        for (size_t idx = 0; idx < infoLines.size(); ++idx) {
+            ASSERT_EQ(infoLines[idx].ends_with("| " + expectedInfoMessages[idx]), true) << "Unexpected line:\n"
+                                                                                         << infoLines[idx];
+        }
+        ASSERT_EQ(warningLines.size(), expectedWarningMessages.size());
+        for (size_t idx = 0; idx < warningLines.size(); ++idx) {
+            ASSERT_EQ(warningLines[idx].ends_with("| " + expectedWarningMessages[idx]), true) << "Unexpected line:\n"
+                                                                                               << warningLines[idx];
+        }
+        // Held back records keep their own level
+        ASSERT_NE(warningLines[3].find(" DEBUG "), std::string::npos);
+    }
+}
+
+TEST_F(LoggerTest, Stats) {
+    constexpr size_t               threadsCount       = 4;
+    constexpr size_t               linesPerThread     = 1000;
+    constexpr unsigned             sampleEvery        = 4;
+    constexpr size_t               latencySampleEvery = 64;
+    const std::vector<OutputFiles> outputFiles        = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    mdn_Logger_Stats_t stats;
+    uint64_t           latencyBucketsSum = 0;
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_WARNING;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, outputFiles));
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    for (size_t callIdx = 0; callIdx < sampleEvery; ++callIdx) {
+        MDN_LOGGER_LOG_DEBUG_SAMPLED(sampleEvery, "Sampled message");  // NOLINT(hicpp-vararg)
+    }
+    for (size_t callIdx = 0; callIdx < 2; ++callIdx) {
+        MDN_LOGGER_LOG_WARNING_RATE_LIMITED(1, 1, "Rate limited message");  // NOLINT(hicpp-vararg)
+    }
+    ASSERT_EQ(mdn_Logger_getStats(&stats), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_EQ(stats.recordsCountArr[MDN_LOGGER_LOGGING_LEVEL_DEBUG], 2);
+    ASSERT_EQ(stats.recordsCountArr[MDN_LOGGER_LOGGING_LEVEL_INFO], 1 + (threadsCount * linesPerThread));
+    ASSERT_EQ(stats.recordsCountArr[MDN_LOGGER_LOGGING_LEVEL_WARNING], 2);
+    ASSERT_EQ(stats.recordsCountArr[MDN_LOGGER_LOGGING_LEVEL_ERROR], 1);
+    ASSERT_EQ(stats.recordsCountArr[MDN_LOGGER_LOGGING_LEVEL_CRITICAL], 1);
+    ASSERT_EQ(stats.filteredCount, (sampleEvery - 1) + 1);
+
+    // Threads may take over the counters of exited ones, so where their sampling starts isn't known
+    ASSERT_GE(stats.latencySampledCount, threadsCount * (linesPerThread / latencySampleEvery));
+    for (const auto bucketCount : stats.latencyBucketsArr) {
+        latencyBucketsSum += bucketCount;
+    }
+    ASSERT_EQ(latencyBucketsSum, stats.latencySampledCount);
+    ASSERT_GT(stats.latencyTotalNs, 0);
+
+    ASSERT_EQ(stats.asyncQueueCapacity, 0);
+    ASSERT_EQ(stats.streamsArrLen, outputFiles.size());
+    ASSERT_EQ(stats.streamsArr[0].recordsCount, 7 + (threadsCount * linesPerThread));
+    ASSERT_EQ(stats.streamsArr[1].recordsCount, 4);
+    for (size_t streamIdx = 0; streamIdx < outputFiles.size(); ++streamIdx) {
+        const auto &outputFileRef = outputFilesInfo[static_cast<std::size_t>(outputFiles[streamIdx])];
+
+        ASSERT_EQ(stats.streamsArr[streamIdx].loggingFormat, MDN_LOGGER_LOGGING_FORMAT_FILE);
+        ASSERT_EQ(stats.streamsArr[streamIdx].bytesCount, fs::file_size(outputFileRef.path));
+        ASSERT_EQ(stats.streamsArr[streamIdx].writeErrorsCount, 0);
+    }
+}
+
+TEST_F(LoggerTest, StatsWriteErrorsAndDump) {
+    const std::string            readOnlyPath    = (testOutputDirPath / (testFullName + ".log")).string();
+    const std::string            dumpPath        = (testOutputDirPath / (testFullName + ".prom")).string();
+    const std::string            message         = "Not written";
+    mdn_Logger_StreamConfig_t    streamConfig    = streamConfigDefault;
+    mdn_Logger_StatsDumpConfig_t statsDumpConfig = {
+        .path       = dumpPath.c_str(),
+        .intervalMs = 10};
+    mdn_Logger_Stats_t stats;
+    FILE              *readOnlyFile;
+    std::string        dump;
+
+    readOnlyFile = fopen(readOnlyPath.c_str(), "w");
+    ASSERT_NE(readOnlyFile, nullptr);
+    ASSERT_EQ(fclose(readOnlyFile), 0);
+    readOnlyFile = fopen(readOnlyPath.c_str(), "r");
+    ASSERT_NE(readOnlyFile, nullptr);
+    streamConfig.stream        = readOnlyFile;
+    streamConfig.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE;
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfig), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_startStatsDump(statsDumpConfig), MDN_STATUS_SUCCESS);
+    logInfo(message);
+    ASSERT_EQ(mdn_Logger_getStats(&stats), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);  // Writes a last dump
+    ASSERT_EQ(fclose(readOnlyFile), 0);
+
+    ASSERT_EQ(stats.streamsArrLen, 1);
+    ASSERT_EQ(stats.streamsArr[0].stream, readOnlyFile);
+    ASSERT_EQ(stats.streamsArr[0].recordsCount, 1);
+    ASSERT_GT(stats.streamsArr[0].bytesCount, message.size());
+    ASSERT_EQ(stats.streamsArr[0].writeErrorsCount, 1);
+
+    dump = readFileContent(dumpPath);
+    ASSERT_NE(dump.find("# TYPE mdn_logger_records_total counter\n"), std::string::npos) << dump;
+    ASSERT_NE(dump.find("mdn_logger_records_total{level=\"info\"} 1\n"), std::string::npos) << dump;
+    ASSERT_NE(dump.find("mdn_logger_stream_bytes_total{stream=\"0\",format=\"file\"} " + std::to_string(stats.streamsArr[0].bytesCount) + "\n"), std::string::npos) << dump;
+    ASSERT_NE(dump.find("mdn_logger_stream_write_errors_total{stream=\"0\",format=\"file\"} 1\n"), std::string::npos) << dump;
+    ASSERT_NE(dump.find("# HELP mdn_logger_log_duration_seconds Time spent in logging calls, measured on one call in 64 of each thread.\n"), std::string::npos) << dump;
+    ASSERT_NE(dump.find("mdn_logger_log_duration_seconds_bucket{le=\"+Inf\"} "), std::string::npos) << dump;
+    ASSERT_FALSE(fs::exists(dumpPath + ".tmp"));
+}
+
+TEST_F(LoggerTest, BinaryDecodesToFileFormat) {
+    constexpr int                  linesCount  = 100;
+    const std::vector<OutputFiles> outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    const char *const partialStr = "abcdef";
+    int               value      = 0;
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_BINARY;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_setTimestampPrecision(MDN_LOGGER_TIMESTAMP_PRECISION_NSEC), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    // NOLINTBEGIN(hicpp-vararg,readability-magic-numbers)
+    for (int lineIdx = 0; lineIdx < linesCount; ++lineIdx) {
+        MDN_LOGGER_LOG_INFO("Line %d of %d, %s", lineIdx, linesCount, "repeated");
+    }
+    MDN_LOGGER_LOG_DEBUG("Signed %hhd %hd %ld %lld %jd %td %zd", static_cast<signed char>(-1), static_cast<short>(-2), -3L, LLONG_MIN, static_cast<intmax_t>(-5), static_cast<ptrdiff_t>(-6), static_cast<size_t>(7));
+    MDN_LOGGER_LOG_WARNING("Unsigned %u %#x %X %o %lu %llu %zu", UINT_MAX, 0xABCU, 0xDEFU, 8U, ULONG_MAX, ULLONG_MAX, SIZE_MAX);
+    MDN_LOGGER_LOG_ERROR("Floating %f %.3e %g %10.2f %La", 3.14159, -2.5e10, 0.0001, 42.0, 1.5L);
+    MDN_LOGGER_LOG_CRITICAL("Strings [%s] [%10s] [%-10s] [%.3s] [%.*s] [%c]", "plain", "right", "left", "truncated", 2, partialStr, 'z');
+    MDN_LOGGER_LOG_INFO("Widths [%*d] [%-*d] [%.*f] [%.*d] 100%%", 6, 1, 6, 2, 2, 1.0, -1, 3);
+    MDN_LOGGER_LOG_INFO("Pointer %p", static_cast<void *>(&value));
+    MDN_LOGGER_LOG_INFO("Wide string %ls falls back to text", L"wide");
+    MDN_LOGGER_LOG_INFO("No conversions at all");
+    // NOLINTEND(hicpp-vararg,readability-magic-numbers)
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    const auto &fileOutputPath   = outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path;
+    const auto &binaryOutputPath = outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].path;
+    const auto  decodedPath      = decodeBinaryOutputFile(outputFiles[1]);
+    ASSERT_EQ(readFileContent(decodedPath), readFileContent(fileOutputPath));
+    ASSERT_LT(fs::file_size(binaryOutputPath), fs::file_size(fileOutputPath));
+
+    // Text files aren't binary logs
+    FILE *textStream = fopen(fileOutputPath.c_str(), "rb");
+    ASSERT_NE(textStream, nullptr);
+    ASSERT_EQ(mdn_Logger_decodeBinary(textStream, stdout), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(fclose(textStream), 0);
+}
+
+TEST_F(LoggerTest, CompressedMatchesPlainFile) {
+    constexpr size_t               linesCount  = 8000;  // Several blocks
+    const std::vector<OutputFiles> outputFiles = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    constexpr size_t expectedMinRatio = 3;
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.compressed = true;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(1, linesCount));  // The two files only match when records come in the same order
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    const auto &plainPath      = outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path;
+    const auto &compressedPath = outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].path;
+    const auto  plainContent   = readFileContent(plainPath);
+    ASSERT_EQ(decompressFile(compressedPath), plainContent);
+    ASSERT_LT(fs::file_size(compressedPath) * expectedMinRatio, plainContent.size());
+
+    // A log cut in the middle of a block is restored up to the previous block
+    const auto truncatedPath = compressedPath + ".truncated";
+    fs::copy_file(compressedPath, truncatedPath, fs::copy_options::overwrite_existing);
+    fs::resize_file(truncatedPath, fs::file_size(compressedPath) - 1);
+    const auto truncatedContent = decompressFile(truncatedPath);
+    ASSERT_LT(truncatedContent.size(), plainContent.size());
+    ASSERT_EQ(plainContent.starts_with(truncatedContent), true);
+
+    // Text files aren't compressed logs
+    FILE *textStream = fopen(plainPath.c_str(), "rb");
+    ASSERT_NE(textStream, nullptr);
+    ASSERT_EQ(mdn_Logger_decompress(textStream, stdout), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(fclose(textStream), 0);
+}
+
+TEST_F(LoggerTest, BinaryFromMultipleThreads) {
+    constexpr size_t               threadsCount   = 8;
+    constexpr size_t               linesPerThread = 500;
+    const std::vector<OutputFiles> outputFiles    = {
+        OutputFiles::LOGGER_OUTPUT_1,
+        OutputFiles::LOGGER_OUTPUT_2,
+    };
+    const auto sortedLines = [](const std::string &path) {
+        auto                     binaryFileReader = BinaryFileReader(path);
+        std::vector<std::string> lines;
+        std::string              line;
+
+        while (binaryFileReader.getLine(line)) {
+            lines.push_back(line);
+        }
+        std::ranges::sort(lines);
+        return lines;
+    };
+
+    outputFilesInfo[static_cast<std::size_t>(outputFiles[1])].streamConfig.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_BINARY;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    const auto decodedPath = decodeBinaryOutputFile(outputFiles[1]);
+    ASSERT_EQ(sortedLines(decodedPath), sortedLines(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].path));
+}
+
+#if (defined __APPLE__) || (defined __linux__)
+namespace {
+// The collector side of the Unix socket sink, bound to 'path'. Datagram sockets are read without waiting, seqpacket ones accept
+// the sink's connection and read until it is closed.
+class UnixSocketCollector {  // NOLINT(hicpp-special-member-functions)
+public:
+    UnixSocketCollector(std::string socketPath, int type)
+        : path(std::move(socketPath)), fd(socket(AF_UNIX, type, 0)) {
+        sockaddr_un address{};
+
+        address.sun_family = AF_UNIX;
+        path.copy(static_cast<char *>(address.sun_path), sizeof(address.sun_path) - 1);
+        (void)unlink(path.c_str());
+        bound = (bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0) && ((type == SOCK_DGRAM) || (listen(fd, 1) == 0));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    ~UnixSocketCollector() {
+        (void)close(fd);
+        (void)unlink(path.c_str());
+    }
+
+    [[nodiscard]] bool isBound() const {
+        return bound;
+    }
+
+    // Returns the count of datagrams read
+    size_t receiveAvailable(std::string &content) const {
+        return receiveFrom(fd, MSG_DONTWAIT, content);
+    }
+
+    size_t receiveConnection(std::string &content) const {
+        const int connectionFd   = accept(fd, nullptr, nullptr);
+        size_t    datagramsCount = receiveFrom(connectionFd, 0, content);
+
+        (void)close(connectionFd);
+        return datagramsCount;
+    }
+
+private:
+    static size_t receiveFrom(int fromFd, int flags, std::string &content) {
+        std::vector<char> buffer(64 * 1024);  // NOLINT(readability-magic-numbers): above the sink's datagram size
+        ssize_t           len;
+        size_t            datagramsCount = 0;
+
+        while ((len = recv(fromFd, buffer.data(), buffer.size(), flags)) > 0) {
+            content.append(buffer.data(), static_cast<size_t>(len));
+            ++datagramsCount;
+        }
+        return datagramsCount;
+    }
+
+    std::string path;
+    int         fd;
+    bool        bound = false;
+};
+}  // namespace
+
+// Records logged while the collector is away are held, then sent packed into a single datagram once the sink reconnected,
+// and records that don't fit are dropped
+TEST_F(LoggerTest, UnixSocketSinkReconnects) {
+    constexpr auto                      reconnectWait = std::chrono::milliseconds(150);
+    const std::string                   path          = (fs::temp_directory_path() / (testFullName + ".sock")).string();
+    const mdn_Logger_UnixSocketConfig_t config        = {
+        .path         = path.c_str(),
+        .seqPacket    = false,
+        .datagramSize = 0,
+        .spillSize    = 1024};  // NOLINT(readability-magic-numbers)
+    const std::vector<std::string>     messages = {"Held 1", "Held 2", "Reconnected", "Refused by the restarted collector", "Reconnected again"};
+    mdn_Logger_Sink_t                  sink;
+    mdn_Logger_Stats_t                 stats;
+    std::optional<UnixSocketCollector> collector;
+    std::string                        content;
+    std::vector<std::string>           lines;
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createUnixSocketSink(&sink, config), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    logInfo(messages[0]);
+    logInfo(std::string(config.spillSize, 'x'));  // Dropped
+    logInfo(messages[1]);
+    collector.emplace(path, SOCK_DGRAM);
+    ASSERT_TRUE(collector->isBound());
+    std::this_thread::sleep_for(reconnectWait);
+    logInfo(messages[2]);
+    ASSERT_EQ(collector->receiveAvailable(content), 1);
+    collector.reset();
+    collector.emplace(path, SOCK_DGRAM);
+    ASSERT_TRUE(collector->isBound());
+    logInfo(messages[3]);  // Still connected to the former collector's socket
+    std::this_thread::sleep_for(reconnectWait);
+    logInfo(messages[4]);
+    ASSERT_EQ(collector->receiveAvailable(content), 1);
+    ASSERT_EQ(mdn_Logger_getStats(&stats), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+
+    appendLines(content, lines);
+    ASSERT_EQ(lines.size(), messages.size());
+    for (size_t idx = 0; idx < messages.size(); ++idx) {
+        ASSERT_EQ(std::regex_match(lines[idx], loggingFormatToRegexMap[MDN_LOGGER_LOGGING_FORMAT_FILE]), true) << lines[idx];
+        ASSERT_EQ(lines[idx].ends_with(messages[idx]), true) << lines[idx];
+    }
+    ASSERT_EQ(stats.streamsArr[0].writeErrorsCount, 1);
+}
+
+// The records of each batch of the async writer are packed into as few datagrams as fit, all sent by the time the sink is closed
+TEST_F(LoggerTest, UnixSocketSinkSeqPacketFromMultipleThreads) {
+    constexpr size_t                    threadsCount   = 4;
+    constexpr size_t                    linesPerThread = 500;
+    const std::string                   path           = (fs::temp_directory_path() / (testFullName + ".sock")).string();
+    const mdn_Logger_UnixSocketConfig_t config         = {
+        .path         = path.c_str(),
+        .seqPacket    = true,
+        .datagramSize = 0,
+        .spillSize    = 0};
+    const UnixSocketCollector collector(path, SOCK_SEQPACKET);
+    mdn_Logger_Sink_t         sink;
+    std::string               content;
+    size_t                    datagramsCount = 0;
+    std::vector<std::string>  lines;
+
+    ASSERT_TRUE(collector.isBound());
+    std::thread receiver([&collector, &content, &datagramsCount]() {
+        datagramsCount = collector.receiveConnection(content);
+    });
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createUnixSocketSink(&sink, config), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    receiver.join();
+
+    appendLines(content, lines);
+    ASSERT_EQ(lines.size(), threadsCount * linesPerThread);
+    for (const auto &line : lines) {
+        ASSERT_EQ(std::regex_match(line, loggingFormatToRegexMap[MDN_LOGGER_LOGGING_FORMAT_FILE]), true) << line;
+    }
+    ASSERT_LE(datagramsCount, lines.size());
+}
+#endif  // OS
+
+#if (defined __APPLE__) || (defined __linux__)
+namespace {
+// Short enough for macOS, which allows 31 characters
+std::string shmRingName() {
+    return "/mdn_logger_test_" + std::to_string(getpid());
+}
+
+// Collects the records of a shared memory ring per producer
+bool appendShmRingRecord(int pid, const char *data, size_t len, void *userData) {
+    (*static_cast<std::map<int, std::string> *>(userData))[pid].append(data, len);
+    return true;
+}
+
+// What each worker process does, it reports failures through its exit code. 'testFullName' is what MDN_LOGGER_FUNC_NAME logs.
+bool produceIntoShmRing(const mdn_Logger_ShmRingConfig_t &config, int producerIdx, int linesCount, const std::string &testFullName) {
+    mdn_Logger_Sink_t sink;
+
+    if ((mdn_Logger_init() != MDN_STATUS_SUCCESS) || (mdn_Logger_createShmRingSink(&sink, config) != MDN_STATUS_SUCCESS)
+        || (mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}) != MDN_STATUS_SUCCESS)) {
+        return false;
+    }
+    for (int lineIdx = 0; lineIdx < linesCount; ++lineIdx) {
+        MDN_LOGGER_LOG_INFO("Line %d of producer %d", lineIdx, producerIdx);  // NOLINT(hicpp-vararg)
+    }
+    return mdn_Logger_deinit() == MDN_STATUS_SUCCESS;
+}
+}  // namespace
+
+// Worker processes write into the same ring, which is drained while they run: the records of each come out whole and in order
+TEST_F(LoggerTest, ShmRingSinkFromMultipleProcesses) {
+    constexpr int                    producersCount   = 3;
+    constexpr int                    linesPerProducer = 300;
+    const std::string                name             = shmRingName();
+    const mdn_Logger_ShmRingConfig_t config           = {.name = name.c_str(), .ringSize = 0};
+    mdn_Logger_ShmRingDrain_t       *drain;
+    mdn_Logger_ShmRingStats_t        stats;
+    std::map<int, std::string>       contentByPid;
+    std::vector<pid_t>               pids;
+    std::vector<std::string>         lines;
+    int                              waitStatus;
+
+    (void)shm_unlink(name.c_str());
+    ASSERT_EQ(mdn_Logger_openShmRingDrain(&drain, config), MDN_STATUS_SUCCESS);
+    for (int producerIdx = 0; producerIdx < producersCount; ++producerIdx) {
+        const pid_t pid = fork();
+
+        if (pid == 0) {
+            _exit(produceIntoShmRing(config, producerIdx, linesPerProducer, testFullName) ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+        ASSERT_GT(pid, 0);
+        pids.push_back(pid);
+    }
+    for (size_t exitedCount = 0; exitedCount < pids.size();) {
+        ASSERT_EQ(mdn_Logger_drainShmRing(drain, appendShmRingRecord, &contentByPid, nullptr), MDN_STATUS_SUCCESS);
+        if (waitpid(-1, &waitStatus, WNOHANG) > 0) {
+            ASSERT_TRUE(WIFEXITED(waitStatus) && (WEXITSTATUS(waitStatus) == EXIT_SUCCESS));
+            ++exitedCount;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    ASSERT_EQ(mdn_Logger_drainShmRing(drain, appendShmRingRecord, &contentByPid, nullptr), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_getShmRingStats(drain, &stats), MDN_STATUS_SUCCESS);
+    mdn_Logger_closeShmRingDrain(drain);
+    (void)shm_unlink(name.c_str());
+
+    ASSERT_EQ(contentByPid.size(), producersCount);
+    for (int producerIdx = 0; producerIdx < producersCount; ++producerIdx) {
+        lines.clear();
+        appendLines(contentByPid[pids[static_cast<size_t>(producerIdx)]], lines);
+        ASSERT_EQ(lines.size(), linesPerProducer);
+        for (size_t lineIdx = 0; lineIdx < lines.size(); ++lineIdx) {
+            ASSERT_EQ(std::regex_match(lines[lineIdx], loggingFormatToRegexMap[MDN_LOGGER_LOGGING_FORMAT_FILE]), true) << lines[lineIdx];
+            ASSERT_EQ(lines[lineIdx].ends_with("Line " + std::to_string(lineIdx) + " of producer " + std::to_string(producerIdx)), true) << lines[lineIdx];
+        }
+    }
+    ASSERT_EQ(stats.producersArrLen, producersCount);
+    for (size_t idx = 0; idx < stats.producersArrLen; ++idx) {
+        ASSERT_NE(std::ranges::find(pids, stats.producersArr[idx].pid), pids.end());
+        ASSERT_EQ(stats.producersArr[idx].open, false);
+        ASSERT_EQ(stats.producersArr[idx].recordsCount, linesPerProducer);
+        ASSERT_EQ(stats.producersArr[idx].overrunsCount, 0);
+    }
+    ASSERT_EQ(stats.skippedLen, 0);
+}
+
+// A ring of a single page, drained every few records so that frames wrap around its end many times over, then left to fill up
+TEST_F(LoggerTest, ShmRingSinkWrapsAndCountsOverruns) {
+    constexpr int                    roundsCount        = 40;
+    constexpr int                    linesPerRound      = 10;
+    constexpr int                    overflowLinesCount = 100;
+    const std::string                name               = shmRingName();
+    const mdn_Logger_ShmRingConfig_t config             = {.name = name.c_str(), .ringSize = 1};  // Rounded up to 4 KiB
+    mdn_Logger_ShmRingDrain_t       *drain;
+    mdn_Logger_Sink_t                sink;
+    mdn_Logger_ShmRingStats_t        stats;
+    mdn_Logger_Stats_t               loggerStats;
+    std::map<int, std::string>       contentByPid;
+    std::vector<std::string>         lines;
+    size_t                           recordsCount;
+
+    (void)shm_unlink(name.c_str());
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createShmRingSink(&sink, config), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_openShmRingDrain(&drain, config), MDN_STATUS_SUCCESS);
+    for (int roundIdx = 0; roundIdx < roundsCount; ++roundIdx) {
+        for (int lineIdx = 0; lineIdx < linesPerRound; ++lineIdx) {
+            MDN_LOGGER_LOG_INFO("Round %d line %d", roundIdx, lineIdx);  // NOLINT(hicpp-vararg)
+        }
+        ASSERT_EQ(mdn_Logger_drainShmRing(drain, appendShmRingRecord, &contentByPid, &recordsCount), MDN_STATUS_SUCCESS);
+        ASSERT_EQ(recordsCount, linesPerRound);
+    }
+    logInfo(std::string(2048, 'x'));  // NOLINT(readability-magic-numbers): more than a quarter of the ring
+    for (int lineIdx = 0; lineIdx < overflowLinesCount; ++lineIdx) {
+        MDN_LOGGER_LOG_INFO("Overflow line %d", lineIdx);  // NOLINT(hicpp-vararg)
+    }
+    ASSERT_EQ(mdn_Logger_drainShmRing(drain, appendShmRingRecord, &contentByPid, &recordsCount), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_getShmRingStats(drain, &stats), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_getStats(&loggerStats), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    mdn_Logger_closeShmRingDrain(drain);
+    (void)shm_unlink(name.c_str());
+
+    ASSERT_GT(recordsCount, 0);
+    ASSERT_LT(recordsCount, overflowLinesCount);
+    appendLines(contentByPid[getpid()], lines);
+    ASSERT_EQ(lines.size(), (roundsCount * linesPerRound) + recordsCount);
+    for (size_t idx = 0; idx < lines.size(); ++idx) {
+        const std::string message = (idx < (roundsCount * linesPerRound))
+                                        ? "Round " + std::to_string(idx / linesPerRound) + " line " + std::to_string(idx % linesPerRound)
+                                        : "Overflow line " + std::to_string(idx - (roundsCount * linesPerRound));
+
+        ASSERT_EQ(std::regex_match(lines[idx], loggingFormatToRegexMap[MDN_LOGGER_LOGGING_FORMAT_FILE]), true) << lines[idx];
+        ASSERT_EQ(lines[idx].ends_with(message), true) << lines[idx];
+    }
+    ASSERT_EQ(stats.producersArrLen, 1);
+    ASSERT_EQ(stats.producersArr[0].pid, getpid());
+    ASSERT_EQ(stats.producersArr[0].open, true);
+    ASSERT_EQ(stats.producersArr[0].recordsCount, lines.size());
+    ASSERT_EQ(stats.producersArr[0].overrunsCount, 1 + overflowLinesCount - recordsCount);
+    ASSERT_EQ(loggerStats.streamsArr[0].writeErrorsCount, stats.producersArr[0].overrunsCount);
+}
+
+// Threads reserve frames concurrently while the drain frees them, and records are only ever lost as counted overruns.
+// The ring doesn't wrap: the sink and the drain map it at different addresses, so ThreadSanitizer can't see that the drain
+// orders the writes of a frame before those of the next lap's.
+TEST_F(LoggerTest, ShmRingSinkFromMultipleThreadsWhileDraining) {
+    constexpr size_t                 threadsCount   = 4;
+    constexpr size_t                 linesPerThread = 500;
+    const std::string                name           = shmRingName();
+    const mdn_Logger_ShmRingConfig_t config         = {.name = name.c_str(), .ringSize = 0};
+    mdn_Logger_ShmRingDrain_t       *drain;
+    mdn_Logger_Sink_t                sink;
+    mdn_Logger_ShmRingStats_t        stats;
+    std::map<int, std::string>       contentByPid;
+    std::vector<std::string>         lines;
+    std::atomic_bool                 stopRequested(false);
+
+    (void)shm_unlink(name.c_str());
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createShmRingSink(&sink, config), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_openShmRingDrain(&drain, config), MDN_STATUS_SUCCESS);
+    std::thread drainer([drain, &contentByPid, &stopRequested]() {
+        size_t recordsCount;
+
+        while (!stopRequested.load()) {
+            (void)mdn_Logger_drainShmRing(drain, appendShmRingRecord, &contentByPid, &recordsCount);
+            if (recordsCount == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    ASSERT_NO_FATAL_FAILURE(logFromThreads(threadsCount, linesPerThread));
+    stopRequested.store(true);
+    drainer.join();
+    ASSERT_EQ(mdn_Logger_drainShmRing(drain, appendShmRingRecord, &contentByPid, nullptr), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_getShmRingStats(drain, &stats), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    mdn_Logger_closeShmRingDrain(drain);
+    (void)shm_unlink(name.c_str());
+
+    appendLines(contentByPid[getpid()], lines);
+    for (const auto &line : lines) {
+        ASSERT_EQ(std::regex_match(line, loggingFormatToRegexMap[MDN_LOGGER_LOGGING_FORMAT_FILE]), true) << line;
+    }
+    ASSERT_EQ(stats.producersArrLen, 1);
+    ASSERT_EQ(stats.producersArr[0].recordsCount, lines.size());
+    ASSERT_EQ(lines.size() + stats.producersArr[0].overrunsCount, threadsCount * linesPerThread);
+}
+#endif  // OS
+
+#ifdef MDN_LOGGER_SAFE_MODE
+
+class LoggerSafeModeTest : public ::LoggerTest {
+protected:
+    static inline mdn_Logger_StreamConfig_t streamConfigNullStream;
+    static inline mdn_Logger_StreamConfig_t streamConfigLoggingLevelTooBig;
+    static inline mdn_Logger_StreamConfig_t streamConfigLoggingLevelTooSmall;
+    static inline mdn_Logger_StreamConfig_t streamConfigLoggingFormatTooBig;
+    static inline mdn_Logger_StreamConfig_t streamConfigLoggingFormatTooSmall;
+    static inline mdn_Logger_StreamConfig_t streamConfigCompressedScreen;
+    static inline mdn_Logger_StreamConfig_t streamConfigIoUringBinary;
+    static inline mdn_Logger_StreamConfig_t streamConfigIoUringCompressed;
+    static inline mdn_Logger_FdConfig_t fdConfigDefault;
+    static inline mdn_Logger_FdConfig_t fdConfigNegativeFd;
+    static inline mdn_Logger_FdConfig_t fdConfigBinary;
+    static inline mdn_Logger_MmapFileConfig_t mmapFileConfigDefault;
+    static inline mdn_Logger_MmapFileConfig_t mmapFileConfigNullPath;
+    static inline mdn_Logger_MmapFileConfig_t mmapFileConfigLoggingLevelTooBig;
+    static inline mdn_Logger_MmapFileConfig_t mmapFileConfigMissingDirectory;
+    static inline mdn_Logger_FlightRecorderConfig_t flightRecorderConfigDefault;
+    static inline mdn_Logger_FlightRecorderConfig_t flightRecorderConfigNullPath;
+    static inline mdn_Logger_FlightRecorderConfig_t flightRecorderConfigLoggingLevelTooBig;
+    static inline mdn_Logger_RotatingFileConfig_t rotatingFileConfigDefault;
+    static inline mdn_Logger_RotatingFileConfig_t rotatingFileConfigNullPath;
+    static inline mdn_Logger_RotatingFileConfig_t rotatingFileConfigLoggingLevelTooBig;
+    static inline mdn_Logger_StatsDumpConfig_t statsDumpConfigDefault;
+    static inline mdn_Logger_StatsDumpConfig_t statsDumpConfigNullPath;
+    static inline mdn_Logger_StatsDumpConfig_t statsDumpConfigZeroInterval;
+    static inline mdn_Logger_BacktraceConfig_t backtraceConfigZeroRecords;
+    static inline mdn_Logger_BacktraceConfig_t backtraceConfigFlushLevelTooSmall;
+    static inline mdn_Logger_UnixSocketConfig_t unixSocketConfigDefault;
+    static inline mdn_Logger_UnixSocketConfig_t unixSocketConfigNullPath;
+    static inline mdn_Logger_UnixSocketConfig_t unixSocketConfigPathTooLong;
+    static inline std::string longPath;
+    static inline mdn_Logger_ShmRingConfig_t shmRingConfigDefault;
+    static inline mdn_Logger_ShmRingConfig_t shmRingConfigNullName;
+    static inline mdn_Logger_ShmRingConfig_t shmRingConfigTooLarge;
+
+public:
+    static void SetUpTestSuite() {
+        streamConfigNullStream        = streamConfigDefault;
+        streamConfigNullStream.stream = nullptr;
+
+        streamConfigLoggingLevelTooBig              = streamConfigDefault;
+        streamConfigLoggingLevelTooBig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
+
+        streamConfigLoggingLevelTooSmall              = streamConfigDefault;
+        streamConfigLoggingLevelTooSmall.loggingLevel = static_cast<mdn_Logger_loggingLevel_t>(-1);  // NOLINT(clang-analyzer-optin.core.EnumCastOutOfRange)
+
+        streamConfigLoggingFormatTooBig               = streamConfigDefault;
+        streamConfigLoggingFormatTooBig.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_COUNT;
+
+        streamConfigLoggingFormatTooSmall               = streamConfigDefault;
+        streamConfigLoggingFormatTooSmall.loggingFormat = static_cast<mdn_Logger_loggingFormat_t>(-1);  // NOLINT(clang-analyzer-optin.core.EnumCastOutOfRange)
+
+        streamConfigCompressedScreen            = streamConfigDefault;
+        streamConfigCompressedScreen.compressed = true;
+
+        streamConfigIoUringBinary               = streamConfigDefault;
+        streamConfigIoUringBinary.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_BINARY;
+        streamConfigIoUringBinary.ioUring       = true;
+
+        streamConfigIoUringCompressed               = streamConfigDefault;
+        streamConfigIoUringCompressed.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE;
+        streamConfigIoUringCompressed.compressed    = true;
+        streamConfigIoUringCompressed.ioUring       = true;
+
+        mmapFileConfigDefault = {
+            .path         = "logger_mmap.log",
+            .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+            .chunkSize    = 0};
+
+        mmapFileConfigNullPath      = mmapFileConfigDefault;
+        mmapFileConfigNullPath.path = nullptr;
+
+        mmapFileConfigLoggingLevelTooBig              = mmapFileConfigDefault;
+        mmapFileConfigLoggingLevelTooBig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
+
+        mmapFileConfigMissingDirectory      = mmapFileConfigDefault;
+        mmapFileConfigMissingDirectory.path = "missing_directory/logger_mmap.log";
+
+        fdConfigDefault = {
+            .fd                = fileno(stdout),
+            .loggingLevel      = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+            .loggingFormat     = MDN_LOGGER_LOGGING_FORMAT_SCREEN,
+            .flushSize         = 0,
+            .flushRecordsCount = 0,
+            .flushIntervalMs   = 0};
+
+        fdConfigNegativeFd    = fdConfigDefault;
+        fdConfigNegativeFd.fd = -1;
+
+        fdConfigBinary               = fdConfigDefault;
+        fdConfigBinary.loggingFormat = MDN_LOGGER_LOGGING_FORMAT_BINARY;
+
+        flightRecorderConfigDefault = {
+            .path         = "logger_flight_recorder.mdnf",
+            .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+            .ringSize     = 0};
+
+        flightRecorderConfigNullPath      = flightRecorderConfigDefault;
+        flightRecorderConfigNullPath.path = nullptr;
+
+        flightRecorderConfigLoggingLevelTooBig              = flightRecorderConfigDefault;
+        flightRecorderConfigLoggingLevelTooBig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
+
+        rotatingFileConfigDefault = {
+            .path                = "logger_rotating.log",
+            .loggingLevel        = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+            .maxFileSize         = 0,
+            .rotationIntervalSec = 0,
+            .retainedCount       = 0,
+            .compress            = false};
+
+        rotatingFileConfigNullPath      = rotatingFileConfigDefault;
+        rotatingFileConfigNullPath.path = nullptr;
+
+        rotatingFileConfigLoggingLevelTooBig              = rotatingFileConfigDefault;
+        rotatingFileConfigLoggingLevelTooBig.loggingLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT;
+
+        statsDumpConfigDefault = {
+            .path       = "logger_stats.prom",
+            .intervalMs = 1000};
+
+        statsDumpConfigNullPath      = statsDumpConfigDefault;
+        statsDumpConfigNullPath.path = nullptr;
+
+        statsDumpConfigZeroInterval            = statsDumpConfigDefault;
+        statsDumpConfigZeroInterval.intervalMs = 0;
+
+        backtraceConfigZeroRecords              = backtraceConfigDefault;
+        backtraceConfigZeroRecords.recordsCount = 0;
+
+        backtraceConfigFlushLevelTooSmall            = backtraceConfigDefault;
+        backtraceConfigFlushLevelTooSmall.flushLevel = backtraceConfigDefault.loggingLevel;
+
+        unixSocketConfigDefault = {
+            .path         = "collector.sock",
+            .seqPacket    = false,
+            .datagramSize = 0,
+            .spillSize    = 0};
+
+        unixSocketConfigNullPath      = unixSocketConfigDefault;
+        unixSocketConfigNullPath.path = nullptr;
+
+        longPath                         = std::string(1024, 'x');  // NOLINT(readability-magic-numbers): longer than any socket address
+        unixSocketConfigPathTooLong      = unixSocketConfigDefault;
+        unixSocketConfigPathTooLong.path = longPath.c_str();
+
+        shmRingConfigDefault = {
+            .name     = "/mdn_logger_test",
+            .ringSize = 0};
+
+        shmRingConfigNullName      = shmRingConfigDefault;
+        shmRingConfigNullName.name = nullptr;
+
+        shmRingConfigTooLarge          = shmRingConfigDefault;
+        shmRingConfigTooLarge.ringSize = SIZE_MAX;
+    }
+};
+
+TEST_F(LoggerSafeModeTest, InvalidArguments) {
+    const std::vector<OutputFiles> outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+    const mdn_Logger_Sink_t        nullSink    = {.ops = nullptr, .context = nullptr};
+    mdn_Logger_Stats_t             stats;
+    mdn_Logger_Sink_t              sink;
+    std::array<char, 16>           buffer{};
+    mdn_Logger_ShmRingDrain_t     *shmRingDrain;
+    mdn_Logger_ShmRingStats_t      shmRingStats;
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigDefault), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_removeOutputStream(stdout), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = mdn_Logger_fileSink(stdout), .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_SCREEN}), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_removeSink(mdn_Logger_fileSink(stdout)), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_createRawFdSink(nullptr, fileno(stdout)), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createRawFdSink(&sink, -1), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createMemorySink(nullptr, buffer.size()), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createMemorySink(&sink, 0), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_readMemorySink(mdn_Logger_fileSink(stdout), buffer.data(), buffer.size()), 0);
+    ASSERT_EQ(mdn_Logger_createCallbackSink(nullptr, appendToRecords, nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createCallbackSink(&sink, nullptr, nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createUnixSocketSink(nullptr, unixSocketConfigDefault), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createUnixSocketSink(&sink, unixSocketConfigNullPath), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createUnixSocketSink(&sink, unixSocketConfigPathTooLong), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createShmRingSink(nullptr, shmRingConfigDefault), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createShmRingSink(&sink, shmRingConfigNullName), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createShmRingSink(&sink, shmRingConfigTooLarge), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_openShmRingDrain(nullptr, shmRingConfigDefault), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_openShmRingDrain(&shmRingDrain, shmRingConfigNullName), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_openShmRingDrain(&shmRingDrain, shmRingConfigTooLarge), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_drainShmRing(nullptr, [](int, const char *, size_t, void *) { return true; }, nullptr, nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_getShmRingStats(nullptr, &shmRingStats), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addFd(fdConfigDefault), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_addMmapFile(mmapFileConfigDefault), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_addRotatingFile(rotatingFileConfigDefault), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_addFlightRecorder(flightRecorderConfigDefault), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_setTimestampPrecision(MDN_LOGGER_TIMESTAMP_PRECISION_MSEC), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_setSiteLevel(nullptr, nullptr, MDN_LOGGER_LOGGING_LEVEL_DEBUG), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_resetSiteLevels(), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_getStats(&stats), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_writeStats(stdout), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_startStatsDump(statsDumpConfigDefault), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_enableBacktrace(backtraceConfigDefault), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_disableBacktrace(), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_decodeBinary(nullptr, stdout), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_decodeBinary(stdin, nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_decompress(nullptr, stdout), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_decompress(stdin, nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_extractFlightRecorder(nullptr, stdout), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_extractFlightRecorder(stdin, nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_allowRateLimited(nullptr, 1, 1, nullptr, nullptr), false);
+    ASSERT_EQ(mdn_Logger_allowSampled(nullptr, 1), false);
+    MDN_LOGGER_LOG_DEBUG("Test message (should not be logged, library not initialized)");  // NOLINT(hicpp-vararg)
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_ERROR_LIBRARY_ALREADY_INITIALIZED);
+
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigNullStream), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigLoggingLevelTooBig), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigLoggingLevelTooSmall), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigLoggingFormatTooBig), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigLoggingFormatTooSmall), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigCompressedScreen), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigIoUringBinary), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigIoUringCompressed), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_setTimestampPrecision(MDN_LOGGER_TIMESTAMP_PRECISION_COUNT), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_setSiteLevel(nullptr, nullptr, MDN_LOGGER_LOGGING_LEVEL_COUNT), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_removeOutputStream(nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_removeOutputStream(stdout), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = nullSink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_SCREEN}), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_createMemorySink(&sink, buffer.size()), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_COUNT, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_ERROR_BAD_ARGUMENT);  // Closes it
+    ASSERT_EQ(mdn_Logger_createMemorySink(&sink, buffer.size()), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_COUNT}), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_removeSink(nullSink), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_removeSink(mdn_Logger_fileSink(stdout)), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addFd(fdConfigNegativeFd), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addFd(fdConfigBinary), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addMmapFile(mmapFileConfigNullPath), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addMmapFile(mmapFileConfigLoggingLevelTooBig), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addMmapFile(mmapFileConfigMissingDirectory), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addRotatingFile(rotatingFileConfigNullPath), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addRotatingFile(rotatingFileConfigLoggingLevelTooBig), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addFlightRecorder(flightRecorderConfigNullPath), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_addFlightRecorder(flightRecorderConfigLoggingLevelTooBig), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_getStats(nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_writeStats(nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_startStatsDump(statsDumpConfigNullPath), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_startStatsDump(statsDumpConfigZeroInterval), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_enableBacktrace(backtraceConfigZeroRecords), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_enableBacktrace(backtraceConfigFlushLevelTooSmall), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_NO_FATAL_FAILURE(addOutputStreams(outputFiles));
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, outputFiles));
+
+    mdn_Logger_log(static_cast<mdn_Logger_loggingLevel_t>(-1), __FILE__, __LINE__, MDN_LOGGER_FUNC_NAME, "Test message (should not be logged, logging format too small)");  // NOLINT(clang-analyzer-optin.core.EnumCastOutOfRange,hicpp-vararg)
+    mdn_Logger_log(MDN_LOGGER_LOGGING_LEVEL_COUNT, __FILE__, __LINE__, MDN_LOGGER_FUNC_NAME, "Test message (should not be logged, logging format too big)");                // NOLINT(hicpp-vararg)
+    mdn_Logger_log(MDN_LOGGER_LOGGING_LEVEL_DEBUG, nullptr, __LINE__, MDN_LOGGER_FUNC_NAME, "Test message (should not be logged, file is null)");                           // NOLINT(hicpp-vararg)
+    mdn_Logger_log(MDN_LOGGER_LOGGING_LEVEL_DEBUG, __FILE__, -1, MDN_LOGGER_FUNC_NAME, "Test message (should not be logged, line is negative)");                            // NOLINT(hicpp-vararg)
+    mdn_Logger_log(MDN_LOGGER_LOGGING_LEVEL_DEBUG, __FILE__, __LINE__, nullptr, "Test message (should not be logged, function is null)");                                   // NOLINT(hicpp-vararg)
+    mdn_Logger_logSite(nullptr, MDN_LOGGER_FUNC_NAME, "Test message (should not be logged, call site is null)");                                                            // NOLINT(hicpp-vararg)
+    mdn_Logger_logMessage(MDN_LOGGER_LOGGING_LEVEL_COUNT, __FILE__, __LINE__, MDN_LOGGER_FUNC_NAME, "Test message", sizeof("Test message") - 1);
+    mdn_Logger_logMessage(MDN_LOGGER_LOGGING_LEVEL_DEBUG, __FILE__, __LINE__, MDN_LOGGER_FUNC_NAME, nullptr, 0);
+
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(defaultLogLines, outputFiles));
+}
+
+TEST_F(LoggerSafeModeTest, InvalidAsyncArguments) {
+    mdn_Logger_AsyncConfig_t asyncConfig;
+    mdn_Logger_AsyncStats_t  asyncStats;
+
+    ASSERT_EQ(mdn_Logger_getAsyncStats(&asyncStats), MDN_STATUS_ERROR_LIBRARY_NOT_INITIALIZED);
+
+    asyncConfig               = asyncConfigDefault;
+    asyncConfig.queueCapacity = 0;
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfig), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    asyncConfig               = asyncConfigDefault;
+    asyncConfig.maxMessageLen = 0;
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfig), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    asyncConfig            = asyncConfigDefault;
+    asyncConfig.fullPolicy = MDN_LOGGER_ASYNC_FULL_POLICY_COUNT;
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfig), MDN_STATUS_ERROR_BAD_ARGUMENT);
+
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_ERROR_LIBRARY_ALREADY_INITIALIZED);
+    ASSERT_EQ(mdn_Logger_getAsyncStats(nullptr), MDN_STATUS_ERROR_BAD_ARGUMENT);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+
+#endif  // MDN_LOGGER_SAFE_MODE
+
+#ifdef MDN_MW_ENABLE_MOCKING
+
+class LoggerTestMemoryAllocationFailure : public LoggerTest {};
+
+TEST_F(LoggerTestMemoryAllocationFailure, InitFail) {
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_init"), _))
+        .WillOnce(Return(nullptr));
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_ERROR_MEM_ALLOC);
+}
+
+TEST_F(LoggerTestMemoryAllocationFailure, AddOutputStreamFail) {
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_appendStream"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addOutputStream(streamConfigDefault), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+
+// The sink is closed when it can't be added
+TEST_F(LoggerTestMemoryAllocationFailure, AddSinkFail) {
+    constexpr size_t  capacity = 4096;
+    mdn_Logger_Sink_t sink;
+
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_createMemorySink"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_appendStream"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createMemorySink(&sink, capacity), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_createMemorySink(&sink, capacity), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_BINARY}), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+
+#if (defined __APPLE__) || (defined __linux__)
+TEST_F(LoggerTestMemoryAllocationFailure, AddMmapFileFail) {
+    const std::string                 path           = (testOutputDirPath / (testFullName + ".log")).string();
+    const mdn_Logger_MmapFileConfig_t mmapFileConfig = {
+        .path         = path.c_str(),
+        .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .chunkSize    = 0};
+
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_MmapSink_create"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addMmapFile(mmapFileConfig), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_addMmapFile(mmapFileConfig), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+
+TEST_F(LoggerTestMemoryAllocationFailure, AddFdFail) {
+    const mdn_Logger_FdConfig_t fdConfig = {
+        .fd                = fileno(stdout),
+        .loggingLevel      = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .loggingFormat     = MDN_LOGGER_LOGGING_FORMAT_SCREEN,
+        .flushSize         = 0,
+        .flushRecordsCount = 0,
+        .flushIntervalMs   = 0};
+
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_FdSink_create"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addFd(fdConfig), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_addFd(fdConfig), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+
+// Falls back to writev() rather than failing
+TEST_F(LoggerTestMemoryAllocationFailure, AddFdIoUringFail) {
+    const std::vector<OutputFiles> outputFiles = {OutputFiles::LOGGER_OUTPUT_1};
+    mdn_Logger_FdConfig_t          fdConfig;
+
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_Uring_create"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_NO_FATAL_FAILURE(openTestOutputFiles(outputFiles));
+    fdConfig = {
+        .fd                = fileno(outputFilesInfo[static_cast<std::size_t>(outputFiles[0])].fileToRead),
+        .loggingLevel      = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .loggingFormat     = MDN_LOGGER_LOGGING_FORMAT_FILE,
+        .flushSize         = 0,
+        .flushRecordsCount = 0,
+        .flushIntervalMs   = 0,
+        .ioUring           = true};
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addFd(fdConfig), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(printAllToLogs(defaultLogLines, {}));
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_NO_FATAL_FAILURE(closeTestOutputFiles(outputFiles));
+
+    ASSERT_NO_FATAL_FAILURE(verifyLogFiles(defaultLogLines, outputFiles));
+}
+
+TEST_F(LoggerTestMemoryAllocationFailure, CreateUnixSocketSinkFail) {
+    const std::string                   path   = (fs::temp_directory_path() / (testFullName + ".sock")).string();
+    const mdn_Logger_UnixSocketConfig_t config = {
+        .path         = path.c_str(),
+        .seqPacket    = false,
+        .datagramSize = 0,
+        .spillSize    = 0};
+    mdn_Logger_Sink_t sink;
+
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_createUnixSocketSink"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createUnixSocketSink(&sink, config), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_createUnixSocketSink(&sink, config), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+
+TEST_F(LoggerTestMemoryAllocationFailure, CreateShmRingSinkFail) {
+    const std::string                name   = shmRingName();
+    const mdn_Logger_ShmRingConfig_t config = {.name = name.c_str(), .ringSize = 0};
+    mdn_Logger_Sink_t                sink;
+    mdn_Logger_ShmRingDrain_t       *drain;
+
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_createShmRingSink"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_openShmRingDrain"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    (void)shm_unlink(name.c_str());
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_createShmRingSink(&sink, config), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_createShmRingSink(&sink, config), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addSink({.sink = sink, .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG, .loggingFormat = MDN_LOGGER_LOGGING_FORMAT_FILE}), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_openShmRingDrain(&drain, config), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_openShmRingDrain(&drain, config), MDN_STATUS_SUCCESS);
+    mdn_Logger_closeShmRingDrain(drain);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    (void)shm_unlink(name.c_str());
+}
+
+TEST_F(LoggerTestMemoryAllocationFailure, AddFlightRecorderFail) {
+    const std::string                       path                 = (testOutputDirPath / (testFullName + ".mdnf")).string();
+    const mdn_Logger_FlightRecorderConfig_t flightRecorderConfig = {
+        .path         = path.c_str(),
+        .loggingLevel = MDN_LOGGER_LOGGING_LEVEL_DEBUG,
+        .ringSize     = 1};
+
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_FlightRecorderSink_create"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_BinarySites_create"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_addFlightRecorder(flightRecorderConfig), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_addFlightRecorder(flightRecorderConfig), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_addFlightRecorder(flightRecorderConfig), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+#endif  // OS
+
+TEST_F(LoggerTestMemoryAllocationFailure, SetSiteLevelFail) {
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_CallSiteRegistry_addRule"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_setSiteLevel("*.c", nullptr, MDN_LOGGER_LOGGING_LEVEL_DEBUG), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_setSiteLevel("*.c", nullptr, MDN_LOGGER_LOGGING_LEVEL_DEBUG), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+
+TEST_F(LoggerTestMemoryAllocationFailure, InitAsyncFail) {
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_initAsync"), _))
+        .WillOnce(Return(nullptr));
+
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_ERROR_MEM_ALLOC);
+}
+
+TEST_F(LoggerTestMemoryAllocationFailure, InitAsyncQueueFail) {
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_AsyncQueue_create"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_initAsync(asyncConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+
+TEST_F(LoggerTestMemoryAllocationFailure, EnableBacktraceFail) {
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_Backtrace_create"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_enableBacktrace(backtraceConfigDefault), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(MDN_LOGGER_IS_LEVEL_ENABLED(MDN_LOGGER_LOGGING_LEVEL_DEBUG), false);
+    ASSERT_EQ(mdn_Logger_enableBacktrace(backtraceConfigDefault), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+}
+
+TEST_F(LoggerTestMemoryAllocationFailure, StartStatsDumpFail) {
+    const std::string                  path            = (testOutputDirPath / (testFullName + ".prom")).string();
+    const mdn_Logger_StatsDumpConfig_t statsDumpConfig = {
+        .path       = path.c_str(),
+        .intervalMs = 1000};
+
+    EXPECT_CALL(*mWMock, malloc(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*mWMock, malloc(StrEq("mdn_Logger_StatsDump_start"), _))
+        .WillOnce(Return(nullptr))
+        .RetiresOnSaturation();
+
+    ASSERT_EQ(mdn_Logger_init(), MDN_STATUS_SUCCESS);
+    ASSERT_EQ(mdn_Logger_startStatsDump(statsDumpConfig), MDN_STATUS_ERROR_MEM_ALLOC);
+    ASSERT_EQ(mdn_Logger_startStatsDump(statsDumpConfig), MDN_STATUS_SUCCESS);
     ASSERT_EQ(mdn_Logger_deinit(), MDN_STATUS_SUCCESS);
+    ASSERT_TRUE(fs::exists(path));
 }
 
 #endif  // MDN_MW_ENABLE_MOCKING